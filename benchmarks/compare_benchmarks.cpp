@@ -0,0 +1,115 @@
+/**
+ * @file compare_benchmarks.cpp
+ * @brief Diffs two benchmark JSON reports and flags regressions
+ *
+ * Usage:
+ *   compare_benchmarks <baseline.json> <candidate.json>
+ *                      [--threshold=0.10] [--noise=3] [--all]
+ *
+ * Reports are written by test_performance_benchmarks --json=<file>;
+ * run it with --repeat=N so each metric has a noise estimate. A metric
+ * regresses only if its median moved the wrong way by more than the
+ * threshold AND by more than --noise times the run-to-run noise.
+ *
+ * Exit status: 0 = no regressions, 1 = regressions found, 2 = error.
+ */
+
+#include "benchmark_report.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program
+              << " <baseline.json> <candidate.json> [--threshold=0.10] [--noise=3] [--all]\n";
+}
+
+void print_host(const std::string& label, const BenchmarkReport& report) {
+    const HostInfo& host = report.host();
+    std::cout << "  " << std::left << std::setw(10) << label << host.timestamp << "  "
+              << host.hostname << "  " << host.cpu_model << " (" << host.cores << " cores)  "
+              << report.repetitions() << " run(s)\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string baseline_file;
+    std::string candidate_file;
+    CompareConfig config;
+    bool show_all = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--threshold=", 0) == 0) {
+            config.threshold = std::stod(arg.substr(12));
+        } else if (arg.rfind("--noise=", 0) == 0) {
+            config.noise_sigmas = std::stod(arg.substr(8));
+        } else if (arg == "--all") {
+            show_all = true;
+        } else if (baseline_file.empty()) {
+            baseline_file = arg;
+        } else if (candidate_file.empty()) {
+            candidate_file = arg;
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (baseline_file.empty() || candidate_file.empty()) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    BenchmarkReport baseline;
+    BenchmarkReport candidate;
+    try {
+        baseline = BenchmarkReport::load(baseline_file);
+        candidate = BenchmarkReport::load(candidate_file);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 2;
+    }
+
+    std::cout << "\n=== Benchmark Comparison ===\n";
+    print_host("baseline", baseline);
+    print_host("candidate", candidate);
+    if (baseline.host().cpu_model != candidate.host().cpu_model) {
+        std::cout << "  WARNING: reports come from different CPUs\n";
+    }
+    std::cout << "  Threshold: " << std::fixed << std::setprecision(1)
+              << config.threshold * 100 << "%, noise: " << config.noise_sigmas << " sigma\n\n";
+
+    auto comparisons = compare_benchmark_reports(baseline, candidate, config);
+
+    std::cout << std::left << std::setw(28) << "Benchmark" << std::setw(22) << "Metric"
+              << std::right << std::setw(14) << "Baseline" << std::setw(14) << "Candidate"
+              << std::setw(10) << "Change" << "  Verdict\n";
+    std::cout << std::string(98, '-') << "\n";
+
+    int regressed = 0;
+    int improved = 0;
+    int noisy = 0;
+    for (const auto& c : comparisons) {
+        switch (c.verdict) {
+            case MetricComparison::Verdict::REGRESSED: regressed++; break;
+            case MetricComparison::Verdict::IMPROVED: improved++; break;
+            case MetricComparison::Verdict::NOISY: noisy++; break;
+            default: break;
+        }
+        if (!show_all && c.verdict == MetricComparison::Verdict::UNCHANGED) {
+            continue;
+        }
+        std::cout << std::left << std::setw(28) << c.benchmark << std::setw(22) << c.metric
+                  << std::right << std::setprecision(1) << std::setw(14) << c.baseline
+                  << std::setw(14) << c.candidate << std::setw(9) << std::showpos
+                  << c.change * 100 << std::noshowpos << "%  " << verdict_name(c.verdict)
+                  << "\n";
+    }
+
+    std::cout << "\n  Compared: " << comparisons.size() << " metrics | regressed: " << regressed
+              << " | improved: " << improved << " | noisy: " << noisy << "\n";
+    std::cout << "  (change is signed so that positive = worse)\n";
+
+    return regressed > 0 ? 1 : 0;
+}
@@ -0,0 +1,531 @@
+/**
+ * @file queue_benchmarks.cpp
+ * @brief Queue benchmark matrix: which queue to deploy on which hop
+ *
+ * Runs every queue (SPSCQueue, SPMCQueue, MPSCQueue, RingBufferPool)
+ * through two experiments:
+ *
+ * - Ping-pong latency: two threads bounce a message through a pair of
+ *   queues; one-way latency = round trip / 2. Repeated for payloads of
+ *   8B..256B and for each thread placement the machine offers:
+ *   SMT siblings (same core), same socket, cross socket, and unpinned.
+ * - Throughput: 1..N producers (MPSC) or consumers (SPMC) draining a
+ *   fixed number of messages; SPSC and RingBufferPool run 1:1. Threads
+ *   are pinned to distinct CPUs when there are enough of them.
+ *
+ * Placements the topology cannot provide are reported as unavailable.
+ * Spin loops yield after a while so oversubscribed runs still finish,
+ * but numbers from fewer CPUs than threads measure the scheduler.
+ *
+ * Usage:
+ *   queue_benchmarks [--quick] [--max-threads=N] [--ops=N]
+ *                    [--roundtrips=N] [--json=<file>]
+ */
+
+#include "benchmark_report.hpp"
+#include "memory_pool.hpp"
+#include "mpsc_queue.hpp"
+#include "performance_monitor.hpp"
+#include "spmc_queue.hpp"
+#include "spsc_queue.hpp"
+#include "thread_config.hpp"
+#include "wait_strategy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Queue capacity for every benchmark (slots)
+static constexpr size_t QUEUE_CAPACITY = 1024;
+
+struct QueueBenchOptions {
+    size_t throughput_ops = 1000000;
+    size_t roundtrips = 20000;
+    size_t max_threads = 4;
+    std::string json_file;
+};
+static QueueBenchOptions g_options;
+static BenchmarkReport g_report;
+
+/**
+ * @brief Message of N bytes; the sequence number is checked on receipt
+ */
+template <size_t N>
+struct Payload {
+    static_assert(N >= sizeof(uint64_t), "payload holds at least the sequence");
+    uint64_t seq = 0;
+    std::array<char, N - sizeof(uint64_t)> pad{};
+};
+
+// ============================================================================
+// QUEUE ADAPTERS (uniform try_push / try_pop)
+// ============================================================================
+
+template <typename T>
+struct SpscAdapter {
+    static constexpr const char* NAME = "spsc";
+    SPSCQueue<T> queue{QUEUE_CAPACITY};
+    bool try_push(const T& item) { return queue.push(item); }
+    bool try_pop(T& out) {
+        auto item = queue.pop();
+        if (!item) return false;
+        out = *item;
+        return true;
+    }
+    bool empty() const { return queue.empty(); }
+};
+
+/// SPSC with QueueTelemetry enabled, to price the telemetry hooks
+template <typename T>
+struct SpscTelemetryAdapter {
+    static constexpr const char* NAME = "spsc+telem";
+    SPSCQueue<T, QueueTelemetry> queue{QUEUE_CAPACITY};
+    bool try_push(const T& item) { return queue.push(item); }
+    bool try_pop(T& out) {
+        auto item = queue.pop();
+        if (!item) return false;
+        out = *item;
+        return true;
+    }
+    bool empty() const { return queue.empty(); }
+};
+
+template <typename T>
+struct SpmcAdapter {
+    static constexpr const char* NAME = "spmc";
+    SPMCQueue<T> queue{QUEUE_CAPACITY};
+    bool try_push(const T& item) { return queue.push(item); }
+    bool try_pop(T& out) {
+        auto item = queue.pop();
+        if (!item) return false;
+        out = *item;
+        return true;
+    }
+    bool empty() const { return queue.empty(); }
+};
+
+template <typename T>
+struct MpscAdapter {
+    static constexpr const char* NAME = "mpsc";
+    MPSCQueue<T> queue{QUEUE_CAPACITY};
+    bool try_push(const T& item) { return queue.push(item); }
+    bool try_pop(T& out) {
+        auto item = queue.pop();
+        if (!item) return false;
+        out = *item;
+        return true;
+    }
+    bool empty() const { return queue.empty(); }
+};
+
+template <typename T>
+struct RingPoolAdapter {
+    static constexpr const char* NAME = "ring_pool";
+    RingBufferPool<T, QUEUE_CAPACITY> queue;
+    bool try_push(const T& item) {
+        T* slot = queue.get_write_slot();
+        if (!slot) return false;
+        *slot = item;
+        queue.commit_write();
+        return true;
+    }
+    bool try_pop(T& out) {
+        T* slot = queue.get_read_slot();
+        if (!slot) return false;
+        out = *slot;
+        queue.release_read();
+        return true;
+    }
+    bool empty() const { return queue.empty(); }
+};
+
+/**
+ * @brief Spins with pause, yielding once the peer has clearly been descheduled
+ */
+class Backoff {
+public:
+    void pause() {
+        cpu_relax();
+        if (++spins_ >= 1024) {
+            std::this_thread::yield();
+            spins_ = 0;
+        }
+    }
+    void reset() { spins_ = 0; }
+
+private:
+    int spins_ = 0;
+};
+
+template <typename Queue, typename T>
+void push_blocking(Queue& queue, const T& item) {
+    Backoff backoff;
+    while (!queue.try_push(item)) {
+        backoff.pause();
+    }
+}
+
+template <typename Queue, typename T>
+void pop_blocking(Queue& queue, T& out) {
+    Backoff backoff;
+    while (!queue.try_pop(out)) {
+        backoff.pause();
+    }
+}
+
+// ============================================================================
+// THREAD PLACEMENT
+// ============================================================================
+
+enum class Placement { SMT_SIBLING, SAME_SOCKET, CROSS_SOCKET, UNPINNED };
+
+const char* placement_name(Placement placement) {
+    switch (placement) {
+        case Placement::SMT_SIBLING: return "smt";
+        case Placement::SAME_SOCKET: return "same_socket";
+        case Placement::CROSS_SOCKET: return "cross_socket";
+        case Placement::UNPINNED: return "unpinned";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Picks two CPUs with the requested relationship
+ * @return {-1, -1} for UNPINNED; nullopt if the topology lacks the pair
+ */
+std::optional<std::pair<int, int>> pick_cpu_pair(const std::vector<CpuLocation>& cpus,
+                                                 Placement placement) {
+    if (placement == Placement::UNPINNED) {
+        return std::make_pair(-1, -1);
+    }
+    for (const auto& a : cpus) {
+        for (const auto& b : cpus) {
+            if (a.cpu >= b.cpu || a.core < 0 || a.socket < 0) continue;
+            bool same_socket = a.socket == b.socket;
+            bool same_core = same_socket && a.core == b.core;
+            if ((placement == Placement::SMT_SIBLING && same_core) ||
+                (placement == Placement::SAME_SOCKET && same_socket && !same_core) ||
+                (placement == Placement::CROSS_SOCKET && !same_socket)) {
+                return std::make_pair(a.cpu, b.cpu);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+// ============================================================================
+// PING-PONG LATENCY
+// ============================================================================
+
+struct PingPongResult {
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+    bool valid = true;
+};
+
+/**
+ * @brief Bounces one message between two threads through two queues
+ */
+template <template <typename> class Adapter, size_t N>
+PingPongResult run_ping_pong(int ping_cpu, int pong_cpu) {
+    using T = Payload<N>;
+    auto to_pong = std::make_unique<Adapter<T>>();
+    auto to_ping = std::make_unique<Adapter<T>>();
+    const size_t warmup = std::min<size_t>(1000, g_options.roundtrips / 10);
+    const size_t total = warmup + g_options.roundtrips;
+    std::atomic<bool> valid{true};
+
+    std::thread pong([&]() {
+        apply_thread_config({"qbench-pong", pong_cpu});
+        T msg;
+        for (size_t i = 0; i < total; ++i) {
+            pop_blocking(*to_pong, msg);
+            if (msg.seq != i) valid.store(false, std::memory_order_relaxed);
+            push_blocking(*to_ping, msg);
+        }
+    });
+
+    PerformanceMonitor one_way("ping_pong");
+    std::thread ping([&]() {
+        apply_thread_config({"qbench-ping", ping_cpu});
+        T msg;
+        for (size_t i = 0; i < total; ++i) {
+            msg.seq = i;
+            auto start = std::chrono::steady_clock::now();
+            push_blocking(*to_pong, msg);
+            pop_blocking(*to_ping, msg);
+            auto end = std::chrono::steady_clock::now();
+            if (i == warmup) one_way.reset();
+            if (i >= warmup) {
+                auto rtt = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+                one_way.record_event_latency(static_cast<uint64_t>(rtt.count()) / 2);
+            }
+        }
+    });
+
+    ping.join();
+    pong.join();
+
+    PingPongResult result;
+    result.p50_ns = one_way.get_p50_ns();
+    result.p99_ns = one_way.get_p99_ns();
+    result.p999_ns = one_way.get_p999_ns();
+    result.valid = valid.load();
+    return result;
+}
+
+template <template <typename> class Adapter, size_t N>
+void ping_pong_row(Placement placement, std::pair<int, int> pair) {
+    std::string name = std::string("queue_pingpong/") + Adapter<Payload<N>>::NAME + "/" +
+                       std::to_string(N) + "B/" + placement_name(placement);
+
+    PingPongResult r = run_ping_pong<Adapter, N>(pair.first, pair.second);
+    std::string cpu_label = pair.first < 0 ? "-" : std::to_string(pair.first) + "," +
+                                                       std::to_string(pair.second);
+    std::cout << "  " << std::left << std::setw(11) << Adapter<Payload<N>>::NAME
+              << std::setw(8) << (std::to_string(N) + "B") << std::setw(14)
+              << placement_name(placement) << std::setw(8) << cpu_label << std::right << std::setw(10) << r.p50_ns
+              << std::setw(10) << r.p99_ns << std::setw(10) << r.p999_ns
+              << (r.valid ? "" : "  SEQUENCE ERROR") << "\n";
+
+    g_report.record(name, "p50_ns", static_cast<double>(r.p50_ns));
+    g_report.record(name, "p99_ns", static_cast<double>(r.p99_ns));
+    g_report.record(name, "p999_ns", static_cast<double>(r.p999_ns));
+}
+
+template <template <typename> class Adapter>
+void ping_pong_sizes(Placement placement, std::pair<int, int> pair) {
+    ping_pong_row<Adapter, 8>(placement, pair);
+    ping_pong_row<Adapter, 32>(placement, pair);
+    ping_pong_row<Adapter, 64>(placement, pair);
+    ping_pong_row<Adapter, 128>(placement, pair);
+    ping_pong_row<Adapter, 256>(placement, pair);
+}
+
+void run_ping_pong_matrix(const std::vector<CpuLocation>& cpus) {
+    std::cout << "\n=== Ping-Pong Latency (one-way = RTT/2, " << g_options.roundtrips
+              << " round trips) ===\n";
+    std::cout << "  " << std::left << std::setw(11) << "queue" << std::setw(8) << "payload"
+              << std::setw(14) << "placement" << std::setw(8) << "cpus" << std::right
+              << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::setw(10)
+              << "p99.9 ns" << "\n";
+    std::cout << "  " << std::string(69, '-') << "\n";
+
+    for (Placement placement : {Placement::SMT_SIBLING, Placement::SAME_SOCKET,
+                                Placement::CROSS_SOCKET, Placement::UNPINNED}) {
+        auto pair = pick_cpu_pair(cpus, placement);
+        if (!pair) {
+            std::cout << "  " << std::left << std::setw(33) << placement_name(placement)
+                      << "unavailable on this topology\n";
+            continue;
+        }
+        ping_pong_sizes<SpscAdapter>(placement, *pair);
+        ping_pong_sizes<SpscTelemetryAdapter>(placement, *pair);
+        ping_pong_sizes<SpmcAdapter>(placement, *pair);
+        ping_pong_sizes<MpscAdapter>(placement, *pair);
+        ping_pong_sizes<RingPoolAdapter>(placement, *pair);
+    }
+}
+
+// ============================================================================
+// THROUGHPUT
+// ============================================================================
+
+struct ThroughputResult {
+    double msgs_per_sec = 0.0;
+    bool pinned = false;
+    bool valid = true;
+};
+
+/**
+ * @brief Moves throughput_ops messages from producers to consumers
+ *
+ * Producers split the messages evenly; consumers drain until every
+ * producer is done and the queue is empty. The checksum of received
+ * sequence numbers must match what was sent.
+ */
+template <template <typename> class Adapter, size_t N>
+ThroughputResult run_throughput(size_t producers, size_t consumers,
+                                const std::vector<CpuLocation>& cpus) {
+    using T = Payload<N>;
+    auto queue = std::make_unique<Adapter<T>>();
+    const size_t per_producer = g_options.throughput_ops / producers;
+    const size_t total = per_producer * producers;
+
+    ThroughputResult result;
+    result.pinned = producers + consumers <= cpus.size();
+    auto cpu_for = [&](size_t thread_index) {
+        return result.pinned ? cpus[thread_index].cpu : -1;
+    };
+
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<size_t> producers_done{0};
+    std::atomic<uint64_t> received_sum{0};
+    std::atomic<uint64_t> received_count{0};
+
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c]() {
+            apply_thread_config({"qbench-cons", cpu_for(producers + c)});
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) cpu_relax();
+
+            uint64_t sum = 0;
+            uint64_t count = 0;
+            Backoff backoff;
+            T msg;
+            while (true) {
+                if (queue->try_pop(msg)) {
+                    sum += msg.seq;
+                    count++;
+                    backoff.reset();
+                } else if (producers_done.load(std::memory_order_acquire) == producers &&
+                           queue->empty()) {
+                    break;
+                } else {
+                    backoff.pause();
+                }
+            }
+            received_sum.fetch_add(sum);
+            received_count.fetch_add(count);
+        });
+    }
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            apply_thread_config({"qbench-prod", cpu_for(p)});
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) cpu_relax();
+
+            T msg;
+            for (size_t i = 0; i < per_producer; ++i) {
+                msg.seq = p * per_producer + i;
+                push_blocking(*queue, msg);
+            }
+            producers_done.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    while (ready.load() < producers + consumers) std::this_thread::yield();
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    result.msgs_per_sec = seconds > 0 ? total / seconds : 0.0;
+    const uint64_t expected_sum = static_cast<uint64_t>(total) * (total - 1) / 2;
+    result.valid = received_count.load() == total && received_sum.load() == expected_sum;
+    return result;
+}
+
+template <template <typename> class Adapter, size_t N>
+void throughput_row(size_t producers, size_t consumers, const std::vector<CpuLocation>& cpus) {
+    std::string shape = std::to_string(producers) + "p" + std::to_string(consumers) + "c";
+    std::string name = std::string("queue_throughput/") + Adapter<Payload<N>>::NAME + "/" +
+                       shape + "/" + std::to_string(N) + "B";
+
+    ThroughputResult r = run_throughput<Adapter, N>(producers, consumers, cpus);
+
+    std::cout << "  " << std::left << std::setw(11) << Adapter<Payload<N>>::NAME
+              << std::setw(8) << shape << std::setw(8) << (std::to_string(N) + "B")
+              << std::setw(10) << (r.pinned ? "pinned" : "unpinned") << std::right
+              << std::fixed << std::setprecision(2) << std::setw(12)
+              << r.msgs_per_sec / 1e6 << (r.valid ? "" : "  CHECKSUM ERROR") << "\n";
+
+    g_report.record(name, "throughput", r.msgs_per_sec, {{"pinned", r.pinned ? "yes" : "no"}});
+}
+
+template <template <typename> class Adapter>
+void throughput_sizes(size_t producers, size_t consumers, const std::vector<CpuLocation>& cpus) {
+    throughput_row<Adapter, 8>(producers, consumers, cpus);
+    throughput_row<Adapter, 64>(producers, consumers, cpus);
+    throughput_row<Adapter, 256>(producers, consumers, cpus);
+}
+
+void run_throughput_matrix(const std::vector<CpuLocation>& cpus) {
+    std::cout << "\n=== Throughput (" << g_options.throughput_ops << " messages) ===\n";
+    std::cout << "  " << std::left << std::setw(11) << "queue" << std::setw(8) << "shape"
+              << std::setw(8) << "payload" << std::setw(10) << "threads" << std::right
+              << std::setw(12) << "M msgs/s" << "\n";
+    std::cout << "  " << std::string(49, '-') << "\n";
+
+    throughput_sizes<SpscAdapter>(1, 1, cpus);
+    throughput_sizes<SpscTelemetryAdapter>(1, 1, cpus);
+    throughput_sizes<RingPoolAdapter>(1, 1, cpus);
+    for (size_t n = 1; n <= g_options.max_threads; ++n) {
+        throughput_sizes<SpmcAdapter>(1, n, cpus);
+    }
+    for (size_t n = 1; n <= g_options.max_threads; ++n) {
+        throughput_sizes<MpscAdapter>(n, 1, cpus);
+    }
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            g_options.throughput_ops = 100000;
+            g_options.roundtrips = 2000;
+            g_options.max_threads = 2;
+        } else if (arg.rfind("--max-threads=", 0) == 0) {
+            g_options.max_threads = std::max(1, std::stoi(arg.substr(14)));
+        } else if (arg.rfind("--ops=", 0) == 0) {
+            g_options.throughput_ops = std::max<size_t>(1, std::stoul(arg.substr(6)));
+        } else if (arg.rfind("--roundtrips=", 0) == 0) {
+            g_options.roundtrips = std::max<size_t>(10, std::stoul(arg.substr(13)));
+        } else if (arg.rfind("--json=", 0) == 0) {
+            g_options.json_file = arg.substr(7);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--quick] [--max-threads=N] [--ops=N] [--roundtrips=N]"
+                         " [--json=<file>]\n";
+            return 2;
+        }
+    }
+
+    std::vector<CpuLocation> cpus = read_cpu_topology();
+
+    std::cout << "\n##############################################################\n";
+    std::cout << "#                 QUEUE BENCHMARK MATRIX                     #\n";
+    std::cout << "##############################################################\n";
+    std::cout << "  CPUs available: " << cpus.size() << "\n";
+    for (const auto& cpu : cpus) {
+        std::cout << "    cpu " << cpu.cpu << ": socket " << cpu.socket << ", core "
+                  << cpu.core << "\n";
+    }
+    if (cpus.size() < 2) {
+        std::cout << "  WARNING: fewer than 2 CPUs; every run is time-sliced\n";
+    }
+
+    run_ping_pong_matrix(cpus);
+    run_throughput_matrix(cpus);
+
+    std::cout << "\n  Pick per hop: 1:1 -> lowest p99 at your payload and placement;"
+                 " fan-out -> spmc; fan-in -> mpsc.\n";
+
+    if (!g_options.json_file.empty()) {
+        try {
+            g_report.save(g_options.json_file);
+            std::cout << "\nResults written to " << g_options.json_file << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -6,18 +6,43 @@
  * performance targets:
  *
  * - CSV parsing with timestamp conversion: >100K rows/sec
- * - Order book updates: <1us per event
+ * - Order book updates: <1us per event (realistic add/cancel/amend mix)
  * - Analytics calculation: <500ns per metric update
  * - Lock-free queue handoff: <100ns median latency
  * - End-to-end latency: <10us from market data to analytics result
  * - Feed handler throughput: >100K msgs/sec (text and binary protocols)
  * - Multi-feed aggregator: >100K msgs/sec
+ * - Pre-trade risk check: <50ns per order
+ *
+ * Where the PMU is reachable, the book, queue and parser tests also print
+ * IPC and cache/branch/dTLB misses per operation (hardware_counters.hpp).
+ * Counted regions include the per-operation clock reads.
+ *
+ * The tests above are closed-loop. Run with --open-loop to instead sweep
+ * target rates and report latency-vs-throughput curves measured from
+ * intended send time (see open_loop_harness.hpp):
+ *
+ *   --open-loop [--arrival=fixed|poisson] [--rates=100000,500000,...]
+ *               [--ops=<messages per point>]
+ *
+ * Results can also be written as JSON for regression tracking; compare
+ * two files with build/compare_benchmarks:
+ *
+ *   --json=<file> [--repeat=<runs>]
+ *
+ * --trace=<file> records per-thread spans (aggregator, book, fill router)
+ * and writes a Chrome trace viewable in ui.perfetto.dev. Tracing adds
+ * tens of nanoseconds per span, so do not combine it with --json runs.
  */
 
+#include "benchmark_report.hpp"
 #include "memory_pool.hpp"
+#include "open_loop_harness.hpp"
 #include "microstructure_order_book.hpp"
+#include "order_flow_workload.hpp"
 #include "performance_monitor.hpp"
 #include "rolling_statistics.hpp"
+#include "trace_recorder.hpp"
 
 // Include SPSC queue (local copy)
 #include "spsc_queue.hpp"
@@ -66,6 +91,64 @@ static constexpr double TARGET_FEED_HANDLER_THROUGHPUT = 100000; // >100K msgs/s
 int tests_passed = 0;
 int tests_failed = 0;
 
+// Order flow shared by all book benchmarks: generated, or replayed with --replay=<events.csv>
+static std::vector<WorkloadOp> g_book_workload;
+static std::string g_workload_name = "generated";
+
+// Structured results of every run (written with --json=<file>)
+static BenchmarkReport g_report;
+
+/**
+ * @brief Open-loop sweep options (--open-loop mode)
+ */
+struct OpenLoopOptions {
+    bool enabled = false;
+    ArrivalProcess arrival = ArrivalProcess::FIXED_INTERVAL;
+    std::vector<double> rates = {100000, 250000, 500000, 1000000, 2000000};
+    size_t num_ops = 50000;
+};
+static OpenLoopOptions g_open_loop;
+
+/**
+ * @brief Builds the shared book workload
+ * @param replay_file OrderEvent CSV to replay, or empty to generate
+ * @param count Messages to generate (warmup + test)
+ */
+void build_book_workload(const std::string& replay_file, size_t count) {
+    if (!replay_file.empty()) {
+        g_book_workload = OrderFlowWorkload::load(replay_file);
+        g_workload_name = replay_file;
+        std::cout << "Replaying " << g_book_workload.size() << " messages from "
+                  << replay_file << "\n";
+    } else {
+        OrderFlowWorkload workload;
+        g_book_workload = workload.generate(count);
+    }
+    OrderFlowWorkload::mix(g_book_workload).print();
+}
+
+/**
+ * @brief Silences std::cout for its lifetime
+ *
+ * The book logs cancels, amends, stops and fills to std::cout; a failed
+ * stream skips formatting, so the timed loops measure the book, not the
+ * terminal.
+ */
+class ScopedQuietCout {
+public:
+    ScopedQuietCout() { std::cout.setstate(std::ios::failbit); }
+    ~ScopedQuietCout() { std::cout.clear(); }
+};
+
+/**
+ * @brief Prints per-op hardware counters, if the PMU is reachable
+ */
+void print_hardware_counters(const PerformanceMonitor& monitor) {
+    if (monitor.hardware_counters_available()) {
+        monitor.print_hardware_counters();
+    }
+}
+
 #define TEST_ASSERT(condition, message) \
     do { \
         if (condition) { \
@@ -80,7 +163,8 @@ int tests_failed = 0;
 /**
  * @brief Test 1: Order Book Update Latency
  *
- * Measures the time to insert orders into the order book.
+ * Measures the time to apply each message of the shared order-flow
+ * workload (adds, cancels, amends, markets, icebergs, stops).
  * Target: <1us p50, <2us p99
  */
 void test_order_book_latency() {
@@ -90,39 +174,39 @@ void test_order_book_latency() {
     MicrostructureOrderBook book("AAPL");
     book.enable_self_trade_prevention(false);  // Disable for benchmark
     PerformanceMonitor monitor("order_book");
+    monitor.enable_hardware_counters();
 
-    std::mt19937 rng(42);
-    std::uniform_real_distribution<double> price_dist(99.0, 101.0);
-    std::uniform_int_distribution<int> qty_dist(100, 1000);
+    {
+        ScopedQuietCout quiet;
 
-    // Warmup
-    for (int i = 0; i < NUM_WARMUP_ITERATIONS; ++i) {
-        int account_id = (i % 100) + 1;  // Use different accounts
-        Order order(i + 1, account_id, Side::BUY, 100.0, 100, TimeInForce::GTC);
-        book.add_order(order);
-    }
-    monitor.reset();
+        // Warmup builds resting depth
+        size_t warmup = std::min<size_t>(NUM_WARMUP_ITERATIONS, g_book_workload.size());
+        for (size_t i = 0; i < warmup; ++i) {
+            OrderFlowWorkload::apply(book, g_book_workload[i]);
+        }
+        monitor.reset();
 
-    // Benchmark
-    for (int i = 0; i < NUM_TEST_ITERATIONS; ++i) {
-        auto start = std::chrono::steady_clock::now();
+        // Benchmark
+        CountedRegion counted(monitor, g_book_workload.size() - warmup);
+        for (size_t i = warmup; i < g_book_workload.size(); ++i) {
+            auto start = std::chrono::steady_clock::now();
 
-        double price = price_dist(rng);
-        int qty = qty_dist(rng);
-        Side side = (i % 2 == 0) ? Side::BUY : Side::SELL;
-        int account_id = (i % 100) + 1;  // Use different accounts to avoid self-trade
-        Order order(NUM_WARMUP_ITERATIONS + i + 1, account_id, side, price, qty, TimeInForce::GTC);
-        book.add_order(order);
+            OrderFlowWorkload::apply(book, g_book_workload[i]);
 
-        auto end = std::chrono::steady_clock::now();
-        auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
-        monitor.record_event_latency(latency);
+            auto end = std::chrono::steady_clock::now();
+            auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+            monitor.record_event_latency(latency);
+        }
     }
 
     std::cout << "  Results:\n";
     std::cout << "    p50: " << monitor.get_p50_ns() << " ns\n";
     std::cout << "    p99: " << monitor.get_p99_ns() << " ns\n";
     std::cout << "    Throughput: " << static_cast<int>(monitor.throughput()) << " ops/sec\n";
+    print_hardware_counters(monitor);
+    g_report.record_monitor("order_book_update", monitor,
+                            {{"workload", g_workload_name},
+                             {"messages", std::to_string(g_book_workload.size())}});
 
     TEST_ASSERT(monitor.get_p50_ns() <= TARGET_ORDER_BOOK_P50_NS,
                 "Order book p50 latency < 1us");
@@ -176,6 +260,7 @@ void test_analytics_latency() {
     std::cout << "  Results:\n";
     std::cout << "    p50: " << monitor.get_p50_ns() << " ns\n";
     std::cout << "    p99: " << monitor.get_p99_ns() << " ns\n";
+    g_report.record_monitor("analytics_compute", monitor);
 
     TEST_ASSERT(monitor.get_p50_ns() <= TARGET_ANALYTICS_P50_NS,
                 "Analytics p50 latency < 500ns");
@@ -195,6 +280,7 @@ void test_queue_latency() {
 
     SPSCQueue<int> queue(4096);
     PerformanceMonitor monitor("queue");
+    monitor.enable_hardware_counters();
 
     // Warmup
     for (int i = 0; i < NUM_WARMUP_ITERATIONS; ++i) {
@@ -205,6 +291,7 @@ void test_queue_latency() {
     monitor.reset();
 
     // Benchmark
+    monitor.begin_counted_region();
     for (int i = 0; i < NUM_QUEUE_ITERATIONS; ++i) {
         auto start = std::chrono::steady_clock::now();
 
@@ -216,11 +303,14 @@ void test_queue_latency() {
         auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
         monitor.record_event_latency(latency);
     }
+    monitor.end_counted_region(NUM_QUEUE_ITERATIONS);
 
     std::cout << "  Results:\n";
     std::cout << "    p50: " << monitor.get_p50_ns() << " ns\n";
     std::cout << "    p99: " << monitor.get_p99_ns() << " ns\n";
     std::cout << "    Throughput: " << static_cast<int>(monitor.throughput()) << " ops/sec\n";
+    print_hardware_counters(monitor);
+    g_report.record_monitor("spsc_queue_handoff", monitor, {{"capacity", "4096"}});
 
     TEST_ASSERT(monitor.get_p50_ns() <= TARGET_QUEUE_P50_NS,
                 "Queue p50 latency < 100ns");
@@ -284,6 +374,10 @@ void test_memory_pool() {
     std::cout << "    Arena: " << arena_ns_per_alloc << " ns/alloc\n";
     std::cout << "    Malloc: " << malloc_ns_per_alloc << " ns/alloc\n";
     std::cout << "    Speedup: " << (malloc_ns_per_alloc / arena_ns_per_alloc) << "x\n";
+    g_report.record("memory_pool", "arena_alloc_ns", arena_ns_per_alloc,
+                    {{"size", std::to_string(ALLOC_SIZE)}});
+    g_report.record("memory_pool", "malloc_alloc_ns", malloc_ns_per_alloc);
+    g_report.record("memory_pool", "speedup", malloc_ns_per_alloc / arena_ns_per_alloc);
 
     // Arena should be faster than malloc
     TEST_ASSERT(arena_ns_per_alloc < malloc_ns_per_alloc,
@@ -306,46 +400,39 @@ void test_end_to_end_latency() {
     book.enable_self_trade_prevention(false);  // Disable for benchmark
     PerformanceMonitor monitor("e2e");
 
-    std::mt19937 rng(42);
-    std::uniform_real_distribution<double> price_dist(99.0, 101.0);
-    std::uniform_int_distribution<int> qty_dist(100, 1000);
-
-    // Warmup
-    for (int i = 0; i < NUM_WARMUP_ITERATIONS; ++i) {
-        int account_id = (i % 100) + 1;
-        Order order(i + 1, account_id, Side::BUY, 100.0, 100, TimeInForce::GTC);
-        book.add_order(order);
-        [[maybe_unused]] auto imbalance = book.get_current_imbalance();
-    }
-    monitor.reset();
+    {
+        ScopedQuietCout quiet;
 
-    // Benchmark complete pipeline
-    for (int i = 0; i < NUM_TEST_ITERATIONS; ++i) {
-        auto start = std::chrono::steady_clock::now();
+        // Warmup
+        size_t warmup = std::min<size_t>(NUM_WARMUP_ITERATIONS, g_book_workload.size());
+        for (size_t i = 0; i < warmup; ++i) {
+            OrderFlowWorkload::apply(book, g_book_workload[i]);
+            [[maybe_unused]] auto imbalance = book.get_current_imbalance();
+        }
+        monitor.reset();
 
-        // 1. Create order
-        double price = price_dist(rng);
-        int qty = qty_dist(rng);
-        Side side = (i % 2 == 0) ? Side::BUY : Side::SELL;
-        int account_id = (i % 100) + 1;
-        Order order(NUM_WARMUP_ITERATIONS + i + 1, account_id, side, price, qty, TimeInForce::GTC);
+        // Benchmark complete pipeline
+        for (size_t i = warmup; i < g_book_workload.size(); ++i) {
+            auto start = std::chrono::steady_clock::now();
 
-        // 2. Insert into order book
-        book.add_order(order);
+            // 1-2. Build the order and apply it to the book
+            OrderFlowWorkload::apply(book, g_book_workload[i]);
 
-        // 3. Read analytics
-        [[maybe_unused]] double imbalance = book.get_current_imbalance();
-        [[maybe_unused]] double spread = book.get_average_spread();
+            // 3. Read analytics
+            [[maybe_unused]] double imbalance = book.get_current_imbalance();
+            [[maybe_unused]] double spread = book.get_average_spread();
 
-        auto end = std::chrono::steady_clock::now();
-        auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
-        monitor.record_event_latency(latency);
+            auto end = std::chrono::steady_clock::now();
+            auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+            monitor.record_event_latency(latency);
+        }
     }
 
     std::cout << "  Results:\n";
     std::cout << "    p50: " << monitor.get_p50_ns() << " ns\n";
     std::cout << "    p99: " << monitor.get_p99_ns() << " ns\n";
     std::cout << "    Throughput: " << static_cast<int>(monitor.throughput()) << " ops/sec\n";
+    g_report.record_monitor("end_to_end", monitor, {{"workload", g_workload_name}});
 
     TEST_ASSERT(monitor.get_p50_ns() <= TARGET_E2E_P50_NS,
                 "End-to-end p50 latency < 10us");
@@ -389,6 +476,7 @@ void test_rolling_statistics_performance() {
     std::cout << "  Results:\n";
     std::cout << "    p50: " << monitor.get_p50_ns() << " ns\n";
     std::cout << "    p99: " << monitor.get_p99_ns() << " ns\n";
+    g_report.record_monitor("rolling_statistics", monitor, {{"window", "1000"}});
 
     // Rolling statistics should be very fast (<500ns)
     TEST_ASSERT(monitor.get_p50_ns() <= 500,
@@ -419,6 +507,7 @@ void test_monitor_overhead() {
 
     std::cout << "  Results:\n";
     std::cout << "    Recording overhead: " << ns_per_record << " ns/record\n";
+    g_report.record("monitor_overhead", "record_ns", ns_per_record);
 
     // Recording should add < 50ns overhead
     TEST_ASSERT(ns_per_record < 50.0,
@@ -455,10 +544,13 @@ void test_csv_parsing_throughput() {
     BacktesterConfig config;
     config.input_filename = test_csv_file;
     MicrostructureBacktester backtester(config);
+    PerformanceMonitor counters("csv_parser");
+    counters.enable_hardware_counters();
 
     auto start = std::chrono::steady_clock::now();
 
     try {
+        CountedRegion counted(counters, NUM_CSV_ROWS);
         backtester.build_event_timeline(test_csv_file);
     } catch (const std::exception& e) {
         std::cerr << "Error building timeline: " << e.what() << std::endl;
@@ -476,6 +568,10 @@ void test_csv_parsing_throughput() {
     std::cout << "    Rows parsed: " << events_parsed << "\n";
     std::cout << "    Duration: " << (duration_us / 1000.0) << " ms\n";
     std::cout << "    Throughput: " << static_cast<int>(rows_per_sec) << " rows/sec\n";
+    print_hardware_counters(counters);
+    g_report.record("csv_parsing", "throughput", rows_per_sec,
+                    {{"rows", std::to_string(NUM_CSV_ROWS)}});
+    g_report.record_counters("csv_parsing", counters);
 
     TEST_ASSERT(events_parsed == NUM_CSV_ROWS,
                 "All CSV rows parsed successfully");
@@ -519,15 +615,19 @@ void test_feed_handler_throughput() {
         }
 
         // Benchmark text parsing
+        PerformanceMonitor counters("text_parser");
+        counters.enable_hardware_counters();
         int successful_parses = 0;
         auto start = std::chrono::steady_clock::now();
 
+        counters.begin_counted_region();
         for (const auto& msg : test_messages) {
             auto tick = parse_text_tick(msg);
             if (tick) {
                 successful_parses++;
             }
         }
+        counters.end_counted_region(NUM_MESSAGES);
 
         auto end = std::chrono::steady_clock::now();
         auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
@@ -537,6 +637,10 @@ void test_feed_handler_throughput() {
         std::cout << "    Parsed: " << successful_parses << "/" << NUM_MESSAGES << "\n";
         std::cout << "    Duration: " << (duration_us / 1000.0) << " ms\n";
         std::cout << "    Throughput: " << static_cast<int>(msgs_per_sec) << " msgs/sec\n";
+        print_hardware_counters(counters);
+        g_report.record("text_protocol_parsing", "throughput", msgs_per_sec,
+                        {{"messages", std::to_string(NUM_MESSAGES)}});
+        g_report.record_counters("text_protocol_parsing", counters);
 
         TEST_ASSERT(successful_parses == NUM_MESSAGES,
                     "Text protocol: All messages parsed");
@@ -565,9 +669,12 @@ void test_feed_handler_throughput() {
         }
 
         // Benchmark binary deserialization
+        PerformanceMonitor counters("binary_parser");
+        counters.enable_hardware_counters();
         int successful_parses = 0;
         auto start = std::chrono::steady_clock::now();
 
+        counters.begin_counted_region();
         for (const auto& msg : serialized_messages) {
             if (msg.size() >= MessageHeader::HEADER_SIZE + TickPayload::PAYLOAD_SIZE) {
                 auto header = deserialize_header(msg.data());
@@ -577,6 +684,7 @@ void test_feed_handler_throughput() {
                 }
             }
         }
+        counters.end_counted_region(NUM_MESSAGES);
 
         auto end = std::chrono::steady_clock::now();
         auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
@@ -586,6 +694,10 @@ void test_feed_handler_throughput() {
         std::cout << "    Parsed: " << successful_parses << "/" << NUM_MESSAGES << "\n";
         std::cout << "    Duration: " << (duration_us / 1000.0) << " ms\n";
         std::cout << "    Throughput: " << static_cast<int>(msgs_per_sec) << " msgs/sec\n";
+        print_hardware_counters(counters);
+        g_report.record("binary_protocol_parsing", "throughput", msgs_per_sec,
+                        {{"messages", std::to_string(NUM_MESSAGES)}});
+        g_report.record_counters("binary_protocol_parsing", counters);
 
         TEST_ASSERT(successful_parses == NUM_MESSAGES,
                     "Binary protocol: All messages parsed");
@@ -645,6 +757,8 @@ void test_feed_handler_throughput() {
         std::cout << "    Processed: " << messages_received.load() << "/" << NUM_MESSAGES << "\n";
         std::cout << "    Duration: " << (duration_us / 1000.0) << " ms\n";
         std::cout << "    Throughput: " << static_cast<int>(msgs_per_sec) << " msgs/sec\n";
+        g_report.record("feed_aggregator", "throughput", msgs_per_sec,
+                        {{"messages", std::to_string(NUM_MESSAGES)}});
 
         TEST_ASSERT(messages_received.load() == NUM_MESSAGES,
                     "Aggregator: All messages processed");
@@ -653,6 +767,318 @@ void test_feed_handler_throughput() {
     }
 }
 
+// ============================================================================
+// OPEN-LOOP MODE
+// ============================================================================
+
+/**
+ * @brief Open-loop point: apply one workload message to a book
+ */
+OpenLoopResult open_loop_book_point(const OpenLoopConfig& config) {
+    MicrostructureOrderBook book("AAPL");
+    book.enable_self_trade_prevention(false);
+    ScopedQuietCout quiet;
+
+    OpenLoopHarness harness(config);
+    return harness.run([&](size_t i) {
+        OrderFlowWorkload::apply(book, g_book_workload[i]);
+    });
+}
+
+/**
+ * @brief Open-loop point: one SPSC queue hop to a consumer thread
+ *
+ * The message is its intended send time; the consumer records the
+ * latency on pop.
+ */
+OpenLoopResult open_loop_queue_point(const OpenLoopConfig& config) {
+    SPSCQueue<uint64_t> queue(65536);
+    LatencySamples responses;
+    responses.reserve(config.warmup_ops + config.num_ops);
+    std::atomic<size_t> completed{0};
+    std::atomic<bool> stop{false};
+
+    std::thread consumer([&]() {
+        QueueWaiter waiter(WaitStrategy::SPIN_YIELD);
+        while (!stop.load(std::memory_order_acquire)) {
+            auto sent = queue.pop();
+            if (!sent) {
+                waiter.idle([&]() { return !queue.empty(); });
+                continue;
+            }
+            waiter.on_work();
+            responses.record(OpenLoopHarness::now_ns() - *sent);
+            completed.fetch_add(1, std::memory_order_release);
+        }
+    });
+
+    OpenLoopHarness harness(config);
+    return harness.run_async(
+        [&](size_t, uint64_t intended) {
+            while (!queue.push(intended)) {
+                cpu_relax();
+            }
+        },
+        responses,
+        [&]() { return completed.load(std::memory_order_acquire); },
+        [&]() {
+            stop.store(true, std::memory_order_release);
+            consumer.join();
+        });
+}
+
+/**
+ * @brief Open-loop point: feed tick -> aggregator queue -> book -> analytics
+ *
+ * Mirrors the platform's tick path. The tick carries its intended send
+ * time in recv_timestamp_ns and its workload index in timestamp.
+ */
+OpenLoopResult open_loop_e2e_point(const OpenLoopConfig& config) {
+    MicrostructureOrderBook book("AAPL");
+    book.enable_self_trade_prevention(false);
+    LatencySamples responses;
+    responses.reserve(config.warmup_ops + config.num_ops);
+    std::atomic<size_t> completed{0};
+    ScopedQuietCout quiet;
+
+    MultiFeedAggregator aggregator;
+    aggregator.add_feed("TestFeed", "localhost", 9999, FeedProtocol::TEXT);
+    aggregator.set_tick_callback([&](const AggregatedTick& tick) {
+        OrderFlowWorkload::apply(book, g_book_workload[tick.tick.timestamp]);
+        [[maybe_unused]] double imbalance = book.get_current_imbalance();
+        [[maybe_unused]] double spread = book.get_average_spread();
+        responses.record(OpenLoopHarness::now_ns() - tick.tick.recv_timestamp_ns);
+        completed.fetch_add(1, std::memory_order_release);
+    });
+    aggregator.start_all();
+
+    OpenLoopHarness harness(config);
+    return harness.run_async(
+        [&](size_t i, uint64_t intended) {
+            FeedTick tick(i, "AAPL", 100.0, 100, intended);
+            aggregator.inject_tick(tick, 0);
+        },
+        responses,
+        [&]() { return completed.load(std::memory_order_acquire); },
+        [&]() { aggregator.stop(); });
+}
+
+/**
+ * @brief Adds one open-loop point to the JSON report
+ */
+void record_open_loop(const std::string& name, const OpenLoopResult& result,
+                      ArrivalProcess arrival) {
+    std::string point = name + "@" + std::to_string(static_cast<long long>(result.target_rate));
+    g_report.record(point, "p50_ns", static_cast<double>(result.p50_ns),
+                    {{"rate", std::to_string(static_cast<long long>(result.target_rate))},
+                     {"arrival", arrival_process_name(arrival)}});
+    g_report.record(point, "p99_ns", static_cast<double>(result.p99_ns));
+    g_report.record(point, "p999_ns", static_cast<double>(result.p999_ns));
+    g_report.record(point, "mean_ns", result.mean_ns);
+    g_report.record(point, "throughput", result.achieved_rate);
+    if (result.service_p99_ns > 0) {
+        g_report.record(point, "service_p99_ns", static_cast<double>(result.service_p99_ns));
+    }
+}
+
+/**
+ * @brief Sweeps target rates for the book, queue hop and end-to-end path
+ */
+void run_open_loop_sweeps() {
+    OpenLoopConfig base;
+    base.arrival = g_open_loop.arrival;
+    base.warmup_ops = std::min<size_t>(NUM_WARMUP_ITERATIONS, g_book_workload.size());
+    base.num_ops = std::min(g_open_loop.num_ops, g_book_workload.size() - base.warmup_ops);
+
+    std::cout << "\n=== Open-Loop Latency vs Throughput ===\n";
+    std::cout << "Latency measured from intended send time (" << arrival_process_name(base.arrival)
+              << " arrivals, " << base.num_ops << " msgs per point)\n";
+
+    auto book = OpenLoopHarness::sweep(g_open_loop.rates, base, open_loop_book_point);
+    OpenLoopHarness::print_curve("Order book (one workload message)", book);
+
+    auto queue = OpenLoopHarness::sweep(g_open_loop.rates, base, open_loop_queue_point);
+    OpenLoopHarness::print_curve("SPSC queue hop", queue, false);
+
+    auto e2e = OpenLoopHarness::sweep(g_open_loop.rates, base, open_loop_e2e_point);
+    OpenLoopHarness::print_curve("End-to-end (feed -> aggregator -> book -> analytics)", e2e, false);
+
+    for (size_t i = 0; i < g_open_loop.rates.size(); ++i) {
+        record_open_loop("open_loop_book", book[i], base.arrival);
+        record_open_loop("open_loop_queue", queue[i], base.arrival);
+        record_open_loop("open_loop_e2e", e2e[i], base.arrival);
+    }
+}
+
+/**
+ * @brief Test 10: Open-Loop Order Book Latency
+ *
+ * Drives the book at a fixed rate well below capacity and checks the
+ * harness invariants: every scheduled message completes, the rate is
+ * sustained, and latency from intended send time is never below the
+ * closed-loop service time.
+ */
+void test_open_loop_order_book() {
+    std::cout << "\n=== Test 10: Open-Loop Order Book Latency ===\n";
+
+    OpenLoopConfig config;
+    config.rate_per_sec = 100000;
+    config.warmup_ops = std::min<size_t>(NUM_WARMUP_ITERATIONS, g_book_workload.size());
+    config.num_ops = std::min<size_t>(20000, g_book_workload.size() - config.warmup_ops);
+
+    OpenLoopResult result = open_loop_book_point(config);
+
+    std::cout << "  Results @ " << static_cast<int>(config.rate_per_sec) << " msgs/sec:\n";
+    std::cout << "    Achieved: " << static_cast<int>(result.achieved_rate) << " msgs/sec\n";
+    std::cout << "    p50: " << result.p50_ns << " ns (service " << result.service_p50_ns << " ns)\n";
+    std::cout << "    p99: " << result.p99_ns << " ns (service " << result.service_p99_ns << " ns)\n";
+    record_open_loop("open_loop_book", result, config.arrival);
+
+    TEST_ASSERT(result.completed == config.num_ops,
+                "Open-loop: all scheduled messages completed");
+    TEST_ASSERT(!result.saturated(),
+                "Open-loop: 100K msgs/sec sustained");
+    TEST_ASSERT(result.p50_ns >= result.service_p50_ns && result.p99_ns >= result.service_p99_ns,
+                "Open-loop: response latency includes service time");
+}
+
+/**
+ * @brief Test 11: Per-Hop Latency Breakdown
+ *
+ * Sends text messages through parse -> aggregator queue -> book -> fill
+ * router -> analytics, stamping each tick's checkpoints, and reports the
+ * latency of every hop so tail latency can be attributed to a stage.
+ * Buys and sells alternate across the spread, so most orders trade.
+ */
+void test_pipeline_hop_latency() {
+    std::cout << "\n=== Test 11: Per-Hop Latency Breakdown ===\n";
+
+    const int NUM_MESSAGES = 20000;
+    std::vector<std::string> messages;
+    messages.reserve(NUM_MESSAGES);
+    for (int i = 0; i < NUM_MESSAGES; ++i) {
+        std::ostringstream oss;
+        oss << (1234567890000ULL + i) << " AAPL " << (i % 2 == 0 ? "100.02" : "99.98") << " "
+            << (i % 2 == 0 ? 100 : 101);
+        messages.push_back(oss.str());
+    }
+
+    MicrostructureOrderBook book("AAPL");
+    book.enable_self_trade_prevention(false);
+    ComponentLatencyTracker tracker;
+    std::atomic<int> processed{0};
+    int next_order_id = 1;
+
+    MultiFeedAggregator aggregator;
+    aggregator.add_feed("TestFeed", "localhost", 9999, FeedProtocol::TEXT);
+    aggregator.set_tick_callback([&](const AggregatedTick& tick) {
+        Side side = (tick.tick.volume % 2 == 0) ? Side::BUY : Side::SELL;
+        Order order(next_order_id++, 1, side, tick.tick.price,
+                    static_cast<int>(tick.tick.volume), TimeInForce::GTC);
+        LatencyCheckpoints checkpoints = tick.tick.checkpoints;
+        book.add_order(order, checkpoints);
+        tracker.record_checkpoints(checkpoints);
+        processed.fetch_add(1, std::memory_order_release);
+    });
+
+    {
+        ScopedQuietCout quiet;
+        aggregator.start_all();
+
+        for (const auto& msg : messages) {
+            uint64_t received = checkpoint_now_ns();
+            auto text_tick = parse_text_tick(msg);
+            if (!text_tick) {
+                continue;
+            }
+            FeedTick tick(*text_tick, received); // Stamps received and parsed
+            aggregator.inject_tick(tick, 0);
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (processed.load(std::memory_order_acquire) < NUM_MESSAGES &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        aggregator.stop();
+    }
+
+    tracker.print_hop_breakdown();
+    for (size_t i = 0; i < NUM_LATENCY_CHECKPOINTS; ++i) {
+        const PerformanceMonitor& hop = tracker.hop(static_cast<LatencyCheckpoint>(i));
+        if (hop.events_processed() > 0) {
+            std::string name = "pipeline_hop_" + hop.get_name();
+            g_report.record(name, "p50_ns", static_cast<double>(hop.get_p50_ns()));
+            g_report.record(name, "p99_ns", static_cast<double>(hop.get_p99_ns()));
+        }
+    }
+    g_report.record_monitor("pipeline_end_to_end", tracker.end_to_end());
+
+    TEST_ASSERT(processed.load() == NUM_MESSAGES, "Hop breakdown: all messages processed");
+    TEST_ASSERT(tracker.hop(CP_DEQUEUED).events_processed() == static_cast<uint64_t>(NUM_MESSAGES) &&
+                    tracker.hop(CP_ANALYTICS_DONE).events_processed() ==
+                        static_cast<uint64_t>(NUM_MESSAGES),
+                "Hop breakdown: every stage stamped");
+    TEST_ASSERT(tracker.hop(CP_FILL_ROUTED).events_processed() > 0,
+                "Hop breakdown: fill routing stamped on trades");
+}
+
+/**
+ * @brief Test 12: Pre-Trade Risk Check Cost
+ *
+ * Every limit enabled, orders spread over many accounts. Amortized over a
+ * tight loop like the monitor overhead test (a per-check clock read would
+ * cost more than the check).
+ */
+void test_pre_trade_risk_check() {
+    std::cout << "\n=== Test 12: Pre-Trade Risk Check Cost ===\n";
+
+    const int NUM_CHECKS = 1000000;
+    const int NUM_ACCOUNTS = 256;
+
+    RiskLimits limits;
+    limits.max_order_quantity = 10000;
+    limits.max_order_notional = 1e7;
+    limits.price_collar = 0.10;
+    limits.max_open_orders = 1000000;
+    limits.max_orders_per_second = 1e6;
+    limits.burst = 1e6;
+    limits.max_position = 1000000;
+    PreTradeRiskGate gate(limits, NUM_ACCOUNTS);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> price_dist(95.0, 105.0);
+    std::uniform_int_distribution<int> qty_dist(1, 500);
+    std::vector<Order> orders;
+    orders.reserve(4096);
+    for (int i = 0; i < 4096; ++i) {
+        orders.emplace_back(i + 1, i % NUM_ACCOUNTS, i % 2 == 0 ? Side::BUY : Side::SELL,
+                            price_dist(rng), qty_dist(rng));
+    }
+
+    uint64_t accepted = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_CHECKS; ++i) {
+        const Order& order = orders[i & 4095];
+        if (gate.check(order, 100.0) == RiskReject::NONE) {
+            gate.on_order_closed(order.account_id);
+            ++accepted;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns_per_check =
+        std::chrono::duration<double, std::nano>(end - start).count() / NUM_CHECKS;
+
+    std::cout << "  Results:\n";
+    std::cout << "    Check cost: " << ns_per_check << " ns/order\n";
+    std::cout << "    Accepted: " << accepted << ", rejected: " << gate.total_rejects() << "\n";
+    g_report.record("pre_trade_risk_check", "check_ns", ns_per_check);
+
+    TEST_ASSERT(accepted + gate.total_rejects() == static_cast<uint64_t>(NUM_CHECKS),
+                "Risk gate: every order accepted or rejected");
+    TEST_ASSERT(ns_per_check < 50.0, "Pre-trade risk check < 50ns");
+}
+
 void print_summary() {
     std::cout << "\n";
     std::cout << "========================================\n";
@@ -673,7 +1099,39 @@ void print_summary() {
     std::cout << "========================================\n";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    std::string replay_file;
+    std::string json_file;
+    std::string trace_file;
+    int repeat = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--replay=", 0) == 0) {
+            replay_file = arg.substr(9);
+        } else if (arg == "--open-loop") {
+            g_open_loop.enabled = true;
+        } else if (arg == "--arrival=poisson") {
+            g_open_loop.arrival = ArrivalProcess::POISSON;
+        } else if (arg == "--arrival=fixed") {
+            g_open_loop.arrival = ArrivalProcess::FIXED_INTERVAL;
+        } else if (arg.rfind("--rates=", 0) == 0) {
+            g_open_loop.rates.clear();
+            std::stringstream rates(arg.substr(8));
+            std::string rate;
+            while (std::getline(rates, rate, ',')) {
+                g_open_loop.rates.push_back(std::stod(rate));
+            }
+        } else if (arg.rfind("--ops=", 0) == 0) {
+            g_open_loop.num_ops = std::stoul(arg.substr(6));
+        } else if (arg.rfind("--json=", 0) == 0) {
+            json_file = arg.substr(7);
+        } else if (arg.rfind("--repeat=", 0) == 0) {
+            repeat = std::max(1, std::stoi(arg.substr(9)));
+        } else if (arg.rfind("--trace=", 0) == 0) {
+            trace_file = arg.substr(8);
+        }
+    }
+
     std::cout << "\n";
     std::cout << "##############################################################\n";
     std::cout << "#                                                            #\n";
@@ -681,15 +1139,75 @@ int main() {
     std::cout << "#                                                            #\n";
     std::cout << "##############################################################\n";
 
-    test_order_book_latency();
-    test_analytics_latency();
-    test_queue_latency();
-    test_memory_pool();
-    test_end_to_end_latency();
-    test_rolling_statistics_performance();
-    test_monitor_overhead();
-    test_csv_parsing_throughput();
-    test_feed_handler_throughput();
+    HardwareCounters probe;
+    if (probe.available()) {
+        std::cout << "  Hardware counters: available\n";
+    } else {
+        std::cout << "  Hardware counters: unavailable (" << probe.unavailable_reason() << ")\n";
+    }
+    if (!trace_file.empty()) {
+        set_current_thread_name("bench-main");
+        TraceRecorder::instance().enable();
+        std::cout << "  Tracing: enabled (" << trace_file << ")\n";
+    }
+
+    if (g_open_loop.enabled) {
+        build_book_workload(replay_file, NUM_WARMUP_ITERATIONS + g_open_loop.num_ops);
+    } else {
+        build_book_workload(replay_file, NUM_WARMUP_ITERATIONS + NUM_TEST_ITERATIONS);
+    }
+
+    for (int run = 1; run <= repeat; ++run) {
+        if (repeat > 1) {
+            std::cout << "\n---------------- Run " << run << "/" << repeat << " ----------------\n";
+        }
+
+        if (g_open_loop.enabled) {
+            run_open_loop_sweeps();
+            continue;
+        }
+
+        test_order_book_latency();
+        test_analytics_latency();
+        test_queue_latency();
+        test_memory_pool();
+        test_end_to_end_latency();
+        test_rolling_statistics_performance();
+        test_monitor_overhead();
+        test_csv_parsing_throughput();
+        test_feed_handler_throughput();
+        test_open_loop_order_book();
+        test_pipeline_hop_latency();
+        test_pre_trade_risk_check();
+    }
+
+    if (!json_file.empty()) {
+        g_report.set_repetitions(repeat);
+        try {
+            g_report.save(json_file);
+            std::cout << "\nResults written to " << json_file << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    if (!trace_file.empty()) {
+        TraceRecorder::instance().disable();
+        try {
+            size_t spans = TraceRecorder::instance().export_chrome_json(trace_file);
+            std::cout << "\nTrace (" << spans << " spans, "
+                      << TraceRecorder::instance().thread_count() << " threads) written to "
+                      << trace_file << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    if (g_open_loop.enabled) {
+        return 0;
+    }
 
     print_summary();
 
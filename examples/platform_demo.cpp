@@ -32,6 +32,9 @@
  * Options:
  *   --historical-only    Run only historical analysis
  *   --realtime           Start real-time mode (requires feeds)
+ *   --record=FILE        Capture the real-time session to FILE
+ *   --replay=FILE        Replay a capture instead of connecting to feeds
+ *   --speed=X            Replay pacing: 1 = recorded, N = Nx, 0 = flat out
  *   --benchmark          Run performance benchmarks
  *   --verbose            Enable verbose output
  *   --help               Show this help
@@ -50,6 +53,9 @@ void print_usage(const char* program) {
     std::cout << "Options:\n";
     std::cout << "  --historical-only    Run only historical analysis (default)\n";
     std::cout << "  --realtime           Start real-time mode (requires mock server)\n";
+    std::cout << "  --record=FILE        Capture the real-time session to FILE\n";
+    std::cout << "  --replay=FILE        Replay a capture instead of connecting to feeds\n";
+    std::cout << "  --speed=X            Replay pacing: 1 = recorded (default), N = Nx, 0 = flat out\n";
     std::cout << "  --benchmark          Run performance benchmarks\n";
     std::cout << "  --verbose            Enable verbose output\n";
     std::cout << "  --help               Show this help\n\n";
@@ -58,6 +64,8 @@ void print_usage(const char* program) {
     std::cout << "  " << program << " --verbose data/calibration_test.csv\n";
     std::cout << "  " << program << " --benchmark  (run performance benchmarks)\n";
     std::cout << "  " << program << " --realtime  (connects to localhost:9000)\n";
+    std::cout << "  " << program << " --realtime --record=session.cap\n";
+    std::cout << "  " << program << " --replay=session.cap --speed=0\n";
 }
 
 void demo_historical_analysis(MicrostructureAnalyticsPlatform& platform,
@@ -120,7 +128,8 @@ void demo_analytics_engine(MicrostructureAnalyticsPlatform& platform) {
     order_book.print_analytics_summary();
     analytics.print_summary();
 
-    // Print snapshot
+    // Publish and print snapshot
+    platform.publish_snapshot();
     platform.print_analytics_snapshot();
 }
 
@@ -156,6 +165,40 @@ void demo_realtime_mode(MicrostructureAnalyticsPlatform& platform) {
     }
 }
 
+void demo_replay_mode(MicrostructureAnalyticsPlatform& platform,
+                      const std::string& capture_file, double speed) {
+    std::cout << "\n";
+    std::cout << "============================================================\n";
+    std::cout << "           DEMO 4: CAPTURE REPLAY                           \n";
+    std::cout << "============================================================\n";
+
+    ReplayOptions options;
+    options.speed = speed;
+    std::cout << "\nReplaying " << capture_file << " at ";
+    if (speed > 0.0) {
+        std::cout << speed << "x";
+    } else {
+        std::cout << "full speed";
+    }
+    std::cout << "...\n";
+
+    ReplayStats stats = platform.replay_capture(capture_file, options);
+    platform.wait();
+
+    std::cout << "  Ticks replayed: " << stats.ticks_replayed << "\n";
+    if (stats.ticks_skipped > 0) {
+        std::cout << "  Ticks skipped:  " << stats.ticks_skipped << "\n";
+    }
+    std::cout << "  Capture span:   " << format_duration_ns(stats.capture_span_ns) << "\n";
+    std::cout << "  Replay time:    " << format_duration_ns(stats.replay_duration_ns) << "\n";
+    if (speed > 0.0) {
+        std::cout << "  Lateness:       mean " << std::fixed << std::setprecision(0)
+                  << stats.mean_lateness_ns << " ns, max " << stats.max_lateness_ns
+                  << " ns\n";
+    }
+    platform.print_analytics_snapshot();
+}
+
 void demo_performance_report(MicrostructureAnalyticsPlatform& platform) {
     std::cout << "\n";
     std::cout << "============================================================\n";
@@ -358,6 +401,9 @@ int main(int argc, char* argv[]) {
     bool benchmark = false;
     bool verbose = false;
     std::string filename = "";
+    std::string record_file = "";
+    std::string replay_file = "";
+    double replay_speed = 1.0;
 
     // Parse arguments
     for (int i = 1; i < argc; ++i) {
@@ -375,6 +421,12 @@ int main(int argc, char* argv[]) {
             benchmark = true;
         } else if (arg == "--verbose") {
             verbose = true;
+        } else if (arg.rfind("--record=", 0) == 0) {
+            record_file = arg.substr(9);
+        } else if (arg.rfind("--replay=", 0) == 0) {
+            replay_file = arg.substr(9);
+        } else if (arg.rfind("--speed=", 0) == 0) {
+            replay_speed = std::stod(arg.substr(8));
         } else if (arg[0] != '-') {
             filename = arg;
         } else {
@@ -404,6 +456,7 @@ int main(int argc, char* argv[]) {
     config.assumed_adv = 10000000;
     config.flow_window_seconds = 60;
     config.enable_performance_monitoring = true;
+    config.capture_file = record_file;
 
     // Create and initialize platform
     MicrostructureAnalyticsPlatform platform(config);
@@ -424,8 +477,10 @@ int main(int argc, char* argv[]) {
             // Demo 3: Analytics Engine
             demo_analytics_engine(platform);
 
-            // Demo 4: Real-Time Mode (optional)
-            if (realtime) {
+            // Demo 4: Real-Time Mode or capture replay (optional)
+            if (!replay_file.empty()) {
+                demo_replay_mode(platform, replay_file, replay_speed);
+            } else if (realtime) {
                 demo_realtime_mode(platform);
             }
 
@@ -22,6 +22,8 @@
 #include <unordered_map>
 #include <cmath>
 #include <csignal>
+#include <cstring>
+#include <vector>
 
 // Lock-free queue components
 #include "../include/queues/spsc_queue.hpp"
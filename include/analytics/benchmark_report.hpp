@@ -0,0 +1,684 @@
+#pragma once
+
+/**
+ * @file benchmark_report.hpp
+ * @brief Machine-readable benchmark results and regression comparison
+ *
+ * A BenchmarkReport collects named results (parameters plus numeric
+ * metrics) from one or more repetitions of a benchmark suite and writes
+ * them as JSON together with host information. Every repetition adds a
+ * sample per metric; the file stores the samples and their median, min,
+ * max and MAD.
+ *
+ * compare_benchmark_reports() diffs two reports metric by metric. A
+ * change counts as a regression only if it is both larger than a
+ * relative threshold and larger than a multiple of the run-to-run noise
+ * (scaled MAD of either side), so single noisy runs do not fail builds.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "hardware_counters.hpp"
+#include "performance_monitor.hpp"
+
+// ============================================================================
+// SAMPLE STATISTICS
+// ============================================================================
+
+/**
+ * @struct MetricSummary
+ * @brief Robust summary of one metric's samples across repetitions
+ */
+struct MetricSummary {
+  std::vector<double> samples;
+  double median = 0.0;
+  double min = 0.0;
+  double max = 0.0;
+  double mad = 0.0; ///< Median absolute deviation
+
+  /**
+   * @brief Noise estimate comparable to a standard deviation (1.4826 * MAD)
+   */
+  double noise() const { return 1.4826 * mad; }
+
+  static double median_of(std::vector<double> values) {
+    if (values.empty()) {
+      return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return n % 2 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+  }
+
+  static MetricSummary from_samples(const std::vector<double> &samples) {
+    MetricSummary s;
+    s.samples = samples;
+    if (samples.empty()) {
+      return s;
+    }
+    s.median = median_of(samples);
+    s.min = *std::min_element(samples.begin(), samples.end());
+    s.max = *std::max_element(samples.begin(), samples.end());
+    std::vector<double> deviations;
+    deviations.reserve(samples.size());
+    for (double v : samples) {
+      deviations.push_back(std::abs(v - s.median));
+    }
+    s.mad = median_of(deviations);
+    return s;
+  }
+};
+
+/**
+ * @brief True if larger values of a metric are better
+ *
+ * Throughput and IPC improve upwards; latencies (*_ns) and per-op
+ * counts (*_per_op) improve downwards.
+ */
+inline bool metric_higher_is_better(const std::string &metric) {
+  return metric.find("throughput") != std::string::npos ||
+         metric.find("speedup") != std::string::npos || metric == "ipc";
+}
+
+// ============================================================================
+// MINIMAL JSON READER
+// ============================================================================
+
+/**
+ * @struct JsonValue
+ * @brief Parsed JSON value (enough to read reports written by this file)
+ */
+struct JsonValue {
+  enum class Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+
+  Type type = Type::NUL;
+  bool boolean = false;
+  double number = 0.0;
+  std::string string;
+  std::vector<JsonValue> array;
+  std::map<std::string, JsonValue> object;
+
+  bool has(const std::string &key) const {
+    return type == Type::OBJECT && object.count(key) > 0;
+  }
+
+  const JsonValue &operator[](const std::string &key) const {
+    static const JsonValue null_value;
+    auto it = object.find(key);
+    return it != object.end() ? it->second : null_value;
+  }
+
+  /**
+   * @brief Parses a complete JSON document
+   * @throws std::runtime_error on malformed input
+   */
+  static JsonValue parse(const std::string &text) {
+    size_t pos = 0;
+    JsonValue value = parse_value(text, pos);
+    skip_whitespace(text, pos);
+    if (pos != text.size()) {
+      throw std::runtime_error("JSON: trailing characters at offset " +
+                               std::to_string(pos));
+    }
+    return value;
+  }
+
+private:
+  static void skip_whitespace(const std::string &text, size_t &pos) {
+    while (pos < text.size() &&
+           std::isspace(static_cast<unsigned char>(text[pos]))) {
+      ++pos;
+    }
+  }
+
+  static void expect(const std::string &text, size_t &pos, char c) {
+    skip_whitespace(text, pos);
+    if (pos >= text.size() || text[pos] != c) {
+      throw std::runtime_error(std::string("JSON: expected '") + c +
+                               "' at offset " + std::to_string(pos));
+    }
+    ++pos;
+  }
+
+  static std::string parse_string(const std::string &text, size_t &pos) {
+    expect(text, pos, '"');
+    std::string out;
+    while (pos < text.size() && text[pos] != '"') {
+      char c = text[pos++];
+      if (c == '\\' && pos < text.size()) {
+        char e = text[pos++];
+        switch (e) {
+        case 'n':
+          out += '\n';
+          break;
+        case 't':
+          out += '\t';
+          break;
+        case 'r':
+          out += '\r';
+          break;
+        case 'u':
+          // Reports only escape control characters; keep them as '?'
+          pos = std::min(pos + 4, text.size());
+          out += '?';
+          break;
+        default:
+          out += e;
+        }
+      } else {
+        out += c;
+      }
+    }
+    expect(text, pos, '"');
+    return out;
+  }
+
+  static JsonValue parse_value(const std::string &text, size_t &pos) {
+    skip_whitespace(text, pos);
+    if (pos >= text.size()) {
+      throw std::runtime_error("JSON: unexpected end of input");
+    }
+
+    JsonValue v;
+    char c = text[pos];
+    if (c == '{') {
+      v.type = Type::OBJECT;
+      ++pos;
+      skip_whitespace(text, pos);
+      if (pos < text.size() && text[pos] == '}') {
+        ++pos;
+        return v;
+      }
+      while (true) {
+        std::string key = parse_string(text, pos);
+        expect(text, pos, ':');
+        v.object[key] = parse_value(text, pos);
+        skip_whitespace(text, pos);
+        if (pos < text.size() && text[pos] == ',') {
+          ++pos;
+          continue;
+        }
+        expect(text, pos, '}');
+        return v;
+      }
+    }
+    if (c == '[') {
+      v.type = Type::ARRAY;
+      ++pos;
+      skip_whitespace(text, pos);
+      if (pos < text.size() && text[pos] == ']') {
+        ++pos;
+        return v;
+      }
+      while (true) {
+        v.array.push_back(parse_value(text, pos));
+        skip_whitespace(text, pos);
+        if (pos < text.size() && text[pos] == ',') {
+          ++pos;
+          continue;
+        }
+        expect(text, pos, ']');
+        return v;
+      }
+    }
+    if (c == '"') {
+      v.type = Type::STRING;
+      v.string = parse_string(text, pos);
+      return v;
+    }
+    if (text.compare(pos, 4, "true") == 0) {
+      v.type = Type::BOOL;
+      v.boolean = true;
+      pos += 4;
+      return v;
+    }
+    if (text.compare(pos, 5, "false") == 0) {
+      v.type = Type::BOOL;
+      pos += 5;
+      return v;
+    }
+    if (text.compare(pos, 4, "null") == 0) {
+      pos += 4;
+      return v;
+    }
+
+    size_t end = pos;
+    while (end < text.size() &&
+           (std::isdigit(static_cast<unsigned char>(text[end])) ||
+            text[end] == '-' || text[end] == '+' || text[end] == '.' ||
+            text[end] == 'e' || text[end] == 'E')) {
+      ++end;
+    }
+    if (end == pos) {
+      throw std::runtime_error("JSON: unexpected character at offset " +
+                               std::to_string(pos));
+    }
+    v.type = Type::NUMBER;
+    v.number = std::stod(text.substr(pos, end - pos));
+    pos = end;
+    return v;
+  }
+};
+
+// ============================================================================
+// REPORT
+// ============================================================================
+
+/**
+ * @struct HostInfo
+ * @brief Machine the results were produced on
+ */
+struct HostInfo {
+  std::string hostname;
+  std::string cpu_model;
+  unsigned cores = 0;
+  std::string compiler;
+  std::string timestamp; ///< UTC, ISO 8601
+  bool hardware_counters = false;
+
+  /**
+   * @brief Describes the current machine
+   */
+  static HostInfo current() {
+    HostInfo info;
+#if defined(__linux__) || defined(__APPLE__)
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) == 0) {
+      info.hostname = name;
+    }
+#endif
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+      if (line.rfind("model name", 0) == 0) {
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+          info.cpu_model = line.substr(line.find_first_not_of(' ', colon + 1));
+        }
+        break;
+      }
+    }
+    info.cores = std::thread::hardware_concurrency();
+#if defined(__clang__)
+    info.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    info.compiler = "gcc " __VERSION__;
+#endif
+
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+#if defined(_WIN32)
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    info.timestamp = buf;
+
+    info.hardware_counters = HardwareCounters().available();
+    return info;
+  }
+};
+
+/**
+ * @struct BenchmarkResult
+ * @brief One named benchmark: parameters plus per-metric samples
+ */
+struct BenchmarkResult {
+  std::string name;
+  std::map<std::string, std::string> params;
+  std::map<std::string, MetricSummary> metrics;
+};
+
+/**
+ * @class BenchmarkReport
+ * @brief Collects benchmark results and reads/writes them as JSON
+ *
+ * Recording the same benchmark name again (a later repetition) appends
+ * a sample to each metric rather than creating a new entry.
+ */
+class BenchmarkReport {
+public:
+  BenchmarkReport() : host_(HostInfo::current()) {}
+
+  /**
+   * @brief Adds one sample of a metric
+   */
+  void record(const std::string &name, const std::string &metric,
+              double value,
+              const std::map<std::string, std::string> &params = {}) {
+    BenchmarkResult &result = find_or_add(name);
+    for (const auto &[key, val] : params) {
+      result.params[key] = val;
+    }
+    MetricSummary &summary = result.metrics[metric];
+    summary.samples.push_back(value);
+    summary = MetricSummary::from_samples(summary.samples);
+  }
+
+  /**
+   * @brief Adds latency percentiles, throughput and hardware counters
+   */
+  void record_monitor(const std::string &name, const PerformanceMonitor &monitor,
+                      const std::map<std::string, std::string> &params = {}) {
+    record(name, "p50_ns", static_cast<double>(monitor.get_p50_ns()), params);
+    record(name, "p99_ns", static_cast<double>(monitor.get_p99_ns()));
+    record(name, "p999_ns", static_cast<double>(monitor.get_p999_ns()));
+    record(name, "mean_ns", monitor.mean_latency());
+    record(name, "throughput", monitor.throughput());
+    record_counters(name, monitor);
+  }
+
+  /**
+   * @brief Adds hardware counters per op (if any were captured)
+   */
+  void record_counters(const std::string &name,
+                       const PerformanceMonitor &monitor) {
+    const HardwareCounterValues &hw = monitor.hardware_counter_totals();
+    uint64_t ops = monitor.hardware_counted_ops();
+    if (!hw.any_valid() || ops == 0) {
+      return;
+    }
+    if (hw.ipc() > 0.0) {
+      record(name, "ipc", hw.ipc());
+    }
+    for (size_t i = 0; i < NUM_HW_COUNTERS; ++i) {
+      auto counter = static_cast<HardwareCounter>(i);
+      if (hw.valid[i]) {
+        std::string metric = hardware_counter_name(counter);
+        std::replace(metric.begin(), metric.end(), '-', '_');
+        record(name, metric + "_per_op", hw.per_op(counter, ops));
+      }
+    }
+  }
+
+  void set_repetitions(int n) { repetitions_ = n; }
+  int repetitions() const { return repetitions_; }
+
+  const HostInfo &host() const { return host_; }
+  const std::vector<BenchmarkResult> &results() const { return results_; }
+
+  const BenchmarkResult *find(const std::string &name) const {
+    for (const auto &r : results_) {
+      if (r.name == name) {
+        return &r;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Serializes the report as JSON
+   */
+  std::string to_json() const {
+    std::ostringstream out;
+    out << std::setprecision(10);
+    out << "{\n";
+    out << "  \"schema\": 1,\n";
+    out << "  \"host\": {\n";
+    out << "    \"hostname\": " << quote(host_.hostname) << ",\n";
+    out << "    \"cpu_model\": " << quote(host_.cpu_model) << ",\n";
+    out << "    \"cores\": " << host_.cores << ",\n";
+    out << "    \"compiler\": " << quote(host_.compiler) << ",\n";
+    out << "    \"timestamp\": " << quote(host_.timestamp) << ",\n";
+    out << "    \"hardware_counters\": "
+        << (host_.hardware_counters ? "true" : "false") << "\n";
+    out << "  },\n";
+    out << "  \"repetitions\": " << repetitions_ << ",\n";
+    out << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results_.size(); ++i) {
+      const BenchmarkResult &r = results_[i];
+      out << (i ? "," : "") << "\n    {\n";
+      out << "      \"name\": " << quote(r.name) << ",\n";
+      out << "      \"params\": {";
+      size_t p = 0;
+      for (const auto &[key, val] : r.params) {
+        out << (p++ ? ", " : "") << quote(key) << ": " << quote(val);
+      }
+      out << "},\n";
+      out << "      \"metrics\": {";
+      size_t m = 0;
+      for (const auto &[metric, s] : r.metrics) {
+        out << (m++ ? "," : "") << "\n        " << quote(metric) << ": {"
+            << "\"median\": " << number(s.median)
+            << ", \"min\": " << number(s.min) << ", \"max\": " << number(s.max)
+            << ", \"mad\": " << number(s.mad) << ", \"samples\": [";
+        for (size_t k = 0; k < s.samples.size(); ++k) {
+          out << (k ? ", " : "") << number(s.samples[k]);
+        }
+        out << "]}";
+      }
+      out << "\n      }\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+  }
+
+  /**
+   * @brief Writes the report to a file
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void save(const std::string &filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+      throw std::runtime_error("Could not open file: " + filename);
+    }
+    file << to_json();
+  }
+
+  /**
+   * @brief Reads a report written by save()
+   * @throws std::runtime_error if the file cannot be read or parsed
+   */
+  static BenchmarkReport load(const std::string &filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+      throw std::runtime_error("Could not open file: " + filename);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    JsonValue root = JsonValue::parse(buffer.str());
+
+    BenchmarkReport report;
+    const JsonValue &host = root["host"];
+    report.host_.hostname = host["hostname"].string;
+    report.host_.cpu_model = host["cpu_model"].string;
+    report.host_.cores = static_cast<unsigned>(host["cores"].number);
+    report.host_.compiler = host["compiler"].string;
+    report.host_.timestamp = host["timestamp"].string;
+    report.host_.hardware_counters = host["hardware_counters"].boolean;
+    report.repetitions_ = static_cast<int>(root["repetitions"].number);
+
+    for (const JsonValue &b : root["benchmarks"].array) {
+      BenchmarkResult result;
+      result.name = b["name"].string;
+      for (const auto &[key, val] : b["params"].object) {
+        result.params[key] = val.string;
+      }
+      for (const auto &[metric, m] : b["metrics"].object) {
+        std::vector<double> samples;
+        for (const JsonValue &v : m["samples"].array) {
+          samples.push_back(v.number);
+        }
+        if (samples.empty() && m.has("median")) {
+          samples.push_back(m["median"].number);
+        }
+        result.metrics[metric] = MetricSummary::from_samples(samples);
+      }
+      report.results_.push_back(std::move(result));
+    }
+    return report;
+  }
+
+private:
+  BenchmarkResult &find_or_add(const std::string &name) {
+    for (auto &r : results_) {
+      if (r.name == name) {
+        return r;
+      }
+    }
+    results_.push_back(BenchmarkResult{name, {}, {}});
+    return results_.back();
+  }
+
+  /// JSON has no NaN/Infinity; non-finite values are written as null
+  static std::string number(double v) {
+    if (!std::isfinite(v)) {
+      return "null";
+    }
+    std::ostringstream oss;
+    oss << std::setprecision(10) << v;
+    return oss.str();
+  }
+
+  static std::string quote(const std::string &s) {
+    std::string out = "\"";
+    for (char c : s) {
+      switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char esc[8];
+          std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+          out += esc;
+        } else {
+          out += c;
+        }
+      }
+    }
+    return out + "\"";
+  }
+
+  HostInfo host_;
+  int repetitions_ = 1;
+  std::vector<BenchmarkResult> results_;
+};
+
+// ============================================================================
+// COMPARISON
+// ============================================================================
+
+/**
+ * @struct CompareConfig
+ * @brief Thresholds for calling a change a regression
+ */
+struct CompareConfig {
+  double threshold = 0.10;  ///< Minimum relative change (10%)
+  double noise_sigmas = 3.0; ///< Change must also exceed this many noise units
+};
+
+/**
+ * @struct MetricComparison
+ * @brief Verdict for one metric of one benchmark
+ */
+struct MetricComparison {
+  enum class Verdict { UNCHANGED, IMPROVED, REGRESSED, NOISY };
+
+  std::string benchmark;
+  std::string metric;
+  double baseline = 0.0;
+  double candidate = 0.0;
+  double change = 0.0; ///< Relative change, positive = worse
+  double noise = 0.0;  ///< Larger of the two sides' noise estimates
+  Verdict verdict = Verdict::UNCHANGED;
+};
+
+inline const char *verdict_name(MetricComparison::Verdict verdict) {
+  switch (verdict) {
+  case MetricComparison::Verdict::IMPROVED:
+    return "improved";
+  case MetricComparison::Verdict::REGRESSED:
+    return "REGRESSED";
+  case MetricComparison::Verdict::NOISY:
+    return "noisy";
+  default:
+    return "ok";
+  }
+}
+
+/**
+ * @brief Compares every metric present in both reports
+ *
+ * A change beyond the threshold is REGRESSED/IMPROVED only if it also
+ * exceeds noise_sigmas times the noise; otherwise it is NOISY.
+ */
+inline std::vector<MetricComparison>
+compare_benchmark_reports(const BenchmarkReport &baseline,
+                          const BenchmarkReport &candidate,
+                          const CompareConfig &config = CompareConfig()) {
+  std::vector<MetricComparison> out;
+  for (const BenchmarkResult &base : baseline.results()) {
+    const BenchmarkResult *cand = candidate.find(base.name);
+    if (!cand) {
+      continue;
+    }
+    for (const auto &[metric, b] : base.metrics) {
+      auto it = cand->metrics.find(metric);
+      if (it == cand->metrics.end()) {
+        continue;
+      }
+      const MetricSummary &c = it->second;
+
+      MetricComparison cmp;
+      cmp.benchmark = base.name;
+      cmp.metric = metric;
+      cmp.baseline = b.median;
+      cmp.candidate = c.median;
+      cmp.noise = std::max(b.noise(), c.noise());
+
+      double diff = c.median - b.median;
+      if (b.median != 0.0) {
+        cmp.change = diff / std::abs(b.median);
+      }
+      if (metric_higher_is_better(metric)) {
+        cmp.change = -cmp.change;
+      }
+
+      if (std::abs(cmp.change) >= config.threshold) {
+        bool beyond_noise = std::abs(diff) > config.noise_sigmas * cmp.noise;
+        if (!beyond_noise) {
+          cmp.verdict = MetricComparison::Verdict::NOISY;
+        } else if (cmp.change > 0) {
+          cmp.verdict = MetricComparison::Verdict::REGRESSED;
+        } else {
+          cmp.verdict = MetricComparison::Verdict::IMPROVED;
+        }
+      }
+      out.push_back(cmp);
+    }
+  }
+  return out;
+}
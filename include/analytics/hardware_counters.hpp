@@ -0,0 +1,284 @@
+#pragma once
+
+/**
+ * @file hardware_counters.hpp
+ * @brief Linux perf_event_open hardware counters around measured regions
+ *
+ * Counts user-space cycles, instructions, cache misses, branch misses and
+ * dTLB read misses for the calling thread. Counters are opened
+ * individually, so a PMU that lacks one event (common in VMs) still
+ * reports the rest; when none can be opened (containers with a seccomp
+ * filter, perf_event_paranoid > 2, non-Linux builds) everything reports
+ * unavailable and callers carry on without counters.
+ *
+ * Counters are enabled around whole regions (thousands of operations),
+ * never per operation: each start/stop costs several syscalls.
+ */
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @enum HardwareCounter
+ * @brief Counted hardware events
+ */
+enum HardwareCounter : size_t {
+  HW_CYCLES = 0,
+  HW_INSTRUCTIONS,
+  HW_CACHE_MISSES,
+  HW_BRANCH_MISSES,
+  HW_DTLB_MISSES,
+  NUM_HW_COUNTERS
+};
+
+inline const char *hardware_counter_name(HardwareCounter counter) {
+  switch (counter) {
+  case HW_CYCLES:
+    return "cycles";
+  case HW_INSTRUCTIONS:
+    return "instructions";
+  case HW_CACHE_MISSES:
+    return "cache-misses";
+  case HW_BRANCH_MISSES:
+    return "branch-misses";
+  case HW_DTLB_MISSES:
+    return "dTLB-misses";
+  default:
+    return "unknown";
+  }
+}
+
+/**
+ * @struct HardwareCounterValues
+ * @brief Counter totals over one or more regions
+ */
+struct HardwareCounterValues {
+  std::array<uint64_t, NUM_HW_COUNTERS> values{};
+  std::array<bool, NUM_HW_COUNTERS> valid{};
+
+  bool any_valid() const {
+    for (bool v : valid) {
+      if (v) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Instructions per cycle, or 0 if either counter is missing
+   */
+  double ipc() const {
+    if (!valid[HW_CYCLES] || !valid[HW_INSTRUCTIONS] || values[HW_CYCLES] == 0) {
+      return 0.0;
+    }
+    return static_cast<double>(values[HW_INSTRUCTIONS]) / values[HW_CYCLES];
+  }
+
+  /**
+   * @brief Counter value per operation
+   */
+  double per_op(HardwareCounter counter, uint64_t ops) const {
+    if (!valid[counter] || ops == 0) {
+      return 0.0;
+    }
+    return static_cast<double>(values[counter]) / ops;
+  }
+
+  HardwareCounterValues &operator+=(const HardwareCounterValues &other) {
+    for (size_t i = 0; i < NUM_HW_COUNTERS; ++i) {
+      values[i] += other.values[i];
+      valid[i] = valid[i] || other.valid[i];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Prints IPC and per-operation counts on one line
+   */
+  void print_per_op(uint64_t ops, const std::string &indent = "    ") const {
+    if (!any_valid()) {
+      std::cout << indent << "HW counters: unavailable\n";
+      return;
+    }
+    std::cout << indent << "HW counters/op:" << std::fixed
+              << std::setprecision(2);
+    if (ipc() > 0.0) {
+      std::cout << " IPC " << ipc();
+    }
+    for (size_t i = 0; i < NUM_HW_COUNTERS; ++i) {
+      if (valid[i]) {
+        std::cout << " | " << hardware_counter_name(static_cast<HardwareCounter>(i))
+                  << " " << per_op(static_cast<HardwareCounter>(i), ops);
+      }
+    }
+    std::cout << "\n";
+  }
+};
+
+/**
+ * @class HardwareCounters
+ * @brief Per-thread perf_event counters for the calling thread
+ *
+ * Usage:
+ * @code
+ *   HardwareCounters counters;
+ *   counters.start();
+ *   ... measured region ...
+ *   HardwareCounterValues v = counters.stop();
+ *   v.print_per_op(num_ops);
+ * @endcode
+ *
+ * Values are scaled by time_enabled / time_running when the kernel had
+ * to multiplex counters.
+ */
+class HardwareCounters {
+public:
+  HardwareCounters() { open_all(); }
+  ~HardwareCounters() { close_all(); }
+
+  // Non-copyable (owns file descriptors)
+  HardwareCounters(const HardwareCounters &) = delete;
+  HardwareCounters &operator=(const HardwareCounters &) = delete;
+
+  /**
+   * @brief True if at least one counter could be opened
+   */
+  bool available() const {
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool available(HardwareCounter counter) const { return fds_[counter] >= 0; }
+
+  /**
+   * @brief Why counters are unavailable (empty if any are available)
+   */
+  const std::string &unavailable_reason() const { return reason_; }
+
+  /**
+   * @brief Resets and enables all open counters
+   */
+  void start() {
+#if defined(__linux__)
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  /**
+   * @brief Disables all open counters and reads them
+   */
+  HardwareCounterValues stop() {
+    HardwareCounterValues result;
+#if defined(__linux__)
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      }
+    }
+    for (size_t i = 0; i < NUM_HW_COUNTERS; ++i) {
+      if (fds_[i] < 0) {
+        continue;
+      }
+      // value, time_enabled, time_running
+      uint64_t data[3] = {};
+      if (::read(fds_[i], data, sizeof(data)) != sizeof(data)) {
+        continue;
+      }
+      uint64_t value = data[0];
+      if (data[2] > 0 && data[2] < data[1]) {
+        value = static_cast<uint64_t>(static_cast<double>(value) * data[1] / data[2]);
+      }
+      result.values[i] = value;
+      result.valid[i] = data[2] > 0;
+    }
+#endif
+    return result;
+  }
+
+private:
+  void open_all() {
+    fds_.fill(-1);
+#if defined(__linux__)
+    const uint64_t dtlb_read_miss =
+        PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    const struct {
+      uint32_t type;
+      uint64_t config;
+    } events[NUM_HW_COUNTERS] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, dtlb_read_miss},
+    };
+
+    int first_errno = 0;
+    for (size_t i = 0; i < NUM_HW_COUNTERS; ++i) {
+      struct perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = events[i].type;
+      attr.config = events[i].config;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1; // Allowed at perf_event_paranoid <= 2
+      attr.exclude_hv = 1;
+      attr.read_format =
+          PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      // pid = 0, cpu = -1: this thread, on any CPU
+      long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+      if (fd < 0) {
+        if (first_errno == 0) {
+          first_errno = errno;
+        }
+        continue;
+      }
+      fds_[i] = static_cast<int>(fd);
+    }
+
+    if (!available()) {
+      reason_ = std::string("perf_event_open: ") + std::strerror(first_errno);
+    }
+#else
+    reason_ = "perf_event_open not supported on this platform";
+#endif
+  }
+
+  void close_all() {
+#if defined(__linux__)
+    for (int &fd : fds_) {
+      if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+      }
+    }
+#endif
+  }
+
+  std::array<int, NUM_HW_COUNTERS> fds_{};
+  std::string reason_;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+/**
+ * @file latency_checkpoints.hpp
+ * @brief Per-event timestamps stamped at each pipeline stage
+ *
+ * A tick carries one LatencyCheckpoints from the socket to the analytics
+ * update. Every stage stamps its checkpoint when it finishes with the
+ * event, so the latency between consecutive checkpoints is the time one
+ * stage (plus any queue wait before it) took for that event. Feeding the
+ * stamps to ComponentLatencyTracker::record_checkpoints() builds per-hop
+ * histograms, which show which stage owns the tail.
+ *
+ * Fills are routed synchronously while the book matches, so
+ * CP_FILL_ROUTED precedes CP_BOOK_DONE: dequeued -> fill_routed is
+ * matching plus routing, fill_routed -> book_done the rest of the update.
+ *
+ * All stamps use steady_clock nanoseconds so they can be compared across
+ * threads. A zero stamp means the stage was skipped (e.g. no fill).
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @enum LatencyCheckpoint
+ * @brief Pipeline stages, in the order an event passes them
+ */
+enum LatencyCheckpoint : size_t {
+  CP_RECEIVED = 0,   ///< Bytes read from the socket
+  CP_PARSED,         ///< Wire message decoded into a FeedTick
+  CP_ENQUEUED,       ///< Pushed onto the aggregator queue
+  CP_DEQUEUED,       ///< Popped by the aggregator processor
+  CP_FILL_ROUTED,    ///< Last resulting fill routed (only if it traded)
+  CP_BOOK_DONE,      ///< Order book update returned
+  CP_ANALYTICS_DONE, ///< Microstructure analytics updated
+  NUM_LATENCY_CHECKPOINTS
+};
+
+inline const char *latency_checkpoint_name(LatencyCheckpoint checkpoint) {
+  switch (checkpoint) {
+  case CP_RECEIVED:
+    return "received";
+  case CP_PARSED:
+    return "parsed";
+  case CP_ENQUEUED:
+    return "enqueued";
+  case CP_DEQUEUED:
+    return "dequeued";
+  case CP_FILL_ROUTED:
+    return "fill_routed";
+  case CP_BOOK_DONE:
+    return "book_done";
+  case CP_ANALYTICS_DONE:
+    return "analytics_done";
+  default:
+    return "unknown";
+  }
+}
+
+/**
+ * @brief Checkpoint clock (steady_clock nanoseconds)
+ */
+inline uint64_t checkpoint_now_ns() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+/**
+ * @struct LatencyCheckpoints
+ * @brief Stage timestamps carried with one event
+ */
+struct LatencyCheckpoints {
+  std::array<uint64_t, NUM_LATENCY_CHECKPOINTS> ns{};
+
+  void stamp(LatencyCheckpoint checkpoint) { ns[checkpoint] = checkpoint_now_ns(); }
+  void stamp(LatencyCheckpoint checkpoint, uint64_t time_ns) {
+    ns[checkpoint] = time_ns;
+  }
+
+  bool has(LatencyCheckpoint checkpoint) const { return ns[checkpoint] != 0; }
+
+  /**
+   * @brief Time from the nearest earlier stamped checkpoint to this one
+   * @return 0 if this checkpoint or every earlier one is unstamped
+   */
+  uint64_t hop_ns(LatencyCheckpoint checkpoint) const {
+    if (!has(checkpoint)) {
+      return 0;
+    }
+    for (size_t i = checkpoint; i-- > 0;) {
+      if (ns[i] != 0) {
+        return ns[checkpoint] > ns[i] ? ns[checkpoint] - ns[i] : 0;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Time from the first to the last stamped checkpoint
+   */
+  uint64_t total_ns() const {
+    uint64_t first = 0;
+    uint64_t last = 0;
+    for (uint64_t t : ns) {
+      if (t == 0) {
+        continue;
+      }
+      if (first == 0) {
+        first = t;
+      }
+      last = t;
+    }
+    return last > first ? last - first : 0;
+  }
+};
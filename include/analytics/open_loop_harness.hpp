@@ -0,0 +1,397 @@
+#pragma once
+
+/**
+ * @file open_loop_harness.hpp
+ * @brief Open-loop latency benchmarking (coordinated-omission correct)
+ *
+ * A closed-loop benchmark issues the next operation only after the
+ * previous one returns, so a stall delays every request behind it
+ * without those requests ever being timed as late. The harness here
+ * instead fixes a send schedule up front at a target rate and measures
+ * each operation from its *intended* send time:
+ *
+ *   response = completion - intended    (what a caller at that rate sees)
+ *   service  = completion - actual send (what a closed loop reports)
+ *
+ * When the system keeps up the two agree; past capacity, response
+ * latency grows with the backlog while service latency stays flat.
+ * Sweeping the rate produces the latency-vs-throughput curve used for
+ * capacity planning.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "wait_strategy.hpp"
+
+/**
+ * @enum ArrivalProcess
+ * @brief Spacing of intended send times
+ */
+enum class ArrivalProcess {
+  FIXED_INTERVAL, ///< Evenly spaced at 1/rate
+  POISSON         ///< Exponential inter-arrival times with mean 1/rate
+};
+
+inline const char *arrival_process_name(ArrivalProcess arrival) {
+  return arrival == ArrivalProcess::POISSON ? "poisson" : "fixed";
+}
+
+/**
+ * @struct OpenLoopConfig
+ * @brief Parameters of one open-loop run
+ */
+struct OpenLoopConfig {
+  double rate_per_sec = 100000.0;
+  ArrivalProcess arrival = ArrivalProcess::FIXED_INTERVAL;
+  size_t num_ops = 50000;  ///< Measured operations
+  size_t warmup_ops = 1000; ///< Leading operations sent on schedule, not measured
+  uint64_t seed = 42;       ///< POISSON arrivals only
+
+  /// Waits longer than this yield the CPU instead of spinning
+  std::chrono::nanoseconds yield_threshold{50000};
+
+  /// Async runs: give up waiting for completions after this long
+  std::chrono::milliseconds drain_timeout{5000};
+};
+
+/**
+ * @class LatencySamples
+ * @brief Exact latency samples for percentile reporting
+ *
+ * Open-loop latencies span nanoseconds to (past saturation) seconds, so
+ * samples are kept raw rather than bucketed. Single writer; read only
+ * after the writer has finished.
+ */
+class LatencySamples {
+public:
+  void reserve(size_t n) { samples_.reserve(n); }
+  void clear() { samples_.clear(); }
+  void record(uint64_t latency_ns) { samples_.push_back(latency_ns); }
+  size_t count() const { return samples_.size(); }
+  const std::vector<uint64_t> &samples() const { return samples_; }
+
+  /**
+   * @brief Latency at a percentile, ignoring the first skip samples
+   * @param percentile Percentile (0.0 to 1.0)
+   * @param skip Leading (warmup) samples to ignore
+   */
+  uint64_t percentile(double percentile, size_t skip = 0) const {
+    std::vector<uint64_t> sorted = measured(skip);
+    if (sorted.empty()) {
+      return 0;
+    }
+    size_t rank = static_cast<size_t>(percentile * (sorted.size() - 1));
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+  }
+
+  double mean(size_t skip = 0) const {
+    if (samples_.size() <= skip) {
+      return 0.0;
+    }
+    double sum = 0.0;
+    for (size_t i = skip; i < samples_.size(); ++i) {
+      sum += static_cast<double>(samples_[i]);
+    }
+    return sum / (samples_.size() - skip);
+  }
+
+  uint64_t max(size_t skip = 0) const {
+    uint64_t m = 0;
+    for (size_t i = skip; i < samples_.size(); ++i) {
+      m = std::max(m, samples_[i]);
+    }
+    return m;
+  }
+
+private:
+  std::vector<uint64_t> measured(size_t skip) const {
+    if (samples_.size() <= skip) {
+      return {};
+    }
+    return std::vector<uint64_t>(samples_.begin() + skip, samples_.end());
+  }
+
+  std::vector<uint64_t> samples_;
+};
+
+/**
+ * @struct OpenLoopResult
+ * @brief One point on a latency-vs-throughput curve
+ */
+struct OpenLoopResult {
+  double target_rate = 0.0;
+  double achieved_rate = 0.0; ///< Completed ops / time to complete them
+  size_t completed = 0;       ///< Measured operations that completed
+
+  // Response latency (from intended send time)
+  uint64_t p50_ns = 0;
+  uint64_t p90_ns = 0;
+  uint64_t p99_ns = 0;
+  uint64_t p999_ns = 0;
+  uint64_t max_ns = 0;
+  double mean_ns = 0.0;
+
+  // Service latency (from actual send time); synchronous runs only
+  uint64_t service_p50_ns = 0;
+  uint64_t service_p99_ns = 0;
+
+  /// Largest delay between an intended and the actual send time
+  uint64_t max_send_lag_ns = 0;
+
+  /**
+   * @brief True if the system could not sustain the target rate
+   */
+  bool saturated() const {
+    return target_rate > 0.0 && achieved_rate < 0.95 * target_rate;
+  }
+};
+
+/**
+ * @class OpenLoopHarness
+ * @brief Drives an operation at a fixed schedule and records latency
+ *
+ * Two modes:
+ * - run():       the operation completes synchronously on the sending
+ *                thread (e.g. applying a message to a book).
+ * - run_async(): the operation hands work to another thread (queue hop,
+ *                feed pipeline). The consumer records
+ *                now - intended_ns into a LatencySamples it owns, in
+ *                send order.
+ *
+ * Send times are never skipped or re-based: if the sender falls behind
+ * it sends immediately, and the lag is charged to the operations that
+ * waited.
+ */
+class OpenLoopHarness {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit OpenLoopHarness(const OpenLoopConfig &config = OpenLoopConfig())
+      : config_(config) {}
+
+  const OpenLoopConfig &get_config() const { return config_; }
+
+  /**
+   * @brief Intended send offsets from the start of the run (ns)
+   * Covers warmup followed by measured operations.
+   */
+  std::vector<uint64_t> schedule() const {
+    size_t n = config_.warmup_ops + config_.num_ops;
+    std::vector<uint64_t> offsets(n);
+    double mean_gap_ns = 1e9 / std::max(config_.rate_per_sec, 1e-9);
+
+    std::mt19937_64 rng(config_.seed);
+    std::exponential_distribution<double> gap(1.0 / mean_gap_ns);
+    double t = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      offsets[i] = static_cast<uint64_t>(t);
+      t += config_.arrival == ArrivalProcess::POISSON ? gap(rng) : mean_gap_ns;
+    }
+    return offsets;
+  }
+
+  /**
+   * @brief Runs a synchronous operation on schedule
+   * @param op Called as op(i) for i in [0, warmup_ops + num_ops)
+   */
+  template <typename Op> OpenLoopResult run(Op &&op) {
+    std::vector<uint64_t> offsets = schedule();
+    LatencySamples response;
+    LatencySamples service;
+    response.reserve(offsets.size());
+    service.reserve(offsets.size());
+
+    uint64_t max_lag = 0;
+    const uint64_t start = now_ns();
+    uint64_t measure_start = start;
+    for (size_t i = 0; i < offsets.size(); ++i) {
+      const uint64_t intended = start + offsets[i];
+      wait_until(intended);
+      if (i == config_.warmup_ops) {
+        measure_start = intended;
+      }
+
+      const uint64_t sent = now_ns();
+      op(i);
+      const uint64_t done = now_ns();
+
+      response.record(done - intended);
+      service.record(done - sent);
+      if (i >= config_.warmup_ops) {
+        max_lag = std::max(max_lag, sent - intended);
+      }
+    }
+    const uint64_t end = now_ns();
+
+    OpenLoopResult result = summarize(response, measure_start, end);
+    result.service_p50_ns = service.percentile(0.50, config_.warmup_ops);
+    result.service_p99_ns = service.percentile(0.99, config_.warmup_ops);
+    result.max_send_lag_ns = max_lag;
+    return result;
+  }
+
+  /**
+   * @brief Runs an asynchronous operation on schedule
+   * @param send Called as send(i, intended_ns); hands work to a consumer
+   * @param responses Filled by the consumer, one sample per operation in
+   *                  send order
+   * @param completed Returns the number of operations the consumer has
+   *                  finished (must be safe to call concurrently)
+   * @param stop Stops the consumer; called after draining (or timing
+   *             out) and before responses are read
+   */
+  template <typename Send, typename Completed, typename Stop>
+  OpenLoopResult run_async(Send &&send, const LatencySamples &responses,
+                           Completed &&completed, Stop &&stop) {
+    std::vector<uint64_t> offsets = schedule();
+
+    uint64_t max_lag = 0;
+    const uint64_t start = now_ns();
+    uint64_t measure_start = start;
+    for (size_t i = 0; i < offsets.size(); ++i) {
+      const uint64_t intended = start + offsets[i];
+      wait_until(intended);
+      if (i == config_.warmup_ops) {
+        measure_start = intended;
+      }
+
+      send(i, intended);
+      if (i >= config_.warmup_ops) {
+        max_lag = std::max(max_lag, now_ns() - intended);
+      }
+    }
+
+    // Wait for the consumer to drain
+    const auto deadline = Clock::now() + config_.drain_timeout;
+    while (completed() < offsets.size() && Clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    const uint64_t end = now_ns();
+    stop();
+
+    OpenLoopResult result = summarize(responses, measure_start, end);
+    result.max_send_lag_ns = max_lag;
+    return result;
+  }
+
+  /**
+   * @brief Runs one point per rate and returns the curve
+   * @param rates Target rates (ops/sec)
+   * @param base Configuration shared by every point
+   * @param run_point Called as run_point(config) for each rate
+   */
+  template <typename RunPoint>
+  static std::vector<OpenLoopResult> sweep(const std::vector<double> &rates,
+                                           const OpenLoopConfig &base,
+                                           RunPoint &&run_point) {
+    std::vector<OpenLoopResult> curve;
+    curve.reserve(rates.size());
+    for (double rate : rates) {
+      OpenLoopConfig config = base;
+      config.rate_per_sec = rate;
+      curve.push_back(run_point(config));
+    }
+    return curve;
+  }
+
+  /**
+   * @brief Prints a latency-vs-throughput curve as a table
+   */
+  static void print_curve(const std::string &name,
+                          const std::vector<OpenLoopResult> &curve,
+                          bool show_service = true) {
+    std::cout << "\n  " << name << "\n";
+    std::cout << "    " << std::right << std::setw(11) << "target/s"
+              << std::setw(11) << "achieved/s" << std::setw(10) << "p50"
+              << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+              << std::setw(10) << "max";
+    if (show_service) {
+      std::cout << std::setw(12) << "svc p99";
+    }
+    std::cout << "\n";
+
+    for (const auto &r : curve) {
+      std::cout << "    " << std::fixed << std::setprecision(0)
+                << std::setw(11) << r.target_rate << std::setw(11)
+                << r.achieved_rate << std::setw(10) << format_ns(r.p50_ns)
+                << std::setw(10) << format_ns(r.p99_ns) << std::setw(10)
+                << format_ns(r.p999_ns) << std::setw(10)
+                << format_ns(r.max_ns);
+      if (show_service) {
+        std::cout << std::setw(12) << format_ns(r.service_p99_ns);
+      }
+      if (r.saturated()) {
+        std::cout << "  saturated";
+      }
+      std::cout << "\n";
+    }
+  }
+
+  /**
+   * @brief Formats a latency with a unit (ns, us, ms, s)
+   */
+  static std::string format_ns(uint64_t ns) {
+    std::ostringstream oss;
+    oss << std::fixed;
+    if (ns < 10000) {
+      oss << ns << "ns";
+    } else if (ns < 10000000) {
+      oss << std::setprecision(1) << ns / 1e3 << "us";
+    } else if (ns < 10000000000ULL) {
+      oss << std::setprecision(1) << ns / 1e6 << "ms";
+    } else {
+      oss << std::setprecision(2) << ns / 1e9 << "s";
+    }
+    return oss.str();
+  }
+
+  static uint64_t now_ns() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch())
+            .count());
+  }
+
+private:
+  void wait_until(uint64_t intended) const {
+    const uint64_t yield_ns = static_cast<uint64_t>(config_.yield_threshold.count());
+    for (uint64_t now = now_ns(); now < intended; now = now_ns()) {
+      // Far from the send time: let consumers on the same core run
+      if (intended - now > yield_ns) {
+        std::this_thread::yield();
+      } else {
+        cpu_relax();
+      }
+    }
+  }
+
+  OpenLoopResult summarize(const LatencySamples &response,
+                           uint64_t measure_start, uint64_t end) const {
+    const size_t skip = config_.warmup_ops;
+    OpenLoopResult result;
+    result.target_rate = config_.rate_per_sec;
+    result.completed = response.count() > skip ? response.count() - skip : 0;
+    if (end > measure_start) {
+      result.achieved_rate = result.completed * 1e9 / (end - measure_start);
+    }
+    result.p50_ns = response.percentile(0.50, skip);
+    result.p90_ns = response.percentile(0.90, skip);
+    result.p99_ns = response.percentile(0.99, skip);
+    result.p999_ns = response.percentile(0.999, skip);
+    result.max_ns = response.max(skip);
+    result.mean_ns = response.mean(skip);
+    return result;
+  }
+
+  OpenLoopConfig config_;
+};
@@ -9,6 +9,7 @@
  * - Throughput measurement
  * - Component-level timing breakdown
  * - Performance target verification
+ * - Optional hardware counters (IPC, cache/branch/dTLB misses per op)
  *
  * Performance targets:
  * - CSV parsing: Maintain 417K rows/sec
@@ -26,12 +27,17 @@
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "hardware_counters.hpp"
+#include "latency_checkpoints.hpp"
+#include "prometheus_writer.hpp"
+
 /**
  * @class PerformanceMonitor
  * @brief Lock-free performance monitoring with latency histograms and
@@ -97,6 +103,11 @@ private:
   bool enabled_ = true;
   std::string name_ = "default";
 
+  // Hardware counters (optional; owned by the thread that enabled them)
+  std::unique_ptr<HardwareCounters> hw_counters_;
+  HardwareCounterValues hw_totals_;
+  uint64_t hw_ops_ = 0;
+
 public:
   /**
    * @brief Default constructor
@@ -129,6 +140,8 @@ public:
     max_latency_ns_.store(0, std::memory_order_relaxed);
     start_time_ = std::chrono::steady_clock::now();
     last_report_time_ = start_time_;
+    hw_totals_ = HardwareCounterValues();
+    hw_ops_ = 0;
 
     std::lock_guard<std::mutex> lock(component_mutex_);
     component_stats_.clear();
@@ -252,6 +265,85 @@ public:
     }
   }
 
+  // ========================================================================
+  // HARDWARE COUNTERS
+  // ========================================================================
+
+  /**
+   * @brief Opens hardware counters for the calling thread
+   * @return true if at least one counter is available
+   *
+   * Counted regions must run on the thread that called this. When
+   * counters are unavailable, regions are no-ops.
+   */
+  bool enable_hardware_counters() {
+    if (!hw_counters_) {
+      hw_counters_ = std::make_unique<HardwareCounters>();
+    }
+    return hw_counters_->available();
+  }
+
+  /**
+   * @brief Checks whether hardware counters are enabled and available
+   */
+  bool hardware_counters_available() const {
+    return hw_counters_ && hw_counters_->available();
+  }
+
+  /**
+   * @brief Reason counters are unavailable (empty if available or never enabled)
+   */
+  std::string hardware_counters_status() const {
+    return hw_counters_ ? hw_counters_->unavailable_reason() : "";
+  }
+
+  /**
+   * @brief Starts counting a region
+   */
+  void begin_counted_region() {
+    if (enabled_ && hardware_counters_available()) {
+      hw_counters_->start();
+    }
+  }
+
+  /**
+   * @brief Stops counting a region and attributes it to ops operations
+   * @param ops Number of operations the region performed
+   */
+  void end_counted_region(uint64_t ops) {
+    if (enabled_ && hardware_counters_available()) {
+      hw_totals_ += hw_counters_->stop();
+      hw_ops_ += ops;
+    }
+  }
+
+  /**
+   * @brief Counter totals over all counted regions since reset()
+   */
+  const HardwareCounterValues &hardware_counter_totals() const {
+    return hw_totals_;
+  }
+
+  /**
+   * @brief Operations covered by hardware_counter_totals()
+   */
+  uint64_t hardware_counted_ops() const { return hw_ops_; }
+
+  /**
+   * @brief Prints IPC and misses per operation
+   */
+  void print_hardware_counters(const std::string &indent = "    ") const {
+    if (!hw_counters_) {
+      return;
+    }
+    if (!hw_counters_->available()) {
+      std::cout << indent << "HW counters: unavailable ("
+                << hw_counters_->unavailable_reason() << ")\n";
+      return;
+    }
+    hw_totals_.print_per_op(hw_ops_, indent);
+  }
+
   // ========================================================================
   // STATISTICS QUERIES
   // ========================================================================
@@ -432,6 +524,11 @@ public:
     std::cout << "\n--- Latency ---\n";
     print_latency_percentiles();
 
+    if (hw_counters_) {
+      std::cout << "\n--- Hardware Counters ---\n";
+      print_hardware_counters("  ");
+    }
+
     if (!component_stats_.empty()) {
       std::cout << "\n--- Component Timing ---\n";
       std::lock_guard<std::mutex> lock(component_mutex_);
@@ -505,6 +602,39 @@ public:
                  "ns,throughput\n";
   }
 
+  /**
+   * @brief Appends this monitor's latency summary and counters to a scrape
+   * @param writer Destination exposition builder
+   * @param prefix Metric name prefix (e.g. "hft" -> hft_latency_ns)
+   * @param label Label key carrying this monitor's name
+   *
+   * Reads only relaxed atomic loads, so it is safe to call from a scrape
+   * thread while recording threads keep writing.
+   */
+  void write_prometheus(PrometheusWriter &writer,
+                        const std::string &prefix = "hft",
+                        const std::string &label = "component") const {
+    const PrometheusWriter::Labels labels = {{label, name_}};
+    const uint64_t events = events_processed();
+    writer.summary(prefix + "_latency_ns", "Latency distribution (ns)",
+                   {{0.5, static_cast<double>(get_p50_ns())},
+                    {0.9, static_cast<double>(get_percentile_ns(0.90))},
+                    {0.99, static_cast<double>(get_p99_ns())},
+                    {0.999, static_cast<double>(get_p999_ns())}},
+                   static_cast<double>(
+                       total_latency_ns_.load(std::memory_order_relaxed)),
+                   events, labels);
+    writer.gauge(prefix + "_latency_max_ns", "Maximum observed latency (ns)",
+                 static_cast<double>(get_max_latency_ns()), labels);
+    writer.counter(prefix + "_latency_overflow_total",
+                   "Samples above the histogram range",
+                   static_cast<double>(get_overflow_count()), labels);
+    writer.counter(prefix + "_events_dropped_total", "Dropped events",
+                   static_cast<double>(events_dropped()), labels);
+    writer.gauge(prefix + "_throughput_per_second",
+                 "Events per second since reset", throughput(), labels);
+  }
+
   /**
    * @brief Gets statistics as a formatted string
    * @return Statistics string
@@ -590,6 +720,26 @@ public:
   ScopedTimer &operator=(const ScopedTimer &) = delete;
 };
 
+/**
+ * @class CountedRegion
+ * @brief RAII hardware-counter region covering a batch of operations
+ */
+class CountedRegion {
+  PerformanceMonitor &monitor_;
+  uint64_t ops_;
+
+public:
+  CountedRegion(PerformanceMonitor &monitor, uint64_t ops)
+      : monitor_(monitor), ops_(ops) {
+    monitor_.begin_counted_region();
+  }
+
+  ~CountedRegion() { monitor_.end_counted_region(ops_); }
+
+  CountedRegion(const CountedRegion &) = delete;
+  CountedRegion &operator=(const CountedRegion &) = delete;
+};
+
 /**
  * @class ComponentLatencyTracker
  * @brief Tracks latencies for multiple components in the pipeline
@@ -617,6 +767,9 @@ public:
 private:
   std::array<PerformanceMonitor, MAX_COMPONENTS> monitors_;
 
+  // Latency into each checkpoint from the previous stamped one
+  std::array<PerformanceMonitor, NUM_LATENCY_CHECKPOINTS> hops_;
+
 public:
   ComponentLatencyTracker() {
     monitors_[CSV_PARSING].set_name("csv_parsing");
@@ -627,6 +780,9 @@ public:
     monitors_[EXECUTION_STRATEGY].set_name("execution_strategy");
     monitors_[END_TO_END].set_name("end_to_end");
     monitors_[CUSTOM].set_name("custom");
+    for (size_t i = 0; i < NUM_LATENCY_CHECKPOINTS; ++i) {
+      hops_[i].set_name(latency_checkpoint_name(static_cast<LatencyCheckpoint>(i)));
+    }
   }
 
   PerformanceMonitor &csv_parsing() { return monitors_[CSV_PARSING]; }
@@ -676,6 +832,98 @@ public:
     for (auto &m : monitors_) {
       m.reset();
     }
+    for (auto &m : hops_) {
+      m.reset();
+    }
+  }
+
+  /**
+   * @brief Records one event's checkpoints into the per-hop histograms
+   *
+   * Each stamped checkpoint after the first adds its hop latency; the
+   * first-to-last span goes to end_to_end(). Safe to call from several
+   * threads (recording is lock-free).
+   */
+  void record_checkpoints(const LatencyCheckpoints &checkpoints) {
+    bool seen = false;
+    for (size_t i = 0; i < NUM_LATENCY_CHECKPOINTS; ++i) {
+      auto checkpoint = static_cast<LatencyCheckpoint>(i);
+      if (!checkpoints.has(checkpoint)) {
+        continue;
+      }
+      if (seen) {
+        hops_[i].record_event_latency(checkpoints.hop_ns(checkpoint));
+      }
+      seen = true;
+    }
+    if (seen) {
+      monitors_[END_TO_END].record_event_latency(checkpoints.total_ns());
+    }
+  }
+
+  /**
+   * @brief Latency into a checkpoint from the previous stamped one
+   */
+  PerformanceMonitor &hop(LatencyCheckpoint checkpoint) {
+    return hops_[checkpoint];
+  }
+  const PerformanceMonitor &hop(LatencyCheckpoint checkpoint) const {
+    return hops_[checkpoint];
+  }
+
+  /**
+   * @brief Prints per-hop percentiles so tail latency can be attributed
+   */
+  void print_hop_breakdown() const {
+    std::cout << "\n--- Per-Hop Latency (ns) ---\n";
+    std::cout << "  " << std::left << std::setw(18) << "into" << std::right
+              << std::setw(10) << "events" << std::setw(10) << "p50"
+              << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+              << std::setw(10) << "max"
+              << "\n";
+    auto row = [](const PerformanceMonitor &m) {
+      std::cout << "  " << std::left << std::setw(18) << m.get_name()
+                << std::right << std::setw(10) << m.events_processed()
+                << std::setw(10) << m.get_p50_ns() << std::setw(10)
+                << m.get_p99_ns() << std::setw(10) << m.get_p999_ns()
+                << std::setw(10) << m.get_max_latency_ns() << "\n";
+    };
+    for (const auto &m : hops_) {
+      if (m.events_processed() > 0) {
+        row(m);
+      }
+    }
+    if (monitors_[END_TO_END].events_processed() > 0) {
+      row(monitors_[END_TO_END]);
+    }
+  }
+
+  /**
+   * @brief Appends component and per-hop metrics for a Prometheus scrape
+   */
+  void write_prometheus(PrometheusWriter &writer) const {
+    for (const auto &m : monitors_) {
+      if (m.events_processed() > 0) {
+        m.write_prometheus(writer, "hft_component", "component");
+      }
+    }
+    for (const auto &m : hops_) {
+      if (m.events_processed() > 0) {
+        m.write_prometheus(writer, "hft_hop", "hop");
+      }
+    }
+  }
+
+  /**
+   * @brief Opens hardware counters for every component (calling thread)
+   * @return true if counters are available
+   */
+  bool enable_hardware_counters() {
+    bool available = false;
+    for (auto &m : monitors_) {
+      available = m.enable_hardware_counters() || available;
+    }
+    return available;
   }
 
   void print_all_statistics() const {
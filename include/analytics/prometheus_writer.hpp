@@ -0,0 +1,194 @@
+#pragma once
+
+/**
+ * @file prometheus_writer.hpp
+ * @brief Prometheus text exposition format (version 0.0.4) builder
+ *
+ * Samples are grouped into metric families so each family's HELP/TYPE
+ * header is emitted exactly once, in first-seen order, regardless of the
+ * order in which collectors add samples:
+ *
+ *   PrometheusWriter w;
+ *   w.counter("hft_feed_messages_total", "Messages received", 42,
+ *             {{"feed", "nasdaq"}});
+ *   std::string body = w.str();
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class PrometheusWriter
+ * @brief Accumulates gauges, counters, summaries and histograms into one
+ *        scrape body
+ */
+class PrometheusWriter {
+public:
+  using Labels = std::vector<std::pair<std::string, std::string>>;
+
+  /**
+   * @brief Adds a gauge sample (value that can go up and down)
+   */
+  void gauge(const std::string &name, const std::string &help, double value,
+             const Labels &labels = {}) {
+    add_sample(family(name, help, "gauge"), name, labels, value);
+  }
+
+  /**
+   * @brief Adds a counter sample (monotonically increasing total)
+   */
+  void counter(const std::string &name, const std::string &help, double value,
+               const Labels &labels = {}) {
+    add_sample(family(name, help, "counter"), name, labels, value);
+  }
+
+  /**
+   * @brief Adds a summary: one sample per quantile plus _sum and _count
+   * @param quantiles (quantile, value) pairs, e.g. {0.99, 1250}
+   */
+  void summary(const std::string &name, const std::string &help,
+               const std::vector<std::pair<double, double>> &quantiles,
+               double sum, uint64_t count, const Labels &labels = {}) {
+    Family &fam = family(name, help, "summary");
+    for (const auto &q : quantiles) {
+      Labels with_quantile = labels;
+      with_quantile.emplace_back("quantile", format_value(q.first));
+      add_sample(fam, name, with_quantile, q.second);
+    }
+    add_sample(fam, name + "_sum", labels, sum);
+    add_sample(fam, name + "_count", labels, static_cast<double>(count));
+  }
+
+  /**
+   * @brief Adds a histogram from per-bucket (non-cumulative) counts
+   * @param buckets (upper bound, count in bucket) pairs, ascending bounds
+   *
+   * Emits cumulative _bucket samples including le="+Inf" (= count).
+   */
+  void histogram(const std::string &name, const std::string &help,
+                 const std::vector<std::pair<double, uint64_t>> &buckets,
+                 double sum, uint64_t count, const Labels &labels = {}) {
+    Family &fam = family(name, help, "histogram");
+    uint64_t cumulative = 0;
+    for (const auto &b : buckets) {
+      cumulative += b.second;
+      Labels with_le = labels;
+      with_le.emplace_back("le", format_value(b.first));
+      add_sample(fam, name + "_bucket", with_le,
+                 static_cast<double>(cumulative));
+    }
+    Labels with_inf = labels;
+    with_inf.emplace_back("le", "+Inf");
+    add_sample(fam, name + "_bucket", with_inf, static_cast<double>(count));
+    add_sample(fam, name + "_sum", labels, sum);
+    add_sample(fam, name + "_count", labels, static_cast<double>(count));
+  }
+
+  /**
+   * @brief Renders all families in exposition format
+   */
+  std::string str() const {
+    std::string out;
+    for (const auto &name : order_) {
+      const Family &fam = families_.at(name);
+      out += "# HELP " + name + " " + fam.help + "\n";
+      out += "# TYPE " + name + " " + fam.type + "\n";
+      for (const auto &sample : fam.samples) {
+        out += sample;
+      }
+    }
+    return out;
+  }
+
+  size_t family_count() const { return order_.size(); }
+
+  void clear() {
+    order_.clear();
+    families_.clear();
+  }
+
+  /**
+   * @brief Formats a sample value ("NaN", "+Inf" and "-Inf" per the spec)
+   */
+  static std::string format_value(double value) {
+    if (std::isnan(value)) {
+      return "NaN";
+    }
+    if (std::isinf(value)) {
+      return value > 0 ? "+Inf" : "-Inf";
+    }
+    char buf[32];
+    if (value == std::floor(value) && std::fabs(value) < 1e15) {
+      snprintf(buf, sizeof(buf), "%.0f", value);
+    } else {
+      snprintf(buf, sizeof(buf), "%.9g", value);
+    }
+    return buf;
+  }
+
+  /**
+   * @brief Escapes a label value (backslash, double quote, newline)
+   */
+  static std::string escape_label(const std::string &value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+      switch (c) {
+      case '\\':
+        out += "\\\\";
+        break;
+      case '"':
+        out += "\\\"";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      default:
+        out += c;
+      }
+    }
+    return out;
+  }
+
+private:
+  struct Family {
+    std::string help;
+    std::string type;
+    std::vector<std::string> samples;
+  };
+
+  Family &family(const std::string &name, const std::string &help,
+                 const std::string &type) {
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+      order_.push_back(name);
+      it = families_.emplace(name, Family{help, type, {}}).first;
+    }
+    return it->second;
+  }
+
+  static void add_sample(Family &fam, const std::string &sample_name,
+                         const Labels &labels, double value) {
+    std::string line = sample_name;
+    if (!labels.empty()) {
+      line += "{";
+      for (size_t i = 0; i < labels.size(); ++i) {
+        if (i > 0) {
+          line += ",";
+        }
+        line += labels[i].first + "=\"" + escape_label(labels[i].second) + "\"";
+      }
+      line += "}";
+    }
+    line += " " + format_value(value) + "\n";
+    fam.samples.push_back(std::move(line));
+  }
+
+  std::vector<std::string> order_;
+  std::unordered_map<std::string, Family> families_;
+};
@@ -0,0 +1,512 @@
+#pragma once
+
+/**
+ * @file trace_recorder.hpp
+ * @brief Per-thread span tracing with Chrome trace (Perfetto) export
+ *
+ * Aggregate timers say how long a stage takes on average; a trace says
+ * where one particular slow event spent its time as it crossed threads
+ * (feed -> aggregator queue -> book -> fill router -> analytics).
+ *
+ * Design:
+ * - Every thread lazily gets its own fixed-size ring of completed spans.
+ *   Recording is one TSC read at each end plus one 32-byte store: no
+ *   locks, no allocation, no shared cache lines.
+ * - Rings overwrite their oldest spans when full, so tracing can stay on
+ *   for a whole session and keep the most recent window.
+ * - A ring outlives its thread so its spans can still be exported, but
+ *   once max_rings are allocated a new thread reuses the ring of the
+ *   thread that exited longest ago, so thread churn does not grow memory.
+ * - Disabled tracing costs one relaxed load and a predictable branch per
+ *   span; defining HFT_DISABLE_TRACING compiles TRACE_SPAN out entirely.
+ * - Spans carry an event id; spans with the same id on different threads
+ *   are linked by flow arrows in the exported trace. Ids come from
+ *   next_trace_event_id() (unique per process): the aggregator stamps
+ *   one on each tick (FeedTick::trace_id) and the platform installs it
+ *   with TRACE_EVENT while the tick is applied, so book and fill-router
+ *   spans (which read current_trace_event()) join the tick's chain.
+ *
+ * Export while traced threads are running may catch a span mid-write;
+ * stop or pause them first for an exact dump.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "thread_config.hpp"
+
+/**
+ * @brief Raw trace clock: TSC on x86 (assumes an invariant TSC),
+ * steady_clock nanoseconds elsewhere
+ */
+inline uint64_t trace_timestamp() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+
+/**
+ * @brief Allocates a process-wide unique event id (never 0)
+ */
+inline uint64_t next_trace_event_id() {
+  static std::atomic<uint64_t> next{1};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Event id installed on the calling thread by TraceEventScope
+inline uint64_t &current_trace_event_slot() {
+  thread_local uint64_t event_id = 0;
+  return event_id;
+}
+
+/**
+ * @brief Event id of the work the calling thread is doing (0 = none)
+ */
+inline uint64_t current_trace_event() { return current_trace_event_slot(); }
+
+/**
+ * @struct TraceSpan
+ * @brief One completed span
+ */
+struct TraceSpan {
+  const char *name = nullptr; ///< Must be a string literal (not copied)
+  uint64_t begin = 0;         ///< trace_timestamp() at entry
+  uint64_t end = 0;           ///< trace_timestamp() at exit
+  uint64_t event_id = 0;      ///< 0 = not linked to other spans
+};
+
+/**
+ * @class TraceRing
+ * @brief Single-writer ring of completed spans for one thread
+ */
+class TraceRing {
+public:
+  TraceRing(size_t capacity, uint32_t tid, std::string thread_name)
+      : spans_(round_up_pow2(capacity)), mask_(spans_.size() - 1), tid_(tid),
+        thread_name_(std::move(thread_name)) {}
+
+  /**
+   * @brief Records a span (owning thread only)
+   */
+  void record(const char *name, uint64_t begin, uint64_t end,
+              uint64_t event_id) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    TraceSpan &span = spans_[head & mask_];
+    span.name = name;
+    span.begin = begin;
+    span.end = end;
+    span.event_id = event_id;
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Copies the retained spans, oldest first
+   */
+  std::vector<TraceSpan> snapshot() const {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    const uint64_t count = std::min<uint64_t>(head, spans_.size());
+    std::vector<TraceSpan> out;
+    out.reserve(count);
+    for (uint64_t i = head - count; i < head; ++i) {
+      out.push_back(spans_[i & mask_]);
+    }
+    return out;
+  }
+
+  /**
+   * @brief Spans recorded since the last clear
+   */
+  uint64_t recorded() const { return head_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Spans lost to wrap-around
+   */
+  uint64_t overwritten() const {
+    uint64_t head = recorded();
+    return head > spans_.size() ? head - spans_.size() : 0;
+  }
+
+  /**
+   * @brief Forgets all spans (only while the owner is not recording)
+   */
+  void clear() { head_.store(0, std::memory_order_release); }
+
+  /**
+   * @brief Hands an idle ring to a new thread (recorder lock held)
+   */
+  void reassign(uint32_t tid, std::string thread_name) {
+    clear();
+    tid_ = tid;
+    thread_name_ = std::move(thread_name);
+  }
+
+  size_t capacity() const { return spans_.size(); }
+  uint32_t tid() const { return tid_; }
+  const std::string &thread_name() const { return thread_name_; }
+
+private:
+  static size_t round_up_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  std::vector<TraceSpan> spans_;
+  size_t mask_;
+  alignas(64) std::atomic<uint64_t> head_{0};
+  uint32_t tid_;
+  std::string thread_name_;
+};
+
+/**
+ * @class TraceRecorder
+ * @brief Process-wide registry of per-thread trace rings
+ */
+class TraceRecorder {
+public:
+  static constexpr size_t DEFAULT_RING_CAPACITY = 1 << 16;
+  static constexpr size_t DEFAULT_MAX_RINGS = 64;
+
+  static TraceRecorder &instance() {
+    static TraceRecorder recorder;
+    return recorder;
+  }
+
+  /**
+   * @brief Fast check used by every span
+   */
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Starts recording
+   * @param ring_capacity Spans kept per thread (rings created from now on)
+   * @param max_rings Rings allocated before exited threads' rings are
+   *        reused (exceeded only while more threads are alive)
+   */
+  void enable(size_t ring_capacity = DEFAULT_RING_CAPACITY,
+              size_t max_rings = DEFAULT_MAX_RINGS) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_capacity_ = ring_capacity;
+    max_rings_ = max_rings;
+    if (!calibrated_) {
+      base_tsc_ = trace_timestamp();
+      base_ns_ = steady_ns();
+      calibrated_ = true;
+    }
+    enabled_.store(true, std::memory_order_release);
+  }
+
+  /**
+   * @brief Stops recording; retained spans stay available for export
+   */
+  void disable() { enabled_.store(false, std::memory_order_release); }
+
+  /**
+   * @brief Records a completed span on the calling thread's ring
+   */
+  void record(const char *name, uint64_t begin, uint64_t end,
+              uint64_t event_id) {
+    thread_ring().record(name, begin, end, event_id);
+  }
+
+  /**
+   * @brief Forgets all retained spans (traced threads must be idle)
+   */
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &ring : rings_) {
+      ring->clear();
+    }
+  }
+
+  /**
+   * @brief Spans currently retained across all threads
+   */
+  size_t span_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t n = 0;
+    for (const auto &ring : rings_) {
+      n += std::min<uint64_t>(ring->recorded(), ring->capacity());
+    }
+    return n;
+  }
+
+  /**
+   * @brief Number of rings allocated (threads with retained spans)
+   */
+  size_t thread_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rings_.size();
+  }
+
+  /**
+   * @brief Serializes all rings as Chrome trace event JSON
+   *
+   * Spans become complete ("X") events in microseconds; threads are
+   * named with metadata events; spans sharing an event id are chained
+   * with flow events in time order.
+   */
+  std::string to_chrome_json() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double ns_per_tick = calibration();
+
+    struct Linked {
+      uint64_t begin;
+      uint32_t tid;
+    };
+    std::map<uint64_t, std::vector<Linked>> flows;
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto sep = [&]() -> std::ostream & {
+      out << (first ? "\n" : ",\n");
+      first = false;
+      return out;
+    };
+
+    for (const auto &ring : rings_) {
+      sep() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+            << ring->tid() << ",\"args\":{\"name\":\""
+            << escape(ring->thread_name()) << "\"}}";
+
+      for (const TraceSpan &span : ring->snapshot()) {
+        if (!span.name) {
+          continue;
+        }
+        sep() << "{\"ph\":\"X\",\"cat\":\"hft\",\"name\":\"" << escape(span.name)
+              << "\",\"pid\":1,\"tid\":" << ring->tid()
+              << ",\"ts\":" << to_us(span.begin, ns_per_tick)
+              << ",\"dur\":" << duration_us(span, ns_per_tick)
+              << ",\"args\":{\"event_id\":" << span.event_id << "}}";
+        if (span.event_id != 0) {
+          flows[span.event_id].push_back({span.begin, ring->tid()});
+        }
+      }
+    }
+
+    for (auto &[event_id, linked] : flows) {
+      if (linked.size() < 2) {
+        continue;
+      }
+      std::sort(linked.begin(), linked.end(),
+                [](const Linked &a, const Linked &b) { return a.begin < b.begin; });
+      for (size_t i = 0; i < linked.size(); ++i) {
+        const char *phase = i == 0 ? "s" : (i + 1 == linked.size() ? "f" : "t");
+        sep() << "{\"ph\":\"" << phase << "\",\"cat\":\"flow\",\"name\":\"event\""
+              << ",\"id\":" << event_id << ",\"pid\":1,\"tid\":" << linked[i].tid
+              << ",\"ts\":" << to_us(linked[i].begin, ns_per_tick)
+              << (i + 1 == linked.size() ? ",\"bp\":\"e\"" : "") << "}";
+      }
+    }
+
+    out << "\n]}\n";
+    return out.str();
+  }
+
+  /**
+   * @brief Writes to_chrome_json() to a file (open in ui.perfetto.dev)
+   * @return Number of spans written
+   * @throws std::runtime_error if the file cannot be written
+   */
+  size_t export_chrome_json(const std::string &filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+      throw std::runtime_error("Could not open file: " + filename);
+    }
+    file << to_chrome_json();
+    return span_count();
+  }
+
+private:
+  TraceRecorder() = default;
+
+  /// Returns the thread's ring to the idle list when the thread exits
+  struct RingLease {
+    TraceRing *ring = nullptr;
+    ~RingLease() {
+      if (ring) {
+        TraceRecorder::instance().release_ring(ring);
+      }
+    }
+  };
+
+  TraceRing &thread_ring() {
+    thread_local RingLease lease;
+    if (!lease.ring) {
+      lease.ring = acquire_ring();
+    }
+    return *lease.ring;
+  }
+
+  TraceRing *acquire_ring() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t tid = next_tid_++;
+    std::string name = get_current_thread_name();
+    if (name.empty()) {
+      name = "thread-" + std::to_string(tid);
+    }
+    if (!idle_rings_.empty() && rings_.size() >= max_rings_) {
+      TraceRing *ring = idle_rings_.front(); // Exited longest ago
+      idle_rings_.pop_front();
+      ring->reassign(tid, std::move(name));
+      return ring;
+    }
+    rings_.push_back(std::make_unique<TraceRing>(ring_capacity_, tid, name));
+    return rings_.back().get();
+  }
+
+  void release_ring(TraceRing *ring) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_rings_.push_back(ring);
+  }
+
+  static uint64_t steady_ns() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+
+  /// Nanoseconds per trace tick, measured over the whole session
+  double calibration() const {
+#if defined(__x86_64__) || defined(__i386__)
+    const uint64_t tsc = trace_timestamp();
+    const uint64_t ns = steady_ns();
+    if (!calibrated_ || tsc <= base_tsc_ || ns <= base_ns_) {
+      return 1.0;
+    }
+    return static_cast<double>(ns - base_ns_) / static_cast<double>(tsc - base_tsc_);
+#else
+    return 1.0;
+#endif
+  }
+
+  double to_us(uint64_t tick, double ns_per_tick) const {
+    double ticks = tick >= base_tsc_ ? static_cast<double>(tick - base_tsc_)
+                                     : -static_cast<double>(base_tsc_ - tick);
+    return ticks * ns_per_tick / 1000.0;
+  }
+
+  static double duration_us(const TraceSpan &span, double ns_per_tick) {
+    uint64_t ticks = span.end >= span.begin ? span.end - span.begin : 0;
+    return static_cast<double>(ticks) * ns_per_tick / 1000.0;
+  }
+
+  static std::string escape(const std::string &s) {
+    std::string out;
+    for (char c : s) {
+      if (c == '"' || c == '\\') {
+        out += '\\';
+      }
+      out += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+    }
+    return out;
+  }
+
+  inline static std::atomic<bool> enabled_{false};
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<TraceRing>> rings_;
+  std::deque<TraceRing *> idle_rings_; // Rings of exited threads, oldest first
+  size_t ring_capacity_ = DEFAULT_RING_CAPACITY;
+  size_t max_rings_ = DEFAULT_MAX_RINGS;
+  uint32_t next_tid_ = 1;
+  bool calibrated_ = false;
+  uint64_t base_tsc_ = 0;
+  uint64_t base_ns_ = 0;
+};
+
+/**
+ * @class TraceScope
+ * @brief RAII span: records [construction, destruction) when tracing is on
+ */
+class TraceScope {
+public:
+  explicit TraceScope(const char *name, uint64_t event_id = 0)
+      : name_(TraceRecorder::enabled() ? name : nullptr), event_id_(event_id) {
+    if (name_) {
+      begin_ = trace_timestamp();
+    }
+  }
+
+  ~TraceScope() {
+    if (name_) {
+      TraceRecorder::instance().record(name_, begin_, trace_timestamp(),
+                                       event_id_);
+    }
+  }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+  const char *name_;
+  uint64_t event_id_;
+  uint64_t begin_ = 0;
+};
+
+/**
+ * @class TraceEventScope
+ * @brief Installs an event id for the calling thread (restored on exit)
+ *
+ * Lets code that does not see the event (the book, the fill router) tag
+ * its spans with it through current_trace_event().
+ */
+class TraceEventScope {
+public:
+  explicit TraceEventScope(uint64_t event_id)
+      : previous_(current_trace_event_slot()) {
+    current_trace_event_slot() = event_id;
+  }
+
+  ~TraceEventScope() { current_trace_event_slot() = previous_; }
+
+  TraceEventScope(const TraceEventScope &) = delete;
+  TraceEventScope &operator=(const TraceEventScope &) = delete;
+
+private:
+  uint64_t previous_;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Traces the enclosing scope: TRACE_SPAN("aggregator.enqueue", id);
+ * TRACE_EVENT(id) makes id the calling thread's current event for the
+ * rest of the scope.
+ */
+#if defined(HFT_DISABLE_TRACING)
+#define TRACE_SPAN(name, event_id) ((void)0)
+#define TRACE_EVENT(event_id) ((void)0)
+#else
+#define TRACE_SPAN(name, event_id)                                             \
+  TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name, event_id)
+#define TRACE_EVENT(event_id)                                                  \
+  TraceEventScope TRACE_CONCAT(trace_event_, __LINE__)(event_id)
+#endif
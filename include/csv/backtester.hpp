@@ -76,6 +76,7 @@ private:
     std::vector<MarketEvent> event_timeline_;
     SimpleImpactModel impact_model_;
     std::unordered_map<std::string, uint64_t> symbol_adv_;  ///< Per-symbol ADV
+    SymbolTable symbol_table_;  ///< Symbols interned while building the timeline
 
 public:
     /**
@@ -204,6 +205,7 @@ public:
      */
     void build_event_timeline(const std::string& csv_file) {
         event_timeline_.clear();
+        symbol_table_.clear();
 
         std::ifstream file(csv_file);
         if (!file.is_open()) {
@@ -242,6 +244,7 @@ public:
             event.volume = static_cast<uint64_t>(row.volume);
             event.type = MarketEventType::TRADE;  // Default to TRADE for simple CSV
 
+            symbol_table_.intern(event.symbol);
             event_timeline_.push_back(event);
         }
 
@@ -383,6 +386,14 @@ public:
         return event_timeline_;
     }
 
+    /**
+     * @brief Gets the symbol table built alongside the timeline
+     * @return Const reference to the interned symbols
+     */
+    const SymbolTable& get_symbol_table() const {
+        return symbol_table_;
+    }
+
     /**
      * @brief Gets number of events in timeline
      * @return Event count
@@ -549,6 +560,8 @@ public:
 
         TimePoint sim_start = Clock::now();
         uint64_t first_ts = symbol_events[0]->timestamp_ns;
+        SymbolId symbol_id = symbol_table_.find(symbol);
+        FixedOrderBuffer<ExecutionSimulator::MAX_CHILD_ORDERS_PER_TICK> orders;
 
         // Convert events to MarketData and feed to algorithm
         for (size_t i = 0; i < symbol_events.size() && !algo->is_complete(); ++i) {
@@ -561,14 +574,15 @@ public:
             md.ask_price = event->price * 1.0001;  // Estimate ask
             md.spread = md.ask_price - md.bid_price;
             md.total_volume = event->volume;
-            md.symbol = event->symbol;
+            md.symbol_id = symbol_id;
 
             // Convert nanosecond timestamp to time point
             auto elapsed_ns = event->timestamp_ns - first_ts;
             md.timestamp = sim_start + std::chrono::nanoseconds(elapsed_ns);
 
             // Get child orders from algorithm
-            auto orders = algo->on_market_data(md);
+            orders.clear();
+            algo->on_market_data(md, orders);
 
             // Simulate execution of orders
             for (auto& order : orders) {
@@ -641,7 +655,7 @@ public:
             md.ask_price = event.price * 1.0001;
             md.spread = md.ask_price - md.bid_price;
             md.total_volume = event.volume;
-            md.symbol = event.symbol;
+            md.symbol_id = symbol_table_.find(event.symbol);
 
             // Convert nanosecond timestamp to time point
             auto elapsed_ns = event.timestamp_ns - first_ts;
@@ -0,0 +1,382 @@
+#pragma once
+
+#include "market_events.hpp"
+#include "symbol_table.hpp"
+#include "volume_curve.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct VolumeCurveConfig
+ * @brief Session layout and build options for volume curves
+ */
+struct VolumeCurveConfig {
+    uint32_t session_start_seconds = 9 * 3600 + 30 * 60;  ///< 09:30 local time
+    uint32_t session_end_seconds = 16 * 3600;             ///< 16:00 local time
+    uint32_t bucket_seconds = 300;                        ///< 5-minute buckets
+    size_t num_threads = 0;                               ///< 0 = hardware concurrency
+};
+
+/**
+ * @class VolumeCurveService
+ * @brief Builds, caches and serves per-symbol intraday volume curves
+ *
+ * Curves are learned from a backtester event timeline. Trade volume is
+ * bucketed by local time of day for each (symbol, day). Each day is
+ * normalized to sum to one, and the days are averaged, so a heavy day
+ * does not dominate the shape. The timeline is split into contiguous
+ * chunks processed in parallel. Each worker keeps its own (symbol, day)
+ * accumulators, and a merge sums the days that straddle chunk edges.
+ *
+ * Curves are indexed by SymbolId, so find() is an array lookup. They
+ * can be saved to and loaded from a compact binary cache, which skips
+ * the rebuild when the history has not changed.
+ */
+class VolumeCurveService {
+public:
+    static constexpr uint32_t FILE_MAGIC = 0x56435256;  ///< "VCRV"
+    static constexpr uint32_t FILE_VERSION = 1;
+
+private:
+    /// Volume per bucket for one symbol on one day
+    struct DayVolume {
+        SymbolId symbol;
+        int64_t day;                  ///< Local midnight, seconds since epoch
+        std::vector<uint64_t> buckets;
+    };
+
+    VolumeCurveConfig config_;
+    SymbolTable symbols_;
+    std::vector<VolumeCurve> curves_;   ///< Indexed by SymbolId
+
+public:
+    explicit VolumeCurveService(const VolumeCurveConfig& config = VolumeCurveConfig())
+        : config_(config) {
+        if (config_.bucket_seconds == 0) config_.bucket_seconds = 1;
+        if (config_.session_end_seconds <= config_.session_start_seconds) {
+            config_.session_end_seconds = config_.session_start_seconds + config_.bucket_seconds;
+        }
+    }
+
+    /**
+     * @brief Builds curves for every symbol in a timeline
+     * @param timeline Events sorted by timestamp (MicrostructureBacktester::get_timeline())
+     * @param symbols Symbols interned for the timeline (get_symbol_table())
+     *
+     * Curve ids match the ids in symbols. Symbols with no trades inside
+     * the session get an empty curve.
+     */
+    void build(const std::vector<MarketEvent>& timeline, const SymbolTable& symbols) {
+        symbols_.clear();
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            symbols_.intern(symbols.name(static_cast<SymbolId>(i)));
+        }
+        curves_.assign(symbols_.size(), VolumeCurve());
+
+        const size_t n = timeline.size();
+        if (n == 0 || symbols_.size() == 0) return;
+
+        size_t threads = config_.num_threads > 0
+            ? config_.num_threads
+            : std::max<size_t>(1, std::thread::hardware_concurrency());
+        threads = std::min(threads, std::max<size_t>(1, n / 4096));
+
+        // Pass 1: per-chunk (symbol, day) bucket volumes
+        std::vector<std::vector<DayVolume>> partials(threads);
+        size_t per_thread = (n + threads - 1) / threads;
+        auto work = [&](size_t t) {
+            size_t begin = t * per_thread;
+            size_t end = std::min(n, begin + per_thread);
+            if (begin < end) {
+                accumulate(timeline, begin, end, partials[t]);
+            }
+        };
+
+        if (threads == 1) {
+            work(0);
+        } else {
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; ++t) {
+                workers.emplace_back(work, t);
+            }
+            for (auto& w : workers) {
+                w.join();
+            }
+        }
+
+        // Pass 2: merge days split across chunks, then average normalized days
+        std::unordered_map<uint64_t, size_t> index;
+        std::vector<DayVolume> days;
+        for (auto& part : partials) {
+            for (auto& dv : part) {
+                uint64_t key = day_key(dv.symbol, dv.day);
+                auto it = index.find(key);
+                if (it == index.end()) {
+                    index.emplace(key, days.size());
+                    days.push_back(std::move(dv));
+                } else {
+                    auto& into = days[it->second].buckets;
+                    for (size_t b = 0; b < into.size(); ++b) {
+                        into[b] += dv.buckets[b];
+                    }
+                }
+            }
+        }
+
+        const uint32_t num_buckets = bucket_count();
+        std::vector<std::vector<double>> shares(curves_.size());
+        for (const auto& dv : days) {
+            uint64_t total = 0;
+            for (uint64_t v : dv.buckets) total += v;
+            if (total == 0) continue;
+
+            auto& share = shares[dv.symbol];
+            if (share.empty()) share.assign(num_buckets, 0.0);
+            for (size_t b = 0; b < num_buckets; ++b) {
+                share[b] += static_cast<double>(dv.buckets[b]) / total;
+            }
+            curves_[dv.symbol].num_days++;
+        }
+
+        for (size_t s = 0; s < curves_.size(); ++s) {
+            auto& curve = curves_[s];
+            curve.session_start_seconds = config_.session_start_seconds;
+            curve.bucket_seconds = config_.bucket_seconds;
+            if (curve.num_days == 0) continue;
+
+            curve.num_buckets = num_buckets;
+            curve.cumulative.assign(num_buckets + 1, 0.0f);
+            double running = 0.0;
+            for (size_t b = 0; b < num_buckets; ++b) {
+                running += shares[s][b] / curve.num_days;
+                curve.cumulative[b + 1] = static_cast<float>(running);
+            }
+            curve.cumulative[num_buckets] = 1.0f;
+        }
+    }
+
+    /**
+     * @brief Gets the curve for a symbol id
+     * @return Curve, or nullptr if unknown or no history
+     */
+    const VolumeCurve* find(SymbolId id) const {
+        if (id >= curves_.size() || curves_[id].empty()) return nullptr;
+        return &curves_[id];
+    }
+
+    /**
+     * @brief Gets the curve for a symbol name
+     * @return Curve, or nullptr if unknown or no history
+     */
+    const VolumeCurve* find(const std::string& symbol) const {
+        return find(symbols_.find(symbol));
+    }
+
+    const SymbolTable& get_symbol_table() const { return symbols_; }
+    const VolumeCurveConfig& get_config() const { return config_; }
+    size_t size() const { return curves_.size(); }
+
+    /**
+     * @brief Writes all curves to a binary cache file
+     * @param filename Output path
+     * @throws std::runtime_error if the file cannot be written
+     *
+     * Layout (native endianness): magic, version, curve count, then per
+     * curve: name length (u16), name bytes, session start, bucket seconds,
+     * bucket count, day count (u32 each), cumulative (float x buckets+1).
+     */
+    void save(const std::string& filename) const {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file for writing: " + filename);
+        }
+
+        write_u32(file, FILE_MAGIC);
+        write_u32(file, FILE_VERSION);
+        write_u32(file, static_cast<uint32_t>(curves_.size()));
+
+        for (size_t s = 0; s < curves_.size(); ++s) {
+            const std::string& name = symbols_.name(static_cast<SymbolId>(s));
+            const auto& curve = curves_[s];
+            uint16_t len = static_cast<uint16_t>(std::min<size_t>(name.size(), 0xFFFF));
+            file.write(reinterpret_cast<const char*>(&len), sizeof(len));
+            file.write(name.data(), len);
+            write_u32(file, curve.session_start_seconds);
+            write_u32(file, curve.bucket_seconds);
+            write_u32(file, curve.empty() ? 0 : curve.num_buckets);
+            write_u32(file, curve.num_days);
+            if (!curve.empty()) {
+                file.write(reinterpret_cast<const char*>(curve.cumulative.data()),
+                           curve.cumulative.size() * sizeof(float));
+            }
+        }
+
+        if (!file) {
+            throw std::runtime_error("Failed writing volume curves: " + filename);
+        }
+    }
+
+    /**
+     * @brief Replaces all curves with those from a binary cache file
+     * @param filename Input path
+     * @throws std::runtime_error if the file is missing or malformed
+     */
+    void load(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file for reading: " + filename);
+        }
+
+        if (read_u32(file) != FILE_MAGIC || read_u32(file) != FILE_VERSION) {
+            throw std::runtime_error("Not a volume curve file: " + filename);
+        }
+
+        uint32_t count = read_u32(file);
+        SymbolTable symbols;
+        std::vector<VolumeCurve> curves(count);
+        for (uint32_t s = 0; s < count && file; ++s) {
+            uint16_t len = 0;
+            file.read(reinterpret_cast<char*>(&len), sizeof(len));
+            std::string name(len, '\0');
+            file.read(&name[0], len);
+            symbols.intern(name);
+
+            auto& curve = curves[s];
+            curve.session_start_seconds = read_u32(file);
+            curve.bucket_seconds = read_u32(file);
+            curve.num_buckets = read_u32(file);
+            curve.num_days = read_u32(file);
+            if (curve.num_buckets > 0) {
+                curve.cumulative.resize(curve.num_buckets + 1);
+                file.read(reinterpret_cast<char*>(curve.cumulative.data()),
+                          curve.cumulative.size() * sizeof(float));
+            }
+        }
+
+        if (!file) {
+            throw std::runtime_error("Truncated volume curve file: " + filename);
+        }
+
+        symbols_ = std::move(symbols);
+        curves_ = std::move(curves);
+    }
+
+    /**
+     * @brief Prints a summary of each curve
+     */
+    void print_summary() const {
+        std::cout << "\n=== Volume Curves ===\n";
+        for (size_t s = 0; s < curves_.size(); ++s) {
+            const auto& curve = curves_[s];
+            std::cout << "  " << symbols_.name(static_cast<SymbolId>(s)) << ": ";
+            if (curve.empty()) {
+                std::cout << "no history\n";
+                continue;
+            }
+            size_t peak = 0;
+            for (size_t b = 1; b < curve.num_buckets; ++b) {
+                if (curve.bucket_fraction(b) > curve.bucket_fraction(peak)) peak = b;
+            }
+            uint32_t peak_start = curve.session_start_seconds + peak * curve.bucket_seconds;
+            std::cout << curve.num_days << " days, " << curve.num_buckets
+                      << " buckets, peak " << peak_start / 3600 << ":"
+                      << (peak_start % 3600) / 60 / 10 << (peak_start % 3600) / 60 % 10
+                      << " (" << curve.bucket_fraction(peak) * 100.0 << "%)\n";
+        }
+    }
+
+private:
+    uint32_t bucket_count() const {
+        uint32_t span = config_.session_end_seconds - config_.session_start_seconds;
+        return (span + config_.bucket_seconds - 1) / config_.bucket_seconds;
+    }
+
+    static uint64_t day_key(SymbolId symbol, int64_t day) {
+        return (static_cast<uint64_t>(day) << 20) ^ symbol;
+    }
+
+    /**
+     * @brief Local midnight for a timestamp (backtester timestamps use mktime)
+     */
+    static int64_t local_midnight(time_t seconds) {
+        struct tm tm = {};
+        localtime_r(&seconds, &tm);
+        tm.tm_hour = 0;
+        tm.tm_min = 0;
+        tm.tm_sec = 0;
+        tm.tm_isdst = -1;
+        return static_cast<int64_t>(mktime(&tm));
+    }
+
+    void accumulate(const std::vector<MarketEvent>& timeline, size_t begin, size_t end,
+                    std::vector<DayVolume>& out) const {
+        const uint32_t num_buckets = bucket_count();
+        std::unordered_map<uint64_t, size_t> index;
+
+        // Local midnight is recomputed only when an event leaves the cached day
+        int64_t day_start = 0;
+        int64_t day_end = 0;
+
+        // Consecutive events are usually the same symbol
+        const std::string* last_name = nullptr;
+        SymbolId last_id = INVALID_SYMBOL_ID;
+
+        for (size_t i = begin; i < end; ++i) {
+            const auto& event = timeline[i];
+            if (event.type != MarketEventType::TRADE || event.volume == 0) continue;
+
+            int64_t seconds = static_cast<int64_t>(event.timestamp_ns / 1000000000ULL);
+            if (seconds < day_start || seconds >= day_end) {
+                day_start = local_midnight(static_cast<time_t>(seconds));
+                day_end = local_midnight(static_cast<time_t>(day_start + 36 * 3600));
+            }
+
+            int64_t second_of_day = seconds - day_start;
+            if (second_of_day < config_.session_start_seconds ||
+                second_of_day >= config_.session_end_seconds) {
+                continue;
+            }
+
+            if (!last_name || *last_name != event.symbol) {
+                last_name = &event.symbol;
+                last_id = symbols_.find(event.symbol);
+            }
+            if (last_id == INVALID_SYMBOL_ID) continue;
+
+            uint64_t key = day_key(last_id, day_start);
+            auto it = index.find(key);
+            size_t slot;
+            if (it == index.end()) {
+                slot = out.size();
+                index.emplace(key, slot);
+                out.push_back({last_id, day_start, std::vector<uint64_t>(num_buckets, 0)});
+            } else {
+                slot = it->second;
+            }
+
+            size_t bucket = static_cast<size_t>(
+                (second_of_day - config_.session_start_seconds) / config_.bucket_seconds);
+            out[slot].buckets[bucket] += event.volume;
+        }
+    }
+
+    static void write_u32(std::ofstream& file, uint32_t value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static uint32_t read_u32(std::ifstream& file) {
+        uint32_t value = 0;
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+};
@@ -0,0 +1,336 @@
+#pragma once
+
+#include "almgren_chriss_strategy.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct FrontierParams
+ * @brief One (lambda, sigma, eta, T) point on the efficient frontier
+ */
+struct FrontierParams {
+    double risk_aversion;       ///< Lambda
+    double volatility;          ///< Daily volatility (sigma)
+    double temporary_impact;    ///< Temporary impact coefficient (eta, clamped positive)
+    double horizon_minutes;     ///< Execution horizon T in minutes
+};
+
+/**
+ * @struct FrontierConfig
+ * @brief Order-level inputs shared by every frontier point
+ */
+struct FrontierConfig {
+    uint64_t target_quantity = 100000;   ///< Parent order size X
+    double adv = 1000000.0;              ///< Average daily volume
+    double permanent_impact = 0.1;       ///< Permanent impact coefficient (gamma)
+    size_t num_slices = 20;              ///< Slices per trajectory
+    size_t num_threads = 0;              ///< Worker threads (0 = hardware concurrency)
+    bool store_trajectories = false;     ///< Keep holdings per point (float)
+};
+
+/**
+ * @struct FrontierTable
+ * @brief Column-oriented efficient frontier results
+ *
+ * Row i corresponds to the i-th FrontierParams passed to solve().
+ * expected_cost_bps matches AlmgrenChrissStrategy::estimate_expected_cost()
+ * for the same parameters. cost_stdev_bps is the standard deviation of
+ * implementation shortfall from price risk,
+ * 1e4 * sigma * sqrt(dt * sum_k x_k^2) with x_k the holdings fraction.
+ */
+struct FrontierTable {
+    size_t num_slices = 0;
+    std::vector<double> risk_aversion;
+    std::vector<double> volatility;
+    std::vector<double> temporary_impact;
+    std::vector<double> horizon_minutes;
+    std::vector<double> expected_cost_bps;
+    std::vector<double> cost_stdev_bps;
+    std::vector<float> trajectories;   ///< size() x (num_slices + 1) when stored
+
+    size_t size() const { return expected_cost_bps.size(); }
+
+    /**
+     * @brief Gets the stored holdings trajectory of a row
+     * @param i Row index
+     * @return Pointer to num_slices + 1 holdings, or nullptr if not stored
+     */
+    const float* trajectory(size_t i) const {
+        if (trajectories.empty()) return nullptr;
+        return trajectories.data() + i * (num_slices + 1);
+    }
+
+    /**
+     * @brief Row minimizing expected cost + lambda_u * variance
+     * @param utility_lambda Risk aversion applied to the variance (bps^2)
+     * @return Row index
+     */
+    size_t best_index(double utility_lambda) const {
+        size_t best = 0;
+        double best_u = 0.0;
+        for (size_t i = 0; i < size(); ++i) {
+            double u = expected_cost_bps[i] +
+                       utility_lambda * cost_stdev_bps[i] * cost_stdev_bps[i];
+            if (i == 0 || u < best_u) {
+                best_u = u;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Prints the frontier as a table
+     * @param max_rows Maximum rows to print
+     */
+    void print(size_t max_rows = 20) const {
+        std::cout << "\n=== Almgren-Chriss Efficient Frontier ===\n";
+        std::cout << std::left
+                  << std::setw(12) << "Lambda"
+                  << std::setw(10) << "Sigma"
+                  << std::setw(10) << "Eta"
+                  << std::setw(10) << "T (min)"
+                  << std::setw(14) << "E[cost] bps"
+                  << std::setw(14) << "Stdev bps"
+                  << "\n";
+        std::cout << std::string(70, '-') << "\n";
+
+        for (size_t i = 0; i < size() && i < max_rows; ++i) {
+            std::cout << std::left
+                      << std::setw(12) << std::scientific << std::setprecision(2)
+                      << risk_aversion[i]
+                      << std::setw(10) << std::fixed << std::setprecision(4) << volatility[i]
+                      << std::setw(10) << temporary_impact[i]
+                      << std::setw(10) << std::setprecision(1) << horizon_minutes[i]
+                      << std::setw(14) << std::setprecision(3) << expected_cost_bps[i]
+                      << std::setw(14) << cost_stdev_bps[i]
+                      << "\n";
+        }
+        if (size() > max_rows) {
+            std::cout << "  ... " << (size() - max_rows) << " more rows\n";
+        }
+    }
+};
+
+/**
+ * @class AlmgrenChrissFrontier
+ * @brief Batch Almgren-Chriss trajectory and expected-cost solver
+ *
+ * Solves many (lambda, sigma, eta, T) points at once for one parent
+ * order. Points are processed in lanes of BATCH in structure-of-arrays
+ * form: the holdings recurrence of almgren_chriss_holdings() runs across
+ * lanes in lockstep, with no per-slice transcendental calls and no
+ * cross-lane dependency, so the inner loop auto-vectorizes under
+ * -O3 -march=native. Blocks of lanes are split across threads.
+ */
+class AlmgrenChrissFrontier {
+public:
+    static constexpr size_t BATCH = 32;   ///< Points solved in lockstep
+
+private:
+    FrontierConfig config_;
+
+public:
+    explicit AlmgrenChrissFrontier(const FrontierConfig& config = FrontierConfig())
+        : config_(config) {
+        if (config_.num_slices == 0) config_.num_slices = 1;
+    }
+
+    /**
+     * @brief Builds the cartesian product of parameter grids
+     */
+    static std::vector<FrontierParams> make_grid(const std::vector<double>& lambdas,
+                                                 const std::vector<double>& sigmas,
+                                                 const std::vector<double>& etas,
+                                                 const std::vector<double>& horizons_minutes) {
+        std::vector<FrontierParams> grid;
+        grid.reserve(lambdas.size() * sigmas.size() * etas.size() * horizons_minutes.size());
+        for (double T : horizons_minutes) {
+            for (double eta : etas) {
+                for (double sigma : sigmas) {
+                    for (double lambda : lambdas) {
+                        grid.push_back({lambda, sigma, eta, T});
+                    }
+                }
+            }
+        }
+        return grid;
+    }
+
+    /**
+     * @brief Log-spaced values, e.g. for a lambda sweep
+     */
+    static std::vector<double> log_space(double lo, double hi, size_t n) {
+        std::vector<double> v(n);
+        if (n == 1) {
+            v[0] = lo;
+            return v;
+        }
+        double step = std::log(hi / lo) / (n - 1);
+        for (size_t i = 0; i < n; ++i) {
+            v[i] = lo * std::exp(step * i);
+        }
+        return v;
+    }
+
+    /**
+     * @brief Solves the frontier for every parameter point
+     * @param points Parameter tuples
+     * @return Table with one row per point, in input order
+     */
+    FrontierTable solve(const std::vector<FrontierParams>& points) const {
+        const size_t n = points.size();
+        const size_t N = config_.num_slices;
+
+        FrontierTable table;
+        table.num_slices = N;
+        table.risk_aversion.resize(n);
+        table.volatility.resize(n);
+        table.temporary_impact.resize(n);
+        table.horizon_minutes.resize(n);
+        table.expected_cost_bps.resize(n);
+        table.cost_stdev_bps.resize(n);
+        if (config_.store_trajectories) {
+            table.trajectories.resize(n * (N + 1));
+        }
+        if (n == 0) return table;
+
+        // Split whole batches across threads
+        size_t num_batches = (n + BATCH - 1) / BATCH;
+        size_t threads = config_.num_threads > 0
+            ? config_.num_threads
+            : std::max<size_t>(1, std::thread::hardware_concurrency());
+        threads = std::min(threads, std::max<size_t>(1, num_batches / 4));
+
+        if (threads <= 1) {
+            solve_range(points, 0, n, table);
+            return table;
+        }
+
+        std::vector<std::thread> workers;
+        size_t per_thread = (num_batches + threads - 1) / threads;
+        for (size_t t = 0; t < threads; ++t) {
+            size_t begin = t * per_thread * BATCH;
+            size_t end = std::min(n, (t + 1) * per_thread * BATCH);
+            if (begin >= end) break;
+            workers.emplace_back([this, &points, &table, begin, end]() {
+                solve_range(points, begin, end, table);
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        return table;
+    }
+
+    const FrontierConfig& get_config() const { return config_; }
+
+private:
+    void solve_range(const std::vector<FrontierParams>& points, size_t begin, size_t end,
+                     FrontierTable& table) const {
+        const size_t N = config_.num_slices;
+        const double adv = config_.adv;
+        const double inv_n = 1.0 / static_cast<double>(N);
+
+        // Per-thread scratch, reused for every batch
+        std::vector<double> holdings((N + 1) * BATCH);
+        std::vector<double> column(N + 1);
+        std::vector<uint64_t> sizes(N);
+
+        alignas(64) double u[BATCH];
+        alignas(64) double r[BATCH];
+        alignas(64) double w[BATCH];
+        alignas(64) double inv[BATCH];
+        alignas(64) double linear[BATCH];
+        alignas(64) double sum_sq[BATCH];
+        double lambda[BATCH];
+        double sigma[BATCH];
+        double eta[BATCH];
+        double tau[BATCH];
+
+        for (size_t base = begin; base < end; base += BATCH) {
+            size_t lanes = std::min(BATCH, end - base);
+
+            // Lane setup: two exp() calls per point
+            for (size_t j = 0; j < BATCH; ++j) {
+                u[j] = 1.0;
+                r[j] = 1.0;
+                w[j] = 0.0;
+                inv[j] = 1.0;
+                linear[j] = 0.0;
+                sum_sq[j] = 0.0;
+                if (j >= lanes) continue;
+
+                const auto& p = points[base + j];
+                lambda[j] = std::max(1e-10, p.risk_aversion);  // Same clamps as the strategy
+                sigma[j] = std::max(0.001, p.volatility);
+                eta[j] = std::max(1e-10, p.temporary_impact);
+                tau[j] = (p.horizon_minutes * 60.0) / 86400.0;
+
+                double kappa_tilde = std::sqrt(lambda[j] * sigma[j] * sigma[j] / (eta[j] / adv));
+                double kt = kappa_tilde * tau[j];
+                if (kt > 1e-12) {
+                    r[j] = std::exp(-kappa_tilde * (tau[j] / N));
+                    w[j] = std::exp(-2.0 * kt);
+                    inv[j] = 1.0 / (1.0 - w[j]);
+                } else {
+                    linear[j] = 1.0;
+                }
+            }
+
+            // Holdings recurrence across all lanes (vectorizable)
+            for (size_t i = 0; i <= N; ++i) {
+                double lin = 1.0 - static_cast<double>(i) * inv_n;
+                double* row = holdings.data() + i * BATCH;
+                for (size_t j = 0; j < BATCH; ++j) {
+                    double h = u[j] > 0.0 ? (u[j] - w[j] / u[j]) * inv[j] : 0.0;
+                    h = linear[j] != 0.0 ? lin : h;
+                    row[j] = h;
+                    u[j] *= r[j];
+                }
+            }
+            for (size_t j = 0; j < BATCH; ++j) {
+                holdings[N * BATCH + j] = 0.0;
+            }
+            for (size_t i = 1; i <= N; ++i) {
+                const double* row = holdings.data() + i * BATCH;
+                for (size_t j = 0; j < BATCH; ++j) {
+                    sum_sq[j] += row[j] * row[j];
+                }
+            }
+
+            // Per-point integer slicing and cost (shared with the strategy)
+            for (size_t j = 0; j < lanes; ++j) {
+                size_t idx = base + j;
+                for (size_t i = 0; i <= N; ++i) {
+                    column[i] = holdings[i * BATCH + j];
+                }
+                almgren_chriss_slice_sizes(column.data(), N, config_.target_quantity,
+                                           sizes.data());
+
+                table.risk_aversion[idx] = lambda[j];
+                table.volatility[idx] = sigma[j];
+                table.temporary_impact[idx] = eta[j];
+                table.horizon_minutes[idx] = points[idx].horizon_minutes;
+                table.expected_cost_bps[idx] = almgren_chriss_expected_cost_bps(
+                    sizes.data(), N, config_.target_quantity, config_.permanent_impact,
+                    eta[j], lambda[j], sigma[j], adv, tau[j]);
+                table.cost_stdev_bps[idx] =
+                    10000.0 * sigma[j] * std::sqrt((tau[j] / N) * sum_sq[j]);
+
+                if (!table.trajectories.empty()) {
+                    float* out = table.trajectories.data() + idx * (N + 1);
+                    for (size_t i = 0; i <= N; ++i) {
+                        out[i] = static_cast<float>(column[i]);
+                    }
+                }
+            }
+        }
+    }
+};
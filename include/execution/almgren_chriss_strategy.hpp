@@ -10,6 +10,109 @@
 #include <iostream>
 #include <vector>
 
+/**
+ * @brief Computes the Almgren-Chriss optimal holdings trajectory
+ * @param kappa_tilde Urgency parameter sqrt(lambda * sigma^2 / eta)
+ * @param tau Execution horizon in days
+ * @param num_slices Number of slices N
+ * @param out Output array of N + 1 holdings fractions (1.0 down to 0.0)
+ *
+ * Evaluates x(t) = sinh(k * (T - t)) / sinh(k * T) without calling sinh
+ * per slice. Dividing numerator and denominator by e^(kT) gives
+ *   x(t_i) = (u_i - w / u_i) / (1 - w),  u_i = e^(-k t_i),  w = e^(-2kT)
+ * where u_i follows the recurrence u_(i+1) = u_i * e^(-k dt). This needs
+ * only two exp() calls per trajectory, cannot overflow for large k*T,
+ * and is the same arithmetic the batched frontier solver vectorizes.
+ */
+inline void almgren_chriss_holdings(double kappa_tilde, double tau,
+                                    size_t num_slices, double* out) {
+    double dt = tau / num_slices;
+    double kt = kappa_tilde * tau;
+
+    if (!(kt > 1e-12)) {
+        // Fallback to linear when urgency vanishes
+        for (size_t i = 0; i <= num_slices; ++i) {
+            out[i] = 1.0 - static_cast<double>(i) / num_slices;
+        }
+        return;
+    }
+
+    double r = std::exp(-kappa_tilde * dt);
+    double w = std::exp(-2.0 * kt);
+    double inv = 1.0 / (1.0 - w);
+    double u = 1.0;
+    for (size_t i = 0; i <= num_slices; ++i) {
+        out[i] = u > 0.0 ? (u - w / u) * inv : 0.0;  // w <= u^2, so 0 once u underflows
+        u *= r;
+    }
+    out[num_slices] = 0.0;
+}
+
+/**
+ * @brief Converts a holdings trajectory into integer slice sizes
+ * @param holdings N + 1 holdings fractions
+ * @param num_slices Number of slices N
+ * @param target_qty Total quantity to allocate
+ * @param out Output array of N slice sizes summing to target_qty
+ */
+inline void almgren_chriss_slice_sizes(const double* holdings, size_t num_slices,
+                                       uint64_t target_qty, uint64_t* out) {
+    uint64_t allocated = 0;
+    for (size_t i = 0; i < num_slices; ++i) {
+        double fraction = holdings[i] - holdings[i + 1];
+        out[i] = static_cast<uint64_t>(target_qty * fraction);
+        allocated += out[i];
+    }
+
+    // Handle rounding errors - add remainder to first slice
+    if (allocated < target_qty) {
+        out[0] += (target_qty - allocated);
+    } else if (allocated > target_qty) {
+        // Subtract excess from largest slice
+        auto max_it = std::max_element(out, out + num_slices);
+        if (*max_it >= (allocated - target_qty)) {
+            *max_it -= (allocated - target_qty);
+        }
+    }
+}
+
+/**
+ * @brief Expected execution cost for a set of slice sizes (in basis points)
+ * @param slice_sizes N slice sizes
+ * @param num_slices Number of slices N
+ * @param target_qty Total quantity X
+ * @param gamma Permanent impact coefficient
+ * @param eta Temporary impact coefficient
+ * @param lambda Risk aversion
+ * @param sigma Daily volatility
+ * @param adv Average daily volume
+ * @param tau Execution horizon in days
+ * @return Expected cost in bps
+ */
+inline double almgren_chriss_expected_cost_bps(const uint64_t* slice_sizes, size_t num_slices,
+                                               uint64_t target_qty, double gamma, double eta,
+                                               double lambda, double sigma, double adv,
+                                               double tau) {
+    // Simplified cost estimate:
+    // Cost = permanent_impact * X + temporary_impact * sum(trades^2) + timing_cost
+    double X = static_cast<double>(target_qty);
+    double perm_cost = gamma * X / adv;
+
+    double temp_cost = 0.0;
+    for (size_t i = 0; i < num_slices; ++i) {
+        double n = static_cast<double>(slice_sizes[i]) / adv;
+        temp_cost += eta * n * n;
+    }
+
+    // Timing risk cost (simplified)
+    double timing_cost = 0.5 * lambda * sigma * sigma *
+                        X * X * tau / (num_slices * adv * adv);
+
+    // Convert to basis points (approximate)
+    double total_cost = perm_cost + temp_cost + timing_cost;
+    return total_cost * 10000.0;  // Convert to bps
+}
+
 /**
  * @class AlmgrenChrissStrategy
  * @brief Optimal execution strategy based on Almgren-Chriss model
@@ -121,7 +224,7 @@ public:
 
         // Extract parameters from impact model
         permanent_impact_ = impact_model.get_permanent_coef();
-        temporary_impact_ = impact_model.get_temporary_coef();
+        temporary_impact_ = std::max(1e-10, impact_model.get_temporary_coef());
         adv_ = impact_model.get_adv();
     }
 
@@ -144,19 +247,19 @@ public:
 
         // Extract parameters from impact model
         permanent_impact_ = impact_model.get_permanent_coef();
-        temporary_impact_ = impact_model.get_temporary_coef();
+        temporary_impact_ = std::max(1e-10, impact_model.get_temporary_coef());
         adv_ = impact_model.get_adv();
     }
 
     /**
      * @brief Sets market impact parameters
      * @param permanent Permanent impact coefficient (gamma)
-     * @param temporary Temporary impact coefficient (eta)
+     * @param temporary Temporary impact coefficient (eta, clamped positive)
      * @param adv_volume Average daily volume
      */
     void set_market_impact(double permanent, double temporary, double adv_volume) {
         permanent_impact_ = permanent;
-        temporary_impact_ = temporary;
+        temporary_impact_ = std::max(1e-10, temporary);
         adv_ = adv_volume;
         trajectory_computed_ = false;  // Recompute trajectory
     }
@@ -201,64 +304,32 @@ public:
         slice_sizes_.resize(num_slices_);
 
         // Time per slice in units of day (assuming duration is intraday)
-        double tau = (duration_.count() / 1000.0) / 86400.0;  // Convert ms to days
-        double dt = tau / num_slices_;  // Time per slice
-
-        // Almgren-Chriss parameters
-        // Kappa = permanent impact rate scaled by ADV
-        double kappa = permanent_impact_ / adv_;
+        double tau = horizon_days();
 
         // Calculate optimal urgency parameter (kappa_tilde)
         // kappa_tilde = sqrt(lambda * sigma^2 / eta)
         double kappa_tilde = std::sqrt(risk_aversion_ * volatility_ * volatility_ /
                                        (temporary_impact_ / adv_));
 
-        // Calculate sinh and cosh terms
-        double sinh_term = std::sinh(kappa_tilde * tau);
-        double cosh_term = std::cosh(kappa_tilde * tau);
-
         // Compute optimal trajectory: x(t) = X * sinh(kappa_tilde * (T - t)) / sinh(kappa_tilde * T)
         // where x(t) is remaining shares at time t, X is initial shares
-        for (size_t i = 0; i <= num_slices_; ++i) {
-            double t = i * dt;
-            double time_remaining = tau - t;
-
-            if (sinh_term > 0) {
-                trajectory_[i] = std::sinh(kappa_tilde * time_remaining) / sinh_term;
-            } else {
-                // Fallback to linear if numerical issues
-                trajectory_[i] = time_remaining / tau;
-            }
-        }
+        almgren_chriss_holdings(kappa_tilde, tau, num_slices_, trajectory_.data());
 
         // Compute slice sizes from trajectory (differences)
-        uint64_t allocated = 0;
-        for (size_t i = 0; i < num_slices_; ++i) {
-            double fraction = trajectory_[i] - trajectory_[i + 1];
-            slice_sizes_[i] = static_cast<uint64_t>(target_quantity_ * fraction);
-            allocated += slice_sizes_[i];
-        }
-
-        // Handle rounding errors - add remainder to first slice
-        if (allocated < target_quantity_) {
-            slice_sizes_[0] += (target_quantity_ - allocated);
-        } else if (allocated > target_quantity_) {
-            // Subtract excess from largest slice
-            auto max_it = std::max_element(slice_sizes_.begin(), slice_sizes_.end());
-            if (*max_it >= (allocated - target_quantity_)) {
-                *max_it -= (allocated - target_quantity_);
-            }
-        }
+        almgren_chriss_slice_sizes(trajectory_.data(), num_slices_, target_quantity_,
+                                   slice_sizes_.data());
 
         trajectory_computed_ = true;
     }
 
+    using ExecutionAlgorithm::compute_child_orders;
+
     /**
      * @brief Computes child orders for Almgren-Chriss execution
      * @param data Current market data
-     * @return Vector of orders (0 or 1 orders)
+     * @param sink Receives 0 or 1 slice orders
      */
-    std::vector<Order> compute_child_orders(const MarketData& data) override {
+    void compute_child_orders(const MarketData& data, OrderSink& sink) override {
         // Compute trajectory on first call
         if (!trajectory_computed_) {
             compute_trajectory();
@@ -271,21 +342,22 @@ public:
 
         // Check if it's time for next slice
         if (!is_time_for_slice(data.timestamp)) {
-            return {};
+            return;
         }
 
         // Calculate slice size
         uint64_t slice_size = calculate_slice_size();
         if (slice_size == 0) {
-            return {};
+            return;
         }
 
         // Update state
         current_slice_++;
         last_slice_time_ = data.timestamp;
+        arm_slice_timer();
 
         // Create order
-        return {create_slice_order(data, static_cast<int>(slice_size))};
+        sink.emit(create_slice_order(data, static_cast<int>(slice_size)));
     }
 
     /**
@@ -297,6 +369,15 @@ public:
         trajectory_computed_ = false;
     }
 
+    /**
+     * @brief Creates an independent copy of this strategy
+     */
+    std::unique_ptr<ExecutionAlgorithm> clone() const override {
+        auto copy = std::make_unique<AlmgrenChrissStrategy>(*this);
+        copy->attach_slice_timer(nullptr);
+        return copy;
+    }
+
     /**
      * @brief Gets the number of slices
      * @return Total slice count
@@ -313,6 +394,17 @@ public:
         return current_slice_;
     }
 
+    /**
+     * @brief Gets the deadline of the next slice
+     * @return Time the next slice becomes due (first slice is due immediately)
+     */
+    TimePoint next_wakeup_time() const override {
+        if (current_slice_ == 0) {
+            return TimePoint::min();
+        }
+        return last_slice_time_ + slice_interval_;
+    }
+
     /**
      * @brief Gets the optimal trajectory
      * @return Vector of optimal holdings [0,1] at each time point
@@ -370,25 +462,9 @@ public:
             return 0.0;
         }
 
-        // Simplified cost estimate:
-        // Cost = permanent_impact * X + temporary_impact * sum(trades^2) + timing_cost
-        double X = static_cast<double>(target_quantity_);
-        double perm_cost = permanent_impact_ * X / adv_;
-
-        double temp_cost = 0.0;
-        for (const auto& size : slice_sizes_) {
-            double n = static_cast<double>(size) / adv_;
-            temp_cost += temporary_impact_ * n * n;
-        }
-
-        // Timing risk cost (simplified)
-        double tau = (duration_.count() / 1000.0) / 86400.0;
-        double timing_cost = 0.5 * risk_aversion_ * volatility_ * volatility_ *
-                            X * X * tau / (num_slices_ * adv_ * adv_);
-
-        // Convert to basis points (approximate)
-        double total_cost = perm_cost + temp_cost + timing_cost;
-        return total_cost * 10000.0;  // Convert to bps
+        return almgren_chriss_expected_cost_bps(
+            slice_sizes_.data(), num_slices_, target_quantity_, permanent_impact_,
+            temporary_impact_, risk_aversion_, volatility_, adv_, horizon_days());
     }
 
     /**
@@ -423,6 +499,14 @@ public:
         }
     }
 
+    /**
+     * @brief Gets the execution horizon in days
+     * @return Duration expressed in trading-model days
+     */
+    double horizon_days() const {
+        return (duration_.count() / 1000.0) / 86400.0;  // Convert ms to days
+    }
+
 private:
     /**
      * @brief Checks if it's time to execute the next slice
@@ -435,6 +519,11 @@ private:
             return true;
         }
 
+        // Deadline tracked by the shared timer wheel
+        if (slice_timer_) {
+            return slice_due_;
+        }
+
         // Check if interval has elapsed since last slice
         auto elapsed_since_last = std::chrono::duration_cast<Duration>(
             current_time - last_slice_time_);
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "market_impact_calibration.hpp"
+#include "order_sink.hpp"
+#include "symbol_table.hpp"
+#include "timer_wheel.hpp"
 
 // Include order book headers (local copies)
 #include "fill.hpp"
@@ -9,9 +12,13 @@
 
 #include <algorithm>
 #include <chrono>
+#include <climits>
 #include <cmath>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 /**
@@ -19,7 +26,9 @@
  * @brief Represents current market state for execution decisions
  *
  * Contains the current market snapshot including price, spread,
- * and volume information needed by execution algorithms.
+ * and volume information needed by execution algorithms. Kept trivially
+ * copyable (symbols are carried as interned SymbolIds, see SymbolTable)
+ * so ticks can be copied through queues and buffers without allocation.
  */
 struct MarketData {
     double price;           ///< Current mid price or last trade price
@@ -30,12 +39,12 @@ struct MarketData {
     uint64_t ask_volume;    ///< Volume at best ask
     uint64_t total_volume;  ///< Total traded volume
     TimePoint timestamp;    ///< Time of this market snapshot
-    std::string symbol;     ///< Trading symbol
+    SymbolId symbol_id;     ///< Interned trading symbol
 
     MarketData()
         : price(0.0), bid_price(0.0), ask_price(0.0), spread(0.0),
           bid_volume(0), ask_volume(0), total_volume(0),
-          timestamp(Clock::now()) {}
+          timestamp(Clock::now()), symbol_id(INVALID_SYMBOL_ID) {}
 
     /**
      * @brief Creates MarketData from bid/ask prices
@@ -68,6 +77,9 @@ struct MarketData {
     }
 };
 
+static_assert(std::is_trivially_copyable<MarketData>::value,
+              "MarketData must stay trivially copyable");
+
 /**
  * @struct ExecutionReport
  * @brief Report generated after execution algorithm completes
@@ -113,19 +125,27 @@ struct ExecutionReport {
  *
  * Provides the framework for implementing execution strategies like
  * TWAP, VWAP, and Almgren-Chriss. Subclasses implement compute_child_orders()
- * to define their specific slicing logic.
+ * to define their specific slicing logic, preferably the OrderSink overload
+ * so that the per-tick path stays allocation-free.
  *
  * Usage:
  *   1. Create algorithm instance with target quantity
- *   2. Feed market data via on_market_data()
- *   3. Execute returned orders and report fills via on_fill()
+ *   2. Feed market data via on_market_data(data, sink)
+ *   3. Execute emitted orders and report fills via on_fill()
  *   4. Generate report when complete via generate_report()
+ *
+ * Slice timing is polled from market data timestamps by default. After
+ * attach_slice_timer(), the algorithm instead registers each next-slice
+ * deadline with a shared TimerWheel and only checks a flag set by the
+ * wheel's callback, so the driver must advance the wheel to each update's
+ * time before calling on_market_data().
  */
-class ExecutionAlgorithm {
+class ExecutionAlgorithm : public TimerHandler {
 protected:
     std::string strategy_name_ = "ExecutionAlgorithm";
     int account_id_ = 1;
     int next_order_id_ = 1;
+    int order_id_limit_ = INT_MAX;  ///< One past the last assignable id
 
     // Execution state
     uint64_t target_quantity_ = 0;
@@ -143,6 +163,11 @@ protected:
     // Order tracking
     size_t orders_generated_ = 0;
 
+    // Slice scheduling via a shared timer wheel (optional)
+    TimerWheel* slice_timer_ = nullptr;
+    uint32_t slice_timer_generation_ = 0;  ///< Invalidates stale timers
+    bool slice_due_ = true;
+
 public:
     /**
      * @brief Default constructor
@@ -158,9 +183,13 @@ public:
         : target_quantity_(target_qty), is_buy_(is_buy) {}
 
     /**
-     * @brief Virtual destructor
+     * @brief Virtual destructor; cancels any armed slice timer
      */
-    virtual ~ExecutionAlgorithm() = default;
+    virtual ~ExecutionAlgorithm() {
+        if (slice_timer_) {
+            slice_timer_->cancel(this);
+        }
+    }
 
     /**
      * @brief Sets the account ID for generated orders
@@ -173,28 +202,34 @@ public:
     /**
      * @brief Gets the next order ID and increments counter
      * @return Next order ID
+     * @throws std::length_error if the id range is exhausted
      */
     int get_next_order_id() {
+        if (next_order_id_ >= order_id_limit_) {
+            throw std::length_error(strategy_name_ + ": child order id range exhausted");
+        }
         return next_order_id_++;
     }
 
     /**
      * @brief Sets the starting order ID
      * @param id Starting order ID
+     * @param limit One past the last ID the algorithm may assign
      */
-    void set_starting_order_id(int id) {
+    void set_starting_order_id(int id, int limit = INT_MAX) {
         next_order_id_ = id;
+        order_id_limit_ = limit;
     }
 
     /**
-     * @brief Processes market data and generates child orders
+     * @brief Processes market data and emits child orders into a sink
      * @param data Current market state
-     * @return Vector of orders to execute (may be empty)
+     * @param sink Destination for child orders
      *
      * This method records the arrival price on first call, checks
      * if execution is complete, and delegates to compute_child_orders().
      */
-    virtual std::vector<Order> on_market_data(const MarketData& data) {
+    virtual void on_market_data(const MarketData& data, OrderSink& sink) {
         // Record start time and arrival price
         if (!started_) {
             started_ = true;
@@ -204,22 +239,52 @@ public:
 
         // Check if complete
         if (is_complete()) {
-            return {};
+            return;
         }
 
         // Delegate to subclass
-        return compute_child_orders(data);
+        compute_child_orders(data, sink);
     }
 
+    /**
+     * @brief Processes market data and generates child orders
+     * @param data Current market state
+     * @return Vector of orders to execute (may be empty)
+     *
+     * Convenience wrapper over the OrderSink overload; allocates a
+     * vector per call, so prefer the sink overload on hot paths.
+     */
+    std::vector<Order> on_market_data(const MarketData& data) {
+        std::vector<Order> orders;
+        VectorOrderSink sink(orders);
+        on_market_data(data, sink);
+        return orders;
+    }
+
+    /**
+     * @brief Computes child orders based on market data
+     * @param data Current market state
+     * @param sink Destination for child orders
+     *
+     * Must be implemented by subclasses to define their specific
+     * slicing and timing logic.
+     */
+    virtual void compute_child_orders(const MarketData& data, OrderSink& sink) = 0;
+
     /**
      * @brief Computes child orders based on market data
      * @param data Current market state
      * @return Vector of orders to execute
      *
-     * Subclasses must implement this method to define their
-     * specific slicing and timing logic.
+     * Convenience wrapper over the OrderSink overload (not a customization
+     * point); allocates a vector per call.
      */
-    virtual std::vector<Order> compute_child_orders(const MarketData& data) = 0;
+    std::vector<Order> compute_child_orders(const MarketData& data) {
+        std::vector<Order> orders;
+        VectorOrderSink sink(orders);
+        compute_child_orders(data, sink);
+        return orders;
+    }
 
     /**
      * @brief Processes a fill notification
@@ -268,6 +333,62 @@ public:
         return strategy_name_;
     }
 
+    /**
+     * @brief Gets the execution direction
+     * @return true for buy execution, false for sell
+     */
+    bool is_buy() const {
+        return is_buy_;
+    }
+
+    /**
+     * @brief Gets the earliest time the algorithm may emit orders again
+     * @return Next wake-up deadline; TimePoint::min() means every update
+     *
+     * Schedulers such as ExecutionEngine use this to skip algorithms with
+     * no slice due instead of feeding them every market data update.
+     */
+    virtual TimePoint next_wakeup_time() const {
+        return TimePoint::min();
+    }
+
+    /**
+     * @brief Registers slice deadlines with a shared timer wheel
+     * @param wheel Timer wheel driven by the caller, or nullptr to go
+     *        back to polling market data timestamps
+     *
+     * Timers armed on the previous wheel are cancelled. The wheel must
+     * outlive the algorithm or be detached first.
+     */
+    void attach_slice_timer(TimerWheel* wheel) {
+        if (slice_timer_) {
+            slice_timer_->cancel(this);
+        }
+        slice_timer_ = wheel;
+        slice_timer_generation_++;
+        slice_due_ = true;
+        if (slice_timer_ && next_wakeup_time() != TimePoint::min()) {
+            arm_slice_timer();
+        }
+    }
+
+    /**
+     * @brief Gets the attached slice timer wheel
+     * @return Timer wheel, or nullptr when polling
+     */
+    TimerWheel* get_slice_timer() const {
+        return slice_timer_;
+    }
+
+    /**
+     * @brief Timer wheel callback marking the next slice as due
+     */
+    void on_timer(uint32_t id, uint64_t /*now_ns*/) override {
+        if (id == slice_timer_generation_) {
+            slice_due_ = true;
+        }
+    }
+
     /**
      * @brief Gets the arrival price
      * @return Price when execution started
@@ -371,6 +492,20 @@ public:
         started_ = false;
         my_fills_.clear();
         orders_generated_ = 0;
+        slice_timer_generation_++;
+        slice_due_ = true;
+    }
+
+    /**
+     * @brief Creates an independent copy of this algorithm
+     * @return Copy with the same configuration and state, detached from
+     *         any slice timer, or nullptr if the algorithm cannot be cloned
+     *
+     * Used to give each worker thread its own instance, e.g. by
+     * MonteCarloEngine. Algorithms are expected to override this.
+     */
+    virtual std::unique_ptr<ExecutionAlgorithm> clone() const {
+        return nullptr;
     }
 
     /**
@@ -385,6 +520,17 @@ public:
     }
 
 protected:
+    /**
+     * @brief Schedules the next_wakeup_time() deadline on the slice timer
+     *
+     * Subclasses call this after emitting a slice. No-op when polling.
+     */
+    void arm_slice_timer() {
+        if (!slice_timer_) return;
+        slice_due_ = false;
+        slice_timer_->schedule(this, ++slice_timer_generation_, next_wakeup_time());
+    }
+
     /**
      * @brief Creates a limit order
      * @param price Limit price
@@ -0,0 +1,504 @@
+#pragma once
+
+#include "execution_algorithm.hpp"
+#include "order_sink.hpp"
+#include "spsc_queue.hpp"
+#include "symbol_table.hpp"
+#include "timer_wheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct ExecutionEngineConfig
+ * @brief Configuration for ExecutionEngine and ShardedExecutionEngine
+ */
+struct ExecutionEngineConfig {
+    uint64_t wheel_resolution_ns = 1000000;   ///< Timer wheel tick (1ms)
+    size_t queue_capacity = 65536;            ///< Per-shard event queue (sharded only)
+};
+
+/**
+ * @class ExecutionEngine
+ * @brief Multiplexes many parent orders over a shared market data stream
+ *
+ * Owns a set of ExecutionAlgorithm instances ("parents"), indexes them by
+ * symbol, and keeps one TimerWheel per symbol keyed on each parent's
+ * next_wakeup_time(). A market data update for a symbol advances only
+ * that symbol's wheel and dispatches only the parents whose slice is due,
+ * so per-update cost scales with due slices rather than total parents.
+ *
+ * Child order ids are partitioned per parent: parent p emits ids in
+ * [(p + 1) * ORDER_ID_STRIDE, (p + 2) * ORDER_ID_STRIDE), which lets
+ * on_fill() route a fill back to its parent without a lookup table. A
+ * parent that runs out of ids fails (see num_failed()) instead of
+ * spilling into the next parent's range; the engine keeps running.
+ *
+ * Not thread-safe; see ShardedExecutionEngine for multi-threaded use.
+ */
+class ExecutionEngine {
+public:
+    using ParentId = uint32_t;
+
+    /// Child order ids reserved per parent
+    static constexpr int ORDER_ID_STRIDE = 1 << 12;
+
+    /// Largest number of parents addressable with int order ids
+    static constexpr ParentId MAX_PARENTS =
+        static_cast<ParentId>(INT_MAX / ORDER_ID_STRIDE - 1);
+
+    static constexpr ParentId INVALID_PARENT = 0xFFFFFFFFu;
+
+private:
+    struct ParentSlot {
+        std::unique_ptr<ExecutionAlgorithm> algo;
+        SymbolId symbol;
+        bool active;
+        bool failed = false;  ///< Child order id range exhausted
+    };
+
+    struct SymbolSlot {
+        std::vector<ParentId> parents;   ///< Local parent indices
+        TimerWheel wheel;                ///< Keyed on local parent index
+
+        explicit SymbolSlot(uint64_t resolution_ns)
+            : wheel(resolution_ns) {}
+    };
+
+    ExecutionEngineConfig config_;
+    ParentId first_parent_id_;
+    std::vector<ParentSlot> parents_;
+    std::vector<std::unique_ptr<SymbolSlot>> symbols_;  ///< Indexed by SymbolId
+    size_t active_parents_ = 0;
+    size_t failed_parents_ = 0;
+    uint64_t dispatch_count_ = 0;
+
+public:
+    /**
+     * @brief Constructor
+     * @param config Engine configuration
+     * @param first_parent_id Id assigned to the first parent (used by
+     *        ShardedExecutionEngine to give shards disjoint id ranges)
+     */
+    explicit ExecutionEngine(const ExecutionEngineConfig& config = ExecutionEngineConfig(),
+                             ParentId first_parent_id = 0)
+        : config_(config), first_parent_id_(first_parent_id) {}
+
+    ExecutionEngine(const ExecutionEngine&) = delete;
+    ExecutionEngine& operator=(const ExecutionEngine&) = delete;
+
+    /**
+     * @brief Adds a parent order
+     * @param algo Algorithm driving the parent (ownership transferred)
+     * @param symbol Symbol the parent trades
+     * @return Parent id
+     *
+     * Overrides the algorithm's starting order id so that its child
+     * orders fall in this parent's id range.
+     */
+    ParentId add_parent(std::unique_ptr<ExecutionAlgorithm> algo, SymbolId symbol) {
+        if (!algo) {
+            throw std::invalid_argument("ExecutionEngine: null algorithm");
+        }
+        if (symbol == INVALID_SYMBOL_ID) {
+            throw std::invalid_argument("ExecutionEngine: invalid symbol id");
+        }
+
+        ParentId local = static_cast<ParentId>(parents_.size());
+        ParentId id = first_parent_id_ + local;
+        if (id >= MAX_PARENTS) {
+            throw std::length_error("ExecutionEngine: parent id space exhausted");
+        }
+
+        const int first_order_id = static_cast<int>((id + 1) * ORDER_ID_STRIDE);
+        algo->set_starting_order_id(first_order_id, first_order_id + ORDER_ID_STRIDE);
+
+        if (symbol >= symbols_.size()) {
+            symbols_.resize(symbol + 1);
+        }
+        if (!symbols_[symbol]) {
+            symbols_[symbol] = std::make_unique<SymbolSlot>(config_.wheel_resolution_ns);
+        }
+
+        auto& slot = *symbols_[symbol];
+        slot.parents.push_back(local);
+        slot.wheel.schedule(local, to_timer_ns(algo->next_wakeup_time()));
+
+        bool active = !algo->is_complete();
+        if (active) active_parents_++;
+        parents_.push_back({std::move(algo), symbol, active});
+        return id;
+    }
+
+    /**
+     * @brief Dispatches a market data update to the parents that are due
+     * @param data Market data (routed by data.symbol_id)
+     * @param sink Destination for child orders
+     * @return Number of parents dispatched
+     */
+    size_t on_market_data(const MarketData& data, OrderSink& sink) {
+        if (data.symbol_id >= symbols_.size() || !symbols_[data.symbol_id]) {
+            return 0;
+        }
+
+        auto& slot = *symbols_[data.symbol_id];
+        size_t dispatched = 0;
+
+        slot.wheel.advance(to_timer_ns(data.timestamp), [&](TimerWheel::TimerId local) {
+            auto& parent = parents_[local];
+            if (!parent.active) return;
+
+            dispatched++;
+            try {
+                parent.algo->on_market_data(data, sink);
+            } catch (const std::length_error&) {
+                // Child ids exhausted: retire this parent, not the process
+                parent.failed = true;
+                failed_parents_++;
+                deactivate(parent);
+                return;
+            }
+
+            if (parent.algo->is_complete()) {
+                deactivate(parent);
+                return;
+            }
+            slot.wheel.schedule(local, to_timer_ns(parent.algo->next_wakeup_time()));
+        });
+
+        dispatch_count_ += dispatched;
+        return dispatched;
+    }
+
+    /**
+     * @brief Routes a fill to the parent that owns the child order
+     * @param fill Fill for a child order emitted by this engine
+     * @return true if a parent accepted the fill
+     */
+    bool on_fill(const Fill& fill) {
+        ParentId local = local_parent_of(fill.buy_order_id);
+        if (local == INVALID_PARENT || !parents_[local].algo->is_buy()) {
+            local = local_parent_of(fill.sell_order_id);
+            if (local == INVALID_PARENT || parents_[local].algo->is_buy()) {
+                return false;
+            }
+        }
+
+        auto& parent = parents_[local];
+        parent.algo->on_fill(fill);
+        if (parent.active && parent.algo->is_complete()) {
+            deactivate(parent);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Maps a child order id to its parent id
+     * @param order_id Child order id
+     * @return Parent id, or INVALID_PARENT if outside any parent range
+     */
+    static ParentId parent_of_order(int order_id) {
+        if (order_id < ORDER_ID_STRIDE) return INVALID_PARENT;
+        return static_cast<ParentId>(order_id / ORDER_ID_STRIDE - 1);
+    }
+
+    /**
+     * @brief Gets a parent's algorithm
+     * @param id Parent id
+     * @return Algorithm, or nullptr if the id is not owned by this engine
+     */
+    ExecutionAlgorithm* get_parent(ParentId id) {
+        if (id < first_parent_id_ || id - first_parent_id_ >= parents_.size()) {
+            return nullptr;
+        }
+        return parents_[id - first_parent_id_].algo.get();
+    }
+
+    const ExecutionAlgorithm* get_parent(ParentId id) const {
+        return const_cast<ExecutionEngine*>(this)->get_parent(id);
+    }
+
+    /**
+     * @brief Gets the parents trading a symbol
+     * @param symbol Symbol id
+     * @return Number of parents registered for the symbol
+     */
+    size_t num_parents_for_symbol(SymbolId symbol) const {
+        if (symbol >= symbols_.size() || !symbols_[symbol]) return 0;
+        return symbols_[symbol]->parents.size();
+    }
+
+    size_t num_parents() const { return parents_.size(); }
+
+    /**
+     * @brief Number of parents that have not yet completed
+     */
+    size_t num_active() const { return active_parents_; }
+
+    /**
+     * @brief Number of parents retired after exhausting their child order ids
+     */
+    size_t num_failed() const { return failed_parents_; }
+
+    bool is_failed(ParentId id) const {
+        return id >= first_parent_id_ && id - first_parent_id_ < parents_.size() &&
+               parents_[id - first_parent_id_].failed;
+    }
+
+    /**
+     * @brief Total parent dispatches since construction
+     */
+    uint64_t get_dispatch_count() const { return dispatch_count_; }
+
+    ParentId get_first_parent_id() const { return first_parent_id_; }
+
+private:
+    ParentId local_parent_of(int order_id) const {
+        ParentId id = parent_of_order(order_id);
+        if (id == INVALID_PARENT || id < first_parent_id_ ||
+            id - first_parent_id_ >= parents_.size()) {
+            return INVALID_PARENT;
+        }
+        return id - first_parent_id_;
+    }
+
+    void deactivate(ParentSlot& parent) {
+        parent.active = false;
+        active_parents_--;
+    }
+};
+
+/**
+ * @class ShardedExecutionEngine
+ * @brief Runs ExecutionEngine shards on worker threads, partitioned by symbol
+ *
+ * Symbol s is owned by shard (s % num_shards). Each shard has its own
+ * engine, SPSC event queue, worker thread and OrderSink, so shards share
+ * no mutable state. publish() and publish_fill() must be called from a
+ * single producer thread.
+ *
+ * Usage:
+ *   1. add_parent() for every parent order
+ *   2. set_shard_sink() for every shard (the sink runs on that shard's thread)
+ *   3. start(), then publish() market data and publish_fill() fills
+ *   4. stop() drains the queues and joins the workers
+ */
+class ShardedExecutionEngine {
+public:
+    using ParentId = ExecutionEngine::ParentId;
+
+private:
+    struct ShardEvent {
+        enum class Kind : uint8_t { MARKET_DATA, FILL };
+
+        Kind kind = Kind::MARKET_DATA;
+        MarketData data;            ///< Market data, or fill timestamp
+        int buy_order_id = 0;
+        int sell_order_id = 0;
+        double fill_price = 0.0;
+        int fill_quantity = 0;
+    };
+
+    struct Shard {
+        ExecutionEngine engine;
+        SPSCQueue<ShardEvent> queue;
+        OrderSink* sink = nullptr;
+        std::thread worker;
+        std::atomic<uint64_t> events_processed{0};
+
+        Shard(const ExecutionEngineConfig& config, ParentId first_parent_id)
+            : engine(config, first_parent_id), queue(config.queue_capacity) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    ParentId parents_per_shard_;
+    std::atomic<bool> running_{false};
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_shards Number of worker threads
+     * @param config Per-shard engine configuration
+     */
+    explicit ShardedExecutionEngine(size_t num_shards,
+                                    const ExecutionEngineConfig& config = ExecutionEngineConfig()) {
+        if (num_shards == 0) num_shards = 1;
+        parents_per_shard_ = static_cast<ParentId>(ExecutionEngine::MAX_PARENTS / num_shards);
+        for (size_t i = 0; i < num_shards; ++i) {
+            shards_.push_back(std::make_unique<Shard>(
+                config, static_cast<ParentId>(i * parents_per_shard_)));
+        }
+    }
+
+    ~ShardedExecutionEngine() {
+        stop();
+    }
+
+    ShardedExecutionEngine(const ShardedExecutionEngine&) = delete;
+    ShardedExecutionEngine& operator=(const ShardedExecutionEngine&) = delete;
+
+    /**
+     * @brief Adds a parent order to the shard owning its symbol
+     * @return Globally unique parent id
+     *
+     * Must be called before start().
+     */
+    ParentId add_parent(std::unique_ptr<ExecutionAlgorithm> algo, SymbolId symbol) {
+        if (running_.load(std::memory_order_relaxed)) {
+            throw std::logic_error("ShardedExecutionEngine: add_parent after start");
+        }
+        auto& shard = *shards_[shard_for_symbol(symbol)];
+        if (shard.engine.num_parents() >= parents_per_shard_) {
+            throw std::length_error("ShardedExecutionEngine: shard parent range exhausted");
+        }
+        return shard.engine.add_parent(std::move(algo), symbol);
+    }
+
+    /**
+     * @brief Sets the sink receiving a shard's child orders
+     * @param shard Shard index
+     * @param sink Sink invoked from the shard's worker thread
+     */
+    void set_shard_sink(size_t shard, OrderSink* sink) {
+        shards_.at(shard)->sink = sink;
+    }
+
+    /**
+     * @brief Starts one worker thread per shard
+     */
+    void start() {
+        for (const auto& shard : shards_) {
+            if (!shard->sink) {
+                throw std::logic_error("ShardedExecutionEngine: shard sink not set");
+            }
+        }
+        if (running_.exchange(true)) return;
+
+        for (auto& shard : shards_) {
+            Shard* s = shard.get();
+            s->worker = std::thread([this, s]() { worker_loop(*s); });
+        }
+    }
+
+    /**
+     * @brief Stops the workers after draining queued events
+     */
+    void stop() {
+        if (!running_.exchange(false)) return;
+        for (auto& shard : shards_) {
+            if (shard->worker.joinable()) {
+                shard->worker.join();
+            }
+        }
+    }
+
+    /**
+     * @brief Publishes market data to the shard owning its symbol
+     * @param data Market data update
+     * @return false if the shard queue is full
+     */
+    bool publish(const MarketData& data) {
+        ShardEvent event;
+        event.data = data;
+        return shards_[shard_for_symbol(data.symbol_id)]->queue.push(event);
+    }
+
+    /**
+     * @brief Publishes a fill to the shard owning the child order
+     * @param fill Fill for a child order emitted by this engine
+     * @return false if the fill maps to no shard or the queue is full
+     */
+    bool publish_fill(const Fill& fill) {
+        size_t shard = shard_for_order(fill.buy_order_id);
+        if (shard >= shards_.size()) {
+            shard = shard_for_order(fill.sell_order_id);
+            if (shard >= shards_.size()) return false;
+        }
+
+        ShardEvent event;
+        event.kind = ShardEvent::Kind::FILL;
+        event.data.timestamp = fill.timestamp;
+        event.buy_order_id = fill.buy_order_id;
+        event.sell_order_id = fill.sell_order_id;
+        event.fill_price = fill.price;
+        event.fill_quantity = fill.quantity;
+        return shards_[shard]->queue.push(event);
+    }
+
+    size_t num_shards() const { return shards_.size(); }
+
+    size_t shard_for_symbol(SymbolId symbol) const {
+        return symbol % shards_.size();
+    }
+
+    /**
+     * @brief Gets a shard's engine (inspect only while stopped)
+     */
+    const ExecutionEngine& get_shard_engine(size_t shard) const {
+        return shards_.at(shard)->engine;
+    }
+
+    /**
+     * @brief Total parents that have not yet completed (call while stopped)
+     */
+    size_t num_active() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) total += shard->engine.num_active();
+        return total;
+    }
+
+    /**
+     * @brief Total parents retired after exhausting their child order ids
+     */
+    size_t num_failed() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) total += shard->engine.num_failed();
+        return total;
+    }
+
+    /**
+     * @brief Events processed by a shard
+     */
+    uint64_t get_events_processed(size_t shard) const {
+        return shards_.at(shard)->events_processed.load(std::memory_order_relaxed);
+    }
+
+private:
+    size_t shard_for_order(int order_id) const {
+        ParentId id = ExecutionEngine::parent_of_order(order_id);
+        if (id == ExecutionEngine::INVALID_PARENT) return shards_.size();
+        return id / parents_per_shard_;
+    }
+
+    void worker_loop(Shard& shard) {
+        while (true) {
+            auto event = shard.queue.pop();
+            if (!event) {
+                if (running_.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                // An event pushed before stop() may have landed after the
+                // empty pop above; drain it before exiting
+                event = shard.queue.pop();
+                if (!event) break;
+            }
+
+            if (event->kind == ShardEvent::Kind::MARKET_DATA) {
+                shard.engine.on_market_data(event->data, *shard.sink);
+            } else {
+                Fill fill(event->buy_order_id, event->sell_order_id,
+                          event->fill_price, event->fill_quantity);
+                fill.timestamp = event->data.timestamp;
+                shard.engine.on_fill(fill);
+            }
+            shard.events_processed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "counter_rng.hpp"
 #include "execution_algorithm.hpp"
 #include "market_impact_calibration.hpp"
 #include "microstructure_order_book.hpp"
+#include "simulation_collector.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -10,6 +12,7 @@
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <random>
 #include <vector>
 
@@ -27,22 +30,33 @@ struct SimulationConfig {
     double fill_probability = 0.8;    ///< Probability of fill for limit orders
     bool apply_market_impact = true;   ///< Whether to model market impact
     unsigned int random_seed = 42;     ///< Random seed for reproducibility
+    uint64_t path_id = 0;              ///< Monte Carlo path (selects the RNG streams)
+    bool use_slice_timer = false;      ///< Drive slice timing from a TimerWheel
+    bool record_price_path = false;    ///< Store every tick in SimulationResult::price_path
+    bool record_fills = false;         ///< Store every fill in SimulationResult::fills
 };
 
 /**
  * @struct SimulationResult
  * @brief Results from running an execution simulation
+ *
+ * stats is aggregated online and is always populated. price_path and
+ * fills are only filled when SimulationConfig::record_price_path /
+ * record_fills are set; otherwise memory stays flat however long the
+ * run is.
  */
 struct SimulationResult {
     ExecutionReport report;
-    std::vector<MarketData> price_path;     ///< Market data history
-    std::vector<Fill> fills;                ///< All fills
+    ExecutionStats stats;                   ///< Online aggregates for the run
+    std::vector<MarketData> price_path;     ///< Market data history (opt-in)
+    std::vector<Fill> fills;                ///< All fills (opt-in)
     double realized_impact_bps = 0.0;       ///< Actual price move during execution
     double predicted_impact_bps = 0.0;      ///< Model-predicted impact
     bool completed = false;                  ///< Whether execution completed
 
     void print() const {
         report.print();
+        stats.print();
         std::cout << "  Realized impact: " << realized_impact_bps << " bps\n";
         std::cout << "  Predicted impact: " << predicted_impact_bps << " bps\n";
         std::cout << "  Completed: " << (completed ? "Yes" : "No") << "\n";
@@ -61,10 +75,15 @@ struct SimulationResult {
  * - Performance measurement
  */
 class ExecutionSimulator {
+public:
+    /// Upper bound on child orders an algorithm may emit per tick
+    static constexpr size_t MAX_CHILD_ORDERS_PER_TICK = 16;
+
 private:
     SimulationConfig config_;
     MarketImpactModel impact_model_;
-    std::mt19937 rng_;
+    PhiloxRng price_rng_;   ///< Price shocks, stream 2 * path_id
+    PhiloxRng fill_rng_;    ///< Limit fill draws, stream 2 * path_id + 1
 
     // Simulation state
     double current_price_ = 0.0;
@@ -79,7 +98,7 @@ public:
      * @param config Simulation configuration
      */
     explicit ExecutionSimulator(const SimulationConfig& config = SimulationConfig())
-        : config_(config), rng_(config.random_seed) {
+        : config_(config) {
         reset();
     }
 
@@ -90,7 +109,7 @@ public:
      */
     ExecutionSimulator(const MarketImpactModel& model,
                        const SimulationConfig& config = SimulationConfig())
-        : config_(config), impact_model_(model), rng_(config.random_seed) {
+        : config_(config), impact_model_(model) {
         reset();
     }
 
@@ -102,7 +121,23 @@ public:
         update_quotes();
         cumulative_volume_ = 0;
         current_time_ = Clock::now();
-        rng_.seed(config_.random_seed);
+        price_rng_.seed(config_.random_seed, 2 * config_.path_id);
+        fill_rng_.seed(config_.random_seed, 2 * config_.path_id + 1);
+    }
+
+    /**
+     * @brief Selects the Monte Carlo path simulated by the next run
+     * @param path_id Path index
+     *
+     * Each path draws price shocks and fill decisions from its own
+     * counter-based streams, so a path reproduces exactly regardless of
+     * which thread runs it. Price and fill streams are separate, so
+     * algorithms compared on the same path see the same price shocks
+     * even when they consume different numbers of fill draws.
+     */
+    void set_path(uint64_t path_id) {
+        config_.path_id = path_id;
+        reset();
     }
 
     /**
@@ -126,10 +161,12 @@ public:
      * @brief Runs a simulation for an execution algorithm
      * @param algo Execution algorithm to test
      * @param duration_ms Simulation duration in milliseconds
+     * @param collector Optional observer of every tick and fill
      * @return SimulationResult with performance metrics
      */
     SimulationResult run_simulation(ExecutionAlgorithm& algo,
-                                    std::chrono::milliseconds duration_ms) {
+                                    std::chrono::milliseconds duration_ms,
+                                    SimulationCollector* collector = nullptr) {
         reset();
         algo.reset();
 
@@ -139,6 +176,15 @@ public:
         // Calculate time step
         auto tick_duration = std::chrono::milliseconds(1000 / config_.ticks_per_second);
         int num_ticks = static_cast<int>(duration_ms.count() * config_.ticks_per_second / 1000);
+        if (config_.record_price_path) {
+            result.price_path.reserve(static_cast<size_t>(std::max(num_ticks, 0)));
+        }
+
+        // Reused every tick so the loop does not allocate for orders
+        FixedOrderBuffer<MAX_CHILD_ORDERS_PER_TICK> orders;
+
+        TimerWheel slice_timer;
+        begin_run(algo, slice_timer, collector);
 
         // Run simulation
         for (int tick = 0; tick < num_ticks && !algo.is_complete(); ++tick) {
@@ -148,31 +194,13 @@ public:
             // Simulate price movement
             simulate_price_tick();
 
-            // Generate market data
+            // Generate market data and let the algorithm trade on it
             MarketData data = get_current_market_data();
-            result.price_path.push_back(data);
-
-            // Get orders from algorithm
-            auto orders = algo.on_market_data(data);
-
-            // Simulate order execution
-            for (auto& order : orders) {
-                auto fills = simulate_order_execution(order, data);
-                for (auto& fill : fills) {
-                    algo.on_fill(fill);
-                    result.fills.push_back(fill);
-
-                    // Apply market impact
-                    if (config_.apply_market_impact) {
-                        apply_market_impact(fill.quantity);
-                    }
-                }
-            }
+            process_tick(algo, data, slice_timer, orders, result, collector,
+                         config_.apply_market_impact);
         }
 
-        // Generate report
-        result.report = algo.generate_report();
-        result.completed = algo.is_complete();
+        end_run(algo, result, collector);
 
         // Calculate realized impact
         result.realized_impact_bps =
@@ -189,14 +217,15 @@ public:
      * @brief Runs simulation with custom market data sequence
      * @param algo Execution algorithm to test
      * @param market_data Sequence of market data points
+     * @param collector Optional observer of every tick and fill
      * @return SimulationResult with performance metrics
      */
     SimulationResult run_simulation(ExecutionAlgorithm& algo,
-                                    const std::vector<MarketData>& market_data) {
+                                    const std::vector<MarketData>& market_data,
+                                    SimulationCollector* collector = nullptr) {
         algo.reset();
 
         SimulationResult result;
-        result.price_path = market_data;
 
         if (market_data.empty()) {
             return result;
@@ -204,6 +233,14 @@ public:
 
         auto start_price = market_data.front().price;
         current_price_ = start_price;
+        if (config_.record_price_path) {
+            result.price_path.reserve(market_data.size());
+        }
+
+        FixedOrderBuffer<MAX_CHILD_ORDERS_PER_TICK> orders;
+
+        TimerWheel slice_timer;
+        begin_run(algo, slice_timer, collector);
 
         // Process each market data point
         for (const auto& data : market_data) {
@@ -212,22 +249,11 @@ public:
             current_price_ = data.price;
             current_time_ = data.timestamp;
 
-            // Get orders from algorithm
-            auto orders = algo.on_market_data(data);
-
-            // Simulate order execution
-            for (auto& order : orders) {
-                auto fills = simulate_order_execution(order, data);
-                for (auto& fill : fills) {
-                    algo.on_fill(fill);
-                    result.fills.push_back(fill);
-                }
-            }
+            // Replayed prices are fixed, so fills do not move them
+            process_tick(algo, data, slice_timer, orders, result, collector, false);
         }
 
-        // Generate report
-        result.report = algo.generate_report();
-        result.completed = algo.is_complete();
+        end_run(algo, result, collector);
 
         // Calculate realized impact
         if (!market_data.empty()) {
@@ -327,6 +353,81 @@ public:
     }
 
 private:
+    /**
+     * @brief Prepares the algorithm and collector for a run
+     */
+    void begin_run(ExecutionAlgorithm& algo, TimerWheel& slice_timer,
+                   SimulationCollector* collector) {
+        if (config_.use_slice_timer) {
+            algo.attach_slice_timer(&slice_timer);
+        }
+        if (collector) {
+            collector->on_start(algo);
+        }
+    }
+
+    /**
+     * @brief Feeds one market data update to the algorithm and executes its orders
+     */
+    void process_tick(ExecutionAlgorithm& algo, const MarketData& data,
+                      TimerWheel& slice_timer,
+                      FixedOrderBuffer<MAX_CHILD_ORDERS_PER_TICK>& orders,
+                      SimulationResult& result, SimulationCollector* collector,
+                      bool apply_impact) {
+        result.stats.on_tick(data);
+        if (config_.record_price_path) {
+            result.price_path.push_back(data);
+        }
+        if (collector) {
+            collector->on_tick(data);
+        }
+
+        if (config_.use_slice_timer) {
+            slice_timer.advance_to(data.timestamp);
+        }
+
+        // Get orders from algorithm
+        orders.clear();
+        algo.on_market_data(data, orders);
+
+        // Simulate order execution
+        for (auto& order : orders) {
+            auto fill = simulate_order_execution(order, data);
+            if (!fill) continue;
+
+            algo.on_fill(*fill);
+            result.stats.on_fill(*fill, data, algo.is_buy());
+            if (config_.record_fills) {
+                result.fills.push_back(*fill);
+            }
+            if (collector) {
+                collector->on_fill(*fill, data);
+            }
+
+            // Apply market impact
+            if (apply_impact) {
+                apply_market_impact(fill->quantity);
+            }
+        }
+    }
+
+    /**
+     * @brief Detaches the run and fills in the report
+     */
+    void end_run(ExecutionAlgorithm& algo, SimulationResult& result,
+                 SimulationCollector* collector) {
+        if (config_.use_slice_timer) {
+            algo.attach_slice_timer(nullptr);
+        }
+        if (collector) {
+            collector->on_finish(algo);
+        }
+
+        // Generate report
+        result.report = algo.generate_report();
+        result.completed = algo.is_complete();
+    }
+
     /**
      * @brief Simulates one tick of price movement
      */
@@ -335,7 +436,7 @@ private:
         std::normal_distribution<double> dist(0.0, 1.0);
         double dt = 1.0 / (config_.ticks_per_second * 252 * 6.5 * 3600);  // Fraction of year
         double drift = 0.0;  // No drift
-        double diffusion = config_.volatility * std::sqrt(dt) * dist(rng_);
+        double diffusion = config_.volatility * std::sqrt(dt) * dist(price_rng_);
 
         current_price_ *= std::exp(drift * dt + diffusion);
 
@@ -363,18 +464,16 @@ private:
      * @brief Simulates execution of an order
      * @param order Order to execute
      * @param data Current market data
-     * @return Vector of fills (may be empty or partial)
+     * @return Fill if the order executed, std::nullopt otherwise
      */
-    std::vector<Fill> simulate_order_execution(Order& order, const MarketData& data) {
-        std::vector<Fill> fills;
-
+    std::optional<Fill> simulate_order_execution(Order& order, const MarketData& data) {
         if (order.is_market_order()) {
             // Market orders always fill at current price
             double fill_price = (order.side == Side::BUY) ? data.ask_price : data.bid_price;
             Fill fill(order.id, order.id, fill_price, order.quantity);
             fill.timestamp = current_time_;
-            fills.push_back(fill);
             cumulative_volume_ += order.quantity;
+            return fill;
         } else {
             // Limit orders have probabilistic fill
             std::uniform_real_distribution<double> dist(0.0, 1.0);
@@ -392,15 +491,15 @@ private:
                 fill_price = std::max(order.price, data.bid_price);
             }
 
-            if (would_fill && dist(rng_) < config_.fill_probability) {
+            if (would_fill && dist(fill_rng_) < config_.fill_probability) {
                 Fill fill(order.id, order.id, fill_price, order.quantity);
                 fill.timestamp = current_time_;
-                fills.push_back(fill);
                 cumulative_volume_ += order.quantity;
+                return fill;
             }
         }
 
-        return fills;
+        return std::nullopt;
     }
 
     /**
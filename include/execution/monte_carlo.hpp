@@ -0,0 +1,267 @@
+#pragma once
+
+#include "execution_algorithm.hpp"
+#include "execution_simulator.hpp"
+#include "market_impact_calibration.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct MonteCarloConfig
+ * @brief Configuration for Monte Carlo execution-cost runs
+ */
+struct MonteCarloConfig {
+    size_t num_paths = 10000;                        ///< Independent paths per algorithm
+    size_t num_threads = 0;                          ///< Worker threads (0 = hardware concurrency)
+    std::chrono::milliseconds duration{60000};       ///< Simulated horizon per path
+    double tail_confidence = 0.95;                   ///< Confidence level for VaR/CVaR
+    SimulationConfig simulation;                     ///< Market model (random_seed keys all paths)
+};
+
+/**
+ * @struct CostDistribution
+ * @brief Distribution of implementation shortfall across Monte Carlo paths
+ *
+ * Shortfall is in basis points with positive values meaning cost, so
+ * VaR and CVaR are taken from the upper tail.
+ */
+struct CostDistribution {
+    std::string algorithm_name;
+    size_t num_paths = 0;
+    size_t num_completed = 0;           ///< Paths that filled the full target
+    double mean_bps = 0.0;
+    double stdev_bps = 0.0;
+    double min_bps = 0.0;
+    double median_bps = 0.0;
+    double max_bps = 0.0;
+    double var_bps = 0.0;               ///< Shortfall quantile at tail_confidence
+    double cvar_bps = 0.0;              ///< Mean shortfall at or beyond var_bps
+    double tail_confidence = 0.95;
+    double mean_fill_rate = 0.0;
+    double elapsed_ms = 0.0;            ///< Wall time for all paths
+    std::vector<double> shortfall_bps;  ///< Per-path shortfall, indexed by path
+
+    void print() const {
+        std::cout << "\n=== Monte Carlo Cost Distribution: " << algorithm_name << " ===\n";
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "  Paths:        " << num_paths << " (" << num_completed << " completed)\n";
+        std::cout << "  Mean:         " << mean_bps << " bps\n";
+        std::cout << "  Stdev:        " << stdev_bps << " bps\n";
+        std::cout << "  Min / Median / Max: " << min_bps << " / " << median_bps
+                  << " / " << max_bps << " bps\n";
+        std::cout << "  VaR " << std::setprecision(0) << tail_confidence * 100 << "%:"
+                  << std::setprecision(3) << "      " << var_bps << " bps\n";
+        std::cout << "  CVaR " << std::setprecision(0) << tail_confidence * 100 << "%:"
+                  << std::setprecision(3) << "     " << cvar_bps << " bps\n";
+        std::cout << "  Fill rate:    " << std::setprecision(1) << mean_fill_rate * 100 << "%\n";
+        std::cout << "  Elapsed:      " << std::setprecision(1) << elapsed_ms << " ms\n";
+    }
+};
+
+/**
+ * @class MonteCarloEngine
+ * @brief Runs many independent ExecutionSimulator paths per algorithm
+ *
+ * Paths are split into contiguous ranges, one per worker thread. Each
+ * worker owns an ExecutionSimulator and a clone() of the algorithm, so
+ * nothing is shared on the hot path and throughput scales with cores.
+ * Path i always uses the simulator's counter-based streams for path i,
+ * so results are identical for any thread count, and algorithms
+ * compared with compare() face the same price shocks path by path.
+ */
+class MonteCarloEngine {
+private:
+    MarketImpactModel impact_model_;
+    MonteCarloConfig config_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param model Market impact model used by every path
+     * @param config Monte Carlo configuration
+     */
+    explicit MonteCarloEngine(const MarketImpactModel& model = MarketImpactModel(),
+                              const MonteCarloConfig& config = MonteCarloConfig())
+        : impact_model_(model), config_(config) {}
+
+    /**
+     * @brief Sets the configuration
+     * @param config New configuration
+     */
+    void set_config(const MonteCarloConfig& config) {
+        config_ = config;
+    }
+
+    const MonteCarloConfig& get_config() const { return config_; }
+
+    /**
+     * @brief Runs all paths for one algorithm
+     * @param prototype Algorithm to clone for each worker
+     * @return Shortfall distribution
+     * @throws std::invalid_argument if the algorithm does not support clone()
+     */
+    CostDistribution run(const ExecutionAlgorithm& prototype) const {
+        const size_t n = config_.num_paths;
+
+        CostDistribution dist;
+        dist.algorithm_name = prototype.name();
+        dist.num_paths = n;
+        dist.tail_confidence = config_.tail_confidence;
+        dist.shortfall_bps.resize(n);
+        if (n == 0) return dist;
+
+        std::vector<double> fill_rates(n);
+        std::vector<unsigned char> completed(n);
+
+        size_t threads = config_.num_threads > 0
+            ? config_.num_threads
+            : std::max<size_t>(1, std::thread::hardware_concurrency());
+        threads = std::min(threads, n);
+
+        // Clone up front so an unsupported algorithm fails before any work
+        std::vector<std::unique_ptr<ExecutionAlgorithm>> clones;
+        clones.reserve(threads);
+        for (size_t t = 0; t < threads; ++t) {
+            clones.push_back(prototype.clone());
+            if (!clones.back()) {
+                throw std::invalid_argument(
+                    "MonteCarloEngine: algorithm '" + prototype.name() + "' does not support clone()");
+            }
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        auto worker = [&](size_t t, size_t begin, size_t end) {
+            ExecutionSimulator sim(impact_model_, config_.simulation);
+            ExecutionAlgorithm& algo = *clones[t];
+            for (size_t path = begin; path < end; ++path) {
+                sim.set_path(path);
+                SimulationResult result = sim.run_simulation(algo, config_.duration);
+                dist.shortfall_bps[path] = result.report.implementation_shortfall_bps;
+                fill_rates[path] = result.report.fill_rate;
+                completed[path] = result.completed ? 1 : 0;
+            }
+        };
+
+        if (threads == 1) {
+            worker(0, 0, n);
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(threads);
+            size_t per_thread = (n + threads - 1) / threads;
+            for (size_t t = 0; t < threads; ++t) {
+                size_t begin = t * per_thread;
+                size_t end = std::min(n, begin + per_thread);
+                if (begin >= end) break;
+                workers.emplace_back(worker, t, begin, end);
+            }
+            for (auto& w : workers) {
+                w.join();
+            }
+        }
+
+        dist.elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+
+        summarize(dist, fill_rates, completed);
+        return dist;
+    }
+
+    /**
+     * @brief Runs the same paths for several algorithms
+     * @param algorithms Algorithms to compare
+     * @return One distribution per algorithm, in input order
+     */
+    std::vector<CostDistribution> compare(
+        const std::vector<std::unique_ptr<ExecutionAlgorithm>>& algorithms) const {
+        std::vector<CostDistribution> results;
+        results.reserve(algorithms.size());
+        for (const auto& algo : algorithms) {
+            results.push_back(run(*algo));
+        }
+        return results;
+    }
+
+    /**
+     * @brief Prints a side-by-side comparison of cost distributions
+     * @param results Distributions from compare()
+     */
+    static void print_comparison(const std::vector<CostDistribution>& results) {
+        std::cout << "\n=== Monte Carlo Algorithm Comparison ===\n";
+        std::cout << std::left
+                  << std::setw(18) << "Algorithm"
+                  << std::setw(10) << "Paths"
+                  << std::setw(12) << "Mean bps"
+                  << std::setw(12) << "Stdev bps"
+                  << std::setw(12) << "VaR bps"
+                  << std::setw(12) << "CVaR bps"
+                  << std::setw(12) << "Fill Rate"
+                  << std::setw(10) << "ms"
+                  << "\n";
+        std::cout << std::string(98, '-') << "\n";
+
+        for (const auto& r : results) {
+            std::cout << std::left
+                      << std::setw(18) << r.algorithm_name
+                      << std::setw(10) << r.num_paths
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(12) << r.mean_bps
+                      << std::setw(12) << r.stdev_bps
+                      << std::setw(12) << r.var_bps
+                      << std::setw(12) << r.cvar_bps
+                      << std::setprecision(1)
+                      << std::setw(12) << r.mean_fill_rate * 100
+                      << std::setw(10) << r.elapsed_ms
+                      << "\n";
+        }
+    }
+
+private:
+    static void summarize(CostDistribution& dist, const std::vector<double>& fill_rates,
+                          const std::vector<unsigned char>& completed) {
+        const size_t n = dist.shortfall_bps.size();
+
+        double sum = 0.0;
+        double fill_sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += dist.shortfall_bps[i];
+            fill_sum += fill_rates[i];
+            dist.num_completed += completed[i];
+        }
+        dist.mean_bps = sum / n;
+        dist.mean_fill_rate = fill_sum / n;
+
+        double sq = 0.0;
+        for (double x : dist.shortfall_bps) {
+            sq += (x - dist.mean_bps) * (x - dist.mean_bps);
+        }
+        dist.stdev_bps = n > 1 ? std::sqrt(sq / (n - 1)) : 0.0;
+
+        // Order statistics on a sorted copy; shortfall_bps stays in path order
+        std::vector<double> sorted(dist.shortfall_bps);
+        std::sort(sorted.begin(), sorted.end());
+        dist.min_bps = sorted.front();
+        dist.max_bps = sorted.back();
+        dist.median_bps = sorted[n / 2];
+
+        double confidence = std::clamp(dist.tail_confidence, 0.0, 1.0);
+        size_t var_index = static_cast<size_t>(std::ceil(confidence * n));
+        var_index = std::min(n - 1, var_index > 0 ? var_index - 1 : 0);
+        dist.var_bps = sorted[var_index];
+
+        double tail_sum = 0.0;
+        for (size_t i = var_index; i < n; ++i) {
+            tail_sum += sorted[i];
+        }
+        dist.cvar_bps = tail_sum / (n - var_index);
+    }
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+// Include order book headers (local copies)
+#include "order.hpp"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+static_assert(std::is_trivially_copyable<Order>::value,
+              "Order must stay trivially copyable for FixedOrderBuffer");
+
+/**
+ * @class OrderSink
+ * @brief Destination for child orders emitted by execution algorithms
+ *
+ * Algorithms push each child order into a sink instead of returning a
+ * freshly allocated std::vector<Order> per market data tick. Callers pick
+ * the sink that matches their hot path:
+ *   - FixedOrderBuffer<N>: fixed-capacity inline storage, reused every tick
+ *   - CallbackOrderSink<F>: forwards each order straight to a callable
+ *   - VectorOrderSink: appends to a caller-owned vector (compatibility)
+ */
+class OrderSink {
+public:
+    virtual ~OrderSink() = default;
+
+    /**
+     * @brief Accepts one child order
+     * @param order Order emitted by the algorithm
+     * @return true if accepted, false if the sink is full
+     */
+    virtual bool emit(const Order& order) = 0;
+};
+
+/**
+ * @class FixedOrderBuffer
+ * @brief Fixed-capacity, allocation-free order sink
+ *
+ * Storage lives inline in the object, so a buffer declared once outside
+ * the market data loop never touches the heap. Orders beyond capacity
+ * are rejected and counted in dropped().
+ *
+ * @tparam Capacity Maximum orders held between clear() calls
+ */
+template <size_t Capacity>
+class FixedOrderBuffer : public OrderSink {
+    static_assert(Capacity > 0, "FixedOrderBuffer capacity must be positive");
+
+private:
+    alignas(Order) unsigned char storage_[Capacity * sizeof(Order)];
+    size_t size_ = 0;
+    size_t dropped_ = 0;
+
+public:
+    bool emit(const Order& order) override {
+        if (size_ >= Capacity) {
+            dropped_++;
+            return false;
+        }
+        new (storage_ + size_ * sizeof(Order)) Order(order);
+        size_++;
+        return true;
+    }
+
+    /**
+     * @brief Discards buffered orders (capacity is retained)
+     */
+    void clear() {
+        size_ = 0;
+        dropped_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    /**
+     * @brief Number of orders rejected since the last clear()
+     */
+    size_t dropped() const { return dropped_; }
+
+    Order* data() {
+        return std::launder(reinterpret_cast<Order*>(storage_));
+    }
+    const Order* data() const {
+        return std::launder(reinterpret_cast<const Order*>(storage_));
+    }
+
+    Order& operator[](size_t i) { return data()[i]; }
+    const Order& operator[](size_t i) const { return data()[i]; }
+
+    Order* begin() { return data(); }
+    Order* end() { return data() + size_; }
+    const Order* begin() const { return data(); }
+    const Order* end() const { return data() + size_; }
+};
+
+/**
+ * @class CallbackOrderSink
+ * @brief Order sink that forwards every order to a callable
+ *
+ * Templated on the callable so lambdas are invoked directly without the
+ * type-erasure allocation of std::function.
+ *
+ * @tparam Fn Callable invocable as bool(const Order&) or void(const Order&)
+ */
+template <typename Fn>
+class CallbackOrderSink : public OrderSink {
+private:
+    Fn fn_;
+
+public:
+    explicit CallbackOrderSink(Fn fn) : fn_(std::move(fn)) {}
+
+    bool emit(const Order& order) override {
+        if constexpr (std::is_same<decltype(fn_(order)), bool>::value) {
+            return fn_(order);
+        } else {
+            fn_(order);
+            return true;
+        }
+    }
+};
+
+/**
+ * @brief Creates a CallbackOrderSink with the callable type deduced
+ */
+template <typename Fn>
+CallbackOrderSink<Fn> make_order_sink(Fn fn) {
+    return CallbackOrderSink<Fn>(std::move(fn));
+}
+
+/**
+ * @class VectorOrderSink
+ * @brief Order sink that appends to a caller-owned vector
+ *
+ * Backs the vector-returning convenience APIs. Reusing the same vector
+ * across ticks (clear() keeps capacity) avoids per-tick allocation.
+ */
+class VectorOrderSink : public OrderSink {
+private:
+    std::vector<Order>& out_;
+
+public:
+    explicit VectorOrderSink(std::vector<Order>& out) : out_(out) {}
+
+    bool emit(const Order& order) override {
+        out_.push_back(order);
+        return true;
+    }
+};
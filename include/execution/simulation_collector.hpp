@@ -0,0 +1,250 @@
+#pragma once
+
+#include "execution_algorithm.hpp"
+
+// Include order book headers (local copies)
+#include "fill.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/**
+ * @struct SlippageHistogram
+ * @brief Fixed-bucket histogram of per-fill slippage in basis points
+ *
+ * Buckets are BUCKET_BPS wide starting at MIN_BPS. Values outside the
+ * range go to underflow/overflow. Storage is a fixed array, so memory
+ * does not grow with the number of fills.
+ */
+struct SlippageHistogram {
+    static constexpr size_t NUM_BUCKETS = 128;
+    static constexpr double BUCKET_BPS = 0.5;
+    static constexpr double MIN_BPS = -32.0;   ///< Covers [-32, +32) bps
+
+    uint64_t counts[NUM_BUCKETS] = {};
+    uint64_t underflow = 0;
+    uint64_t overflow = 0;
+    uint64_t total = 0;
+
+    /**
+     * @brief Adds a sample
+     * @param bps Slippage in basis points
+     * @param weight Sample weight (e.g. fill quantity)
+     */
+    void add(double bps, uint64_t weight = 1) {
+        total += weight;
+        double pos = (bps - MIN_BPS) / BUCKET_BPS;
+        if (pos < 0.0) {
+            underflow += weight;
+        } else if (pos >= static_cast<double>(NUM_BUCKETS)) {
+            overflow += weight;
+        } else {
+            counts[static_cast<size_t>(pos)] += weight;
+        }
+    }
+
+    /**
+     * @brief Approximate percentile from bucket midpoints
+     * @param p Percentile in [0, 100]
+     * @return Slippage in bps; range edges for under/overflow
+     */
+    double percentile(double p) const {
+        if (total == 0) return 0.0;
+        uint64_t target = static_cast<uint64_t>(std::clamp(p, 0.0, 100.0) / 100.0 * (total - 1));
+        uint64_t seen = underflow;
+        if (target < seen) return MIN_BPS;
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            seen += counts[i];
+            if (target < seen) {
+                return MIN_BPS + (static_cast<double>(i) + 0.5) * BUCKET_BPS;
+            }
+        }
+        return MIN_BPS + NUM_BUCKETS * BUCKET_BPS;
+    }
+
+    void clear() {
+        std::fill(std::begin(counts), std::end(counts), 0);
+        underflow = 0;
+        overflow = 0;
+        total = 0;
+    }
+};
+
+/**
+ * @struct ExecutionStats
+ * @brief Online aggregates maintained while a simulation runs
+ *
+ * Updated once per tick and once per fill in O(1) with no allocation.
+ * This makes a SimulationResult constant-size regardless of how many
+ * ticks or fills the run produced.
+ */
+struct ExecutionStats {
+    uint64_t num_ticks = 0;
+    uint64_t num_fills = 0;
+    uint64_t filled_quantity = 0;
+    double notional = 0.0;               ///< Sum of price * quantity
+    double arrival_mid = 0.0;            ///< Mid at the first tick
+    double first_price = 0.0;
+    double last_price = 0.0;
+    double min_price = 0.0;
+    double max_price = 0.0;
+    double slippage_sum_bps = 0.0;       ///< Quantity-weighted slippage vs mid
+    SlippageHistogram slippage;          ///< Quantity-weighted, cost positive
+
+    /**
+     * @brief Records a market data update
+     */
+    void on_tick(const MarketData& data) {
+        if (num_ticks == 0) {
+            arrival_mid = mid_of(data);
+            first_price = data.price;
+            min_price = data.price;
+            max_price = data.price;
+        }
+        num_ticks++;
+        last_price = data.price;
+        min_price = std::min(min_price, data.price);
+        max_price = std::max(max_price, data.price);
+    }
+
+    /**
+     * @brief Records a fill against the market state it executed in
+     * @param fill Execution
+     * @param data Market state at the fill
+     * @param is_buy Direction of the parent order
+     */
+    void on_fill(const Fill& fill, const MarketData& data, bool is_buy) {
+        num_fills++;
+        filled_quantity += fill.quantity;
+        notional += fill.price * fill.quantity;
+
+        double mid = mid_of(data);
+        if (mid > 0.0) {
+            double bps = (fill.price - mid) / mid * 10000.0;
+            if (!is_buy) bps = -bps;
+            slippage_sum_bps += bps * fill.quantity;
+            slippage.add(bps, fill.quantity);
+        }
+    }
+
+    /**
+     * @brief Volume-weighted fill price
+     */
+    double vwap() const {
+        return filled_quantity > 0 ? notional / filled_quantity : 0.0;
+    }
+
+    /**
+     * @brief Shortfall of the fill VWAP vs arrival mid (cost positive)
+     */
+    double shortfall_bps(bool is_buy) const {
+        if (arrival_mid <= 0.0 || filled_quantity == 0) return 0.0;
+        double bps = (vwap() - arrival_mid) / arrival_mid * 10000.0;
+        return is_buy ? bps : -bps;
+    }
+
+    /**
+     * @brief Quantity-weighted mean slippage vs mid at fill time
+     */
+    double mean_slippage_bps() const {
+        return filled_quantity > 0 ? slippage_sum_bps / filled_quantity : 0.0;
+    }
+
+    /**
+     * @brief Price move from first to last tick
+     */
+    double price_move_bps() const {
+        return first_price > 0.0 ? (last_price - first_price) / first_price * 10000.0 : 0.0;
+    }
+
+    /**
+     * @brief Mid of the quotes, falling back to the reported price
+     */
+    static double mid_of(const MarketData& data) {
+        if (data.bid_price > 0.0 && data.ask_price > 0.0) {
+            return (data.bid_price + data.ask_price) / 2.0;
+        }
+        return data.price;
+    }
+
+    void print() const {
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "  Ticks: " << num_ticks << ", Fills: " << num_fills
+                  << ", Filled: " << filled_quantity << "\n";
+        std::cout << "  Fill VWAP: " << std::setprecision(4) << vwap() << "\n";
+        std::cout << "  Mean slippage: " << std::setprecision(3) << mean_slippage_bps()
+                  << " bps (p50 " << slippage.percentile(50)
+                  << ", p95 " << slippage.percentile(95) << ")\n";
+        std::cout << "  Price range: " << std::setprecision(4) << min_price
+                  << " - " << max_price << "\n";
+    }
+};
+
+/**
+ * @class SimulationCollector
+ * @brief Streaming observer of ExecutionSimulator runs
+ *
+ * Implementations see every tick and fill as it happens instead of
+ * reading vectors from the SimulationResult afterwards, so analysis of
+ * long runs needs no per-event storage.
+ */
+class SimulationCollector {
+public:
+    virtual ~SimulationCollector() = default;
+
+    /**
+     * @brief Called before the first tick
+     */
+    virtual void on_start(const ExecutionAlgorithm& /*algo*/) {}
+
+    /**
+     * @brief Called for every market data update, before the algorithm sees it
+     */
+    virtual void on_tick(const MarketData& /*data*/) {}
+
+    /**
+     * @brief Called for every fill
+     * @param fill Execution
+     * @param data Market state the fill executed against
+     */
+    virtual void on_fill(const Fill& /*fill*/, const MarketData& /*data*/) {}
+
+    /**
+     * @brief Called after the last tick
+     */
+    virtual void on_finish(const ExecutionAlgorithm& /*algo*/) {}
+};
+
+/**
+ * @class PathRecorder
+ * @brief Collector that stores the full price path and fills
+ *
+ * Use when a run needs to be plotted or replayed. Memory grows with the
+ * run length; enable only for runs that need the history.
+ */
+class PathRecorder : public SimulationCollector {
+private:
+    std::vector<MarketData> price_path_;
+    std::vector<Fill> fills_;
+
+public:
+    void on_start(const ExecutionAlgorithm& /*algo*/) override {
+        price_path_.clear();
+        fills_.clear();
+    }
+
+    void on_tick(const MarketData& data) override {
+        price_path_.push_back(data);
+    }
+
+    void on_fill(const Fill& fill, const MarketData& /*data*/) override {
+        fills_.push_back(fill);
+    }
+
+    const std::vector<MarketData>& price_path() const { return price_path_; }
+    const std::vector<Fill>& fills() const { return fills_; }
+};
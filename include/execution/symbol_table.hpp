@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Compact symbol identifier used on hot paths instead of std::string
+using SymbolId = uint32_t;
+
+/// Reserved id for "no symbol"
+constexpr SymbolId INVALID_SYMBOL_ID = 0xFFFFFFFFu;
+
+/**
+ * @class SymbolTable
+ * @brief Interns symbol strings into dense integer ids
+ *
+ * Ids are assigned sequentially from 0 in first-seen order, so they can
+ * index directly into per-symbol arrays. Interning happens at load time;
+ * hot paths carry only the SymbolId.
+ */
+class SymbolTable {
+private:
+    std::unordered_map<std::string, SymbolId> ids_;
+    std::vector<std::string> names_;
+
+public:
+    /**
+     * @brief Returns the id for a symbol, assigning a new one if unseen
+     * @param symbol Symbol string
+     * @return Dense symbol id
+     */
+    SymbolId intern(const std::string& symbol) {
+        auto it = ids_.find(symbol);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+        SymbolId id = static_cast<SymbolId>(names_.size());
+        ids_.emplace(symbol, id);
+        names_.push_back(symbol);
+        return id;
+    }
+
+    /**
+     * @brief Looks up a symbol without interning it
+     * @param symbol Symbol string
+     * @return Symbol id, or INVALID_SYMBOL_ID if unknown
+     */
+    SymbolId find(const std::string& symbol) const {
+        auto it = ids_.find(symbol);
+        return it != ids_.end() ? it->second : INVALID_SYMBOL_ID;
+    }
+
+    /**
+     * @brief Gets the symbol string for an id
+     * @param id Symbol id
+     * @return Symbol string, or empty string if unknown
+     */
+    const std::string& name(SymbolId id) const {
+        static const std::string empty;
+        return id < names_.size() ? names_[id] : empty;
+    }
+
+    size_t size() const { return names_.size(); }
+
+    void clear() {
+        ids_.clear();
+        names_.clear();
+    }
+};
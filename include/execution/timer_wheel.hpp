@@ -0,0 +1,318 @@
+#pragma once
+
+// Include order book headers (local copies)
+#include "types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Converts a TimePoint to timer wheel nanoseconds
+ * @param t Time point (TimePoint::min() maps to 0, i.e. "already due")
+ * @return Nanoseconds since the Clock epoch
+ */
+inline uint64_t to_timer_ns(TimePoint t) {
+    if (t == TimePoint::min()) return 0;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        t.time_since_epoch()).count();
+    return ns > 0 ? static_cast<uint64_t>(ns) : 0;
+}
+
+/**
+ * @class TimerHandler
+ * @brief Receives expiry callbacks from a TimerWheel
+ */
+class TimerHandler {
+public:
+    virtual ~TimerHandler() = default;
+
+    /**
+     * @brief Called when a timer scheduled with this handler expires
+     * @param id Identifier passed to TimerWheel::schedule()
+     * @param now_ns Time the wheel was advanced to
+     */
+    virtual void on_timer(uint32_t id, uint64_t now_ns) = 0;
+};
+
+/**
+ * @class TimerWheel
+ * @brief Hierarchical timing wheel keyed on nanosecond deadlines
+ *
+ * Deadlines are quantized to resolution_ns ticks and stored in LEVELS
+ * wheels of 64 slots each. A timer lives at the level of the highest
+ * 6-bit group in which its tick differs from the current tick, so every
+ * occupied slot is strictly ahead of the wheel's position. A 64-bit
+ * occupancy mask per level lets advance() jump straight to the next
+ * occupied slot, so idle gaps cost nothing. When the wheel reaches a
+ * higher-level slot, its timers cascade to lower levels. Each timer
+ * cascades at most LEVELS times, so schedule and expiry are O(1)
+ * amortized regardless of how many timers are pending.
+ *
+ * The wheel has no clock of its own. Callers drive it with advance() /
+ * advance_to() using wall clock time (poll()) or replayed event time,
+ * which makes the same code usable live and in backtests.
+ *
+ * Timers are identified by a caller-chosen uint32_t id and, optionally,
+ * a TimerHandler to call back. Individual ids are not cancelled; callers
+ * ignore stale ids (e.g. by encoding a generation counter in the id). A
+ * handler that is going away must cancel() itself so the wheel never
+ * calls a destroyed object.
+ */
+class TimerWheel {
+public:
+    using TimerId = uint32_t;
+
+    static constexpr size_t SLOT_BITS = 6;
+    static constexpr size_t SLOTS_PER_LEVEL = size_t(1) << SLOT_BITS;
+    static constexpr size_t LEVELS = 8;  ///< Covers 2^48 ticks before overflow
+
+private:
+    struct Entry {
+        uint64_t deadline_ns;
+        TimerId id;
+        TimerHandler* handler;
+    };
+
+    /// Stands in for a handler cancelled while its timer was firing
+    struct CancelledHandler : TimerHandler {
+        void on_timer(uint32_t, uint64_t) override {}
+    };
+
+    std::vector<Entry> slots_[LEVELS][SLOTS_PER_LEVEL];
+    uint64_t occupied_[LEVELS] = {};
+    std::vector<Entry> pending_;     ///< Tick reached, deadline not yet
+    std::vector<Entry> overflow_;    ///< Beyond the top level
+    std::vector<Entry> scratch_;     ///< Reused while cascading
+    std::vector<Entry> expired_;     ///< Reused while firing
+    CancelledHandler cancelled_;
+    uint64_t resolution_ns_;
+    uint64_t current_tick_ = 0;
+    size_t size_ = 0;
+
+public:
+    /**
+     * @brief Constructor
+     * @param resolution_ns Width of one tick in nanoseconds (default 1ms)
+     */
+    explicit TimerWheel(uint64_t resolution_ns = 1000000)
+        : resolution_ns_(resolution_ns > 0 ? resolution_ns : 1) {}
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Schedules a timer
+     * @param id Caller-chosen identifier returned on expiry
+     * @param deadline_ns Absolute deadline in nanoseconds
+     * @param handler Callback target, or nullptr to report via advance()'s callable
+     *
+     * Deadlines already in the past fire on the next advance().
+     */
+    void schedule(TimerId id, uint64_t deadline_ns, TimerHandler* handler = nullptr) {
+        insert({deadline_ns, id, handler});
+        size_++;
+    }
+
+    /**
+     * @brief Schedules a handler callback
+     * @param handler Callback target
+     * @param id Identifier passed back to the handler
+     * @param deadline Absolute deadline
+     */
+    void schedule(TimerHandler* handler, TimerId id, TimePoint deadline) {
+        schedule(id, to_timer_ns(deadline), handler);
+    }
+
+    /**
+     * @brief Drops every timer scheduled with a handler
+     * @param handler Callback target about to be destroyed or detached
+     * @return Number of timers removed
+     *
+     * O(scheduled timers). Safe to call from a callback: timers of the
+     * handler already expiring in the current advance() are skipped.
+     */
+    size_t cancel(const TimerHandler* handler) {
+        if (!handler) return 0;
+        auto owned = [handler](const Entry& e) { return e.handler == handler; };
+        size_t removed = erase_if(pending_, owned) + erase_if(overflow_, owned);
+        for (size_t level = 0; level < LEVELS; ++level) {
+            for (uint64_t mask = occupied_[level]; mask; mask &= mask - 1) {
+                size_t idx = static_cast<size_t>(__builtin_ctzll(mask));
+                removed += erase_if(slots_[level][idx], owned);
+                if (slots_[level][idx].empty()) {
+                    occupied_[level] &= ~(uint64_t(1) << idx);
+                }
+            }
+        }
+        size_ -= removed;
+
+        for (auto& e : expired_) {
+            if (owned(e)) e.handler = &cancelled_;
+        }
+        return removed;
+    }
+
+    /**
+     * @brief Advances the wheel and fires expired timers
+     * @param now_ns Current time in nanoseconds
+     * @param on_expire Callable invoked as on_expire(TimerId) for expired
+     *        timers scheduled without a handler
+     * @return Number of timers fired
+     *
+     * Callbacks may schedule new timers; those fire no earlier than the
+     * next advance().
+     */
+    template <typename Fn>
+    size_t advance(uint64_t now_ns, Fn&& on_expire) {
+        uint64_t now_tick = now_ns / resolution_ns_;
+        if (now_tick > current_tick_) {
+            advance_ticks(now_tick);
+        }
+
+        // Everything whose tick has been reached sits in pending_
+        for (size_t j = 0; j < pending_.size();) {
+            if (pending_[j].deadline_ns <= now_ns) {
+                expired_.push_back(pending_[j]);
+                pending_[j] = pending_.back();
+                pending_.pop_back();
+            } else {
+                ++j;
+            }
+        }
+
+        size_t fired = expired_.size();
+        size_ -= fired;
+        for (size_t i = 0; i < fired; ++i) {
+            const Entry& e = expired_[i];
+            if (e.handler) {
+                e.handler->on_timer(e.id, now_ns);
+            } else {
+                on_expire(e.id);
+            }
+        }
+        expired_.clear();
+        return fired;
+    }
+
+    /**
+     * @brief Advances the wheel, firing handler callbacks only
+     */
+    size_t advance(uint64_t now_ns) {
+        return advance(now_ns, [](TimerId) {});
+    }
+
+    /**
+     * @brief Advances the wheel to a (possibly replayed) event time
+     */
+    size_t advance_to(TimePoint now) {
+        return advance(to_timer_ns(now));
+    }
+
+    /**
+     * @brief Advances the wheel to the current wall clock time
+     */
+    size_t poll() {
+        return advance_to(Clock::now());
+    }
+
+    /**
+     * @brief Number of scheduled timers
+     */
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    uint64_t resolution_ns() const { return resolution_ns_; }
+
+private:
+    template <typename Pred>
+    static size_t erase_if(std::vector<Entry>& entries, Pred pred) {
+        auto end = std::remove_if(entries.begin(), entries.end(), pred);
+        size_t removed = static_cast<size_t>(entries.end() - end);
+        entries.erase(end, entries.end());
+        return removed;
+    }
+
+    void insert(const Entry& e) {
+        uint64_t tick = e.deadline_ns / resolution_ns_;
+        if (tick <= current_tick_) {
+            pending_.push_back(e);
+            return;
+        }
+
+        // Level = highest 6-bit group where tick differs from current
+        uint64_t diff = tick ^ current_tick_;
+        size_t level = (63 - static_cast<size_t>(__builtin_clzll(diff))) / SLOT_BITS;
+        if (level >= LEVELS) {
+            overflow_.push_back(e);
+            return;
+        }
+
+        size_t idx = (tick >> (level * SLOT_BITS)) & (SLOTS_PER_LEVEL - 1);
+        slots_[level][idx].push_back(e);
+        occupied_[level] |= uint64_t(1) << idx;
+    }
+
+    void advance_ticks(uint64_t now_tick) {
+        while (true) {
+            // Lowest level with an occupied slot ahead of the current position
+            size_t level = LEVELS;
+            size_t idx = 0;
+            for (size_t l = 0; l < LEVELS; ++l) {
+                size_t cur = (current_tick_ >> (l * SLOT_BITS)) & (SLOTS_PER_LEVEL - 1);
+                uint64_t ahead = cur + 1 < SLOTS_PER_LEVEL
+                    ? occupied_[l] & (~uint64_t(0) << (cur + 1))
+                    : 0;
+                if (ahead) {
+                    level = l;
+                    idx = static_cast<size_t>(__builtin_ctzll(ahead));
+                    break;
+                }
+            }
+
+            if (level == LEVELS) {
+                if (!advance_overflow(now_tick)) break;
+                continue;
+            }
+
+            // First tick covered by that slot
+            size_t shift = level * SLOT_BITS;
+            uint64_t block = current_tick_ >> (shift + SLOT_BITS) << (shift + SLOT_BITS);
+            uint64_t slot_tick = block | (static_cast<uint64_t>(idx) << shift);
+            if (slot_tick > now_tick) break;
+
+            current_tick_ = slot_tick;
+            occupied_[level] &= ~(uint64_t(1) << idx);
+            scratch_.swap(slots_[level][idx]);
+            for (const auto& e : scratch_) {
+                insert(e);
+            }
+            scratch_.clear();
+        }
+        current_tick_ = now_tick;
+    }
+
+    bool advance_overflow(uint64_t now_tick) {
+        if (overflow_.empty()) return false;
+
+        uint64_t min_tick = ~uint64_t(0);
+        for (const auto& e : overflow_) {
+            min_tick = std::min(min_tick, e.deadline_ns / resolution_ns_);
+        }
+        if (min_tick > now_tick) return false;
+
+        // Jump to the start of the top-level block holding the earliest timer
+        size_t shift = LEVELS * SLOT_BITS;
+        current_tick_ = std::max(current_tick_, min_tick >> shift << shift);
+        scratch_.swap(overflow_);
+        for (const auto& e : scratch_) {
+            insert(e);
+        }
+        scratch_.clear();
+        return true;
+    }
+};
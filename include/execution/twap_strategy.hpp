@@ -101,17 +101,19 @@ public:
         max_slice_pct_ = max_pct;
     }
 
+    using ExecutionAlgorithm::compute_child_orders;
+
     /**
      * @brief Computes child orders for TWAP execution
      * @param data Current market data
-     * @return Vector of orders (0 or 1 orders)
+     * @param sink Receives 0 or 1 slice orders
      *
      * TWAP logic:
      * 1. Check if it's time for the next slice
      * 2. Calculate slice size (equal division of remaining)
      * 3. Generate order at current market price
      */
-    std::vector<Order> compute_child_orders(const MarketData& data) override {
+    void compute_child_orders(const MarketData& data, OrderSink& sink) override {
         // Initialize timing on first call
         if (current_slice_ == 0 && !started_) {
             last_slice_time_ = data.timestamp;
@@ -119,21 +121,22 @@ public:
 
         // Check if it's time for next slice
         if (!is_time_for_slice(data.timestamp)) {
-            return {};
+            return;
         }
 
         // Calculate slice size
         uint64_t slice_size = calculate_slice_size();
         if (slice_size == 0) {
-            return {};
+            return;
         }
 
         // Update state
         current_slice_++;
         last_slice_time_ = data.timestamp;
+        arm_slice_timer();
 
         // Create order
-        return {create_slice_order(data, static_cast<int>(slice_size))};
+        sink.emit(create_slice_order(data, static_cast<int>(slice_size)));
     }
 
     /**
@@ -144,6 +147,15 @@ public:
         current_slice_ = 0;
     }
 
+    /**
+     * @brief Creates an independent copy of this strategy
+     */
+    std::unique_ptr<ExecutionAlgorithm> clone() const override {
+        auto copy = std::make_unique<TWAPStrategy>(*this);
+        copy->attach_slice_timer(nullptr);
+        return copy;
+    }
+
     /**
      * @brief Gets the number of slices
      * @return Total slice count
@@ -160,6 +172,17 @@ public:
         return current_slice_;
     }
 
+    /**
+     * @brief Gets the deadline of the next slice
+     * @return Time the next slice becomes due (first slice is due immediately)
+     */
+    TimePoint next_wakeup_time() const override {
+        if (current_slice_ == 0) {
+            return TimePoint::min();
+        }
+        return last_slice_time_ + slice_interval_;
+    }
+
     /**
      * @brief Gets the slice interval duration
      * @return Duration between slices
@@ -229,6 +252,11 @@ private:
             return true;
         }
 
+        // Deadline tracked by the shared timer wheel
+        if (slice_timer_) {
+            return slice_due_;
+        }
+
         // Check if interval has elapsed since last slice
         auto elapsed_since_last = std::chrono::duration_cast<Duration>(
             current_time - last_slice_time_);
@@ -322,11 +350,25 @@ public:
         max_catchup_multiplier_ = multiplier;
     }
 
-    std::vector<Order> compute_child_orders(const MarketData& data) override {
-        // Get base TWAP orders
-        auto orders = TWAPStrategy::compute_child_orders(data);
+    /**
+     * @brief Creates an independent copy of this strategy
+     */
+    std::unique_ptr<ExecutionAlgorithm> clone() const override {
+        auto copy = std::make_unique<AggressiveTWAP>(*this);
+        copy->attach_slice_timer(nullptr);
+        return copy;
+    }
+
+    using TWAPStrategy::compute_child_orders;
+
+    void compute_child_orders(const MarketData& data, OrderSink& sink) override {
+        // Get base TWAP order (at most one per tick)
+        FixedOrderBuffer<1> base;
+        TWAPStrategy::compute_child_orders(data, base);
+
+        if (base.empty()) return;
 
-        if (orders.empty()) return orders;
+        Order order = base[0];
 
         // Calculate how much we should have executed by now
         auto elapsed = get_elapsed_time(data.timestamp);
@@ -344,20 +386,20 @@ public:
                 static_cast<uint64_t>(base_slice * (max_catchup_multiplier_ - 1.0)));
 
             // Modify order quantity
-            if (!orders.empty() && additional > 0) {
-                int new_qty = orders[0].quantity + static_cast<int>(additional);
+            if (additional > 0) {
+                int new_qty = order.quantity + static_cast<int>(additional);
                 new_qty = static_cast<int>(std::min(
                     static_cast<uint64_t>(new_qty), remaining_quantity()));
 
                 // Create new order with updated quantity
-                if (orders[0].is_market_order()) {
-                    orders[0] = create_market_order(new_qty);
+                if (order.is_market_order()) {
+                    order = create_market_order(new_qty);
                 } else {
-                    orders[0] = create_limit_order(orders[0].price, new_qty);
+                    order = create_limit_order(order.price, new_qty);
                 }
             }
         }
 
-        return orders;
+        sink.emit(order);
     }
 };
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct VolumeCurve
+ * @brief Intraday cumulative volume profile for one symbol
+ *
+ * The trading session [session_start_seconds, session_start_seconds +
+ * num_buckets * bucket_seconds) is divided into fixed buckets. cumulative
+ * holds num_buckets + 1 points: cumulative[i] is the average fraction of
+ * the day's volume traded before bucket i, so cumulative[0] = 0 and
+ * cumulative[num_buckets] = 1. Values are stored as float to keep cached
+ * curves compact.
+ */
+struct VolumeCurve {
+    uint32_t session_start_seconds = 9 * 3600 + 30 * 60;  ///< Seconds after midnight
+    uint32_t bucket_seconds = 300;
+    uint32_t num_buckets = 0;
+    uint32_t num_days = 0;                                ///< Days averaged into the curve
+    std::vector<float> cumulative;
+
+    bool empty() const { return num_buckets == 0 || cumulative.size() != num_buckets + 1; }
+
+    uint32_t session_end_seconds() const {
+        return session_start_seconds + num_buckets * bucket_seconds;
+    }
+
+    /**
+     * @brief Fraction of daily volume expected before a time of day
+     * @param second_of_day Seconds after midnight
+     * @return Value in [0, 1], linearly interpolated within a bucket
+     */
+    double fraction_before(double second_of_day) const {
+        if (empty()) return 0.0;
+        double pos = (second_of_day - session_start_seconds) / bucket_seconds;
+        if (pos <= 0.0) return 0.0;
+        if (pos >= num_buckets) return 1.0;
+        size_t i = static_cast<size_t>(pos);
+        double frac = pos - static_cast<double>(i);
+        return cumulative[i] + frac * (cumulative[i + 1] - cumulative[i]);
+    }
+
+    /**
+     * @brief Fraction of a bucket's share of daily volume
+     * @param bucket Bucket index
+     */
+    double bucket_fraction(size_t bucket) const {
+        if (bucket >= num_buckets || empty()) return 0.0;
+        return cumulative[bucket + 1] - cumulative[bucket];
+    }
+
+    /**
+     * @brief Per-slice volume weights for an execution window
+     * @param start_second_of_day Execution start, seconds after midnight
+     * @param duration Execution duration
+     * @param num_slices Number of equal-time slices
+     * @return Weights summing to 1; uniform if the window sees no volume
+     */
+    std::vector<double> slice_weights(uint32_t start_second_of_day,
+                                      std::chrono::milliseconds duration,
+                                      size_t num_slices) const {
+        if (num_slices == 0) return {};
+
+        std::vector<double> weights(num_slices);
+        double slice_seconds = duration.count() / 1000.0 / num_slices;
+        double total = 0.0;
+        double prev = fraction_before(start_second_of_day);
+        for (size_t k = 0; k < num_slices; ++k) {
+            double next = fraction_before(start_second_of_day + (k + 1) * slice_seconds);
+            weights[k] = std::max(0.0, next - prev);
+            total += weights[k];
+            prev = next;
+        }
+
+        if (total <= 0.0) {
+            std::fill(weights.begin(), weights.end(), 1.0 / num_slices);
+            return weights;
+        }
+        for (auto& w : weights) {
+            w /= total;
+        }
+        return weights;
+    }
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "execution_algorithm.hpp"
+#include "volume_curve.hpp"
 
 #include <algorithm>
 #include <chrono>
@@ -49,7 +50,8 @@ public:
         U_SHAPED,   ///< High at open/close, low midday
         MORNING,    ///< Front-loaded, higher early volume
         AFTERNOON,  ///< Back-loaded, higher late volume
-        CUSTOM      ///< User-provided distribution
+        CUSTOM,     ///< User-provided distribution
+        HISTORICAL  ///< Learned intraday volume curve
     };
 
 private:
@@ -139,6 +141,28 @@ public:
         compute_slice_sizes();
     }
 
+    /**
+     * @brief Weights slices by a historical intraday volume curve
+     * @param curve Curve for the traded symbol (see VolumeCurveService)
+     * @param start_second_of_day Execution start, seconds after local midnight
+     *
+     * Each slice gets the curve's share of volume over its time window.
+     * An empty curve leaves the current profile unchanged.
+     */
+    void set_volume_curve(const VolumeCurve& curve, uint32_t start_second_of_day) {
+        if (curve.empty()) {
+            return;
+        }
+
+        profile_type_ = VolumeProfile::HISTORICAL;
+        volume_weights_ = curve.slice_weights(
+            start_second_of_day,
+            std::chrono::duration_cast<std::chrono::milliseconds>(duration_),
+            num_slices_);
+
+        compute_slice_sizes();
+    }
+
     /**
      * @brief Enables real-time volume adaptation
      * @param enable Whether to adapt to real market volume
@@ -159,10 +183,12 @@ public:
         limit_offset_bps_ = offset_bps;
     }
 
+    using ExecutionAlgorithm::compute_child_orders;
+
     /**
      * @brief Computes child orders for VWAP execution
      * @param data Current market data
-     * @return Vector of orders (0 or 1 orders)
+     * @param sink Receives 0 or 1 slice orders
      *
      * VWAP logic:
      * 1. Check if it's time for the next slice
@@ -170,7 +196,7 @@ public:
      * 3. Optionally adjust based on real-time market volume
      * 4. Generate order at current market price
      */
-    std::vector<Order> compute_child_orders(const MarketData& data) override {
+    void compute_child_orders(const MarketData& data, OrderSink& sink) override {
         // Initialize timing on first call
         if (current_slice_ == 0 && !started_) {
             last_slice_time_ = data.timestamp;
@@ -178,24 +204,25 @@ public:
 
         // Check if it's time for next slice
         if (!is_time_for_slice(data.timestamp)) {
-            return {};
+            return;
         }
 
         // Calculate slice size
         uint64_t slice_size = calculate_slice_size(data);
         if (slice_size == 0) {
-            return {};
+            return;
         }
 
         // Update state
         current_slice_++;
         last_slice_time_ = data.timestamp;
+        arm_slice_timer();
         if (data.total_volume > 0) {
             last_market_volume_ = data.total_volume;
         }
 
         // Create order
-        return {create_slice_order(data, static_cast<int>(slice_size))};
+        sink.emit(create_slice_order(data, static_cast<int>(slice_size)));
     }
 
     /**
@@ -207,6 +234,15 @@ public:
         last_market_volume_ = 0;
     }
 
+    /**
+     * @brief Creates an independent copy of this strategy
+     */
+    std::unique_ptr<ExecutionAlgorithm> clone() const override {
+        auto copy = std::make_unique<VWAPStrategy>(*this);
+        copy->attach_slice_timer(nullptr);
+        return copy;
+    }
+
     /**
      * @brief Gets the number of slices
      * @return Total slice count
@@ -223,6 +259,17 @@ public:
         return current_slice_;
     }
 
+    /**
+     * @brief Gets the deadline of the next slice
+     * @return Time the next slice becomes due (first slice is due immediately)
+     */
+    TimePoint next_wakeup_time() const override {
+        if (current_slice_ == 0) {
+            return TimePoint::min();
+        }
+        return last_slice_time_ + slice_interval_;
+    }
+
     /**
      * @brief Gets the volume profile type
      * @return VolumeProfile enum
@@ -312,7 +359,8 @@ private:
                 break;
 
             case VolumeProfile::CUSTOM:
-                // Will be set via set_custom_volume_weights()
+            case VolumeProfile::HISTORICAL:
+                // Will be set via set_custom_volume_weights() / set_volume_curve()
                 std::fill(volume_weights_.begin(), volume_weights_.end(),
                          1.0 / num_slices_);
                 break;
@@ -362,6 +410,11 @@ private:
             return true;
         }
 
+        // Deadline tracked by the shared timer wheel
+        if (slice_timer_) {
+            return slice_due_;
+        }
+
         // Check if interval has elapsed since last slice
         auto elapsed_since_last = std::chrono::duration_cast<Duration>(
             current_time - last_slice_time_);
@@ -440,6 +493,7 @@ private:
             case VolumeProfile::MORNING: return "Morning-Weighted";
             case VolumeProfile::AFTERNOON: return "Afternoon-Weighted";
             case VolumeProfile::CUSTOM: return "Custom";
+            case VolumeProfile::HISTORICAL: return "Historical";
             default: return "Unknown";
         }
     }
@@ -232,6 +232,36 @@ inline std::string serialize_order_book_update(uint64_t sequence, const char sym
   return message;
 }
 
+// Size of an encoded order book update frame (header + payload)
+constexpr size_t ORDER_BOOK_UPDATE_FRAME_SIZE =
+    MessageHeader::HEADER_SIZE + OrderBookUpdatePayload::PAYLOAD_SIZE; // 30 bytes
+
+// Encode order book update into a caller-provided buffer (no allocation)
+// Same bytes as serialize_order_book_update(); out must hold
+// ORDER_BOOK_UPDATE_FRAME_SIZE bytes
+inline size_t encode_order_book_update(char* out, uint64_t sequence, const char symbol[4],
+                                       uint8_t side, float price, int64_t quantity) {
+  uint32_t length_net = htonl(static_cast<uint32_t>(OrderBookUpdatePayload::PAYLOAD_SIZE));
+  memcpy(out, &length_net, 4);
+  out[4] = static_cast<char>(MessageType::ORDER_BOOK_UPDATE);
+  uint64_t sequence_net = htonll(sequence);
+  memcpy(out + 5, &sequence_net, 8);
+
+  char* payload = out + MessageHeader::HEADER_SIZE;
+  memcpy(payload, symbol, 4);
+  payload[4] = static_cast<char>(side);
+
+  uint32_t price_bits;
+  memcpy(&price_bits, &price, 4);
+  uint32_t price_net = htonl(price_bits);
+  memcpy(payload + 5, &price_net, 4);
+
+  uint64_t qty_net = htonll(static_cast<uint64_t>(quantity));
+  memcpy(payload + 9, &qty_net, 8);
+
+  return ORDER_BOOK_UPDATE_FRAME_SIZE;
+}
+
 // Deserialize header from raw bytes
 inline MessageHeader deserialize_header(const char* data) {
   MessageHeader header;
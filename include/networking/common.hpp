@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <arpa/inet.h>
 #include <cerrno>
+#include <cstdarg>
 #include <chrono>
 #include <cstring>
 #include <fcntl.h>
@@ -532,6 +533,64 @@ inline Result<void> socket_set_nonblocking(int sockfd) {
   return Result<void>();
 }
 
+/**
+ * Create a listening TCP socket bound to address:port
+ *
+ * @param address IPv4 address to bind ("0.0.0.0" for all interfaces)
+ * @param port Port number (0 = let the kernel pick an ephemeral port)
+ * @param backlog listen() backlog
+ * @return Result containing listening socket fd on success
+ */
+inline Result<int> socket_listen(const std::string &address, int port,
+                                 int backlog = 16) {
+  int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+  if (sockfd < 0) {
+    return Result<int>::error(
+        std::string("socket creation failed: ") + strerror(errno));
+  }
+
+  int reuse = 1;
+  setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  if (address == "localhost") {
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  } else if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) <= 0) {
+    close(sockfd);
+    return Result<int>::error("Invalid address: " + address);
+  }
+
+  if (bind(sockfd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    std::string err = "bind failed on " + address + ":" +
+                      std::to_string(port) + ": " + strerror(errno);
+    close(sockfd);
+    return Result<int>::error(err);
+  }
+
+  if (listen(sockfd, backlog) < 0) {
+    std::string err = std::string("listen failed: ") + strerror(errno);
+    close(sockfd);
+    return Result<int>::error(err);
+  }
+
+  return Result<int>(sockfd);
+}
+
+/**
+ * Get the local port a socket is bound to (resolves ephemeral port 0)
+ */
+inline int socket_local_port(int sockfd) {
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  if (getsockname(sockfd, (struct sockaddr *)&addr, &len) < 0) {
+    return -1;
+  }
+  return ntohs(addr.sin_port);
+}
+
 // =============================================================================
 // Utility Functions
 // =============================================================================
@@ -0,0 +1,260 @@
+#pragma once
+
+/**
+ * @file conflating_subscriber.hpp
+ * @brief Last-value L2 conflation for consumers slower than the book
+ *
+ * A ConflatingSubscriber sits between one or more MarketDataPublishers and
+ * a slow consumer (analytics, UI). poll() drains the publishers' rings
+ * into a last-value cache keyed by (symbol, side, price); deliver() hands
+ * the consumer only the latest quantity of each level that changed since
+ * its previous call, best prices first. Ten changes to one level between
+ * two deliveries arrive as one.
+ *
+ * Memory is bounded: a source whose pending levels exceed
+ * max_pending_levels drops them and is delivered as a CLEAR followed by
+ * its current depth instead. Neither side ever waits on the book; a poller
+ * that falls a ring behind resynchronizes from the publisher's snapshot and
+ * only the levels that differ are marked.
+ *
+ *   ConflatingSubscriber conflator;
+ *   conflator.add_source(publisher);
+ *   conflator.poll();                                  // Keep up with the ring
+ *   conflator.deliver([](const ConflatedUpdate& u) {   // Consumer's pace
+ *       ...
+ *   });
+ *
+ * poll() and deliver() may run on different threads (a pump thread and the
+ * consumer); the handler runs without the cache lock held.
+ */
+
+#include "market_data_publisher.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ConflatedUpdate
+ * @brief One merged level change (or a book reset) handed to the consumer
+ */
+struct ConflatedUpdate {
+    enum class Type : uint8_t {
+        LEVEL,  ///< Level now holds quantity (0 = removed)
+        CLEAR   ///< Drop every level of this source; current depth follows
+    };
+
+    Type type = Type::LEVEL;
+    uint32_t source = 0;  ///< Index returned by add_source()
+    uint8_t side = 0;     ///< 0 = bid, 1 = ask
+    float price = 0.0f;
+    uint64_t quantity = 0;
+};
+
+/**
+ * @struct ConflationStats
+ * @brief Per-subscriber conflation counters
+ */
+struct ConflationStats {
+    uint64_t updates_received = 0;   ///< Level changes drained from the rings
+    uint64_t updates_delivered = 0;  ///< LEVEL updates handed to the consumer
+    uint64_t overflows = 0;          ///< Pending caches dropped for a refresh
+    uint64_t laps = 0;               ///< Ring overruns (snapshot resyncs)
+    size_t pending_levels = 0;       ///< Levels waiting for deliver()
+
+    /// Changes received per change delivered (>= 1; 0 before any delivery)
+    double conflation_ratio() const {
+        return updates_delivered > 0
+                   ? static_cast<double>(updates_received) / updates_delivered
+                   : 0.0;
+    }
+};
+
+/**
+ * @class ConflatingSubscriber
+ * @brief Last-value-per-level cache between publishers and a slow consumer
+ */
+class ConflatingSubscriber {
+public:
+    using Handler = std::function<void(const ConflatedUpdate&)>;
+
+    static constexpr size_t DEFAULT_MAX_PENDING_LEVELS = 4096;
+
+    /**
+     * @param max_pending_levels Pending levels per source before the source
+     *        is delivered as a full refresh instead
+     */
+    explicit ConflatingSubscriber(size_t max_pending_levels = DEFAULT_MAX_PENDING_LEVELS)
+        : max_pending_levels_(max_pending_levels) {}
+
+    ConflatingSubscriber(const ConflatingSubscriber&) = delete;
+    ConflatingSubscriber& operator=(const ConflatingSubscriber&) = delete;
+
+    /**
+     * @brief Subscribes to a publisher (before polling starts)
+     * @return Source index carried by its updates
+     *
+     * The first poll() marks the publisher's whole snapshot as pending, so
+     * the consumer starts from the current book.
+     */
+    uint32_t add_source(const MarketDataPublisher& publisher) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint32_t index = static_cast<uint32_t>(sources_.size());
+        sources_.push_back(std::make_unique<Source>(publisher));
+        Source& source = *sources_.back();
+        source.reader.set_level_handler([this, &source](uint8_t side, float price,
+                                                        uint64_t quantity) {
+            on_level(source, side, price, quantity);
+        });
+        return index;
+    }
+
+    /**
+     * @brief Drains every source's ring into the cache
+     * @return Level changes absorbed
+     */
+    size_t poll() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint64_t before = stats_.updates_received;
+        for (auto& source : sources_) {
+            const uint64_t laps = source->reader.laps();
+            source->reader.poll();
+            stats_.laps += source->reader.laps() - laps;
+        }
+        return static_cast<size_t>(stats_.updates_received - before);
+    }
+
+    /**
+     * @brief Hands pending changes to the consumer, best prices first
+     * @param handler Called once per update, without the cache lock held
+     * @param max_updates Upper bound on LEVEL updates for this call; a
+     *        source's refresh (CLEAR plus its depth) is never split
+     * @return LEVEL updates delivered
+     */
+    size_t deliver(const Handler& handler, size_t max_updates = SIZE_MAX) {
+        batch_.clear();
+        size_t delivered = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (uint32_t i = 0; i < sources_.size() && delivered < max_updates; ++i) {
+                Source& source = *sources_[i];
+                if (source.refresh) {
+                    delivered += take_refresh(i, source);
+                    continue;
+                }
+                delivered += take_pending(i, 0, source.pending_bids, max_updates - delivered);
+                delivered += take_pending(i, 1, source.pending_asks, max_updates - delivered);
+            }
+            stats_.updates_delivered += delivered;
+        }
+
+        for (const auto& update : batch_) {
+            handler(update);
+        }
+        return delivered;
+    }
+
+    // ========================================================================
+    // QUERIES (any thread)
+    // ========================================================================
+
+    ConflationStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ConflationStats stats = stats_;
+        for (const auto& source : sources_) {
+            stats.pending_levels += source->pending_bids.size() + source->pending_asks.size();
+        }
+        return stats;
+    }
+
+    double conflation_ratio() const { return stats().conflation_ratio(); }
+
+    const std::string& symbol(uint32_t source) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sources_[source]->publisher.symbol();
+    }
+
+    size_t source_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sources_.size();
+    }
+
+private:
+    struct Source {
+        explicit Source(const MarketDataPublisher& p) : publisher(p), reader(p) {}
+
+        const MarketDataPublisher& publisher;
+        MarketDataSubscriber reader;  // Current depth of the source
+        std::map<float, uint64_t, std::greater<float>> pending_bids;
+        std::map<float, uint64_t> pending_asks;
+        bool refresh = false;  // Pending caches overflowed
+    };
+
+    // Level handler of a source's reader (poll(), lock held)
+    void on_level(Source& source, uint8_t side, float price, uint64_t quantity) {
+        stats_.updates_received++;
+        if (source.refresh) {
+            return; // The refresh will carry the latest depth
+        }
+        if (side == 0) {
+            source.pending_bids[price] = quantity;
+        } else {
+            source.pending_asks[price] = quantity;
+        }
+        if (source.pending_bids.size() + source.pending_asks.size() > max_pending_levels_) {
+            source.pending_bids.clear();
+            source.pending_asks.clear();
+            source.refresh = true;
+            stats_.overflows++;
+        }
+    }
+
+    template <typename Map>
+    size_t take_pending(uint32_t index, uint8_t side, Map& pending, size_t budget) {
+        size_t taken = 0;
+        auto it = pending.begin();
+        for (; it != pending.end() && taken < budget; ++it, ++taken) {
+            ConflatedUpdate update;
+            update.source = index;
+            update.side = side;
+            update.price = it->first;
+            update.quantity = it->second;
+            batch_.push_back(update);
+        }
+        pending.erase(pending.begin(), it);
+        return taken;
+    }
+
+    size_t take_refresh(uint32_t index, Source& source) {
+        ConflatedUpdate clear;
+        clear.type = ConflatedUpdate::Type::CLEAR;
+        clear.source = index;
+        batch_.push_back(clear);
+
+        size_t taken = 0;
+        for (uint8_t side = 0; side < 2; ++side) {
+            const auto levels = side == 0 ? source.reader.bids() : source.reader.asks();
+            for (const auto& level : levels) {
+                ConflatedUpdate update;
+                update.source = index;
+                update.side = side;
+                update.price = level.price;
+                update.quantity = level.quantity;
+                batch_.push_back(update);
+                taken++;
+            }
+        }
+        source.refresh = false;
+        return taken;
+    }
+
+    const size_t max_pending_levels_;
+    std::vector<std::unique_ptr<Source>> sources_;
+    ConflationStats stats_;
+    std::vector<ConflatedUpdate> batch_;  // deliver() scratch, consumer thread
+    mutable std::mutex mutex_;
+};
@@ -0,0 +1,470 @@
+#pragma once
+
+/**
+ * @file market_data_publisher.hpp
+ * @brief Incremental L2 market data from an order book
+ *
+ * MarketDataPublisher listens to a book's per-level depth changes and
+ * encodes each one as a binary_protocol ORDER_BOOK_UPDATE frame into a
+ * BroadcastRing. Every snapshot_interval updates (and on attach) it also
+ * encodes a full SNAPSHOT_RESPONSE whose header sequence is the last
+ * update it includes.
+ *
+ * Subscribers read the ring at their own pace without ever slowing the
+ * book. MarketDataSubscriber joins (or recovers after being lapped) by
+ * applying the latest snapshot and continuing from the update after it:
+ *
+ *   MarketDataPublisher publisher("AAPL");
+ *   publisher.attach(book);              // Book thread produces
+ *   MarketDataSubscriber subscriber(publisher);
+ *   subscriber.poll();                   // Any one reader thread
+ *
+ * Periodic snapshots cost the book thread two depth copies and a
+ * serialized frame (heap allocations) every snapshot_interval updates.
+ * A MarketDataSnapshotter moves that work to a reader thread: it rebuilds
+ * depth from the ring like any subscriber and installs the snapshots, and
+ * the book thread then only builds one when a reader that fell a full
+ * ring behind asks for it:
+ *
+ *   MarketDataSnapshotter snapshotter(publisher);  // Before updates flow
+ *   snapshotter.poll();                            // Snapshot thread
+ *
+ * Wire prices are floats (binary_protocol), so subscriber levels are keyed
+ * by the float price. Snapshots carry at most 255 levels per side (the
+ * protocol's level count is one byte).
+ */
+
+#include "binary_protocol.hpp"
+#include "broadcast_ring.hpp"
+#include "order_book.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @struct MarketDataFrame
+ * @brief One encoded ORDER_BOOK_UPDATE message (ring slot payload)
+ */
+struct MarketDataFrame {
+    char bytes[ORDER_BOOK_UPDATE_FRAME_SIZE];
+};
+
+/**
+ * @struct MarketDataSnapshot
+ * @brief Latest encoded full-depth snapshot
+ */
+struct MarketDataSnapshot {
+    uint64_t sequence = 0;                     ///< Last update included
+    std::shared_ptr<const std::string> frame;  ///< SNAPSHOT_RESPONSE message (null until the first)
+};
+
+/**
+ * @class MarketDataPublisher
+ * @brief Encodes a book's level changes into a broadcast ring
+ *
+ * Single producer: every method except the reader accessors runs on the
+ * thread that owns the book.
+ */
+class MarketDataPublisher {
+public:
+    static constexpr size_t MAX_SNAPSHOT_LEVELS = 255;
+
+    /**
+     * @param symbol Symbol on the wire (first 4 characters, NUL padded)
+     * @param ring_capacity Updates retained for readers (power of 2)
+     * @param snapshot_interval Updates between snapshots (0 = attach only);
+     *        capped at half the ring so a lapped reader can always recover
+     * @param snapshot_levels Levels per side in each snapshot (max 255)
+     */
+    explicit MarketDataPublisher(const std::string& symbol, size_t ring_capacity = 65536,
+                                 uint64_t snapshot_interval = 1024,
+                                 size_t snapshot_levels = MAX_SNAPSHOT_LEVELS)
+        : symbol_(symbol),
+          ring_(ring_capacity),
+          snapshot_levels_(std::min(snapshot_levels, MAX_SNAPSHOT_LEVELS)) {
+        std::memset(wire_symbol_, 0, sizeof(wire_symbol_));
+        std::memcpy(wire_symbol_, symbol.data(), std::min(symbol.size(), sizeof(wire_symbol_)));
+        snapshot_interval_ = std::min<uint64_t>(snapshot_interval, ring_.capacity() / 2);
+        if (snapshot_interval > 0 && snapshot_interval_ == 0) {
+            snapshot_interval_ = 1;
+        }
+    }
+
+    MarketDataPublisher(const MarketDataPublisher&) = delete;
+    MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
+
+    /**
+     * @brief Starts publishing a book's depth (OrderBook or MicrostructureOrderBook)
+     *
+     * Enables depth tracking on the book and publishes an initial snapshot.
+     * The book must outlive the publisher's use of it.
+     */
+    template <typename Book>
+    void attach(Book& book) {
+        book.enable_depth_tracking();
+        depth_source_ = [&book](Side side, size_t max_levels) {
+            return book.get_depth(side, max_levels);
+        };
+        book.register_depth_listener(
+            [this](const BookLevelUpdate& update) { on_level_update(update); });
+        publish_snapshot();
+    }
+
+    /**
+     * @brief Encodes one level change (depth listener)
+     */
+    void on_level_update(const BookLevelUpdate& update) {
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed) + 1;
+        MarketDataFrame frame;
+        encode_order_book_update(frame.bytes, sequence, wire_symbol_,
+                                 update.side == Side::BUY ? 0 : 1,
+                                 static_cast<float>(update.price), update.quantity);
+        ring_.publish(frame);
+        sequence_.store(sequence, std::memory_order_release);
+
+        if (external_snapshots_.load(std::memory_order_relaxed)) {
+            if (snapshot_requested_.load(std::memory_order_relaxed)) {
+                snapshot_requested_.store(false, std::memory_order_relaxed);
+                publish_snapshot();
+            }
+        } else if (snapshot_interval_ > 0 && sequence % snapshot_interval_ == 0) {
+            publish_snapshot();
+        }
+    }
+
+    /**
+     * @brief Encodes the book's current depth as the latest snapshot
+     */
+    void publish_snapshot() {
+        if (!depth_source_) {
+            return;
+        }
+        std::vector<OrderBookLevel> bids = to_wire(depth_source_(Side::BUY, snapshot_levels_));
+        std::vector<OrderBookLevel> asks = to_wire(depth_source_(Side::SELL, snapshot_levels_));
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        install_snapshot(sequence, std::make_shared<const std::string>(
+            serialize_snapshot_response(sequence, wire_symbol_, bids, asks)));
+    }
+
+    /**
+     * @brief Leaves periodic snapshots to a snapshot builder (see
+     *        MarketDataSnapshotter); the book thread then builds one only
+     *        on request_snapshot()
+     */
+    void set_external_snapshots(bool external) {
+        external_snapshots_.store(external, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Asks the book thread for a snapshot at its next update (any
+     *        thread; subscribers call it when they cannot resync)
+     */
+    void request_snapshot() const {
+        snapshot_requested_.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Makes a snapshot frame the latest one (any thread)
+     * @param sequence Last update the frame includes
+     * @param frame SNAPSHOT_RESPONSE message
+     *
+     * Ignored if a newer snapshot is already installed.
+     */
+    void install_snapshot(uint64_t sequence, std::shared_ptr<const std::string> frame) {
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        if (snapshot_.frame && sequence < snapshot_.sequence) {
+            return;
+        }
+        snapshot_.sequence = sequence;
+        snapshot_.frame = std::move(frame);
+        snapshots_published_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // ========================================================================
+    // READERS (any thread)
+    // ========================================================================
+
+    MarketDataSnapshot latest_snapshot() const {
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        return snapshot_;
+    }
+
+    const BroadcastRing<MarketDataFrame>& ring() const { return ring_; }
+
+    /// Sequence of the last published update (ring position = sequence - 1)
+    uint64_t sequence() const { return sequence_.load(std::memory_order_acquire); }
+
+    uint64_t snapshots_published() const {
+        return snapshots_published_.load(std::memory_order_relaxed);
+    }
+
+    const std::string& symbol() const { return symbol_; }
+    const char* wire_symbol() const { return wire_symbol_; }
+    uint64_t snapshot_interval() const { return snapshot_interval_; }
+    size_t snapshot_levels() const { return snapshot_levels_; }
+
+private:
+    static std::vector<OrderBookLevel> to_wire(const std::vector<DepthLevel>& levels) {
+        std::vector<OrderBookLevel> wire;
+        wire.reserve(levels.size());
+        for (const auto& level : levels) {
+            wire.push_back({static_cast<float>(level.price),
+                            static_cast<uint64_t>(level.quantity)});
+        }
+        return wire;
+    }
+
+    std::string symbol_;
+    char wire_symbol_[4];
+    BroadcastRing<MarketDataFrame> ring_;
+    uint64_t snapshot_interval_ = 0;
+    size_t snapshot_levels_;
+    std::function<std::vector<DepthLevel>(Side, size_t)> depth_source_;
+
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> snapshots_published_{0};
+    std::atomic<bool> external_snapshots_{false};
+    mutable std::atomic<bool> snapshot_requested_{false};
+
+    mutable std::mutex snapshot_mutex_; // Cold: snapshot swap and late joiners
+    MarketDataSnapshot snapshot_;
+};
+
+/**
+ * @class MarketDataSubscriber
+ * @brief Rebuilds a publisher's depth from its snapshot and update frames
+ *
+ * Owned by one reader thread. Never blocks the publisher: if it falls a
+ * full ring behind it resynchronizes from the latest snapshot.
+ */
+class MarketDataSubscriber {
+public:
+    /// Level change as seen by this subscriber (side 0 = bid, 1 = ask; 0 = removed)
+    using LevelHandler = std::function<void(uint8_t side, float price, uint64_t quantity)>;
+
+    explicit MarketDataSubscriber(const MarketDataPublisher& publisher)
+        : publisher_(publisher) {}
+
+    /**
+     * @brief Reports every level this subscriber changes, including the
+     *        differences a snapshot resync makes
+     */
+    void set_level_handler(LevelHandler handler) { level_handler_ = std::move(handler); }
+
+    /**
+     * @brief Applies pending updates (resynchronizing first if needed)
+     * @param max_updates Upper bound on updates applied in this call
+     * @return Updates applied
+     */
+    size_t poll(size_t max_updates = SIZE_MAX) {
+        if (!synced_ && !resync()) {
+            return 0;
+        }
+
+        size_t applied = 0;
+        MarketDataFrame frame;
+        while (applied < max_updates) {
+            auto status = publisher_.ring().try_read(position_, frame);
+            if (status == BroadcastRing<MarketDataFrame>::ReadStatus::EMPTY) {
+                break;
+            }
+            if (status == BroadcastRing<MarketDataFrame>::ReadStatus::LAPPED) {
+                laps_++;
+                synced_ = false;
+                if (!resync()) {
+                    break; // Wait for a snapshot newer than the ring's tail
+                }
+                continue;
+            }
+            apply(frame);
+            applied++;
+        }
+        return applied;
+    }
+
+    /// Best-first levels (price, quantity) as last reconstructed
+    std::vector<OrderBookLevel> bids(size_t max_levels = SIZE_MAX) const {
+        return levels(bids_, max_levels);
+    }
+    std::vector<OrderBookLevel> asks(size_t max_levels = SIZE_MAX) const {
+        return levels(asks_, max_levels);
+    }
+
+    uint64_t sequence() const { return sequence_; }       ///< Last applied
+    uint64_t updates_applied() const { return updates_applied_; }
+    uint64_t snapshots_applied() const { return snapshots_applied_; }
+    uint64_t laps() const { return laps_; }               ///< Times overrun
+    bool synced() const { return synced_; }
+
+private:
+    /**
+     * @brief Replaces local depth with the latest snapshot
+     * @return false if there is no snapshot new enough to continue from
+     *         (one is then requested from the publisher)
+     */
+    bool resync() {
+        MarketDataSnapshot snapshot = publisher_.latest_snapshot();
+        if (!snapshot.frame || snapshot.sequence < publisher_.ring().oldest()) {
+            publisher_.request_snapshot();
+            return false;
+        }
+
+        const std::string& message = *snapshot.frame;
+        MessageHeader header = deserialize_header(message.data());
+        char symbol[4];
+        std::vector<OrderBookLevel> bids;
+        std::vector<OrderBookLevel> asks;
+        deserialize_snapshot_response(message.data() + MessageHeader::HEADER_SIZE,
+                                      header.length, symbol, bids, asks);
+
+        if (level_handler_) {
+            report_differences(0, bids_, bids);
+            report_differences(1, asks_, asks);
+        }
+        bids_.clear();
+        asks_.clear();
+        for (const auto& level : bids) {
+            bids_[level.price] = level.quantity;
+        }
+        for (const auto& level : asks) {
+            asks_[level.price] = level.quantity;
+        }
+        sequence_ = header.sequence;
+        position_ = header.sequence; // Ring position of update sequence + 1
+        synced_ = true;
+        snapshots_applied_++;
+        return true;
+    }
+
+    void apply(const MarketDataFrame& frame) {
+        MessageHeader header = deserialize_header(frame.bytes);
+        OrderBookUpdatePayload update =
+            deserialize_order_book_update(frame.bytes + MessageHeader::HEADER_SIZE);
+        if (update.side == 0) {
+            set_level(bids_, update.price, update.quantity);
+        } else {
+            set_level(asks_, update.price, update.quantity);
+        }
+        if (level_handler_) {
+            level_handler_(update.side, update.price,
+                           update.quantity > 0 ? static_cast<uint64_t>(update.quantity) : 0);
+        }
+        sequence_ = header.sequence;
+        updates_applied_++;
+    }
+
+    /// Reports levels that differ between local depth and a snapshot side
+    template <typename Map>
+    void report_differences(uint8_t side, const Map& current,
+                            const std::vector<OrderBookLevel>& snapshot) {
+        Map next;
+        for (const auto& level : snapshot) {
+            next[level.price] = level.quantity;
+        }
+        for (const auto& level : current) {
+            if (next.find(level.first) == next.end()) {
+                level_handler_(side, level.first, 0);
+            }
+        }
+        for (const auto& level : next) {
+            auto it = current.find(level.first);
+            if (it == current.end() || it->second != level.second) {
+                level_handler_(side, level.first, level.second);
+            }
+        }
+    }
+
+    template <typename Map>
+    static void set_level(Map& side, float price, int64_t quantity) {
+        if (quantity > 0) {
+            side[price] = static_cast<uint64_t>(quantity);
+        } else {
+            side.erase(price);
+        }
+    }
+
+    template <typename Map>
+    static std::vector<OrderBookLevel> levels(const Map& side, size_t max_levels) {
+        std::vector<OrderBookLevel> out;
+        for (auto it = side.begin(); it != side.end() && out.size() < max_levels; ++it) {
+            out.push_back({it->first, it->second});
+        }
+        return out;
+    }
+
+    const MarketDataPublisher& publisher_;
+    uint64_t position_ = 0;
+    uint64_t sequence_ = 0;
+    bool synced_ = false;
+    std::map<float, uint64_t, std::greater<float>> bids_;
+    std::map<float, uint64_t> asks_;
+    LevelHandler level_handler_;
+
+    uint64_t updates_applied_ = 0;
+    uint64_t snapshots_applied_ = 0;
+    uint64_t laps_ = 0;
+};
+
+/**
+ * @class MarketDataSnapshotter
+ * @brief Builds a publisher's periodic snapshots on a reader thread
+ *
+ * Rebuilds depth from the ring like any subscriber and installs a snapshot
+ * every snapshot_interval updates, so the book thread no longer serializes
+ * them. Create it before updates flow; it owns snapshots until destroyed.
+ * If it is lapped and the latest snapshot is too old to resync from, its
+ * reader asks the book thread for a fresh one.
+ */
+class MarketDataSnapshotter {
+public:
+    explicit MarketDataSnapshotter(MarketDataPublisher& publisher)
+        : publisher_(publisher), reader_(publisher) {
+        publisher_.set_external_snapshots(true);
+    }
+
+    ~MarketDataSnapshotter() { publisher_.set_external_snapshots(false); }
+
+    MarketDataSnapshotter(const MarketDataSnapshotter&) = delete;
+    MarketDataSnapshotter& operator=(const MarketDataSnapshotter&) = delete;
+
+    /**
+     * @brief Applies pending updates, installing a snapshot at each interval
+     * @return Snapshots installed
+     */
+    size_t poll() {
+        const uint64_t interval = publisher_.snapshot_interval();
+        size_t installed = 0;
+        while (true) {
+            const size_t budget = interval > 0
+                ? static_cast<size_t>(interval - reader_.sequence() % interval)
+                : SIZE_MAX;
+            const size_t applied = reader_.poll(budget);
+            if (!reader_.synced() || applied == 0) {
+                return installed;
+            }
+            if (interval > 0 && reader_.sequence() % interval == 0) {
+                const size_t levels = publisher_.snapshot_levels();
+                publisher_.install_snapshot(
+                    reader_.sequence(),
+                    std::make_shared<const std::string>(serialize_snapshot_response(
+                        reader_.sequence(), publisher_.wire_symbol(),
+                        reader_.bids(levels), reader_.asks(levels))));
+                installed++;
+            }
+        }
+    }
+
+    uint64_t sequence() const { return reader_.sequence(); }  ///< Last applied
+    uint64_t laps() const { return reader_.laps(); }
+
+private:
+    MarketDataPublisher& publisher_;
+    MarketDataSubscriber reader_;
+};
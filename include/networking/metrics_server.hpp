@@ -0,0 +1,230 @@
+#pragma once
+
+/**
+ * @file metrics_server.hpp
+ * @brief Minimal HTTP endpoint serving Prometheus metrics
+ *
+ * Runs one background thread that accepts scrapes on GET /metrics and
+ * renders whatever the registered collectors write. Collectors run on the
+ * server thread, so they must only read state that is safe to read
+ * concurrently (atomics, seqlock snapshots, histogram buckets) - a scrape
+ * never takes a lock the feed or worker threads hold.
+ *
+ * Usage:
+ *   MetricsServer server;
+ *   server.add_collector([&](PrometheusWriter& w) {
+ *       monitor.write_prometheus(w);
+ *   });
+ *   server.start(9464);          // curl http://127.0.0.1:9464/metrics
+ *   ...
+ *   server.stop();
+ */
+
+#include "common.hpp"
+#include "prometheus_writer.hpp"
+
+#include <poll.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Appends samples to a scrape
+using MetricsCollector = std::function<void(PrometheusWriter&)>;
+
+/**
+ * @class MetricsServer
+ * @brief Background HTTP/1.0 server for Prometheus scrapes
+ */
+class MetricsServer {
+public:
+    static constexpr int POLL_INTERVAL_MS = 100;  ///< Stop-flag check period
+    static constexpr int CLIENT_TIMEOUT_MS = 1000; ///< Per-request read timeout
+
+    MetricsServer() = default;
+
+    ~MetricsServer() {
+        stop();
+    }
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+     * @brief Registers a collector (call before start())
+     */
+    void add_collector(MetricsCollector collector) {
+        std::lock_guard<std::mutex> lock(collectors_mutex_);
+        collectors_.push_back(std::move(collector));
+    }
+
+    /**
+     * @brief Binds the listening socket and starts the server thread
+     * @param port TCP port (0 = ephemeral; see port())
+     * @param bind_address Interface to bind (loopback by default)
+     */
+    Result<void> start(int port, const std::string& bind_address = "127.0.0.1") {
+        if (running_) {
+            return Result<void>();
+        }
+
+        auto listener = socket_listen(bind_address, port);
+        if (!listener) {
+            return Result<void>::error(listener.error());
+        }
+        listen_fd_ = listener.value();
+        port_ = socket_local_port(listen_fd_);
+
+        should_stop_ = false;
+        running_ = true;
+        thread_ = std::thread([this]() { serve_loop(); });
+        return Result<void>();
+    }
+
+    /**
+     * @brief Stops the server thread and closes the listening socket
+     */
+    void stop() {
+        should_stop_ = true;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (listen_fd_ >= 0) {
+            close(listen_fd_);
+            listen_fd_ = -1;
+        }
+        running_ = false;
+    }
+
+    bool is_running() const { return running_; }
+
+    /**
+     * @brief Port the server is bound to (resolved when started with 0)
+     */
+    int port() const { return port_; }
+
+    /**
+     * @brief Number of successful /metrics responses
+     */
+    uint64_t scrape_count() const {
+        return scrapes_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Renders the current exposition body from all collectors
+     */
+    std::string render() const {
+        PrometheusWriter writer;
+        {
+            std::lock_guard<std::mutex> lock(collectors_mutex_);
+            for (const auto& collector : collectors_) {
+                collector(writer);
+            }
+        }
+        writer.counter("hft_metrics_scrapes_total", "Scrapes served",
+                       static_cast<double>(scrape_count()));
+        return writer.str();
+    }
+
+private:
+    void serve_loop() {
+        while (!should_stop_.load(std::memory_order_relaxed)) {
+            struct pollfd pfd;
+            pfd.fd = listen_fd_;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+
+            int ready = poll(&pfd, 1, POLL_INTERVAL_MS);
+            if (ready <= 0 || !(pfd.revents & POLLIN)) {
+                continue;
+            }
+
+            int client = accept(listen_fd_, nullptr, nullptr);
+            if (client < 0) {
+                continue;
+            }
+            handle_client(client);
+            close(client);
+        }
+    }
+
+    void handle_client(int client) {
+        struct timeval tv;
+        tv.tv_sec = CLIENT_TIMEOUT_MS / 1000;
+        tv.tv_usec = (CLIENT_TIMEOUT_MS % 1000) * 1000;
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+        // Read until the end of the request headers (bodies are ignored)
+        std::string request;
+        char buf[1024];
+        while (request.find("\r\n\r\n") == std::string::npos &&
+               request.find("\n\n") == std::string::npos &&
+               request.size() < 8192) {
+            ssize_t n = recv(client, buf, sizeof(buf), 0);
+            if (n <= 0) {
+                break;
+            }
+            request.append(buf, static_cast<size_t>(n));
+        }
+
+        const size_t line_end = request.find_first_of("\r\n");
+        const std::string request_line = request.substr(0, line_end);
+        const size_t method_end = request_line.find(' ');
+        const size_t path_end = request_line.find(' ', method_end + 1);
+        std::string method = request_line.substr(0, method_end);
+        std::string path = method_end == std::string::npos
+                               ? ""
+                               : request_line.substr(method_end + 1,
+                                                     path_end - method_end - 1);
+        const size_t query = path.find('?');
+        if (query != std::string::npos) {
+            path.resize(query);
+        }
+
+        if (method == "GET" && path == "/metrics") {
+            scrapes_.fetch_add(1, std::memory_order_relaxed);
+            send_response(client, "200 OK",
+                          "text/plain; version=0.0.4; charset=utf-8", render());
+        } else if (method == "GET" || method == "HEAD") {
+            send_response(client, "404 Not Found", "text/plain",
+                          "metrics are served at /metrics\n");
+        } else {
+            send_response(client, "405 Method Not Allowed", "text/plain",
+                          "only GET is supported\n");
+        }
+    }
+
+    static void send_response(int client, const std::string& status,
+                              const std::string& content_type,
+                              const std::string& body) {
+        std::string response = "HTTP/1.0 " + status + "\r\n"
+                               "Content-Type: " + content_type + "\r\n"
+                               "Content-Length: " + std::to_string(body.size()) +
+                               "\r\n"
+                               "Connection: close\r\n\r\n" +
+                               body;
+        size_t sent = 0;
+        while (sent < response.size()) {
+            ssize_t n = send(client, response.data() + sent,
+                             response.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return;
+            }
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    std::vector<MetricsCollector> collectors_;
+    mutable std::mutex collectors_mutex_;  ///< Registration vs. scrape only
+
+    std::thread thread_;
+    std::atomic<bool> should_stop_{false};
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> scrapes_{0};
+    int listen_fd_ = -1;
+    int port_ = 0;
+};
@@ -17,6 +17,11 @@
 
 // Queue and protocol includes (local copies from TCP-Socket)
 #include "spsc_queue.hpp"
+#include "thread_config.hpp"
+#include "wait_strategy.hpp"
+#include "latency_checkpoints.hpp"
+#include "trace_recorder.hpp"
+#include "prometheus_writer.hpp"
 #include "common.hpp"
 #include "text_protocol.hpp"
 #include "binary_protocol.hpp"
@@ -24,6 +29,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -63,6 +69,11 @@ struct FeedSource {
 /**
  * @struct FeedTick
  * @brief Unified tick structure for the aggregator
+ *
+ * Ticks decoded from a protocol message are stamped CP_PARSED, and
+ * CP_RECEIVED from recv_ts when the feed handler passes one. Take recv_ts
+ * from checkpoint_now_ns() when the socket is read, so the two checkpoints
+ * share a clock.
  */
 struct FeedTick {
     uint64_t timestamp;         ///< Exchange timestamp
@@ -70,6 +81,8 @@ struct FeedTick {
     double price;               ///< Trade/quote price
     int64_t volume;             ///< Volume
     uint64_t recv_timestamp_ns; ///< Local receive timestamp
+    LatencyCheckpoints checkpoints; ///< Per-stage timestamps
+    uint64_t trace_id = 0;      ///< Trace event id, stamped on enqueue (0 = untraced)
 
     FeedTick() : timestamp(0), price(0.0), volume(0), recv_timestamp_ns(0) {
         symbol[0] = '\0';
@@ -86,6 +99,7 @@ struct FeedTick {
         : timestamp(tt.timestamp), price(tt.price), volume(tt.volume),
           recv_timestamp_ns(recv_ts) {
         std::memcpy(symbol, tt.symbol, sizeof(symbol));
+        stamp_decoded();
     }
 
     // Construct from binary protocol tick
@@ -94,6 +108,15 @@ struct FeedTick {
           volume(tp.volume), recv_timestamp_ns(recv_ts) {
         std::memcpy(symbol, tp.symbol, 4);
         symbol[4] = '\0';
+        stamp_decoded();
+    }
+
+private:
+    void stamp_decoded() {
+        if (recv_timestamp_ns != 0) {
+            checkpoints.stamp(CP_RECEIVED, recv_timestamp_ns);
+        }
+        checkpoints.stamp(CP_PARSED);
     }
 };
 
@@ -112,6 +135,23 @@ struct FeedStatistics {
     std::chrono::steady_clock::time_point last_message_time;
 };
 
+/**
+ * @struct FeedCounters
+ * @brief Per-feed counters a monitoring thread can read while feeds run
+ *
+ * Each counter has a single writer, so updates are a relaxed load/store
+ * rather than a locked read-modify-write.
+ */
+struct FeedCounters {
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> processed{0};
+
+    static void bump(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+    }
+};
+
 /**
  * @struct AggregatedTick
  * @brief Tick with source information for cross-feed analysis
@@ -128,6 +168,44 @@ struct AggregatedTick {
         : tick(t), source(src), aggregator_recv_ns(now_ns()), source_index(idx) {}
 };
 
+/**
+ * @brief Appends one queue's depth/back-pressure telemetry to a scrape
+ * @param labels Identify the queue (e.g. {{"queue", "aggregator"}})
+ */
+inline void write_queue_telemetry(PrometheusWriter& writer,
+                                  const QueueTelemetrySnapshot& t,
+                                  const PrometheusWriter::Labels& labels) {
+    writer.gauge("hft_queue_high_water", "Max queue occupancy after a push",
+                 static_cast<double>(t.high_water), labels);
+    writer.counter("hft_queue_pushes_total", "Successful pushes",
+                   static_cast<double>(t.pushes), labels);
+    writer.counter("hft_queue_push_failures_total",
+                   "Pushes that found the queue full",
+                   static_cast<double>(t.push_failures), labels);
+    writer.counter("hft_queue_stalls_total",
+                   "Producer waits for the consumer to free a slot",
+                   static_cast<double>(t.stalls), labels);
+    writer.counter("hft_queue_stall_spins_total",
+                   "Retry iterations spent waiting on a full queue",
+                   static_cast<double>(t.stall_spins), labels);
+    writer.counter("hft_queue_stall_ns_total",
+                   "Producer time spent waiting on a full queue (ns)",
+                   static_cast<double>(t.stall_ns), labels);
+
+    // Occupancy as a fraction of capacity, one bucket per tenth
+    std::vector<std::pair<double, uint64_t>> buckets;
+    for (size_t i = 0; i < QueueTelemetrySnapshot::NUM_OCCUPANCY_BUCKETS; ++i) {
+        buckets.emplace_back(
+            static_cast<double>(i + 1) / QueueTelemetrySnapshot::NUM_OCCUPANCY_BUCKETS,
+            t.occupancy[i]);
+    }
+    writer.histogram("hft_queue_occupancy_ratio",
+                     "Sampled queue occupancy / capacity", buckets,
+                     t.capacity > 0 ? static_cast<double>(t.occupancy_sum) / t.capacity
+                                    : 0.0,
+                     t.occupancy_samples, labels);
+}
+
 /// Callback type for aggregated ticks
 using AggregatedTickCallback = std::function<void(const AggregatedTick&)>;
 
@@ -158,13 +236,17 @@ public:
 private:
     std::vector<FeedSource> sources_;
     std::vector<FeedStatistics> stats_;
+    std::deque<FeedCounters> counters_;  ///< Stable addresses; never moved
 
-    SPSCQueue<AggregatedTick> aggregated_queue_;
+    SPSCQueue<AggregatedTick, QueueTelemetry> aggregated_queue_;
     std::atomic<bool> should_stop_{false};
     std::atomic<bool> running_{false};
 
     std::thread processor_thread_;
     AggregatedTickCallback callback_;
+    AggregatedTickCallback capture_tap_;  ///< Sees every tick before callback_
+    QueueWaiter waiter_;                ///< Processor idle policy
+    ThreadConfig processor_thread_config_{"md-aggregator", -1};
 
     // Aggregate statistics
     std::atomic<uint64_t> total_messages_{0};
@@ -198,6 +280,7 @@ public:
         sources_.emplace_back(name, host, port, protocol);
         stats_.emplace_back();
         stats_.back().name = name;
+        counters_.emplace_back();
         return sources_.size() - 1;
     }
 
@@ -210,6 +293,7 @@ public:
         sources_.push_back(source);
         stats_.emplace_back();
         stats_.back().name = source.name;
+        counters_.emplace_back();
         return sources_.size() - 1;
     }
 
@@ -221,6 +305,15 @@ public:
         callback_ = std::move(callback);
     }
 
+    /**
+     * @brief Sets a tap that sees every tick, in dispatch order, before the
+     *        tick callback (used by TickCaptureWriter)
+     * @param tap Runs on the processor thread; set before start_all()
+     */
+    void set_capture_tap(AggregatedTickCallback tap) {
+        capture_tap_ = std::move(tap);
+    }
+
     /**
      * @brief Sets verbose mode for debugging
      * @param verbose Enable verbose logging
@@ -229,6 +322,31 @@ public:
         verbose_ = verbose;
     }
 
+    /**
+     * @brief Sets how the processor thread waits for ticks
+     * @param strategy Wait strategy (takes effect on next start_all())
+     */
+    void set_wait_strategy(WaitStrategy strategy) {
+        if (!running_) {
+            waiter_.set_strategy(strategy);
+        }
+    }
+
+    WaitStrategy get_wait_strategy() const { return waiter_.strategy(); }
+
+    /**
+     * @brief Sets the processor thread's name and CPU
+     * @param config Name and CPU (applies on next start_all())
+     */
+    void set_processor_thread_config(const ThreadConfig& config) {
+        processor_thread_config_ = config;
+    }
+
+    /**
+     * @brief Number of times the processor thread parked (SPIN_PARK only)
+     */
+    uint64_t processor_park_count() const { return waiter_.park_count(); }
+
     /**
      * @brief Injects a tick directly (for testing or simulation)
      * @param tick The tick to inject
@@ -238,8 +356,14 @@ public:
         if (source_index >= sources_.size()) return;
 
         AggregatedTick agg_tick(tick, sources_[source_index].name, source_index);
+        if (agg_tick.tick.trace_id == 0 && TraceRecorder::enabled()) {
+            agg_tick.tick.trace_id = next_trace_event_id();
+        }
+        TRACE_SPAN("aggregator.enqueue", agg_tick.tick.trace_id);
+        agg_tick.tick.checkpoints.stamp(CP_ENQUEUED);
         enqueue_tick(agg_tick);
         stats_[source_index].messages_received++;
+        FeedCounters::bump(counters_[source_index].received);
     }
 
     /**
@@ -263,7 +387,13 @@ public:
         start_time_ = std::chrono::steady_clock::now();
 
         // Start the aggregator processor thread
-        processor_thread_ = std::thread([this]() { processor_loop(); });
+        processor_thread_ = std::thread([this]() {
+            if (!apply_thread_config(processor_thread_config_) && verbose_) {
+                std::cerr << "[Aggregator] Could not pin processor to CPU "
+                          << processor_thread_config_.cpu << "\n";
+            }
+            processor_loop();
+        });
 
         if (verbose_) {
             std::cout << "[Aggregator] Started with " << sources_.size() << " feed sources\n";
@@ -277,6 +407,7 @@ public:
      */
     void stop() {
         should_stop_ = true;
+        waiter_.wake();
 
         // Wait for processor thread
         if (processor_thread_.joinable()) {
@@ -292,6 +423,7 @@ public:
      */
     void wait() {
         should_stop_ = true;
+        waiter_.wake();
         if (processor_thread_.joinable()) {
             processor_thread_.join();
         }
@@ -311,6 +443,18 @@ public:
      */
     size_t feed_count() const { return sources_.size(); }
 
+    /**
+     * @brief Feed names in index order
+     */
+    std::vector<std::string> feed_names() const {
+        std::vector<std::string> names;
+        names.reserve(sources_.size());
+        for (const auto& source : sources_) {
+            names.push_back(source.name);
+        }
+        return names;
+    }
+
     /**
      * @brief Gets statistics for a specific feed
      * @param index Feed index
@@ -336,6 +480,56 @@ public:
         return total_messages_.load(std::memory_order_relaxed);
     }
 
+    /**
+     * @brief Ticks waiting in the aggregation queue (approximate)
+     */
+    size_t queue_depth() const { return aggregated_queue_.size(); }
+
+    size_t queue_capacity() const { return aggregated_queue_.capacity(); }
+
+    /**
+     * @brief High-water mark, full pushes, stalls and sampled occupancy
+     */
+    QueueTelemetrySnapshot queue_telemetry() const {
+        return aggregated_queue_.telemetry_snapshot();
+    }
+
+    /**
+     * @brief Appends per-feed rates and queue depth for a Prometheus scrape
+     *
+     * Safe to call from any thread while the feeds run: only atomic
+     * counters and queue indices are read. Feeds must not be added
+     * concurrently.
+     */
+    void write_prometheus(PrometheusWriter& writer) const {
+        for (size_t i = 0; i < sources_.size(); ++i) {
+            const PrometheusWriter::Labels labels = {{"feed", sources_[i].name}};
+            writer.counter("hft_feed_messages_received_total",
+                           "Ticks received from the feed",
+                           static_cast<double>(counters_[i].received.load(
+                               std::memory_order_relaxed)),
+                           labels);
+            writer.counter("hft_feed_messages_processed_total",
+                           "Ticks dispatched by the aggregator",
+                           static_cast<double>(counters_[i].processed.load(
+                               std::memory_order_relaxed)),
+                           labels);
+        }
+        writer.counter("hft_aggregator_messages_total",
+                       "Ticks dispatched across all feeds",
+                       static_cast<double>(total_messages()));
+        writer.gauge("hft_aggregator_queue_depth",
+                     "Ticks waiting in the aggregation queue",
+                     static_cast<double>(queue_depth()));
+        writer.gauge("hft_aggregator_queue_capacity",
+                     "Aggregation queue capacity",
+                     static_cast<double>(queue_capacity()));
+        writer.counter("hft_aggregator_parks_total",
+                       "Times the processor thread parked",
+                       static_cast<double>(processor_park_count()));
+        write_queue_telemetry(writer, queue_telemetry(), {{"queue", "aggregator"}});
+    }
+
     /**
      * @brief Gets aggregate throughput across all feeds
      * @return Messages per second
@@ -370,6 +564,7 @@ public:
         std::cout << "Connected feeds: " << connected_count() << "\n";
         std::cout << "Total messages: " << total_messages_.load() << "\n";
         std::cout << "Aggregate throughput: " << aggregate_throughput() << " msg/sec\n";
+        queue_telemetry().print("aggregator");
     }
 
 private:
@@ -377,14 +572,25 @@ private:
      * @brief Enqueues a tick to the aggregation queue
      */
     void enqueue_tick(const AggregatedTick& tick) {
-        // Non-blocking enqueue with retry
-        int retries = 0;
-        while (!aggregated_queue_.push(tick) && !should_stop_) {
-            if (++retries > 100) {
-                std::this_thread::yield();
-                retries = 0;
+        if (!aggregated_queue_.push(tick)) {
+            // Full: retry, and record how long the consumer held us up
+            const uint64_t stall_start = now_ns();
+            uint64_t spins = 0;
+            int retries = 0;
+            while (!aggregated_queue_.push(tick)) {
+                if (should_stop_) break;
+                ++spins;
+                cpu_relax();
+                // Busy-spin never yields the core
+                if (++retries > 100 && waiter_.strategy() != WaitStrategy::BUSY_SPIN) {
+                    std::this_thread::yield();
+                    retries = 0;
+                }
             }
+            aggregated_queue_.telemetry().record_stall(spins, now_ns() - stall_start);
+            if (should_stop_) return;
         }
+        waiter_.notify();
     }
 
     /**
@@ -394,9 +600,14 @@ private:
         while (!should_stop_ || !aggregated_queue_.empty()) {
             auto tick_opt = aggregated_queue_.pop();
             if (tick_opt) {
+                tick_opt->tick.checkpoints.stamp(CP_DEQUEUED);
                 total_messages_.fetch_add(1, std::memory_order_relaxed);
 
+                if (capture_tap_) {
+                    capture_tap_(*tick_opt);
+                }
                 if (callback_) {
+                    TRACE_SPAN("aggregator.dispatch", tick_opt->tick.trace_id);
                     callback_(*tick_opt);
                 }
 
@@ -405,9 +616,14 @@ private:
                     stats_[tick_opt->source_index].last_message_time =
                         std::chrono::steady_clock::now();
                     stats_[tick_opt->source_index].messages_processed++;
+                    FeedCounters::bump(counters_[tick_opt->source_index].processed);
                 }
+                waiter_.on_work();
             } else {
-                std::this_thread::yield();
+                waiter_.idle([this]() {
+                    return should_stop_.load(std::memory_order_relaxed) ||
+                           !aggregated_queue_.empty();
+                });
             }
         }
     }
@@ -0,0 +1,509 @@
+#pragma once
+
+/**
+ * @file tick_capture.hpp
+ * @brief Record a live aggregator session to disk and replay it
+ *
+ * TickCaptureWriter taps MultiFeedAggregator's dispatch path and appends
+ * every AggregatedTick, in dispatch order, to a binary capture file.
+ * TickReplayer loads a capture and re-injects the ticks through
+ * inject_tick() at original pacing, N times faster, or as fast as
+ * possible, so a production latency spike can be reproduced offline.
+ *
+ * File layout (all integers in network byte order, like binary_protocol):
+ *
+ *   Header:  [6-byte magic "HFTCAP"][2-byte version][4-byte source count]
+ *            per source: [2-byte name length][name bytes]
+ *   Record:  [8 aggregator_recv_ns][8 recv_timestamp_ns][8 timestamp]
+ *            [8 price (IEEE-754 bits)][8 volume][4 source_index][8 symbol]
+ *
+ * Prices are stored as raw double bits, so replayed ticks are identical
+ * to the recorded ones.
+ */
+
+#include "multi_feed_aggregator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct CapturedTick
+ * @brief One record of a capture file
+ */
+struct CapturedTick {
+    FeedTick tick;                 ///< Exchange timestamp, symbol, price, volume, recv ts
+    uint32_t source_index = 0;     ///< Index into the capture's source table
+    uint64_t aggregator_recv_ns = 0; ///< When the aggregator enqueued it (pacing clock)
+
+    static constexpr size_t RECORD_SIZE = 8 + 8 + 8 + 8 + 8 + 4 + 8; // 52 bytes
+};
+
+namespace tick_capture_detail {
+
+constexpr char MAGIC[6] = {'H', 'F', 'T', 'C', 'A', 'P'};
+constexpr uint16_t VERSION = 1;
+
+inline void put_u64(std::string& out, uint64_t value) {
+    uint64_t net = htonll(value);
+    out.append(reinterpret_cast<const char*>(&net), 8);
+}
+
+inline void put_u32(std::string& out, uint32_t value) {
+    uint32_t net = htonl(value);
+    out.append(reinterpret_cast<const char*>(&net), 4);
+}
+
+inline void put_u16(std::string& out, uint16_t value) {
+    uint16_t net = htons(value);
+    out.append(reinterpret_cast<const char*>(&net), 2);
+}
+
+inline uint64_t get_u64(const char* data) {
+    uint64_t net;
+    std::memcpy(&net, data, 8);
+    return ntohll(net);
+}
+
+inline uint32_t get_u32(const char* data) {
+    uint32_t net;
+    std::memcpy(&net, data, 4);
+    return ntohl(net);
+}
+
+inline uint16_t get_u16(const char* data) {
+    uint16_t net;
+    std::memcpy(&net, data, 2);
+    return ntohs(net);
+}
+
+} // namespace tick_capture_detail
+
+/**
+ * @class TickCaptureWriter
+ * @brief Appends aggregated ticks to a capture file
+ *
+ * write() is called from the aggregator's processor thread only. It
+ * encodes records into a staging block; full blocks are handed to a
+ * writer thread that owns the file, so the processor thread never waits
+ * on disk. At most MAX_PENDING_BLOCKS blocks queue for the disk; beyond
+ * that records are dropped and counted rather than stalling the feed.
+ *
+ * A write error latches: capture stops, the failure is counted and
+ * failed() turns true, but nothing is thrown into the feed path.
+ */
+class TickCaptureWriter {
+public:
+    static constexpr size_t FLUSH_BYTES = 64 * 1024;
+    static constexpr size_t MAX_PENDING_BLOCKS = 16;
+
+    /**
+     * @brief Creates the file, stages the source table and starts the writer thread
+     * @param filename Capture file path (truncated)
+     * @param sources Feed names, indexed by AggregatedTick::source_index
+     * @throws std::runtime_error if the file cannot be created
+     */
+    TickCaptureWriter(const std::string& filename,
+                      const std::vector<std::string>& sources)
+        : filename_(filename), file_(filename, std::ios::binary | std::ios::trunc) {
+        if (!file_.is_open()) {
+            throw std::runtime_error("Cannot create capture file: " + filename);
+        }
+
+        // The header is the first staged block, written like any other
+        using namespace tick_capture_detail;
+        staging_.reserve(FLUSH_BYTES + CapturedTick::RECORD_SIZE);
+        staging_.append(MAGIC, sizeof(MAGIC));
+        put_u16(staging_, VERSION);
+        put_u32(staging_, static_cast<uint32_t>(sources.size()));
+        for (const auto& name : sources) {
+            put_u16(staging_, static_cast<uint16_t>(name.size()));
+            staging_.append(name);
+        }
+        writer_ = std::thread([this]() { writer_loop(); });
+    }
+
+    ~TickCaptureWriter() { close(); }
+
+    TickCaptureWriter(const TickCaptureWriter&) = delete;
+    TickCaptureWriter& operator=(const TickCaptureWriter&) = delete;
+
+    /**
+     * @brief Records the aggregator's ticks from now on
+     *
+     * Call before aggregator.start_all(); the writer must outlive the
+     * aggregator's processor thread.
+     */
+    void attach(MultiFeedAggregator& aggregator) {
+        aggregator.set_capture_tap([this](const AggregatedTick& tick) { write(tick); });
+    }
+
+    /**
+     * @brief Appends one tick (no-op once a write error has latched)
+     */
+    void write(const AggregatedTick& agg) {
+        ++records_;
+        if (failed_.load(std::memory_order_relaxed)) {
+            records_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        using namespace tick_capture_detail;
+        const FeedTick& t = agg.tick;
+        uint64_t price_bits;
+        std::memcpy(&price_bits, &t.price, 8);
+
+        put_u64(staging_, agg.aggregator_recv_ns);
+        put_u64(staging_, t.recv_timestamp_ns);
+        put_u64(staging_, t.timestamp);
+        put_u64(staging_, price_bits);
+        put_u64(staging_, static_cast<uint64_t>(t.volume));
+        put_u32(staging_, static_cast<uint32_t>(agg.source_index));
+        staging_.append(t.symbol, sizeof(t.symbol));
+        ++staged_records_;
+
+        if (staging_.size() >= FLUSH_BYTES) {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Hands staged records to the writer thread (does not wait for disk)
+     */
+    void flush() {
+        if (staging_.empty()) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.size() >= MAX_PENDING_BLOCKS) {
+            // Disk is behind: drop this block rather than stall the feed
+            records_dropped_.fetch_add(staged_records_, std::memory_order_relaxed);
+            staging_.clear();
+        } else {
+            pending_.push_back({std::move(staging_), staged_records_});
+            staging_.clear();
+            if (!spare_.empty()) {
+                staging_.swap(spare_.back());
+                spare_.pop_back();
+            }
+            staging_.reserve(FLUSH_BYTES + CapturedTick::RECORD_SIZE);
+            cv_.notify_one();
+        }
+        staged_records_ = 0;
+    }
+
+    /**
+     * @brief Writes everything staged, stops the writer thread and closes
+     *        the file (idempotent; never throws)
+     */
+    void close() {
+        if (!writer_.joinable()) return;
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closing_ = true;
+        }
+        cv_.notify_one();
+        writer_.join();
+        file_.close();
+    }
+
+    /// Records passed to write(), including any dropped
+    uint64_t records_written() const { return records_; }
+
+    /// Records lost to a full handoff or to a write error
+    uint64_t records_dropped() const {
+        return records_dropped_.load(std::memory_order_relaxed);
+    }
+
+    /// Failed writes to the file (capture stops after the first)
+    uint64_t write_errors() const { return write_errors_.load(std::memory_order_relaxed); }
+
+    bool failed() const { return failed_.load(std::memory_order_relaxed); }
+
+    const std::string& filename() const { return filename_; }
+
+private:
+    struct Block {
+        std::string bytes;
+        uint64_t records;
+    };
+
+    void writer_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this] { return closing_ || !pending_.empty(); });
+            if (pending_.empty()) break; // Closing and drained
+
+            Block block = std::move(pending_.front());
+            pending_.pop_front();
+            lock.unlock();
+
+            if (!failed_.load(std::memory_order_relaxed)) {
+                file_.write(block.bytes.data(),
+                            static_cast<std::streamsize>(block.bytes.size()));
+                file_.flush();
+                if (!file_) {
+                    write_errors_.fetch_add(1, std::memory_order_relaxed);
+                    failed_.store(true, std::memory_order_relaxed);
+                }
+            }
+            if (failed_.load(std::memory_order_relaxed)) {
+                records_dropped_.fetch_add(block.records, std::memory_order_relaxed);
+            }
+
+            block.bytes.clear();
+            lock.lock();
+            spare_.push_back(std::move(block.bytes));
+        }
+    }
+
+    std::string filename_;
+    std::ofstream file_;                 // Writer thread after construction
+
+    // Processor thread only
+    std::string staging_;
+    uint64_t staged_records_ = 0;
+    uint64_t records_ = 0;
+
+    // Handoff to the writer thread
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Block> pending_;          // Full blocks, oldest first
+    std::vector<std::string> spare_;     // Written blocks, capacity kept
+    bool closing_ = false;
+
+    std::atomic<bool> failed_{false};
+    std::atomic<uint64_t> write_errors_{0};
+    std::atomic<uint64_t> records_dropped_{0};
+    std::thread writer_;
+};
+
+/**
+ * @class TickCaptureReader
+ * @brief Reads a capture file produced by TickCaptureWriter
+ */
+class TickCaptureReader {
+public:
+    /**
+     * @brief Opens a capture and reads its source table
+     * @throws std::runtime_error on missing file, bad magic or version
+     */
+    explicit TickCaptureReader(const std::string& filename)
+        : filename_(filename), file_(filename, std::ios::binary) {
+        if (!file_.is_open()) {
+            throw std::runtime_error("Cannot open capture file: " + filename);
+        }
+
+        using namespace tick_capture_detail;
+        char header[sizeof(MAGIC) + 2 + 4];
+        if (!file_.read(header, sizeof(header)) ||
+            std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error("Not a tick capture file: " + filename);
+        }
+        version_ = get_u16(header + sizeof(MAGIC));
+        if (version_ != VERSION) {
+            throw std::runtime_error("Unsupported capture version " +
+                                     std::to_string(version_) + ": " + filename);
+        }
+
+        const uint32_t num_sources = get_u32(header + sizeof(MAGIC) + 2);
+        for (uint32_t i = 0; i < num_sources; ++i) {
+            char len_bytes[2];
+            if (!file_.read(len_bytes, 2)) {
+                throw std::runtime_error("Truncated capture header: " + filename);
+            }
+            std::string name(get_u16(len_bytes), '\0');
+            if (!file_.read(&name[0], static_cast<std::streamsize>(name.size()))) {
+                throw std::runtime_error("Truncated capture header: " + filename);
+            }
+            sources_.push_back(std::move(name));
+        }
+    }
+
+    /**
+     * @brief Reads the next record
+     * @return false at end of file (a trailing partial record is ignored)
+     */
+    bool next(CapturedTick& out) {
+        using namespace tick_capture_detail;
+        char rec[CapturedTick::RECORD_SIZE];
+        if (!file_.read(rec, sizeof(rec))) {
+            return false;
+        }
+
+        const char* p = rec;
+        out.aggregator_recv_ns = get_u64(p);
+        p += 8;
+        out.tick.recv_timestamp_ns = get_u64(p);
+        p += 8;
+        out.tick.timestamp = get_u64(p);
+        p += 8;
+        uint64_t price_bits = get_u64(p);
+        std::memcpy(&out.tick.price, &price_bits, 8);
+        p += 8;
+        out.tick.volume = static_cast<int64_t>(get_u64(p));
+        p += 8;
+        out.source_index = get_u32(p);
+        p += 4;
+        std::memcpy(out.tick.symbol, p, sizeof(out.tick.symbol));
+        out.tick.symbol[sizeof(out.tick.symbol) - 1] = '\0';
+        out.tick.checkpoints = LatencyCheckpoints();
+        return true;
+    }
+
+    /**
+     * @brief Reads every remaining record
+     */
+    std::vector<CapturedTick> read_all() {
+        std::vector<CapturedTick> ticks;
+        CapturedTick tick;
+        while (next(tick)) {
+            ticks.push_back(tick);
+        }
+        return ticks;
+    }
+
+    const std::vector<std::string>& sources() const { return sources_; }
+    uint16_t version() const { return version_; }
+
+private:
+    std::string filename_;
+    std::ifstream file_;
+    std::vector<std::string> sources_;
+    uint16_t version_ = 0;
+};
+
+/**
+ * @struct ReplayOptions
+ * @brief Pacing for TickReplayer::replay()
+ */
+struct ReplayOptions {
+    double speed = 1.0;            ///< 1 = original pacing, N = N times faster, 0 = flat out
+    bool add_missing_feeds = true; ///< Add capture sources the aggregator lacks
+    int64_t spin_threshold_ns = 50000; ///< Spin (not sleep) for the last stretch
+};
+
+/**
+ * @struct ReplayStats
+ * @brief Outcome of a replay
+ */
+struct ReplayStats {
+    uint64_t ticks_replayed = 0;
+    uint64_t ticks_skipped = 0;    ///< Source index unknown to the aggregator
+    uint64_t capture_span_ns = 0;  ///< First-to-last recorded timestamp
+    uint64_t replay_duration_ns = 0;
+    uint64_t max_lateness_ns = 0;  ///< Worst injection delay behind schedule
+    double mean_lateness_ns = 0.0;
+};
+
+/**
+ * @class TickReplayer
+ * @brief Re-injects a capture into an aggregator
+ *
+ * The capture is loaded into memory up front so disk reads never perturb
+ * pacing. Each tick is stamped CP_RECEIVED at injection: the replayer
+ * stands in for the feed handler's socket read.
+ */
+class TickReplayer {
+public:
+    /**
+     * @brief Loads a capture file
+     * @throws std::runtime_error if the file cannot be read
+     */
+    explicit TickReplayer(const std::string& filename) {
+        TickCaptureReader reader(filename);
+        sources_ = reader.sources();
+        ticks_ = reader.read_all();
+    }
+
+    const std::vector<std::string>& sources() const { return sources_; }
+    const std::vector<CapturedTick>& ticks() const { return ticks_; }
+    size_t size() const { return ticks_.size(); }
+
+    /**
+     * @brief Adds capture sources beyond the aggregator's feed count
+     *
+     * Source indices are preserved, so an aggregator configured with the
+     * same feeds as the recording session is used as-is.
+     */
+    void add_missing_feeds(MultiFeedAggregator& aggregator) const {
+        for (size_t i = aggregator.feed_count(); i < sources_.size(); ++i) {
+            aggregator.add_feed(sources_[i], "replay", 0);
+        }
+    }
+
+    /**
+     * @brief Injects every tick into a running aggregator
+     *
+     * Blocks the calling thread (which acts as the feed thread) until the
+     * last tick has been injected.
+     */
+    ReplayStats replay(MultiFeedAggregator& aggregator,
+                       const ReplayOptions& options = ReplayOptions()) const {
+        ReplayStats stats;
+        if (ticks_.empty()) {
+            return stats;
+        }
+        if (options.add_missing_feeds) {
+            add_missing_feeds(aggregator);
+        }
+
+        const uint64_t first_ns = ticks_.front().aggregator_recv_ns;
+        stats.capture_span_ns = ticks_.back().aggregator_recv_ns - first_ns;
+        const bool paced = options.speed > 0.0;
+        const uint64_t start_ns = now_ns();
+        double total_lateness = 0.0;
+
+        for (const auto& captured : ticks_) {
+            if (captured.source_index >= aggregator.feed_count()) {
+                ++stats.ticks_skipped;
+                continue;
+            }
+
+            if (paced) {
+                const uint64_t offset = static_cast<uint64_t>(
+                    (captured.aggregator_recv_ns - first_ns) / options.speed);
+                const uint64_t target = start_ns + offset;
+                wait_until(target, options.spin_threshold_ns);
+                const uint64_t now = now_ns();
+                const uint64_t late = now > target ? now - target : 0;
+                stats.max_lateness_ns = std::max(stats.max_lateness_ns, late);
+                total_lateness += static_cast<double>(late);
+            }
+
+            FeedTick tick = captured.tick;
+            tick.checkpoints.stamp(CP_RECEIVED);
+            aggregator.inject_tick(tick, captured.source_index);
+            ++stats.ticks_replayed;
+        }
+
+        stats.replay_duration_ns = now_ns() - start_ns;
+        if (paced && stats.ticks_replayed > 0) {
+            stats.mean_lateness_ns = total_lateness / stats.ticks_replayed;
+        }
+        return stats;
+    }
+
+private:
+    static void wait_until(uint64_t target_ns, int64_t spin_threshold_ns) {
+        int64_t remaining = static_cast<int64_t>(target_ns - now_ns());
+        if (remaining > spin_threshold_ns) {
+            std::this_thread::sleep_for(
+                std::chrono::nanoseconds(remaining - spin_threshold_ns));
+        }
+        while (static_cast<int64_t>(target_ns - now_ns()) > 0) {
+            cpu_relax();
+        }
+    }
+
+    std::vector<std::string> sources_;
+    std::vector<CapturedTick> ticks_;
+};
@@ -0,0 +1,159 @@
+// include/fill_index.hpp
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+/**
+ * Append-only fill indexing
+ *
+ * Fills live in one append-only std::vector; indexes hold 32-bit offsets
+ * into it (offsets, unlike pointers, survive the vector growing). Each
+ * account or symbol keeps a posting list of offsets in fixed-size chunks,
+ * so appending never copies earlier postings. Queries return a FillView
+ * over (records, postings) that iterates in fill order without copying.
+ */
+
+/**
+ * @brief Append-only vector of fixed-size chunks (no relocation on growth)
+ */
+template <typename T, size_t ChunkSize = 64> class ChunkedVector {
+public:
+  void push_back(const T &value) {
+    if (size_ % ChunkSize == 0) {
+      chunks_.push_back(std::make_unique<std::array<T, ChunkSize>>());
+    }
+    (*chunks_.back())[size_ % ChunkSize] = value;
+    ++size_;
+  }
+
+  const T &operator[](size_t i) const {
+    return (*chunks_[i / ChunkSize])[i % ChunkSize];
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    chunks_.clear();
+    size_ = 0;
+  }
+
+private:
+  std::vector<std::unique_ptr<std::array<T, ChunkSize>>> chunks_;
+  size_t size_ = 0;
+};
+
+/// Offsets into a fill vector, in append order
+using FillPostingList = ChunkedVector<uint32_t, 64>;
+
+/**
+ * @brief Non-owning view of the fills selected by a posting list
+ *
+ * Valid until the next fill is appended (like a vector iterator).
+ */
+template <typename Record> class FillView {
+public:
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Record;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Record *;
+    using reference = const Record &;
+
+    iterator(const FillView *view, size_t pos) : view_(view), pos_(pos) {}
+
+    reference operator*() const { return (*view_)[pos_]; }
+    pointer operator->() const { return &(*view_)[pos_]; }
+    iterator &operator++() {
+      ++pos_;
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++pos_;
+      return tmp;
+    }
+    bool operator==(const iterator &other) const { return pos_ == other.pos_; }
+    bool operator!=(const iterator &other) const { return pos_ != other.pos_; }
+
+  private:
+    const FillView *view_;
+    size_t pos_;
+  };
+
+  FillView() = default;
+  FillView(const std::vector<Record> *records, const FillPostingList *postings)
+      : records_(records), postings_(postings) {}
+
+  size_t size() const { return postings_ ? postings_->size() : 0; }
+  bool empty() const { return size() == 0; }
+
+  const Record &operator[](size_t i) const {
+    return (*records_)[(*postings_)[i]];
+  }
+  const Record &front() const { return (*this)[0]; }
+  const Record &back() const { return (*this)[size() - 1]; }
+
+  iterator begin() const { return iterator(this, 0); }
+  iterator end() const { return iterator(this, size()); }
+
+  /**
+   * @brief Copies the selected fills (for callers that need ownership)
+   */
+  std::vector<Record> to_vector() const {
+    std::vector<Record> out;
+    out.reserve(size());
+    for (const auto &record : *this) {
+      out.push_back(record);
+    }
+    return out;
+  }
+
+private:
+  const std::vector<Record> *records_ = nullptr;
+  const FillPostingList *postings_ = nullptr;
+};
+
+/**
+ * @brief Dense fill_id -> offset index for monotonically assigned ids
+ */
+class FillIdIndex {
+public:
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  void insert(uint64_t id, uint32_t offset) {
+    if (offsets_.empty()) {
+      first_id_ = id;
+    }
+    if (id < first_id_) {
+      return; // Ids are assigned in increasing order; ignore stragglers
+    }
+    const size_t slot = static_cast<size_t>(id - first_id_);
+    if (slot >= offsets_.size()) {
+      offsets_.resize(slot + 1, NONE);
+    }
+    offsets_[slot] = offset;
+  }
+
+  uint32_t find(uint64_t id) const {
+    if (offsets_.empty() || id < first_id_ || id - first_id_ >= offsets_.size()) {
+      return NONE;
+    }
+    return offsets_[static_cast<size_t>(id - first_id_)];
+  }
+
+  void clear() {
+    offsets_.clear();
+    first_id_ = 0;
+  }
+
+private:
+  std::vector<uint32_t> offsets_;
+  uint64_t first_id_ = 0;
+};
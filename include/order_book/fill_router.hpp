@@ -2,7 +2,9 @@
 #pragma once
 
 #include "fill.hpp"
+#include "fill_index.hpp"
 #include "order.hpp"
+#include "position_ledger.hpp"
 #include "types.hpp"
 #include <functional>
 #include <unordered_map>
@@ -49,6 +51,8 @@ struct EnhancedFill {
         routing_time(Clock::now()) {}
 };
 
+using EnhancedFillView = FillView<EnhancedFill>;
+
 // Callback types
 using FillCallback = std::function<void(const EnhancedFill &)>;
 using SelfTradeCallback =
@@ -56,10 +60,16 @@ using SelfTradeCallback =
 
 class FillRouter {
 private:
-  // Fill history
+  // Fill history (append-only) and its indexes
   std::vector<EnhancedFill> routed_fills_;
+  FillIdIndex fill_id_index_;
+  std::unordered_map<int, FillPostingList> fills_by_account_;
+  std::unordered_map<std::string, FillPostingList> fills_by_symbol_;
   uint64_t next_fill_id_;
 
+  // Per-account positions and P&L, updated as each fill is routed
+  PositionLedger ledger_;
+
   // Callbacks
   std::vector<FillCallback> fill_callbacks_;
   std::vector<SelfTradeCallback> self_trade_callbacks_;
@@ -101,14 +111,20 @@ public:
   bool route_fill(const Fill &fill, const Order &aggressive_order,
                   const Order &passive_order, const std::string &symbol);
 
-  // Query fills
+  // Query fills (views are valid until the next fill is routed)
   const std::vector<EnhancedFill> &get_all_fills() const {
     return routed_fills_;
   }
-  std::vector<EnhancedFill> get_fills_for_account(int account_id) const;
-  std::vector<EnhancedFill>
-  get_fills_for_symbol(const std::string &symbol) const;
+  EnhancedFillView get_fills_for_account(int account_id) const;
+  EnhancedFillView get_fills_for_symbol(const std::string &symbol) const;
   EnhancedFill *get_fill_by_id(uint64_t fill_id);
+  const EnhancedFill *get_fill_by_id(uint64_t fill_id) const;
+
+  // Positions (safe to read from any thread)
+  const PositionLedger &get_ledger() const { return ledger_; }
+  Position get_position(int account_id, const std::string &symbol) const {
+    return ledger_.get_position(account_id, symbol);
+  }
 
   // Statistics
   uint64_t get_self_trades_prevented() const { return self_trades_prevented_; }
@@ -119,6 +135,8 @@ public:
 private:
   bool is_self_trade(const Order &aggressive, const Order &passive) const;
   void calculate_fees(EnhancedFill &fill, bool aggressive_is_buyer);
+  void index_fill(uint32_t offset);
+  void update_positions(const EnhancedFill &fill);
   void notify_callbacks(const EnhancedFill &fill);
   void notify_self_trade(int account_id, const Order &order1,
                          const Order &order2);
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "latency_checkpoints.hpp"
 #include "rolling_statistics.hpp"
+#include "trace_recorder.hpp"
 
 // Include order book headers (local copies)
 #include "order_book.hpp"
@@ -88,6 +90,52 @@ private:
             std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
     }
 
+    /**
+     * @brief Shared add_order body; checkpoints may be null
+     */
+    bool add_order_stamped(const Order& order, LatencyCheckpoints* checkpoints) {
+        TRACE_SPAN("book.add_order", current_trace_event());
+
+        // Forward to underlying book
+        const uint64_t fills_before =
+            checkpoints ? book_.get_fill_router().get_total_fills() : 0;
+        if (!book_.add_order(order)) {
+            // Rejected pre-trade: the book and its analytics are unchanged
+            if (checkpoints) {
+                checkpoints->stamp(CP_BOOK_DONE);
+            }
+            return false;
+        }
+
+        // Track volume by side
+        if (order.side == Side::BUY) {
+            total_buy_volume_ += order.quantity;
+        } else {
+            total_sell_volume_ += order.quantity;
+        }
+        order_count_++;
+
+        if (checkpoints) {
+            const FillRouter& router = book_.get_fill_router();
+            if (router.get_total_fills() > fills_before) {
+                auto routed = router.get_all_fills().back().routing_time;
+                checkpoints->stamp(
+                    CP_FILL_ROUTED,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        routed.time_since_epoch()).count());
+            }
+            checkpoints->stamp(CP_BOOK_DONE);
+        }
+
+        // Update analytics after order is processed
+        update_analytics();
+
+        if (checkpoints) {
+            checkpoints->stamp(CP_ANALYTICS_DONE);
+        }
+        return true;
+    }
+
 public:
     /**
      * @brief Constructs a MicrostructureOrderBook with the given symbol
@@ -105,21 +153,21 @@ public:
      * @param order The order to add
      *
      * This is the main entry point that adds microstructure tracking.
+     * @return false if pre-trade risk checks rejected the order
      */
-    void add_order(Order order) {
-        // Track volume by side
-        if (order.side == Side::BUY) {
-            total_buy_volume_ += order.quantity;
-        } else {
-            total_sell_volume_ += order.quantity;
-        }
-        order_count_++;
-
-        // Forward to underlying book
-        book_.add_order(order);
+    bool add_order(Order order) {
+        return add_order_stamped(order, nullptr);
+    }
 
-        // Update analytics after order is processed
-        update_analytics();
+    /**
+     * @brief Adds an order and stamps the pipeline checkpoints it passes
+     * @param order The order to add
+     * @param checkpoints Receives CP_FILL_ROUTED (if the order traded),
+     *        CP_BOOK_DONE and CP_ANALYTICS_DONE
+     * @return false if pre-trade risk checks rejected the order
+     */
+    bool add_order(Order order, LatencyCheckpoints& checkpoints) {
+        return add_order_stamped(order, &checkpoints);
     }
 
     /**
@@ -300,10 +348,32 @@ public:
 
     const std::vector<Fill>& get_fills() const { return book_.get_fills(); }
     const std::vector<AccountFill>& get_account_fills() const { return book_.get_account_fills(); }
+    FillView<AccountFill> get_fills_for_account(int account_id) const { return book_.get_fills_for_account(account_id); }
     const std::vector<EnhancedFill>& get_enhanced_fills() const { return book_.get_enhanced_fills(); }
 
     FillRouter& get_fill_router() { return book_.get_fill_router(); }
     const FillRouter& get_fill_router() const { return book_.get_fill_router(); }
+    void enable_depth_tracking() { book_.enable_depth_tracking(); }
+    void disable_depth_tracking() { book_.disable_depth_tracking(); }
+    void register_depth_listener(DepthListener listener) {
+        book_.register_depth_listener(std::move(listener));
+    }
+    std::vector<DepthLevel> get_depth(Side side, size_t max_levels) const {
+        return book_.get_depth(side, max_levels);
+    }
+    uint64_t depth_sequence() const { return book_.depth_sequence(); }
+
+    void enable_risk_checks(const RiskLimits& defaults,
+                            size_t max_accounts = PreTradeRiskGate::DEFAULT_MAX_ACCOUNTS) {
+        book_.enable_risk_checks(defaults, max_accounts);
+    }
+    PreTradeRiskGate* get_risk_gate() { return book_.get_risk_gate(); }
+    const PreTradeRiskGate* get_risk_gate() const { return book_.get_risk_gate(); }
+    RiskReject last_risk_reject() const { return book_.last_risk_reject(); }
+
+    Position get_position(int account_id) const {
+        return book_.get_fill_router().get_position(account_id, book_.get_symbol());
+    }
 
     void enable_self_trade_prevention(bool enable) { book_.enable_self_trade_prevention(enable); }
     void set_fee_schedule(double maker_rate, double taker_rate) { book_.set_fee_schedule(maker_rate, taker_rate); }
@@ -4,9 +4,12 @@
 #include "fill.hpp"
 #include "fill_router.hpp"
 #include "order.hpp"
+#include "pre_trade_risk.hpp"
 #include "snapshot.hpp"
 #include "timer.hpp"
+#include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <queue>
 #include <unordered_map>
@@ -25,6 +28,21 @@ struct AccountFill {
         symbol(sym) {}
 };
 
+// Incremental L2: new aggregate visible quantity at one price level
+struct BookLevelUpdate {
+  uint64_t sequence; // Per book, +1 for every level change
+  Side side;
+  double price;
+  int64_t quantity; // 0 = level removed
+};
+
+struct DepthLevel {
+  double price;
+  int64_t quantity;
+};
+
+using DepthListener = std::function<void(const BookLevelUpdate &)>;
+
 class OrderBook {
 private:
   std::priority_queue<Order, std::vector<Order>, BidComparator> bids_;
@@ -33,8 +51,10 @@ private:
   std::unordered_map<int, Order> cancelled_orders_; // id -> order
   std::vector<Fill> fills_;
   std::vector<AccountFill> account_fills_; // NEW: Track fills with account info
+  std::unordered_map<int, FillPostingList> account_fill_index_; // account -> offsets
   std::vector<long long> insertion_latencies_ns_;
   std::unique_ptr<FillRouter> fill_router_;
+  std::unique_ptr<PreTradeRiskGate> risk_gate_; // Null = no pre-trade checks
 
   bool execute_trade(Order &aggressive_order, Order &passive_order);
   void update_order_state(Order &order);
@@ -63,6 +83,7 @@ private:
   std::multimap<double, Order> stop_buys_;  // Buy stops: trigger at or above
   std::multimap<double, Order> stop_sells_; // Sell stops: trigger at or below
   double last_trade_price_;
+  RiskReject last_risk_reject_ = RiskReject::NONE;
 
   size_t snapshot_counter_;
 
@@ -84,6 +105,24 @@ private:
   void trigger_stop_order_immediately(Order &stop_order, double ref_price);
   void finalize_after_matching(Order &o);
 
+  // Incremental depth (maintained only while tracking is enabled)
+  bool depth_tracking_ = false;
+  uint64_t depth_sequence_ = 0;
+  std::map<double, int64_t, std::greater<double>> bid_depth_;
+  std::map<double, int64_t> ask_depth_;
+  std::vector<DepthListener> depth_listeners_;
+
+  static int64_t visible_quantity(const Order &order);
+  void apply_depth_change(Side side, double price, int64_t delta);
+  void notify_depth(Side side, double price, int64_t quantity);
+  void rebuild_depth(bool notify = false);
+  template <typename Map>
+  void notify_depth_diff(Side side, const Map &before, const Map &after);
+
+  // Pre-trade risk helpers
+  double risk_reference_price() const;
+  void release_risk_if_done(int order_id, int account_id);
+
 public:
   OrderBook(const std::string &symbol = "DEFAULT");
 
@@ -91,7 +130,8 @@ public:
   // OPERATIONAL METHODS
   // ==================================================================
 
-  void add_order(Order o);
+  // Returns false if the pre-trade risk gate rejected the order
+  bool add_order(Order o);
   std::optional<Order> get_best_bid() const;
   std::optional<Order> get_best_ask() const;
   std::optional<double> get_spread() const;
@@ -103,8 +143,8 @@ public:
   // Get fills with account information
   const std::vector<AccountFill> &get_account_fills() const;
 
-  // Get fills for a specific account
-  std::vector<AccountFill> get_fills_for_account(int account_id) const;
+  // Get fills for a specific account (view valid until the next fill)
+  FillView<AccountFill> get_fills_for_account(int account_id) const;
 
   // Configure fill routing
   void enable_self_trade_prevention(bool enable) {
@@ -115,6 +155,28 @@ public:
     fill_router_->set_fee_schedule(maker_rate, taker_rate);
   }
 
+  // Incremental L2 depth: per-level aggregate visible quantity, updated as
+  // orders rest, trade and cancel (icebergs contribute their display size)
+  void enable_depth_tracking();
+  void disable_depth_tracking();
+  bool is_depth_tracking() const { return depth_tracking_; }
+  void register_depth_listener(DepthListener listener) {
+    depth_listeners_.push_back(std::move(listener));
+  }
+  std::vector<DepthLevel> get_depth(Side side, size_t max_levels) const;
+  uint64_t depth_sequence() const { return depth_sequence_; }
+
+  // Pre-trade risk (disabled until enabled; rejects never reach the book)
+  void enable_risk_checks(
+      const RiskLimits &defaults,
+      size_t max_accounts = PreTradeRiskGate::DEFAULT_MAX_ACCOUNTS) {
+    risk_gate_ = std::make_unique<PreTradeRiskGate>(defaults, max_accounts);
+  }
+  void disable_risk_checks() { risk_gate_.reset(); }
+  PreTradeRiskGate *get_risk_gate() { return risk_gate_.get(); }
+  const PreTradeRiskGate *get_risk_gate() const { return risk_gate_.get(); }
+  RiskReject last_risk_reject() const { return last_risk_reject_; }
+
   // Get fills with enhanced metadata
   const std::vector<EnhancedFill> &get_enhanced_fills() const {
     return fill_router_->get_all_fills();
@@ -0,0 +1,512 @@
+#pragma once
+
+// Include order book headers (local copies)
+#include "event.hpp"
+#include "order.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @enum WorkloadOpType
+ * @brief Kind of order book message in a workload
+ */
+enum class WorkloadOpType : uint8_t {
+    ADD,        ///< GTC limit order
+    CANCEL,     ///< Cancel a resting order
+    AMEND,      ///< Cancel/replace: new price and quantity
+    MARKET,     ///< IOC market order
+    ICEBERG,    ///< GTC limit with hidden reserve
+    STOP        ///< Stop-market order
+};
+
+/**
+ * @struct WorkloadOp
+ * @brief One pre-generated order book message
+ */
+struct WorkloadOp {
+    WorkloadOpType type = WorkloadOpType::ADD;
+    Side side = Side::BUY;
+    int order_id = 0;
+    int account_id = 1;
+    int quantity = 0;
+    int peak_size = 0;           ///< ICEBERG only
+    double price = 0.0;          ///< Limit price, or stop price for STOP
+};
+
+/**
+ * @enum DepthProfile
+ * @brief How resting orders spread away from the touch
+ */
+enum class DepthProfile {
+    TOUCH_HEAVY,    ///< Geometric in distance: most orders at or near the touch
+    HUMP,           ///< Peaks a few ticks behind the touch
+    FLAT            ///< Uniform out to max_distance_ticks
+};
+
+/**
+ * @struct WorkloadConfig
+ * @brief Parameters of a synthetic order-flow workload
+ *
+ * Defaults approximate a liquid equity: roughly nine in ten messages
+ * are cancels or replaces of resting orders, and prices cluster within
+ * a few ticks of the touch.
+ *
+ * The weights are not the realized shares: cancels are throttled while
+ * the book is below target_resting_orders, so in steady state cancels
+ * track adds and replaces make up most of the flow (about 8% adds, 9%
+ * cancels, 79% replaces with the defaults).
+ */
+struct WorkloadConfig {
+    uint64_t seed = 42;
+    int first_order_id = 1;
+    int num_accounts = 100;
+
+    // Reference market: mid random-walks one tick at a time
+    double mid_price = 100.0;
+    double tick_size = 0.01;
+    int spread_ticks = 1;
+    double mid_move_probability = 0.01;     ///< Per message
+
+    // Message mix (relative weights)
+    double add_weight = 0.05;
+    double cancel_weight = 0.45;
+    double amend_weight = 0.48;
+    double market_weight = 0.012;
+    double iceberg_weight = 0.006;
+    double stop_weight = 0.002;
+
+    // Price placement relative to the touch
+    DepthProfile depth_profile = DepthProfile::TOUCH_HEAVY;
+    double touch_distance_p = 0.35;         ///< Geometric parameter (TOUCH_HEAVY)
+    int hump_ticks = 3;                     ///< Peak distance (HUMP)
+    int max_distance_ticks = 50;
+    double aggressive_fraction = 0.02;      ///< Limits priced through the touch
+
+    // Quantity: lognormal in lots
+    int lot_size = 100;
+    double quantity_median_lots = 2.0;
+    double quantity_sigma = 0.8;
+    int iceberg_peak_lots = 1;
+
+    // Queue depth: cancels thin out below this many resting orders
+    size_t target_resting_orders = 2000;
+
+    // Bursts: runs of cancel/replace quote flicker near the touch
+    double burst_probability = 0.0;         ///< Chance per message to start a burst
+    size_t burst_length = 200;
+    double burst_cancel_share = 0.9;        ///< Cancels+amends within a burst
+};
+
+/**
+ * @struct WorkloadMix
+ * @brief Message counts by type
+ */
+struct WorkloadMix {
+    size_t counts[6] = {};
+
+    size_t total() const {
+        size_t n = 0;
+        for (size_t c : counts) n += c;
+        return n;
+    }
+
+    double share(WorkloadOpType type) const {
+        size_t n = total();
+        return n > 0 ? static_cast<double>(counts[static_cast<size_t>(type)]) / n : 0.0;
+    }
+
+    void print() const {
+        static const char* names[] = {"add", "cancel", "amend", "market", "iceberg", "stop"};
+        std::cout << std::fixed << std::setprecision(1) << "  Mix:";
+        for (size_t i = 0; i < 6; ++i) {
+            std::cout << " " << names[i] << " "
+                      << share(static_cast<WorkloadOpType>(i)) * 100 << "%";
+        }
+        std::cout << " (" << total() << " msgs)\n";
+    }
+};
+
+/**
+ * @class OrderFlowWorkload
+ * @brief Seeded generator and recorder of realistic order book workloads
+ *
+ * Messages are generated up front into a vector, so benchmarks time
+ * only the book. The generator keeps its own model of the market (a
+ * random-walk mid and the set of orders it believes are resting) so
+ * cancels and amends target live orders. Orders that filled in the book
+ * may still be cancelled; those cancels are rejected by the book, as
+ * they would be in production.
+ *
+ * Workloads can be saved in, and replayed from, the OrderEvent CSV
+ * format written by OrderBook::save_events().
+ */
+class OrderFlowWorkload {
+private:
+    struct LiveOrder {
+        int order_id;
+        Side side;
+    };
+
+    WorkloadConfig config_;
+    std::mt19937_64 rng_;
+    std::vector<LiveOrder> live_;
+    int next_order_id_;
+    int64_t mid_ticks_;
+    size_t burst_remaining_ = 0;
+
+public:
+    explicit OrderFlowWorkload(const WorkloadConfig& config = WorkloadConfig())
+        : config_(config),
+          rng_(config.seed),
+          next_order_id_(config.first_order_id),
+          mid_ticks_(std::llround(config.mid_price / config.tick_size)) {}
+
+    const WorkloadConfig& get_config() const { return config_; }
+
+    /**
+     * @brief Generates the next messages
+     * @param count Number of messages
+     * @return Messages in arrival order
+     *
+     * Successive calls continue the same stream.
+     */
+    std::vector<WorkloadOp> generate(size_t count) {
+        std::vector<WorkloadOp> ops;
+        ops.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            ops.push_back(next());
+        }
+        return ops;
+    }
+
+    /**
+     * @brief Generates one message
+     */
+    WorkloadOp next() {
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        if (unit(rng_) < config_.mid_move_probability) {
+            mid_ticks_ += unit(rng_) < 0.5 ? -1 : 1;
+            mid_ticks_ = std::max<int64_t>(mid_ticks_, config_.spread_ticks + config_.max_distance_ticks + 1);
+        }
+
+        WorkloadOpType type = pick_type(unit);
+        if ((type == WorkloadOpType::CANCEL || type == WorkloadOpType::AMEND) && live_.empty()) {
+            type = WorkloadOpType::ADD;
+        }
+
+        WorkloadOp op;
+        op.type = type;
+        switch (type) {
+            case WorkloadOpType::CANCEL: {
+                size_t idx = pick_live();
+                op.order_id = live_[idx].order_id;
+                op.side = live_[idx].side;
+                live_[idx] = live_.back();
+                live_.pop_back();
+                break;
+            }
+            case WorkloadOpType::AMEND: {
+                const LiveOrder& target = live_[pick_live()];
+                op.order_id = target.order_id;
+                op.side = target.side;
+                op.price = passive_price(op.side);
+                op.quantity = draw_quantity();
+                break;
+            }
+            case WorkloadOpType::MARKET:
+                op.order_id = next_order_id_++;
+                op.side = draw_side();
+                op.quantity = draw_quantity();
+                break;
+            case WorkloadOpType::STOP: {
+                op.order_id = next_order_id_++;
+                op.side = draw_side();
+                op.quantity = draw_quantity();
+                // Buy stops above the ask, sell stops below the bid
+                int offset = config_.spread_ticks + 1 + draw_distance();
+                op.price = ticks_to_price(op.side == Side::BUY ? mid_ticks_ + offset
+                                                               : mid_ticks_ - offset);
+                break;
+            }
+            case WorkloadOpType::ADD:
+            case WorkloadOpType::ICEBERG: {
+                op.order_id = next_order_id_++;
+                op.side = draw_side();
+                op.quantity = draw_quantity();
+                if (unit(rng_) < config_.aggressive_fraction) {
+                    op.price = aggressive_price(op.side);
+                } else {
+                    op.price = passive_price(op.side);
+                }
+                if (type == WorkloadOpType::ICEBERG) {
+                    op.peak_size = std::max(1, config_.iceberg_peak_lots) * config_.lot_size;
+                    op.quantity = std::max(op.quantity, op.peak_size * 4);
+                }
+                live_.push_back({op.order_id, op.side});
+                break;
+            }
+        }
+
+        op.account_id = 1 + static_cast<int>(rng_() % static_cast<uint64_t>(std::max(1, config_.num_accounts)));
+        return op;
+    }
+
+    /**
+     * @brief Number of orders the generator believes are resting
+     */
+    size_t live_orders() const { return live_.size(); }
+
+    /**
+     * @brief Counts messages by type
+     */
+    static WorkloadMix mix(const std::vector<WorkloadOp>& ops) {
+        WorkloadMix m;
+        for (const auto& op : ops) {
+            m.counts[static_cast<size_t>(op.type)]++;
+        }
+        return m;
+    }
+
+    /**
+     * @brief Applies one message to a book
+     * @param book OrderBook or MicrostructureOrderBook
+     * @param op Message
+     * @return false if the book rejected a cancel or amend
+     */
+    template <typename Book>
+    static bool apply(Book& book, const WorkloadOp& op) {
+        switch (op.type) {
+            case WorkloadOpType::ADD:
+                book.add_order(Order(op.order_id, op.account_id, op.side, op.price,
+                                     op.quantity, TimeInForce::GTC));
+                return true;
+            case WorkloadOpType::ICEBERG:
+                book.add_order(Order(op.order_id, op.account_id, op.side, op.price,
+                                     op.quantity, op.peak_size, TimeInForce::GTC));
+                return true;
+            case WorkloadOpType::MARKET:
+                book.add_order(Order(op.order_id, op.account_id, op.side,
+                                     OrderType::MARKET, op.quantity));
+                return true;
+            case WorkloadOpType::STOP:
+                book.add_order(Order(op.order_id, op.account_id, op.side, op.price,
+                                     op.quantity, true));
+                return true;
+            case WorkloadOpType::CANCEL:
+                return book.cancel_order(op.order_id);
+            case WorkloadOpType::AMEND:
+                return book.amend_order(op.order_id, op.price, op.quantity);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Writes messages as an OrderEvent CSV file
+     * @param filename Output path
+     * @param ops Messages
+     * @throws std::runtime_error if the file cannot be written
+     *
+     * STOP messages are written as NEW MARKET orders with the stop price
+     * in the price column, since the event format has no stop type.
+     */
+    static void save(const std::string& filename, const std::vector<WorkloadOp>& ops) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+
+        file << OrderEvent::csv_header() << "\n";
+        TimePoint ts{};
+        for (const auto& op : ops) {
+            ts += std::chrono::nanoseconds(1);
+            file << to_event(op, ts).to_csv() << "\n";
+        }
+    }
+
+    /**
+     * @brief Loads messages from an OrderEvent CSV file
+     * @param filename File written by save() or OrderBook::save_events()
+     * @return Messages in file order; FILL events are skipped
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    static std::vector<WorkloadOp> load(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+
+        std::vector<WorkloadOp> ops;
+        std::string line;
+        std::getline(file, line);  // Skip header
+        while (std::getline(file, line)) {
+            if (line.empty()) continue;
+
+            OrderEvent event = OrderEvent::from_csv(line);
+            WorkloadOp op;
+            op.order_id = event.order_id;
+            op.account_id = event.account_id > 0 ? event.account_id : 1;
+            op.side = event.side;
+
+            switch (event.type) {
+                case EventType::NEW_ORDER:
+                    op.quantity = event.quantity;
+                    op.price = event.price;
+                    if (event.order_type == OrderType::MARKET) {
+                        bool has_stop = std::isfinite(event.price) && event.price > 0.0;
+                        op.type = has_stop ? WorkloadOpType::STOP : WorkloadOpType::MARKET;
+                    } else if (event.peak_size > 0) {
+                        op.type = WorkloadOpType::ICEBERG;
+                        op.peak_size = event.peak_size;
+                    } else {
+                        op.type = WorkloadOpType::ADD;
+                    }
+                    break;
+                case EventType::CANCEL_ORDER:
+                    op.type = WorkloadOpType::CANCEL;
+                    break;
+                case EventType::AMEND_ORDER:
+                    op.type = WorkloadOpType::AMEND;
+                    op.price = event.new_price;
+                    op.quantity = event.new_quantity;
+                    break;
+                case EventType::FILL:
+                    continue;
+            }
+            ops.push_back(op);
+        }
+        return ops;
+    }
+
+private:
+    WorkloadOpType pick_type(std::uniform_real_distribution<double>& unit) {
+        // Bursts: quote flicker near the touch
+        if (burst_remaining_ == 0 && config_.burst_probability > 0.0 &&
+            unit(rng_) < config_.burst_probability) {
+            burst_remaining_ = config_.burst_length;
+        }
+        if (burst_remaining_ > 0) {
+            burst_remaining_--;
+            double u = unit(rng_);
+            if (u < config_.burst_cancel_share) {
+                return u < config_.burst_cancel_share / 2 ? WorkloadOpType::CANCEL
+                                                          : WorkloadOpType::AMEND;
+            }
+            return WorkloadOpType::ADD;
+        }
+
+        // Thin the book out more slowly while it is below target depth
+        double depth_scale = config_.target_resting_orders > 0
+            ? std::min(1.0, static_cast<double>(live_.size()) / config_.target_resting_orders)
+            : 1.0;
+        double weights[6] = {
+            config_.add_weight,
+            config_.cancel_weight * depth_scale,
+            config_.amend_weight,
+            config_.market_weight,
+            config_.iceberg_weight,
+            config_.stop_weight
+        };
+
+        double total = 0.0;
+        for (double w : weights) total += w;
+        double u = unit(rng_) * total;
+        for (size_t i = 0; i < 6; ++i) {
+            if (u < weights[i]) return static_cast<WorkloadOpType>(i);
+            u -= weights[i];
+        }
+        return WorkloadOpType::ADD;
+    }
+
+    size_t pick_live() {
+        return static_cast<size_t>(rng_() % live_.size());
+    }
+
+    Side draw_side() {
+        return (rng_() & 1) ? Side::BUY : Side::SELL;
+    }
+
+    int draw_quantity() {
+        std::lognormal_distribution<double> lots(std::log(config_.quantity_median_lots),
+                                                 config_.quantity_sigma);
+        int n = static_cast<int>(std::lround(lots(rng_)));
+        return std::max(1, n) * config_.lot_size;
+    }
+
+    /// Ticks behind the touch, per the depth profile
+    int draw_distance() {
+        int d = 0;
+        switch (config_.depth_profile) {
+            case DepthProfile::TOUCH_HEAVY: {
+                std::geometric_distribution<int> geo(config_.touch_distance_p);
+                d = geo(rng_);
+                break;
+            }
+            case DepthProfile::HUMP: {
+                std::poisson_distribution<int> poisson(std::max(0, config_.hump_ticks));
+                d = poisson(rng_);
+                break;
+            }
+            case DepthProfile::FLAT: {
+                std::uniform_int_distribution<int> flat(0, config_.max_distance_ticks);
+                d = flat(rng_);
+                break;
+            }
+        }
+        return std::min(d, config_.max_distance_ticks);
+    }
+
+    int64_t bid_ticks() const { return mid_ticks_ - config_.spread_ticks / 2; }
+    int64_t ask_ticks() const { return bid_ticks() + std::max(1, config_.spread_ticks); }
+
+    double passive_price(Side side) {
+        int d = draw_distance();
+        return ticks_to_price(side == Side::BUY ? bid_ticks() - d : ask_ticks() + d);
+    }
+
+    double aggressive_price(Side side) {
+        int through = 1 + static_cast<int>(rng_() % 3);
+        return ticks_to_price(side == Side::BUY ? ask_ticks() + through - 1
+                                                : bid_ticks() - through + 1);
+    }
+
+    double ticks_to_price(int64_t ticks) const {
+        return static_cast<double>(ticks) * config_.tick_size;
+    }
+
+    static OrderEvent to_event(const WorkloadOp& op, TimePoint ts) {
+        switch (op.type) {
+            case WorkloadOpType::CANCEL:
+                return OrderEvent(ts, EventType::CANCEL_ORDER, op.order_id, op.account_id);
+            case WorkloadOpType::AMEND:
+                return OrderEvent(ts, op.order_id, std::optional<double>(op.price),
+                                  std::optional<int>(op.quantity), op.account_id);
+            case WorkloadOpType::MARKET:
+                return OrderEvent(ts, op.order_id, op.side, OrderType::MARKET,
+                                  TimeInForce::IOC, 0.0, op.quantity, 0, op.account_id);
+            case WorkloadOpType::STOP:
+                return OrderEvent(ts, op.order_id, op.side, OrderType::MARKET,
+                                  TimeInForce::GTC, op.price, op.quantity, 0, op.account_id);
+            case WorkloadOpType::ICEBERG:
+                return OrderEvent(ts, op.order_id, op.side, OrderType::LIMIT,
+                                  TimeInForce::GTC, op.price, op.quantity, op.peak_size,
+                                  op.account_id);
+            case WorkloadOpType::ADD:
+            default:
+                return OrderEvent(ts, op.order_id, op.side, OrderType::LIMIT,
+                                  TimeInForce::GTC, op.price, op.quantity, 0, op.account_id);
+        }
+    }
+};
@@ -0,0 +1,342 @@
+// include/position_ledger.hpp
+#pragma once
+
+#include "seqlock.hpp"
+#include "symbol_table.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Real-time position and P&L ledger
+ *
+ * Updated once per fill on the routing thread, in O(1):
+ * - Accounts and symbols are interned to dense ids; each account holds a
+ *   vector of position slots indexed by SymbolId
+ * - Each slot publishes its Position through a SeqLock, so risk and
+ *   reporting threads read a consistent position without blocking fills
+ * - Unrealized P&L is marked against each symbol's last trade at read
+ *   time, so a trade does not have to touch every account holding the
+ *   symbol
+ *
+ * Slot creation (first fill for an account/symbol pair) is the only step
+ * that takes a lock; readers can cache a PositionHandle to skip it.
+ */
+
+/**
+ * @brief Position state for one (account, symbol) pair
+ *
+ * Trivially copyable so it can be published through a SeqLock.
+ */
+struct Position {
+  int64_t net_quantity = 0;   // + long, - short
+  double average_cost = 0.0;  // Entry price of the open quantity
+  double realized_pnl = 0.0;  // From closed quantity, before fees
+  double unrealized_pnl = 0.0; // Open quantity marked to last_price
+  double last_price = 0.0;    // Symbol's last trade (mark)
+  double maker_fees = 0.0;
+  double taker_fees = 0.0;
+  int64_t bought_quantity = 0;
+  int64_t sold_quantity = 0;
+  uint64_t fill_count = 0;
+  uint64_t last_fill_id = 0;
+
+  double total_fees() const { return maker_fees + taker_fees; }
+  double net_pnl() const { return realized_pnl + unrealized_pnl - total_fees(); }
+
+  /**
+   * @brief Applies one execution
+   * @param quantity Signed quantity (+ buy, - sell)
+   * @param price Execution price
+   */
+  void apply(int64_t quantity, double price) {
+    if (quantity > 0) {
+      bought_quantity += quantity;
+    } else {
+      sold_quantity -= quantity;
+    }
+
+    if (net_quantity == 0 || (net_quantity > 0) == (quantity > 0)) {
+      // Opening or adding: volume-weighted entry price
+      const double held = static_cast<double>(std::llabs(net_quantity));
+      const double added = static_cast<double>(std::llabs(quantity));
+      average_cost = (average_cost * held + price * added) / (held + added);
+      net_quantity += quantity;
+      return;
+    }
+
+    // Reducing, closing or flipping
+    const int64_t closed = std::min(std::llabs(quantity), std::llabs(net_quantity));
+    const double direction = net_quantity > 0 ? 1.0 : -1.0;
+    realized_pnl += static_cast<double>(closed) * (price - average_cost) * direction;
+    net_quantity += quantity;
+    if (net_quantity == 0) {
+      average_cost = 0.0;
+    } else if ((net_quantity > 0) != (direction > 0)) {
+      average_cost = price; // Flipped: the remainder opened at this price
+    }
+  }
+
+  /**
+   * @brief Marks the open quantity to a price
+   */
+  void mark(double price) {
+    last_price = price;
+    unrealized_pnl =
+        net_quantity != 0
+            ? static_cast<double>(net_quantity) * (price - average_cost)
+            : 0.0;
+  }
+};
+
+/**
+ * @brief Live ledger slot for one (account, symbol) pair
+ */
+struct PositionSlot {
+  int account_id = 0;
+  SymbolId symbol_id = INVALID_SYMBOL_ID;
+  Position live;                 // Writer only
+  SeqLock<Position> published;   // Any thread
+};
+
+/**
+ * @brief Stable reader-side reference to a slot (valid for the ledger's life)
+ */
+class PositionHandle {
+public:
+  PositionHandle() = default;
+  PositionHandle(const PositionSlot *slot, const std::atomic<double> *mark)
+      : slot_(slot), mark_(mark) {}
+
+  bool valid() const { return slot_ != nullptr; }
+
+  /**
+   * @brief Latest published position, marked to the symbol's last trade
+   */
+  Position read() const {
+    if (!slot_) {
+      return Position();
+    }
+    Position p = slot_->published.read();
+    p.mark(mark_->load(std::memory_order_relaxed));
+    return p;
+  }
+
+  uint64_t version() const { return slot_ ? slot_->published.version() : 0; }
+
+private:
+  const PositionSlot *slot_ = nullptr;
+  const std::atomic<double> *mark_ = nullptr;
+};
+
+class PositionLedger {
+public:
+  /**
+   * @brief Records one side of a fill
+   * @param account_id Account that traded
+   * @param symbol Symbol traded
+   * @param quantity Signed quantity (+ bought, - sold)
+   * @param price Execution price
+   * @param fee Fee charged to this side
+   * @param is_maker Whether this side provided liquidity
+   * @param fill_id Fill identifier (for audit)
+   *
+   * Single writer (the routing thread).
+   */
+  void record(int account_id, const std::string &symbol, int64_t quantity,
+              double price, double fee, bool is_maker, uint64_t fill_id) {
+    record(account_id, intern_symbol(symbol), quantity, price, fee, is_maker,
+           fill_id);
+  }
+
+  void record(int account_id, SymbolId symbol_id, int64_t quantity,
+              double price, double fee, bool is_maker, uint64_t fill_id) {
+    PositionSlot &slot = slot_for(account_id, symbol_id);
+    Position &p = slot.live;
+    p.apply(quantity, price);
+    if (is_maker) {
+      p.maker_fees += fee;
+    } else {
+      p.taker_fees += fee;
+    }
+    p.fill_count++;
+    p.last_fill_id = fill_id;
+    p.mark(price);
+    slot.published.write(p);
+    marks_[symbol_id]->store(price, std::memory_order_relaxed);
+    records_.store(records_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Records a trade print that moves the mark without a fill
+   */
+  void mark(const std::string &symbol, double price) {
+    SymbolId id = intern_symbol(symbol);
+    marks_[id]->store(price, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Interns a symbol (writer thread; cached for repeated symbols)
+   */
+  SymbolId intern_symbol(const std::string &symbol) {
+    if (last_symbol_id_ != INVALID_SYMBOL_ID && symbol == last_symbol_) {
+      return last_symbol_id_;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    SymbolId id = symbols_.intern(symbol);
+    while (marks_.size() <= id) {
+      marks_.push_back(std::make_unique<std::atomic<double>>(0.0));
+    }
+    last_symbol_ = symbol;
+    last_symbol_id_ = id;
+    return id;
+  }
+
+  // ========================================================================
+  // READERS (any thread)
+  // ========================================================================
+
+  /**
+   * @brief Handle for repeated lock-free reads of one position
+   * @return Invalid handle if the pair has never traded
+   */
+  PositionHandle handle(int account_id, const std::string &symbol) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SymbolId symbol_id = symbols_.find(symbol);
+    auto it = account_index_.find(account_id);
+    if (symbol_id == INVALID_SYMBOL_ID || it == account_index_.end()) {
+      return PositionHandle();
+    }
+    const auto &row = accounts_[it->second]->slots;
+    if (symbol_id >= row.size() || !row[symbol_id]) {
+      return PositionHandle();
+    }
+    return PositionHandle(row[symbol_id].get(), marks_[symbol_id].get());
+  }
+
+  /**
+   * @brief Current position (flat Position if never traded)
+   */
+  Position get_position(int account_id, const std::string &symbol) const {
+    return handle(account_id, symbol).read();
+  }
+
+  /**
+   * @brief Sum over every symbol the account traded
+   *
+   * Quantities are summed across symbols; average_cost and last_price
+   * are left at zero.
+   */
+  Position get_account_totals(int account_id) const {
+    Position total;
+    for (const auto &h : account_handles(account_id)) {
+      Position p = h.read();
+      total.net_quantity += p.net_quantity;
+      total.realized_pnl += p.realized_pnl;
+      total.unrealized_pnl += p.unrealized_pnl;
+      total.maker_fees += p.maker_fees;
+      total.taker_fees += p.taker_fees;
+      total.bought_quantity += p.bought_quantity;
+      total.sold_quantity += p.sold_quantity;
+      total.fill_count += p.fill_count;
+      total.last_fill_id = std::max(total.last_fill_id, p.last_fill_id);
+    }
+    return total;
+  }
+
+  double last_price(const std::string &symbol) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SymbolId id = symbols_.find(symbol);
+    return id != INVALID_SYMBOL_ID ? marks_[id]->load(std::memory_order_relaxed)
+                                   : 0.0;
+  }
+
+  size_t account_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return accounts_.size();
+  }
+
+  /**
+   * @brief Fill sides recorded (two per routed fill)
+   */
+  uint64_t total_records() const {
+    return records_.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct AccountRow {
+    int account_id = 0;
+    std::vector<std::unique_ptr<PositionSlot>> slots; // Indexed by SymbolId
+  };
+
+  std::vector<PositionHandle> account_handles(int account_id) const {
+    std::vector<PositionHandle> handles;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = account_index_.find(account_id);
+    if (it == account_index_.end()) {
+      return handles;
+    }
+    const auto &row = accounts_[it->second]->slots;
+    for (size_t id = 0; id < row.size(); ++id) {
+      if (row[id]) {
+        handles.emplace_back(row[id].get(), marks_[id].get());
+      }
+    }
+    return handles;
+  }
+
+  /**
+   * @brief Dense slot lookup; creates the slot under the lock on first use
+   */
+  PositionSlot &slot_for(int account_id, SymbolId symbol_id) {
+    AccountRow *row;
+    auto it = account_index_.find(account_id);
+    if (it != account_index_.end()) {
+      row = accounts_[it->second].get();
+      if (symbol_id < row->slots.size() && row->slots[symbol_id]) {
+        return *row->slots[symbol_id]; // Hot path: no lock
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    it = account_index_.find(account_id);
+    if (it == account_index_.end()) {
+      it = account_index_.emplace(account_id, static_cast<uint32_t>(accounts_.size())).first;
+      accounts_.push_back(std::make_unique<AccountRow>());
+      accounts_.back()->account_id = account_id;
+    }
+    row = accounts_[it->second].get();
+    if (symbol_id >= row->slots.size()) {
+      row->slots.resize(symbol_id + 1);
+    }
+    if (!row->slots[symbol_id]) {
+      row->slots[symbol_id] = std::make_unique<PositionSlot>();
+      row->slots[symbol_id]->account_id = account_id;
+      row->slots[symbol_id]->symbol_id = symbol_id;
+    }
+    return *row->slots[symbol_id];
+  }
+
+  // Structure (account index, rows, symbols, marks) changes only under
+  // mutex_; the writer reads it without the lock since it is the only
+  // thread that changes it
+  std::unordered_map<int, uint32_t> account_index_; // account -> row
+  std::vector<std::unique_ptr<AccountRow>> accounts_;
+  SymbolTable symbols_;
+  std::vector<std::unique_ptr<std::atomic<double>>> marks_; // By SymbolId
+  mutable std::mutex mutex_;
+
+  // Writer-only symbol cache (a router usually serves one symbol)
+  std::string last_symbol_;
+  SymbolId last_symbol_id_ = INVALID_SYMBOL_ID;
+
+  std::atomic<uint64_t> records_{0};
+};
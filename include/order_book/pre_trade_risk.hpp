@@ -0,0 +1,358 @@
+// include/pre_trade_risk.hpp
+#pragma once
+
+#include "order.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * Pre-trade risk gate
+ *
+ * Runs in front of OrderBook::add_order with per-account limits:
+ * - Max order quantity and notional
+ * - Price collar around a reference price (last trade, else BBO mid)
+ * - Max open orders
+ * - Message rate (token bucket: sustained rate plus burst)
+ * - Max absolute position, from the book's own fills
+ * - Market orders are rejected under a notional limit until a reference
+ *   price exists (they cannot be priced)
+ *
+ * Account state lives in a dense array indexed by account id, sized at
+ * construction, so a check is an array index plus arithmetic: no lookups,
+ * no allocation. Every limit is evaluated into a fail mask and the reject
+ * reason is the lowest set bit, so the accept path has a single branch.
+ * The order's creation timestamp drives the token bucket (no clock read,
+ * and replays throttle the same way they did live).
+ *
+ * Single writer (the book's thread); counters are relaxed atomics so a
+ * metrics thread can read them.
+ */
+
+enum class RiskReject : uint8_t {
+  NONE = 0,
+  UNKNOWN_ACCOUNT,
+  MAX_QUANTITY,
+  MAX_NOTIONAL,
+  PRICE_COLLAR,
+  MAX_OPEN_ORDERS,
+  RATE_LIMIT,
+  POSITION_LIMIT,
+  NO_REFERENCE_PRICE,
+  COUNT
+};
+
+inline const char *risk_reject_name(RiskReject reason) {
+  switch (reason) {
+  case RiskReject::NONE:
+    return "none";
+  case RiskReject::UNKNOWN_ACCOUNT:
+    return "unknown_account";
+  case RiskReject::MAX_QUANTITY:
+    return "max_quantity";
+  case RiskReject::MAX_NOTIONAL:
+    return "max_notional";
+  case RiskReject::PRICE_COLLAR:
+    return "price_collar";
+  case RiskReject::MAX_OPEN_ORDERS:
+    return "max_open_orders";
+  case RiskReject::RATE_LIMIT:
+    return "rate_limit";
+  case RiskReject::POSITION_LIMIT:
+    return "position_limit";
+  case RiskReject::NO_REFERENCE_PRICE:
+    return "no_reference_price";
+  default:
+    return "unknown";
+  }
+}
+
+/**
+ * @brief Per-account limits (defaults leave every check disabled)
+ */
+struct RiskLimits {
+  int64_t max_order_quantity = std::numeric_limits<int64_t>::max();
+  double max_order_notional = std::numeric_limits<double>::infinity();
+  double price_collar = std::numeric_limits<double>::infinity(); // Fraction of reference, e.g. 0.05
+  uint32_t max_open_orders = std::numeric_limits<uint32_t>::max();
+  double max_orders_per_second = 0.0; // 0 = no throttle
+  double burst = 1.0;                 // Token bucket depth
+  int64_t max_position = std::numeric_limits<int64_t>::max(); // Absolute net quantity
+};
+
+class PreTradeRiskGate {
+public:
+  static constexpr size_t DEFAULT_MAX_ACCOUNTS = 1024;
+  static constexpr size_t NUM_REASONS = static_cast<size_t>(RiskReject::COUNT);
+
+  /**
+   * @param defaults Limits applied to every account until overridden
+   * @param max_accounts Account ids [0, max_accounts) are accepted
+   */
+  explicit PreTradeRiskGate(const RiskLimits &defaults = RiskLimits(),
+                            size_t max_accounts = DEFAULT_MAX_ACCOUNTS)
+      : accounts_(max_accounts) {
+    for (auto &account : accounts_) {
+      reset_account(account, defaults);
+    }
+  }
+
+  PreTradeRiskGate(const PreTradeRiskGate &) = delete;
+  PreTradeRiskGate &operator=(const PreTradeRiskGate &) = delete;
+
+  // ========================================================================
+  // CONFIGURATION (between orders, on the book's thread)
+  // ========================================================================
+
+  void set_limits(int account_id, const RiskLimits &limits) {
+    if (valid(account_id)) {
+      AccountState &account = accounts_[account_id];
+      account.limits = limits;
+      account.tokens = limits.burst;
+    }
+  }
+
+  void set_default_limits(const RiskLimits &limits) {
+    for (auto &account : accounts_) {
+      account.limits = limits;
+      account.tokens = limits.burst;
+    }
+  }
+
+  const RiskLimits &get_limits(int account_id) const {
+    return accounts_[valid(account_id) ? account_id : 0].limits;
+  }
+
+  // ========================================================================
+  // HOT PATH
+  // ========================================================================
+
+  /**
+   * @brief Checks an order and, if accepted, counts it as open
+   * @param order Order about to enter the book
+   * @param reference_price Last trade or BBO mid (<= 0 if unknown)
+   * @return RiskReject::NONE if accepted
+   */
+  RiskReject check(const Order &order, double reference_price) {
+    bump(checks_);
+    if (!valid(order.account_id)) {
+      return reject(RiskReject::UNKNOWN_ACCOUNT);
+    }
+    AccountState &account = accounts_[order.account_id];
+
+    // Token bucket refill from the order's creation time
+    account.tokens = refilled_tokens(account, order);
+    account.last_refill_ns = std::max(account.last_refill_ns, timestamp_ns(order));
+
+    const uint32_t fails = fail_mask(account, order, reference_price,
+                                     account.tokens, account.open_orders);
+    if (fails != 0) {
+      account.rejects++;
+      return reject(static_cast<RiskReject>(__builtin_ctz(fails)));
+    }
+
+    account.tokens -= 1.0;
+    account.open_orders++;
+    bump(accepted_);
+    return RiskReject::NONE;
+  }
+
+  /**
+   * @brief Evaluates an order without changing any state or counter
+   * @param replacing The order replaces one of the account's open orders
+   *        (cancel/replace), so it does not need a new open-order slot
+   *
+   * Lets the book pre-check an amend before cancelling the original.
+   */
+  RiskReject evaluate(const Order &order, double reference_price,
+                      bool replacing = false) const {
+    if (!valid(order.account_id)) {
+      return RiskReject::UNKNOWN_ACCOUNT;
+    }
+    const AccountState &account = accounts_[order.account_id];
+    const uint32_t open_orders =
+        account.open_orders - ((replacing && account.open_orders > 0) ? 1 : 0);
+    const uint32_t fails = fail_mask(account, order, reference_price,
+                                     refilled_tokens(account, order), open_orders);
+    return fails != 0 ? static_cast<RiskReject>(__builtin_ctz(fails))
+                      : RiskReject::NONE;
+  }
+
+  /**
+   * @brief Counts a reject found by evaluate() as a checked, rejected order
+   */
+  void record_reject(int account_id, RiskReject reason) {
+    bump(checks_);
+    if (valid(account_id)) {
+      accounts_[account_id].rejects++;
+    }
+    reject(reason);
+  }
+
+  /**
+   * @brief An accepted order left the book (filled, cancelled or expired)
+   */
+  void on_order_closed(int account_id) {
+    if (valid(account_id) && accounts_[account_id].open_orders > 0) {
+      accounts_[account_id].open_orders--;
+    }
+  }
+
+  /**
+   * @brief Applies a fill to both counterparties' positions
+   */
+  void on_fill(int buy_account_id, int sell_account_id, int64_t quantity) {
+    if (valid(buy_account_id)) {
+      accounts_[buy_account_id].position += quantity;
+    }
+    if (valid(sell_account_id)) {
+      accounts_[sell_account_id].position -= quantity;
+    }
+  }
+
+  // ========================================================================
+  // QUERIES
+  // ========================================================================
+
+  int64_t position(int account_id) const {
+    return valid(account_id) ? accounts_[account_id].position : 0;
+  }
+
+  uint32_t open_orders(int account_id) const {
+    return valid(account_id) ? accounts_[account_id].open_orders : 0;
+  }
+
+  uint64_t account_rejects(int account_id) const {
+    return valid(account_id) ? accounts_[account_id].rejects : 0;
+  }
+
+  /**
+   * @brief Telemetry (any thread)
+   */
+  uint64_t checks() const { return checks_.load(std::memory_order_relaxed); }
+  uint64_t accepted() const { return accepted_.load(std::memory_order_relaxed); }
+  uint64_t rejects(RiskReject reason) const {
+    return rejects_[static_cast<size_t>(reason)].load(std::memory_order_relaxed);
+  }
+  uint64_t total_rejects() const {
+    uint64_t total = 0;
+    for (const auto &count : rejects_) {
+      total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  size_t max_accounts() const { return accounts_.size(); }
+
+  void print_statistics() const {
+    std::cout << "\n=== Pre-Trade Risk Statistics ===" << std::endl;
+    std::cout << "Orders Checked:         " << checks() << std::endl;
+    std::cout << "Accepted:               " << accepted() << std::endl;
+    std::cout << "Rejected:               " << total_rejects() << std::endl;
+    for (size_t i = 1; i < NUM_REASONS; ++i) {
+      const uint64_t count = rejects_[i].load(std::memory_order_relaxed);
+      if (count > 0) {
+        std::cout << "  " << std::left << std::setw(22)
+                  << risk_reject_name(static_cast<RiskReject>(i)) << count
+                  << std::endl;
+      }
+    }
+  }
+
+private:
+  struct alignas(64) AccountState {
+    RiskLimits limits;
+    double tokens = 0.0;
+    int64_t last_refill_ns = 0;
+    int64_t position = 0;
+    uint32_t open_orders = 0;
+    uint64_t rejects = 0;
+  };
+
+  static int64_t timestamp_ns(const Order &order) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               order.timestamp.time_since_epoch())
+        .count();
+  }
+
+  static double refilled_tokens(const AccountState &account, const Order &order) {
+    const double elapsed_s =
+        static_cast<double>(
+            std::max<int64_t>(timestamp_ns(order) - account.last_refill_ns, 0)) *
+        1e-9;
+    return std::min(account.limits.burst,
+                    account.tokens + elapsed_s * account.limits.max_orders_per_second);
+  }
+
+  /**
+   * @brief Every limit the order breaches, one bit per RiskReject
+   */
+  static uint32_t fail_mask(const AccountState &account, const Order &order,
+                            double reference_price, double tokens,
+                            uint32_t open_orders) {
+    const RiskLimits &limits = account.limits;
+    const int64_t quantity = order.quantity;
+    const bool is_market = order.is_market_order();
+    const bool has_reference = reference_price > 0.0;
+    const double price = is_market ? reference_price : order.price;
+    const double notional = price * static_cast<double>(quantity);
+    const bool collared = !is_market & !order.is_stop & has_reference;
+    const int64_t position = account.position;
+    const int64_t new_position =
+        position + (order.side == Side::BUY ? quantity : -quantity);
+
+    return static_cast<uint32_t>((quantity <= 0) | (quantity > limits.max_order_quantity))
+               << static_cast<uint32_t>(RiskReject::MAX_QUANTITY) |
+           static_cast<uint32_t>(notional > limits.max_order_notional)
+               << static_cast<uint32_t>(RiskReject::MAX_NOTIONAL) |
+           static_cast<uint32_t>(collared & (std::fabs(price - reference_price) >
+                                             limits.price_collar * reference_price))
+               << static_cast<uint32_t>(RiskReject::PRICE_COLLAR) |
+           static_cast<uint32_t>(open_orders >= limits.max_open_orders)
+               << static_cast<uint32_t>(RiskReject::MAX_OPEN_ORDERS) |
+           static_cast<uint32_t>((limits.max_orders_per_second > 0.0) & (tokens < 1.0))
+               << static_cast<uint32_t>(RiskReject::RATE_LIMIT) |
+           // Orders that reduce an over-limit position are always allowed
+           static_cast<uint32_t>((std::llabs(new_position) > limits.max_position) &
+                                 (std::llabs(new_position) > std::llabs(position)))
+               << static_cast<uint32_t>(RiskReject::POSITION_LIMIT) |
+           // An unpriced market order would otherwise pass the notional limit
+           static_cast<uint32_t>(is_market & !has_reference &
+                                 std::isfinite(limits.max_order_notional))
+               << static_cast<uint32_t>(RiskReject::NO_REFERENCE_PRICE);
+  }
+
+  static void reset_account(AccountState &account, const RiskLimits &limits) {
+    account = AccountState();
+    account.limits = limits;
+    account.tokens = limits.burst;
+  }
+
+  bool valid(int account_id) const {
+    return static_cast<size_t>(account_id) < accounts_.size();
+  }
+
+  static void bump(std::atomic<uint64_t> &counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  }
+
+  RiskReject reject(RiskReject reason) {
+    bump(rejects_[static_cast<size_t>(reason)]);
+    return reason;
+  }
+
+  std::vector<AccountState> accounts_;
+  std::atomic<uint64_t> checks_{0};
+  std::atomic<uint64_t> accepted_{0};
+  std::array<std::atomic<uint64_t>, NUM_REASONS> rejects_{};
+};
@@ -29,23 +29,36 @@
 #include "backtester.hpp"
 #include "execution_algorithm.hpp"
 #include "execution_simulator.hpp"
+#include "conflating_subscriber.hpp"
+#include "market_data_publisher.hpp"
 #include "market_impact_calibration.hpp"
+#include "metrics_server.hpp"
 #include "microstructure_analytics.hpp"
 #include "microstructure_order_book.hpp"
 #include "multi_feed_aggregator.hpp"
 #include "performance_monitor.hpp"
+#include "seqlock.hpp"
+#include "spsc_queue.hpp"
+#include "symbol_table.hpp"
+#include "thread_config.hpp"
+#include "tick_capture.hpp"
+#include "trace_recorder.hpp"
+#include "wait_strategy.hpp"
 #include "twap_strategy.hpp"
 #include "vwap_strategy.hpp"
 #include "almgren_chriss_strategy.hpp"
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -73,11 +86,46 @@ struct PlatformConfig {
   // Callbacks
   bool enable_analytics_updates = true;
   int analytics_update_interval_ms = 10000; // 10 seconds
+
+  // Symbol routing
+  std::vector<std::string> symbols;        // Books created up front (others on first tick)
+  std::vector<std::string> pinned_symbols; // Each processed on its own worker thread
+  size_t worker_queue_capacity = 65536;    // Per-worker SPSC queue size
+
+  // Threading: busy-spin for colocated boxes, spin-park to leave cores idle
+  WaitStrategy wait_strategy = WaitStrategy::SPIN_YIELD; // Feed and worker threads
+  ThreadConfig feed_thread{"md-feed", -1};
+  ThreadConfig analytics_thread{"md-analytics", -1};
+  std::vector<int> worker_cpus; // CPU per pinned symbol (pinned_symbols order), -1 = any
+
+  // Snapshot publishing (whichever comes first)
+  uint64_t snapshot_publish_events = 1000;  // Publish every N feed events
+  int snapshot_publish_interval_us = 1000;  // or after this much time
+
+  // Prometheus endpoint (GET /metrics), started with real-time mode
+  bool enable_metrics_server = false;
+  int metrics_port = 9464;                        // 0 = ephemeral
+  std::string metrics_bind_address = "127.0.0.1"; // Loopback only by default
+
+  // Record every aggregated tick of a real-time session (replay_capture())
+  std::string capture_file = "";
+
+  // Pre-trade risk gate in front of every book (rejects counted per symbol)
+  bool enable_risk_checks = false;
+  RiskLimits risk_limits; // Defaults for every account
+
+  // Incremental L2 updates from each symbol's book (market_data_publisher())
+  bool enable_market_data = false;
+  size_t market_data_ring_capacity = 65536;     // Updates kept for readers
+  uint64_t market_data_snapshot_interval = 1024; // Updates between snapshots
+  ThreadConfig market_data_thread{"md-snap", -1}; // Builds snapshots in real-time mode
 };
 
 /**
  * @struct AnalyticsSnapshot
  * @brief Point-in-time snapshot of analytics state
+ *
+ * Trivially copyable so it can be published through a SeqLock.
  */
 struct AnalyticsSnapshot {
   // Order book state
@@ -159,9 +207,62 @@ struct ExecutionComparison {
  * 2. Real-time feed processing with flow analytics
  * 3. Execution strategy testing and comparison
  * 4. Comprehensive performance monitoring
+ *
+ * Real-time ticks are routed by symbol. Each symbol gets its own order
+ * book, analytics and published snapshot, created on its first tick or
+ * up front from PlatformConfig::symbols. Ticks for symbols listed in
+ * PlatformConfig::pinned_symbols are handed to a dedicated worker thread
+ * through an SPSC queue; all other symbols are processed inline on the
+ * feed thread. The "DEFAULT" book from get_order_book() is separate and
+ * only receives ticks that carry no symbol.
  */
 class MicrostructureAnalyticsPlatform {
+public:
+  /**
+   * @struct SymbolSlot
+   * @brief Per-symbol book, analytics and published snapshot
+   *
+   * Book and analytics are only touched by the thread that owns the
+   * symbol (the feed thread, or the symbol's worker if pinned). Other
+   * threads read the published snapshot.
+   */
+  struct SymbolSlot {
+    std::string symbol;
+    SymbolId id = INVALID_SYMBOL_ID;
+    int worker = -1; // Index into workers_, -1 = feed thread
+    std::unique_ptr<MicrostructureOrderBook> order_book;
+    std::unique_ptr<MicrostructureAnalytics> analytics;
+    std::unique_ptr<MarketDataPublisher> market_data; // If enabled
+    std::unique_ptr<MarketDataSnapshotter> market_data_snapshotter; // Snapshot thread only
+    SeqLock<AnalyticsSnapshot> snapshot;
+    std::atomic<uint64_t> ticks_processed{0};
+
+    // Owner thread only
+    int next_order_id = 1;
+    uint64_t events_since_publish = 0;
+    std::chrono::steady_clock::time_point last_publish_time;
+  };
+
 private:
+  /// Tick handed from the feed thread to a symbol worker
+  struct RoutedTick {
+    SymbolSlot *slot = nullptr;
+    FeedTick tick;
+    std::chrono::steady_clock::time_point enqueue_time;
+  };
+
+  /// Dedicated thread for pinned symbols
+  struct SymbolWorker {
+    std::unique_ptr<SPSCQueue<RoutedTick, QueueTelemetry>> queue;
+    std::thread thread;
+    ThreadConfig thread_config;
+    QueueWaiter waiter;
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> processed{0};
+    uint64_t enqueued = 0;               // Feed thread only
+    std::atomic<uint64_t> full_waits{0}; // Times the feed thread found the queue full
+  };
+
   PlatformConfig config_;
 
   // Historical analysis
@@ -177,12 +278,32 @@ private:
 
   // Performance monitoring
   std::unique_ptr<PerformanceMonitor> performance_monitor_;
+  std::unique_ptr<ComponentLatencyTracker> latency_tracker_; // Per-hop
+  std::unique_ptr<MetricsServer> metrics_server_;            // Scrape thread
+  std::unique_ptr<TickCaptureWriter> capture_writer_;        // Session recording
 
   // State
   std::atomic<bool> running_{false};
   std::atomic<bool> initialized_{false};
   std::thread analytics_update_thread_;
+  std::thread market_data_thread_; // Builds L2 snapshots off the book threads
   std::mutex state_mutex_;
+  std::mutex analytics_wait_mutex_;
+  std::condition_variable analytics_wait_cv_;
+
+  // Published analytics: written by the feed processing thread, read by anyone
+  SeqLock<AnalyticsSnapshot> published_snapshot_;
+  uint64_t events_since_publish_ = 0;
+  std::chrono::steady_clock::time_point last_publish_time_;
+
+  // Symbol routing
+  SymbolTable symbol_table_;
+  std::vector<std::unique_ptr<SymbolSlot>> slots_;        // Indexed by SymbolId
+  std::unordered_map<uint64_t, SymbolSlot *> route_;      // Feed thread only (reads and writes)
+  std::vector<std::unique_ptr<SymbolWorker>> workers_;
+  mutable std::mutex slots_mutex_;                        // Guards slot creation
+  std::vector<std::pair<std::string, std::unique_ptr<ConflatingSubscriber>>>
+      conflating_subscribers_; // Named, for metrics
 
   // Calibrated impact model
   MarketImpactModel calibrated_impact_model_;
@@ -217,6 +338,9 @@ public:
 
     // Initialize order book
     order_book_ = std::make_unique<MicrostructureOrderBook>("DEFAULT");
+    if (config_.enable_risk_checks) {
+      order_book_->enable_risk_checks(config_.risk_limits);
+    }
 
     // Initialize analytics
     analytics_ =
@@ -230,6 +354,8 @@ public:
     // Initialize feed aggregator
     feed_aggregator_ = std::make_unique<MultiFeedAggregator>();
     feed_aggregator_->set_verbose(config_.verbose);
+    feed_aggregator_->set_wait_strategy(config_.wait_strategy);
+    feed_aggregator_->set_processor_thread_config(config_.feed_thread);
 
     // Add configured feeds
     for (const auto &source : config_.feed_sources) {
@@ -246,8 +372,30 @@ public:
     simulator_ = std::make_unique<ExecutionSimulator>(sim_config);
 
     // Initialize performance monitor
-    performance_monitor_ = std::make_unique<PerformanceMonitor>();
+    performance_monitor_ = std::make_unique<PerformanceMonitor>("tick_processing");
     performance_monitor_->set_enabled(config_.enable_performance_monitoring);
+    latency_tracker_ = std::make_unique<ComponentLatencyTracker>();
+
+    // Pre-create symbol books; pinned symbols get a worker each
+    for (const auto &symbol : config_.symbols) {
+      get_or_create_slot(symbol);
+    }
+    for (size_t i = 0; i < config_.pinned_symbols.size(); ++i) {
+      const auto &symbol = config_.pinned_symbols[i];
+      SymbolSlot *slot = get_or_create_slot(symbol);
+      if (slot->worker < 0) {
+        slot->worker = static_cast<int>(workers_.size());
+        auto worker = std::make_unique<SymbolWorker>();
+        worker->queue =
+            std::make_unique<SPSCQueue<RoutedTick, QueueTelemetry>>(config_.worker_queue_capacity);
+        worker->waiter.set_strategy(config_.wait_strategy);
+        worker->thread_config.name = "md-w-" + symbol;
+        worker->thread_config.cpu =
+            i < config_.worker_cpus.size() ? config_.worker_cpus[i] : -1;
+        workers_.push_back(std::move(worker));
+      }
+    }
+    start_workers();
 
     initialized_ = true;
 
@@ -380,6 +528,15 @@ public:
       std::cout << "[Platform] Starting real-time mode...\n";
     }
 
+    // Open the capture first: a throw here leaves no threads running
+    if (!config_.capture_file.empty() && !capture_writer_) {
+      capture_writer_ = std::make_unique<TickCaptureWriter>(
+          config_.capture_file, feed_aggregator_->feed_names());
+      capture_writer_->attach(*feed_aggregator_);
+    }
+
+    start_workers();
+
     if (!feed_aggregator_->start_all()) {
       std::cerr << "[Platform] Failed to start feeds\n";
       return false;
@@ -387,20 +544,34 @@ public:
 
     running_ = true;
 
+    if (config_.enable_metrics_server &&
+        !start_metrics_server(config_.metrics_port)) {
+      std::cerr << "[Platform] Metrics server disabled\n";
+    }
+
     // Start analytics update thread
     if (config_.enable_analytics_updates) {
       analytics_update_thread_ = std::thread([this]() {
+        apply_thread_config(config_.analytics_thread);
+        std::unique_lock<std::mutex> lock(analytics_wait_mutex_);
         while (running_) {
-          std::this_thread::sleep_for(
-              std::chrono::milliseconds(config_.analytics_update_interval_ms));
+          // Sleeps without spinning; stop() wakes it immediately
+          analytics_wait_cv_.wait_for(
+              lock, std::chrono::milliseconds(config_.analytics_update_interval_ms),
+              [this]() { return !running_; });
 
           if (running_) {
+            TRACE_SPAN("platform.analytics", 0);
             print_analytics_snapshot();
           }
         }
       });
     }
 
+    if (config_.enable_market_data) {
+      market_data_thread_ = std::thread([this]() { run_market_data_snapshots(); });
+    }
+
     return true;
   }
 
@@ -408,15 +579,31 @@ public:
    * @brief Stops real-time mode
    */
   void stop() {
-    running_ = false;
+    {
+      std::lock_guard<std::mutex> lock(analytics_wait_mutex_);
+      running_ = false;
+    }
+    analytics_wait_cv_.notify_all();
 
     if (analytics_update_thread_.joinable()) {
       analytics_update_thread_.join();
     }
+    if (market_data_thread_.joinable()) {
+      market_data_thread_.join();
+    }
 
     if (feed_aggregator_) {
       feed_aggregator_->stop();
     }
+    close_capture();
+
+    // Feed thread is gone; drain workers and publish the final state
+    stop_workers();
+    if (initialized_) {
+      publish_snapshot();
+      publish_symbol_snapshots();
+    }
+    stop_metrics_server();
   }
 
   /**
@@ -426,7 +613,44 @@ public:
     if (feed_aggregator_) {
       feed_aggregator_->wait();
     }
-    running_ = false;
+    close_capture();
+    {
+      std::lock_guard<std::mutex> lock(analytics_wait_mutex_);
+      running_ = false;
+    }
+    analytics_wait_cv_.notify_all();
+    if (market_data_thread_.joinable()) {
+      market_data_thread_.join();
+    }
+
+    stop_workers();
+    if (initialized_) {
+      publish_snapshot();
+      publish_symbol_snapshots();
+    }
+  }
+
+  /**
+   * @brief Replays a capture file through the feed aggregator
+   * @param filename Capture written via PlatformConfig::capture_file
+   * @param options Pacing (original, Nx, or as fast as possible)
+   * @return Replay statistics
+   *
+   * Starts real-time mode if needed (adding the capture's feeds when the
+   * platform has none) and blocks until every tick is injected. Call
+   * wait() or stop() afterwards to drain and publish.
+   */
+  ReplayStats replay_capture(const std::string &filename,
+                             const ReplayOptions &options = ReplayOptions()) {
+    ensure_initialized();
+    TickReplayer replayer(filename);
+    if (!running_) {
+      replayer.add_missing_feeds(*feed_aggregator_);
+      if (!start_real_time_mode()) {
+        throw std::runtime_error("Cannot start real-time mode for replay");
+      }
+    }
+    return replayer.replay(*feed_aggregator_, options);
   }
 
   /**
@@ -436,52 +660,190 @@ public:
   bool is_running() const { return running_; }
 
   /**
-   * @brief Gets current analytics snapshot
-   * @return Snapshot of current state
+   * @brief Gets the most recently published analytics snapshot
+   * @return Snapshot as of the last publish_snapshot()
+   *
+   * Safe to call from any number of threads at any rate. Readers copy
+   * the published snapshot through a seqlock and never touch the live
+   * order book or analytics, so they cannot stall feed processing.
    */
-  AnalyticsSnapshot get_snapshot() const {
-    AnalyticsSnapshot snapshot;
-    snapshot.timestamp = std::chrono::steady_clock::now();
+  AnalyticsSnapshot get_snapshot() const { return published_snapshot_.read(); }
 
-    if (order_book_) {
-      if (auto spread = order_book_->get_current_spread()) {
-        snapshot.spread = *spread;
-      }
-      if (auto bid = order_book_->get_best_bid()) {
-        snapshot.best_bid = bid->price;
-      }
-      if (auto ask = order_book_->get_best_ask()) {
-        snapshot.best_ask = ask->price;
+  /**
+   * @brief Number of snapshots published so far
+   * @return Increases by one per publish_snapshot()
+   */
+  uint64_t snapshot_version() const { return published_snapshot_.version(); }
+
+  /**
+   * @brief Captures live state and publishes it to snapshot readers
+   *
+   * In real-time mode the feed processing thread calls this every
+   * snapshot_publish_events events or snapshot_publish_interval_us. When
+   * driving the order book directly, call it from that same thread.
+   */
+  void publish_snapshot() {
+    TRACE_SPAN("platform.publish_snapshot", 0);
+    published_snapshot_.write(capture_snapshot());
+    events_since_publish_ = 0;
+    last_publish_time_ = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * @brief Gets the most recently published snapshot for one symbol
+   * @param symbol Trading symbol
+   * @return Snapshot, or a default snapshot if the symbol is unknown
+   *
+   * Published by the symbol's owning thread on the same cadence as
+   * get_snapshot(). Safe to call from any thread.
+   */
+  AnalyticsSnapshot get_snapshot(const std::string &symbol) const {
+    const SymbolSlot *slot = find_slot(symbol);
+    return slot ? slot->snapshot.read() : AnalyticsSnapshot();
+  }
+
+  // ========================================================================
+  // SYMBOL ROUTING
+  // ========================================================================
+
+  /**
+   * @brief Routes a tick to its symbol's book as if a feed delivered it
+   * @param tick Tick to process
+   *
+   * Feeds call this from the aggregator's processor thread. Only one
+   * thread may route ticks at a time.
+   */
+  void route_tick(const AggregatedTick &tick) {
+    ensure_initialized();
+    on_aggregated_tick(tick);
+  }
+
+  /**
+   * @brief Waits until every pinned worker has processed its queued ticks
+   *
+   * Call from the routing thread; afterwards pinned books may be read
+   * until the next tick is routed.
+   */
+  void flush_workers() const {
+    for (const auto &worker : workers_) {
+      while (worker->thread.joinable() &&
+             worker->processed.load(std::memory_order_acquire) <
+                 worker->enqueued) {
+        std::this_thread::yield();
       }
-      snapshot.order_imbalance = order_book_->get_current_imbalance();
     }
+  }
 
-    if (analytics_) {
-      snapshot.flow.imbalance = analytics_->get_flow_imbalance();
-      snapshot.flow.buy_ratio = analytics_->get_buy_ratio();
-      snapshot.flow.buy_volume =
-          analytics_->get_flow_tracker().get_total_buy_volume();
-      snapshot.flow.sell_volume =
-          analytics_->get_flow_tracker().get_total_sell_volume();
-    }
+  /**
+   * @brief Gets the order book for a symbol
+   * @param symbol Trading symbol
+   * @return Book, or nullptr if no tick for the symbol has been routed
+   *
+   * Only safe to use from the symbol's owning thread, or while no ticks
+   * are being routed.
+   */
+  MicrostructureOrderBook *find_order_book(const std::string &symbol) {
+    SymbolSlot *slot = find_slot(symbol);
+    return slot ? slot->order_book.get() : nullptr;
+  }
 
-    if (has_calibrated_model_) {
-      snapshot.estimated_impact_100k =
-          calibrated_impact_model_.estimate_total_impact(100000,
-                                                         config_.assumed_adv);
-      snapshot.estimated_impact_1m =
-          calibrated_impact_model_.estimate_total_impact(1000000,
-                                                         config_.assumed_adv);
+  /**
+   * @brief Gets the analytics engine for a symbol
+   * @param symbol Trading symbol
+   * @return Analytics, or nullptr if the symbol is unknown
+   */
+  MicrostructureAnalytics *find_analytics(const std::string &symbol) {
+    SymbolSlot *slot = find_slot(symbol);
+    return slot ? slot->analytics.get() : nullptr;
+  }
+
+  /**
+   * @brief Checks whether a symbol runs on a dedicated worker
+   * @param symbol Trading symbol
+   * @return true if pinned
+   */
+  bool is_pinned(const std::string &symbol) const {
+    const SymbolSlot *slot = find_slot(symbol);
+    return slot && slot->worker >= 0;
+  }
+
+  /**
+   * @brief Number of symbols with a book
+   */
+  size_t symbol_count() const {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    return slots_.size();
+  }
+
+  /**
+   * @brief Symbols with a book, in creation order
+   */
+  std::vector<std::string> get_symbols() const {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    std::vector<std::string> symbols;
+    symbols.reserve(slots_.size());
+    for (const auto &slot : slots_) {
+      symbols.push_back(slot->symbol);
     }
+    return symbols;
+  }
 
-    if (performance_monitor_) {
-      snapshot.events_processed = performance_monitor_->events_processed();
-      snapshot.throughput = performance_monitor_->throughput();
-      snapshot.latency_p50_ns = performance_monitor_->latency_percentile(50);
-      snapshot.latency_p99_ns = performance_monitor_->latency_percentile(99);
+  /**
+   * @brief Ticks processed for a symbol
+   */
+  uint64_t ticks_processed(const std::string &symbol) const {
+    const SymbolSlot *slot = find_slot(symbol);
+    return slot ? slot->ticks_processed.load(std::memory_order_relaxed) : 0;
+  }
+
+  /**
+   * @brief Depth/back-pressure telemetry of a pinned symbol's queue
+   * @return Empty snapshot if the symbol is not pinned
+   *
+   * A high-water mark near capacity or growing stall time identifies the
+   * worker that is falling behind the feed thread.
+   */
+  QueueTelemetrySnapshot worker_queue_telemetry(const std::string &symbol) const {
+    const SymbolSlot *slot = find_slot(symbol);
+    if (!slot || slot->worker < 0) {
+      return QueueTelemetrySnapshot();
     }
+    return workers_[slot->worker]->queue->telemetry_snapshot();
+  }
 
-    return snapshot;
+  /**
+   * @brief A symbol's L2 publisher, for MarketDataSubscriber
+   * @return nullptr if market data is disabled or the symbol is unknown
+   */
+  const MarketDataPublisher *market_data_publisher(const std::string &symbol) const {
+    const SymbolSlot *slot = find_slot(symbol);
+    return slot ? slot->market_data.get() : nullptr;
+  }
+
+  /**
+   * @brief Creates a conflating L2 subscriber over some symbols
+   * @param name Label for its metrics
+   * @param symbols Symbols to subscribe to (books created if new)
+   * @param max_pending_levels Per-symbol cache bound before a full refresh
+   * @return nullptr if market data is disabled
+   *
+   * For consumers slower than the book: the caller polls and delivers at
+   * its own pace (see ConflatingSubscriber), and the platform exports its
+   * conflation counters. Call before start_real_time_mode().
+   */
+  ConflatingSubscriber *add_conflating_subscriber(
+      const std::string &name, const std::vector<std::string> &symbols,
+      size_t max_pending_levels = ConflatingSubscriber::DEFAULT_MAX_PENDING_LEVELS) {
+    if (!config_.enable_market_data) {
+      return nullptr;
+    }
+    auto subscriber = std::make_unique<ConflatingSubscriber>(max_pending_levels);
+    for (const auto &symbol : symbols) {
+      subscriber->add_source(*get_or_create_slot(symbol)->market_data);
+    }
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    conflating_subscribers_.emplace_back(name, std::move(subscriber));
+    return conflating_subscribers_.back().second.get();
   }
 
   /**
@@ -621,7 +983,7 @@ public:
     for (const auto& [name, risk] : ac_risks) {
       AlmgrenChrissStrategy ac_variant(target_qty, 30, 30);
       ac_variant.set_risk_aversion(risk);
-      ac_variant.set_market_impact(0.1, 0.01, config_.backtester.assumed_adv);
+      ac_variant.set_market_impact(0.1, 0.01, config_.assumed_adv);
       ac_variant.set_volatility(0.02);
 
       auto result = backtester_->test_execution_strategy(&ac_variant, symbol,
@@ -689,6 +1051,141 @@ public:
     return *performance_monitor_;
   }
 
+  /**
+   * @brief Gets the per-hop latency tracker
+   * @return Reference to tracker (fed from each tick's checkpoints)
+   */
+  ComponentLatencyTracker &get_latency_tracker() {
+    ensure_initialized();
+    return *latency_tracker_;
+  }
+
+  // ========================================================================
+  // METRICS EXPORT
+  // ========================================================================
+
+  /**
+   * @brief Starts the Prometheus endpoint on a background thread
+   * @param port TCP port (0 = ephemeral; see metrics_port())
+   * @return true if listening
+   */
+  bool start_metrics_server(int port) {
+    ensure_initialized();
+    if (metrics_server_ && metrics_server_->is_running()) {
+      return true;
+    }
+
+    metrics_server_ = std::make_unique<MetricsServer>();
+    metrics_server_->add_collector(
+        [this](PrometheusWriter &writer) { write_prometheus(writer); });
+    auto started = metrics_server_->start(port, config_.metrics_bind_address);
+    if (!started) {
+      std::cerr << "[Platform] Metrics server: " << started.error() << "\n";
+      metrics_server_.reset();
+      return false;
+    }
+    if (config_.verbose) {
+      std::cout << "[Platform] Serving metrics on http://"
+                << config_.metrics_bind_address << ":"
+                << metrics_server_->port() << "/metrics\n";
+    }
+    return true;
+  }
+
+  void stop_metrics_server() {
+    if (metrics_server_) {
+      metrics_server_->stop();
+    }
+  }
+
+  /**
+   * @brief Port the metrics endpoint listens on, 0 if not running
+   */
+  int metrics_port() const {
+    return metrics_server_ && metrics_server_->is_running()
+               ? metrics_server_->port()
+               : 0;
+  }
+
+  /**
+   * @brief Appends feed rates, latency percentiles, queue depths and drop
+   *        counts to a scrape
+   *
+   * Called from the metrics thread. Reads atomics and histogram buckets
+   * only; slots_mutex_ is shared solely with symbol creation, never with
+   * per-tick processing.
+   */
+  void write_prometheus(PrometheusWriter &writer) const {
+    if (!initialized_) {
+      return;
+    }
+
+    feed_aggregator_->write_prometheus(writer);
+    performance_monitor_->write_prometheus(writer);
+    latency_tracker_->write_prometheus(writer);
+
+    writer.counter("hft_snapshots_published_total",
+                   "Analytics snapshots published",
+                   static_cast<double>(snapshot_version()));
+    write_risk_telemetry(writer, order_book_->get_risk_gate(), "DEFAULT");
+
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    for (const auto &slot : slots_) {
+      const PrometheusWriter::Labels labels = {{"symbol", slot->symbol}};
+      writer.counter("hft_symbol_ticks_total", "Ticks processed per symbol",
+                     static_cast<double>(slot->ticks_processed.load(
+                         std::memory_order_relaxed)),
+                     labels);
+      write_risk_telemetry(writer, slot->order_book->get_risk_gate(),
+                           slot->symbol);
+      if (slot->market_data) {
+        writer.counter("hft_md_updates_total", "L2 level updates published",
+                       static_cast<double>(slot->market_data->sequence()), labels);
+        writer.counter("hft_md_snapshots_total", "L2 snapshots published",
+                       static_cast<double>(
+                           slot->market_data->snapshots_published()),
+                       labels);
+      }
+      if (slot->worker < 0) {
+        continue;
+      }
+      const SymbolWorker &worker = *workers_[slot->worker];
+      writer.gauge("hft_worker_queue_depth",
+                   "Ticks waiting in a pinned symbol's queue",
+                   static_cast<double>(worker.queue->size()), labels);
+      writer.gauge("hft_worker_queue_capacity",
+                   "Pinned symbol queue capacity",
+                   static_cast<double>(worker.queue->capacity()), labels);
+      writer.counter("hft_worker_queue_full_total",
+                     "Times the feed thread found the worker queue full",
+                     static_cast<double>(
+                         worker.full_waits.load(std::memory_order_relaxed)),
+                     labels);
+      write_queue_telemetry(writer, worker.queue->telemetry_snapshot(),
+                            {{"queue", "worker"}, {"symbol", slot->symbol}});
+    }
+
+    for (const auto &entry : conflating_subscribers_) {
+      const ConflationStats stats = entry.second->stats();
+      const PrometheusWriter::Labels labels = {{"subscriber", entry.first}};
+      writer.counter("hft_md_conflated_received_total",
+                     "L2 level changes drained by a conflating subscriber",
+                     static_cast<double>(stats.updates_received), labels);
+      writer.counter("hft_md_conflated_delivered_total",
+                     "Merged L2 updates delivered to a slow consumer",
+                     static_cast<double>(stats.updates_delivered), labels);
+      writer.gauge("hft_md_conflation_ratio",
+                   "Level changes received per update delivered",
+                   stats.conflation_ratio(), labels);
+      writer.gauge("hft_md_conflation_pending_levels",
+                   "Levels waiting for the consumer",
+                   static_cast<double>(stats.pending_levels), labels);
+      writer.counter("hft_md_conflation_overflows_total",
+                     "Pending caches replaced by a full refresh",
+                     static_cast<double>(stats.overflows), labels);
+    }
+  }
+
   /**
    * @brief Gets the calibrated impact model
    * @return Reference to impact model
@@ -725,10 +1222,39 @@ public:
       feed_aggregator_->print_stats();
     }
 
+    // Routed symbols
+    {
+      std::lock_guard<std::mutex> lock(slots_mutex_);
+      if (!slots_.empty()) {
+        std::cout << "\n--- Symbols ---\n";
+        for (const auto &slot : slots_) {
+          auto snapshot = slot->snapshot.read();
+          std::cout << "  " << std::left << std::setw(8) << slot->symbol
+                    << " ticks: " << slot->ticks_processed.load()
+                    << ", spread: " << snapshot.spread
+                    << (slot->worker >= 0 ? " (pinned)" : "") << "\n";
+          if (const PreTradeRiskGate *gate = slot->order_book->get_risk_gate()) {
+            std::cout << "           risk: " << gate->checks() << " checked, "
+                      << gate->total_rejects() << " rejected\n";
+          }
+        }
+        for (const auto &slot : slots_) {
+          if (slot->worker >= 0) {
+            workers_[slot->worker]->queue->telemetry_snapshot().print(
+                slot->symbol);
+          }
+        }
+      }
+    }
+
     // Performance stats
     if (performance_monitor_) {
       performance_monitor_->print_statistics();
     }
+    if (latency_tracker_ &&
+        latency_tracker_->end_to_end().events_processed() > 0) {
+      latency_tracker_->print_hop_breakdown();
+    }
 
     // Impact model
     if (has_calibrated_model_) {
@@ -747,6 +1273,82 @@ public:
   }
 
 private:
+  /**
+   * @brief Appends a book's pre-trade check and reject counters (if enabled)
+   */
+  static void write_risk_telemetry(PrometheusWriter &writer,
+                                   const PreTradeRiskGate *gate,
+                                   const std::string &symbol) {
+    if (!gate) {
+      return;
+    }
+    writer.counter("hft_risk_checks_total", "Orders checked pre-trade",
+                   static_cast<double>(gate->checks()), {{"symbol", symbol}});
+    for (size_t i = 1; i < PreTradeRiskGate::NUM_REASONS; ++i) {
+      const RiskReject reason = static_cast<RiskReject>(i);
+      writer.counter("hft_risk_rejects_total",
+                     "Orders rejected pre-trade, by reason",
+                     static_cast<double>(gate->rejects(reason)),
+                     {{"symbol", symbol}, {"reason", risk_reject_name(reason)}});
+    }
+  }
+
+  /**
+   * @brief Reads live state into a snapshot (owning thread only)
+   */
+  AnalyticsSnapshot capture_snapshot() const {
+    return capture_snapshot(order_book_.get(), analytics_.get());
+  }
+
+  /**
+   * @brief Reads one book and analytics engine into a snapshot
+   */
+  AnalyticsSnapshot capture_snapshot(const MicrostructureOrderBook *book,
+                                     const MicrostructureAnalytics *analytics) const {
+    AnalyticsSnapshot snapshot;
+    snapshot.timestamp = std::chrono::steady_clock::now();
+
+    if (book) {
+      if (auto spread = book->get_current_spread()) {
+        snapshot.spread = *spread;
+      }
+      if (auto bid = book->get_best_bid()) {
+        snapshot.best_bid = bid->price;
+      }
+      if (auto ask = book->get_best_ask()) {
+        snapshot.best_ask = ask->price;
+      }
+      snapshot.order_imbalance = book->get_current_imbalance();
+    }
+
+    if (analytics) {
+      snapshot.flow.imbalance = analytics->get_flow_imbalance();
+      snapshot.flow.buy_ratio = analytics->get_buy_ratio();
+      snapshot.flow.buy_volume =
+          analytics->get_flow_tracker().get_total_buy_volume();
+      snapshot.flow.sell_volume =
+          analytics->get_flow_tracker().get_total_sell_volume();
+    }
+
+    if (has_calibrated_model_) {
+      snapshot.estimated_impact_100k =
+          calibrated_impact_model_.estimate_total_impact(100000,
+                                                         config_.assumed_adv);
+      snapshot.estimated_impact_1m =
+          calibrated_impact_model_.estimate_total_impact(1000000,
+                                                         config_.assumed_adv);
+    }
+
+    if (performance_monitor_) {
+      snapshot.events_processed = performance_monitor_->events_processed();
+      snapshot.throughput = performance_monitor_->throughput();
+      snapshot.latency_p50_ns = performance_monitor_->latency_percentile(50);
+      snapshot.latency_p99_ns = performance_monitor_->latency_percentile(99);
+    }
+
+    return snapshot;
+  }
+
   /**
    * @brief Ensures platform is initialized
    */
@@ -756,31 +1358,293 @@ private:
     }
   }
 
+  /**
+   * @brief Looks up a symbol's slot (any thread)
+   */
+  SymbolSlot *find_slot(const std::string &symbol) const {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    SymbolId id = symbol_table_.find(symbol);
+    return id < slots_.size() ? slots_[id].get() : nullptr;
+  }
+
+  /**
+   * @brief Returns a symbol's slot, creating its book and analytics if new
+   */
+  SymbolSlot *get_or_create_slot(const std::string &symbol) {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    SymbolId id = symbol_table_.intern(symbol);
+    if (id < slots_.size()) {
+      return slots_[id].get();
+    }
+
+    auto slot = std::make_unique<SymbolSlot>();
+    slot->symbol = symbol;
+    slot->id = id;
+    slot->order_book = std::make_unique<MicrostructureOrderBook>(symbol);
+    if (config_.enable_risk_checks) {
+      slot->order_book->enable_risk_checks(config_.risk_limits);
+    }
+    slot->analytics =
+        std::make_unique<MicrostructureAnalytics>(config_.flow_window_seconds);
+    slot->analytics->set_per_symbol_tracking(false);
+    slot->analytics->set_auto_calibrate(config_.auto_calibrate_impact);
+    slot->analytics->connect_to_order_book(*slot->order_book);
+    if (config_.enable_market_data) {
+      slot->market_data = std::make_unique<MarketDataPublisher>(
+          symbol, config_.market_data_ring_capacity,
+          config_.market_data_snapshot_interval);
+      slot->market_data->attach(*slot->order_book);
+      // Periodic snapshots come from the snapshot thread; outside real-time
+      // mode the book thread builds one only when a lapped reader asks
+      slot->market_data_snapshotter =
+          std::make_unique<MarketDataSnapshotter>(*slot->market_data);
+    }
+    slot->last_publish_time = std::chrono::steady_clock::now();
+
+    SymbolSlot *raw = slot.get();
+    slots_.push_back(std::move(slot));
+    return raw;
+  }
+
+  /**
+   * @brief Packs a symbol of up to 8 characters into a routing key
+   */
+  static uint64_t pack_symbol(const char *symbol) {
+    char buf[8] = {};
+    size_t len = strnlen(symbol, sizeof(buf));
+    std::memcpy(buf, symbol, len);
+    uint64_t key;
+    std::memcpy(&key, buf, sizeof(key));
+    return key;
+  }
+
+  /**
+   * @brief Starts pinned-symbol workers that are not running
+   */
+  void start_workers() {
+    for (auto &worker : workers_) {
+      if (worker->thread.joinable()) {
+        continue;
+      }
+      worker->stop.store(false, std::memory_order_relaxed);
+      SymbolWorker *w = worker.get();
+      worker->thread = std::thread([this, w]() { run_worker(*w); });
+    }
+  }
+
+  /**
+   * @brief Flushes and closes the session capture, if recording
+   *
+   * Call only once the aggregator's processor thread has stopped.
+   */
+  void close_capture() {
+    if (capture_writer_) {
+      feed_aggregator_->set_capture_tap(nullptr);
+      capture_writer_->close();
+      if (capture_writer_->failed() || capture_writer_->records_dropped() > 0) {
+        std::cerr << "[Platform] Capture " << capture_writer_->filename()
+                  << " incomplete: " << capture_writer_->write_errors()
+                  << " write error(s), " << capture_writer_->records_dropped()
+                  << " record(s) dropped\n";
+      }
+      capture_writer_.reset();
+    }
+  }
+
+  /**
+   * @brief Stops workers after they drain their queues
+   */
+  void stop_workers() {
+    for (auto &worker : workers_) {
+      worker->stop.store(true, std::memory_order_release);
+      worker->waiter.wake();
+    }
+    for (auto &worker : workers_) {
+      if (worker->thread.joinable()) {
+        worker->thread.join();
+      }
+    }
+  }
+
+  /**
+   * @brief Worker loop: processes routed ticks until stopped and drained
+   */
+  void run_worker(SymbolWorker &worker) {
+    apply_thread_config(worker.thread_config);
+    while (true) {
+      if (auto routed = worker.queue->pop()) {
+        process_symbol_tick(*routed->slot, routed->tick, routed->enqueue_time);
+        worker.processed.fetch_add(1, std::memory_order_release);
+        worker.waiter.on_work();
+        continue;
+      }
+      if (worker.stop.load(std::memory_order_acquire)) {
+        break;
+      }
+      worker.waiter.idle([&worker]() {
+        return worker.stop.load(std::memory_order_relaxed) ||
+               !worker.queue->empty();
+      });
+    }
+  }
+
+  /**
+   * @brief Snapshot thread: rebuilds each symbol's L2 depth from its ring and
+   *        installs the periodic snapshots, so book threads do not build them
+   */
+  void run_market_data_snapshots() {
+    apply_thread_config(config_.market_data_thread);
+    std::vector<MarketDataSnapshotter *> snapshotters;
+    size_t known_slots = 0;
+    std::unique_lock<std::mutex> lock(analytics_wait_mutex_);
+    while (running_) {
+      lock.unlock();
+      {
+        // Slots are never removed; only pick up new ones under the lock
+        std::lock_guard<std::mutex> slots_lock(slots_mutex_);
+        for (; known_slots < slots_.size(); ++known_slots) {
+          snapshotters.push_back(slots_[known_slots]->market_data_snapshotter.get());
+        }
+      }
+      for (auto *snapshotter : snapshotters) {
+        snapshotter->poll();
+      }
+      lock.lock();
+      analytics_wait_cv_.wait_for(lock, std::chrono::microseconds(100),
+                                  [this]() { return !running_; });
+    }
+  }
+
+  /**
+   * @brief Publishes every symbol's snapshot (no workers may be running)
+   */
+  void publish_symbol_snapshots() {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    for (auto &slot : slots_) {
+      slot->snapshot.write(
+          capture_snapshot(slot->order_book.get(), slot->analytics.get()));
+    }
+  }
+
+  /**
+   * @brief Applies a tick to its symbol's book (owning thread only)
+   */
+  void process_symbol_tick(SymbolSlot &slot, const FeedTick &tick,
+                           std::chrono::steady_clock::time_point start_time) {
+    TRACE_SPAN("platform.book_update", tick.trace_id);
+    TRACE_EVENT(tick.trace_id); // Book and fill-router spans join the tick
+    // Create synthetic order from tick (for demonstration)
+    // In production, this would come from actual order flow
+    int account_id = 1; // Default account
+    Side side = (tick.volume % 2 == 0) ? Side::BUY : Side::SELL;
+    Order order(slot.next_order_id++, account_id, side, tick.price,
+                static_cast<int>(tick.volume), TimeInForce::GTC);
+
+    // Add to order book (this triggers analytics via FillRouter)
+    LatencyCheckpoints checkpoints = tick.checkpoints;
+    slot.order_book->add_order(order, checkpoints);
+    slot.ticks_processed.fetch_add(1, std::memory_order_relaxed);
+    if (config_.enable_performance_monitoring) {
+      latency_tracker_->record_checkpoints(checkpoints);
+    }
+
+    // Record latency (includes the queue hop for pinned symbols)
+    auto end_time = std::chrono::steady_clock::now();
+    performance_monitor_->record_event_latency(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end_time -
+                                                             start_time));
+
+    if (++slot.events_since_publish >= config_.snapshot_publish_events ||
+        end_time - slot.last_publish_time >=
+            std::chrono::microseconds(config_.snapshot_publish_interval_us)) {
+      slot.snapshot.write(
+          capture_snapshot(slot.order_book.get(), slot.analytics.get()));
+      slot.events_since_publish = 0;
+      slot.last_publish_time = end_time;
+    }
+  }
+
   /**
    * @brief Callback for aggregated ticks from feeds
+   *
+   * Routes by symbol: pinned symbols are queued to their worker, others
+   * are processed inline. Ticks without a symbol go to the DEFAULT book.
    */
   void on_aggregated_tick(const AggregatedTick &tick) {
+    TRACE_SPAN("platform.route", tick.tick.trace_id);
     auto start_time = std::chrono::steady_clock::now();
 
-    // Create synthetic order from tick (for demonstration)
-    // In production, this would come from actual order flow
+    if (tick.tick.symbol[0] == '\0') {
+      process_default_tick(tick, start_time);
+    } else {
+      uint64_t key = pack_symbol(tick.tick.symbol);
+      auto it = route_.find(key);
+      SymbolSlot *slot;
+      if (it != route_.end()) {
+        slot = it->second;
+      } else {
+        // Slots may be created on any thread; only this one caches them
+        slot = get_or_create_slot(std::string(
+            tick.tick.symbol, strnlen(tick.tick.symbol, sizeof(tick.tick.symbol))));
+        route_.emplace(key, slot);
+      }
+
+      if (slot->worker < 0) {
+        process_symbol_tick(*slot, tick.tick, start_time);
+      } else {
+        SymbolWorker &worker = *workers_[slot->worker];
+        RoutedTick routed{slot, tick.tick, start_time};
+        // Back-pressure: never drop, wait for the worker to catch up
+        if (!worker.queue->push(routed)) {
+          // One full event per stall; spins and wait time go to the
+          // queue telemetry (hft_queue_stall_* metrics)
+          worker.full_waits.fetch_add(1, std::memory_order_relaxed);
+          const uint64_t stall_start = now_ns();
+          uint64_t spins = 0;
+          do {
+            ++spins;
+            cpu_relax();
+            if (config_.wait_strategy != WaitStrategy::BUSY_SPIN) {
+              std::this_thread::yield();
+            }
+          } while (!worker.queue->push(routed));
+          worker.queue->telemetry().record_stall(spins, now_ns() - stall_start);
+        }
+        worker.enqueued++;
+        worker.waiter.notify();
+      }
+    }
+
+    // Publish for snapshot readers every N events or T microseconds
+    if (++events_since_publish_ >= config_.snapshot_publish_events ||
+        std::chrono::steady_clock::now() - last_publish_time_ >=
+            std::chrono::microseconds(config_.snapshot_publish_interval_us)) {
+      publish_snapshot();
+    }
+  }
+
+  /**
+   * @brief Applies a tick without a symbol to the DEFAULT book
+   */
+  void process_default_tick(const AggregatedTick &tick,
+                            std::chrono::steady_clock::time_point start_time) {
+    TRACE_SPAN("platform.book_update", tick.tick.trace_id);
+    TRACE_EVENT(tick.tick.trace_id);
     int order_id =
         static_cast<int>(performance_monitor_->events_processed() + 1);
     int account_id = 1; // Default account
     Side side = (tick.tick.volume % 2 == 0) ? Side::BUY : Side::SELL;
-    double price = tick.tick.price;
-    int quantity = static_cast<int>(tick.tick.volume);
-
-    // Use proper Order constructor
-    Order order(order_id, account_id, side, price, quantity, TimeInForce::GTC);
-
-    // Add to order book (this triggers analytics via FillRouter)
-    order_book_->add_order(order);
+    Order order(order_id, account_id, side, tick.tick.price,
+                static_cast<int>(tick.tick.volume), TimeInForce::GTC);
+    LatencyCheckpoints checkpoints = tick.tick.checkpoints;
+    order_book_->add_order(order, checkpoints);
+    if (config_.enable_performance_monitoring) {
+      latency_tracker_->record_checkpoints(checkpoints);
+    }
 
-    // Record latency
     auto end_time = std::chrono::steady_clock::now();
-    auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        end_time - start_time);
-    performance_monitor_->record_event_latency(latency);
+    performance_monitor_->record_event_latency(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end_time -
+                                                             start_time));
   }
 };
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+/**
+ * Single-Producer Broadcast Ring
+ *
+ * Every reader sees every item (unlike SPMCQueue, where consumers compete
+ * for items). The producer never waits: it overwrites the oldest slot, and
+ * a reader that falls more than capacity() items behind is told it was
+ * lapped so it can resynchronize (e.g. from a snapshot).
+ *
+ * Each slot is a small sequence lock: the writer stores 2*pos+1, the
+ * payload, then 2*pos+2. A reader at position pos accepts the slot only if
+ * it reads 2*pos+2 before and after copying, so a torn or overwritten value
+ * is never returned. As in SeqLock, the payload is held in relaxed atomic
+ * words so concurrent access is not a data race.
+ *
+ * Readers keep their own position; the ring holds no per-reader state, so
+ * readers can join and leave at any time.
+ */
+
+template <typename T>
+class BroadcastRing {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "BroadcastRing requires a trivially copyable type");
+
+public:
+  enum class ReadStatus {
+    OK,     // Item copied, position advanced
+    EMPTY,  // Nothing published at this position yet
+    LAPPED  // Item was overwritten; resume from oldest() after a resync
+  };
+
+  explicit BroadcastRing(size_t capacity)
+      : capacity_(round_up_to_power_of_2(capacity)),
+        mask_(capacity_ - 1),
+        slots_(std::make_unique<Slot[]>(capacity_)) {}
+
+  // Non-copyable, non-movable
+  BroadcastRing(const BroadcastRing &) = delete;
+  BroadcastRing &operator=(const BroadcastRing &) = delete;
+
+  /**
+   * Producer-side: Publish an item (never blocks, never fails)
+   * @return Position of the item
+   */
+  uint64_t publish(const T &item) {
+    const uint64_t pos = head_.load(std::memory_order_relaxed);
+    Slot &slot = slots_[pos & mask_];
+    slot.seq.store(2 * pos + 1, std::memory_order_relaxed);
+    // Keep the payload stores after the odd sequence becomes visible
+    std::atomic_thread_fence(std::memory_order_release);
+    store(slot, item);
+    slot.seq.store(2 * pos + 2, std::memory_order_release);
+    head_.store(pos + 1, std::memory_order_release);
+    return pos;
+  }
+
+  /**
+   * Reader-side: Copy the item at position and advance it
+   */
+  ReadStatus try_read(uint64_t &position, T &out) const {
+    const Slot &slot = slots_[position & mask_];
+    const uint64_t expected = 2 * position + 2;
+    const uint64_t before = slot.seq.load(std::memory_order_acquire);
+    if (before != expected) {
+      return before < expected ? ReadStatus::EMPTY : ReadStatus::LAPPED;
+    }
+    load(slot, out);
+    // Keep the payload loads before the second sequence check
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != expected) {
+      return ReadStatus::LAPPED;
+    }
+    ++position;
+    return ReadStatus::OK;
+  }
+
+  /**
+   * Position the next publish() will use (= items published so far)
+   */
+  uint64_t head() const { return head_.load(std::memory_order_acquire); }
+
+  /**
+   * Oldest position still readable
+   */
+  uint64_t oldest() const {
+    const uint64_t head = this->head();
+    return head > capacity_ ? head - capacity_ : 0;
+  }
+
+  size_t capacity() const { return capacity_; }
+
+private:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+  static constexpr size_t NUM_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  struct Slot {
+    std::atomic<uint64_t> seq{0};
+    std::atomic<uint64_t> data[NUM_WORDS];
+  };
+
+  static void store(Slot &slot, const T &value) {
+    uint64_t words[NUM_WORDS] = {};
+    std::memcpy(words, &value, sizeof(T));
+    for (size_t i = 0; i < NUM_WORDS; ++i) {
+      slot.data[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  static void load(const Slot &slot, T &out) {
+    uint64_t words[NUM_WORDS];
+    for (size_t i = 0; i < NUM_WORDS; ++i) {
+      words[i] = slot.data[i].load(std::memory_order_relaxed);
+    }
+    std::memcpy(&out, words, sizeof(T));
+  }
+
+  static size_t round_up_to_power_of_2(size_t n) {
+    if (n == 0)
+      return 1;
+    n--;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+    n |= n >> 32;
+    return n + 1;
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Producer-owned, read by readers joining or resyncing
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_{0};
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+/**
+ * Bounded Lock-Free Multiple-Producer Single-Consumer (MPSC) Queue
+ *
+ * Several feed handlers funnelling into one sequencer is the MPSC hop.
+ *
+ * Key differences from SPSC:
+ * 1. Producers compete for head_ using compare-and-swap (CAS)
+ * 2. Each slot carries a sequence number, so a producer that claimed a
+ *    slot but has not finished writing it is never read early
+ * 3. The consumer owns tail_ exclusively (no CAS on pop)
+ *
+ * Slot i is free for the producer holding ticket t when
+ * sequence == t, and ready for the consumer when sequence == t + 1.
+ */
+
+template <typename T>
+class MPSCQueue {
+public:
+  explicit MPSCQueue(size_t capacity)
+      : capacity_(round_up_to_power_of_2(capacity < 2 ? 2 : capacity)),
+        mask_(capacity_ - 1),
+        slots_(std::make_unique<Slot[]>(capacity_)),
+        head_(0),
+        tail_(0) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Non-copyable, non-movable
+  MPSCQueue(const MPSCQueue &) = delete;
+  MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+  /**
+   * Producer-side: Push an item (any number of producer threads)
+   * Returns false if the queue is full
+   */
+  bool push(const T &item) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[head & mask_];
+      const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(head);
+
+      if (diff == 0) {
+        // Slot free for this ticket: try to claim it
+        if (head_.compare_exchange_weak(head, head + 1,
+                                        std::memory_order_relaxed,
+                                        std::memory_order_relaxed)) {
+          slot.data = item;
+          // Release: publish the data to the consumer
+          slot.sequence.store(head + 1, std::memory_order_release);
+          return true;
+        }
+        // CAS failed: head was reloaded, retry
+      } else if (diff < 0) {
+        return false; // Queue full (consumer has not freed this slot yet)
+      } else {
+        head = head_.load(std::memory_order_relaxed); // Lost the race
+      }
+    }
+  }
+
+  /**
+   * Consumer-side: Pop an item (single consumer thread only)
+   */
+  std::optional<T> pop() {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    Slot &slot = slots_[tail & mask_];
+
+    // Acquire: synchronize with the producer's release of sequence
+    if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+      return std::nullopt; // Empty, or the claiming producer is mid-write
+    }
+
+    std::optional<T> item(std::move(slot.data));
+    // Release: hand the slot back to producers one lap later
+    slot.sequence.store(tail + capacity_, std::memory_order_release);
+    tail_.store(tail + 1, std::memory_order_relaxed);
+    return item;
+  }
+
+  /**
+   * Check if queue is empty
+   * Note: This is a snapshot and may be immediately stale
+   */
+  bool empty() const { return size() == 0; }
+
+  /**
+   * Get approximate size
+   * Note: Counts slots claimed by producers that are still writing
+   */
+  size_t size() const {
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    return head > tail ? head - tail : 0;
+  }
+
+  size_t capacity() const { return capacity_; }
+
+private:
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    T data{};
+  };
+
+  static size_t round_up_to_power_of_2(size_t n) {
+    if (n == 0) return 1;
+    n--;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+    n |= n >> 32;
+    return n + 1;
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  // Cache line padding: prevent false sharing between producers and consumer
+  alignas(64) std::atomic<size_t> head_;  // Producers claim tickets via CAS
+
+  alignas(64) std::atomic<size_t> tail_;  // Consumer writes, producers never read
+};
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * Optional Queue Telemetry (depth and back-pressure)
+ *
+ * Plugged into SPSCQueue / SPMCQueue as a policy type:
+ *
+ *   SPSCQueue<Tick>                  // NullQueueTelemetry: compiles away
+ *   SPSCQueue<Tick, QueueTelemetry>  // high-water, full pushes, stalls
+ *
+ * Every counter is written only by the single producer, so updates are
+ * relaxed load/store pairs (no locked RMW), and the block lives on its
+ * own cache lines so the consumer never shares a line with it. Monitoring
+ * threads read it with relaxed loads via snapshot().
+ *
+ * Occupancy is sampled once every SAMPLE_INTERVAL successful pushes into
+ * a histogram of fill fraction (tenths of capacity).
+ */
+
+/**
+ * Plain-value copy of a QueueTelemetry for reporting
+ */
+struct QueueTelemetrySnapshot {
+  static constexpr size_t NUM_OCCUPANCY_BUCKETS = 10;
+
+  size_t capacity = 0;
+  uint64_t pushes = 0;         // Successful pushes
+  uint64_t high_water = 0;     // Max occupancy seen right after a push
+  uint64_t push_failures = 0;  // push() calls that found the queue full
+  uint64_t stalls = 0;         // Producer waits reported via record_stall()
+  uint64_t stall_spins = 0;    // Retry iterations spent in those waits
+  uint64_t stall_ns = 0;       // Wall time spent in those waits
+  uint64_t occupancy_samples = 0;
+  uint64_t occupancy_sum = 0;  // Sum of sampled occupancies (items)
+  std::array<uint64_t, NUM_OCCUPANCY_BUCKETS> occupancy{}; // [i*10%, (i+1)*10%)
+
+  double mean_occupancy() const {
+    return occupancy_samples > 0
+               ? static_cast<double>(occupancy_sum) / occupancy_samples
+               : 0.0;
+  }
+
+  void print(const std::string &name) const {
+    std::cout << "  Queue [" << name << "] capacity " << capacity << ":\n";
+    std::cout << "    Pushes: " << pushes << ", high-water: " << high_water
+              << " (" << std::fixed << std::setprecision(1)
+              << (capacity > 0 ? 100.0 * high_water / capacity : 0.0)
+              << "%)\n";
+    std::cout << "    Full pushes: " << push_failures << ", stalls: " << stalls
+              << " (" << stall_spins << " spins, " << stall_ns / 1000
+              << " us)\n";
+    if (occupancy_samples > 0) {
+      std::cout << "    Occupancy (" << occupancy_samples
+                << " samples, mean " << std::setprecision(1)
+                << mean_occupancy() << "):";
+      for (size_t i = 0; i < NUM_OCCUPANCY_BUCKETS; ++i) {
+        if (occupancy[i] > 0) {
+          std::cout << " " << i * 10 << "%:" << occupancy[i];
+        }
+      }
+      std::cout << "\n";
+    }
+  }
+};
+
+/**
+ * Telemetry disabled: every hook is an empty inline call
+ */
+struct NullQueueTelemetry {
+  static constexpr bool enabled = false;
+
+  void on_push(size_t /*occupancy*/, size_t /*capacity*/) {}
+  void on_full() {}
+  void record_stall(uint64_t /*spins*/, uint64_t /*ns*/) {}
+};
+
+/**
+ * Producer-side queue telemetry
+ */
+class QueueTelemetry {
+public:
+  static constexpr bool enabled = true;
+  static constexpr uint64_t SAMPLE_INTERVAL = 64; // Pushes per occupancy sample
+  static constexpr size_t NUM_OCCUPANCY_BUCKETS =
+      QueueTelemetrySnapshot::NUM_OCCUPANCY_BUCKETS;
+
+  /**
+   * Producer-side: after a successful push
+   * @param occupancy Items in the queue including the one just pushed
+   */
+  void on_push(size_t occupancy, size_t capacity) {
+    const uint64_t pushes = pushes_.load(std::memory_order_relaxed) + 1;
+    pushes_.store(pushes, std::memory_order_relaxed);
+    if (occupancy > high_water_.load(std::memory_order_relaxed)) {
+      high_water_.store(occupancy, std::memory_order_relaxed);
+    }
+    if (pushes % SAMPLE_INTERVAL == 0) {
+      sample(occupancy, capacity);
+    }
+  }
+
+  /**
+   * Producer-side: push() found the queue full
+   */
+  void on_full() { bump(push_failures_, 1); }
+
+  /**
+   * Producer-side: a blocking enqueue had to wait for the consumer
+   * @param spins Retry iterations before the push succeeded
+   * @param ns Time spent waiting
+   */
+  void record_stall(uint64_t spins, uint64_t ns) {
+    bump(stalls_, 1);
+    bump(stall_spins_, spins);
+    bump(stall_ns_, ns);
+  }
+
+  /**
+   * Safe from any thread; values may be mid-update relative to each other
+   */
+  QueueTelemetrySnapshot snapshot(size_t capacity) const {
+    QueueTelemetrySnapshot s;
+    s.capacity = capacity;
+    s.pushes = pushes_.load(std::memory_order_relaxed);
+    s.high_water = high_water_.load(std::memory_order_relaxed);
+    s.push_failures = push_failures_.load(std::memory_order_relaxed);
+    s.stalls = stalls_.load(std::memory_order_relaxed);
+    s.stall_spins = stall_spins_.load(std::memory_order_relaxed);
+    s.stall_ns = stall_ns_.load(std::memory_order_relaxed);
+    s.occupancy_samples = occupancy_samples_.load(std::memory_order_relaxed);
+    s.occupancy_sum = occupancy_sum_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < NUM_OCCUPANCY_BUCKETS; ++i) {
+      s.occupancy[i] = occupancy_[i].load(std::memory_order_relaxed);
+    }
+    return s;
+  }
+
+  /**
+   * Reset counters (only while the producer is idle)
+   */
+  void reset() {
+    pushes_.store(0, std::memory_order_relaxed);
+    high_water_.store(0, std::memory_order_relaxed);
+    push_failures_.store(0, std::memory_order_relaxed);
+    stalls_.store(0, std::memory_order_relaxed);
+    stall_spins_.store(0, std::memory_order_relaxed);
+    stall_ns_.store(0, std::memory_order_relaxed);
+    occupancy_samples_.store(0, std::memory_order_relaxed);
+    occupancy_sum_.store(0, std::memory_order_relaxed);
+    for (auto &bucket : occupancy_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  static void bump(std::atomic<uint64_t> &counter, uint64_t n) {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+
+  void sample(size_t occupancy, size_t capacity) {
+    size_t bucket = capacity > 0 ? occupancy * NUM_OCCUPANCY_BUCKETS / capacity
+                                 : 0;
+    if (bucket >= NUM_OCCUPANCY_BUCKETS) {
+      bucket = NUM_OCCUPANCY_BUCKETS - 1;
+    }
+    bump(occupancy_[bucket], 1);
+    bump(occupancy_samples_, 1);
+    bump(occupancy_sum_, occupancy);
+  }
+
+  // Hot: touched on every push
+  alignas(64) std::atomic<uint64_t> pushes_{0};
+  std::atomic<uint64_t> high_water_{0};
+
+  // Cold: full queue and sampling only
+  alignas(64) std::atomic<uint64_t> push_failures_{0};
+  std::atomic<uint64_t> stalls_{0};
+  std::atomic<uint64_t> stall_spins_{0};
+  std::atomic<uint64_t> stall_ns_{0};
+  std::atomic<uint64_t> occupancy_samples_{0};
+  std::atomic<uint64_t> occupancy_sum_{0};
+  std::array<std::atomic<uint64_t>, NUM_OCCUPANCY_BUCKETS> occupancy_{};
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "wait_strategy.hpp"
+
+/**
+ * Single-Writer Sequence Lock
+ *
+ * Publishes a value of trivially copyable type T from one writer thread
+ * to any number of readers. Neither side blocks:
+ * - The writer bumps the sequence to odd, copies the value in, then bumps
+ *   it to even. Writes never wait for readers.
+ * - Readers copy the value out and retry if the sequence was odd or
+ *   changed during the copy, so a torn value is never returned.
+ *
+ * The payload is stored as relaxed atomic 64-bit words rather than raw
+ * bytes, so concurrent reads and writes are not a data race under the
+ * C++ memory model; on x86-64 these compile to plain moves.
+ *
+ * Cache coherency considerations:
+ * - seq_ shares a line with the start of the payload; readers touch both
+ * - The whole object is cache-line aligned so it never shares a line
+ *   with unrelated writer state
+ */
+
+template <typename T>
+class SeqLock {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SeqLock requires a trivially copyable type");
+
+public:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  SeqLock() : SeqLock(T{}) {}
+  explicit SeqLock(const T &initial) { store(initial); }
+
+  // Non-copyable, non-movable
+  SeqLock(const SeqLock &) = delete;
+  SeqLock &operator=(const SeqLock &) = delete;
+
+  /**
+   * Writer-side: Publish a new value
+   * Must only be called from one thread at a time.
+   */
+  void write(const T &value) {
+    const uint64_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    // Keep the payload stores after the odd sequence becomes visible
+    std::atomic_thread_fence(std::memory_order_release);
+    store(value);
+    seq_.store(seq + 2, std::memory_order_release);
+  }
+
+  /**
+   * Reader-side: Single attempt to read a consistent value
+   * Returns false if a write was in progress; out is then unspecified.
+   */
+  bool try_read(T &out) const {
+    const uint64_t before = seq_.load(std::memory_order_acquire);
+    if (before & 1) {
+      return false;
+    }
+    load(out);
+    // Keep the payload loads before the second sequence check
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return seq_.load(std::memory_order_relaxed) == before;
+  }
+
+  /**
+   * Reader-side: Read a consistent value, retrying across concurrent writes
+   */
+  T read() const {
+    T out;
+    while (!try_read(out)) {
+      cpu_relax();
+    }
+    return out;
+  }
+
+  /**
+   * Number of completed writes (changes whenever a new value is published)
+   */
+  uint64_t version() const {
+    return seq_.load(std::memory_order_acquire) / 2;
+  }
+
+private:
+  static constexpr size_t NUM_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  void store(const T &value) {
+    uint64_t words[NUM_WORDS] = {};
+    std::memcpy(words, &value, sizeof(T));
+    for (size_t i = 0; i < NUM_WORDS; ++i) {
+      data_[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  void load(T &out) const {
+    uint64_t words[NUM_WORDS];
+    for (size_t i = 0; i < NUM_WORDS; ++i) {
+      words[i] = data_[i].load(std::memory_order_relaxed);
+    }
+    std::memcpy(&out, words, sizeof(T));
+  }
+
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> seq_{0};
+  std::atomic<uint64_t> data_[NUM_WORDS];
+};
@@ -5,6 +5,8 @@
 #include <memory>
 #include <optional>
 
+#include "queue_telemetry.hpp"
+
 /**
  * Lock-Free Single-Producer Multiple-Consumer (SPMC) Ring Buffer
  *
@@ -16,9 +18,12 @@
  * Cache coherency considerations:
  * - head_ and tail_ on separate cache lines (prevent producer/consumer ping-pong)
  * - Each consumer should pad their local state to prevent false sharing
+ *
+ * Telemetry is producer-side only, so it works unchanged with many
+ * consumers (see SPSCQueue).
  */
 
-template <typename T>
+template <typename T, typename Telemetry = NullQueueTelemetry>
 class SPMCQueue {
 public:
   explicit SPMCQueue(size_t capacity)
@@ -42,7 +47,9 @@ public:
 
     // Check if queue is full
     // Use acquire to see latest tail_ from any consumer
-    if (next_head == tail_.load(std::memory_order_acquire)) {
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    if (next_head == tail) {
+      telemetry_.on_full();
       return false; // Queue full
     }
 
@@ -50,6 +57,7 @@ public:
 
     // Release: make buffer write visible to all consumers
     head_.store(next_head, std::memory_order_release);
+    telemetry_.on_push((next_head - tail) & mask_, capacity_);
     return true;
   }
 
@@ -60,12 +68,15 @@ public:
     const size_t head = head_.load(std::memory_order_relaxed);
     const size_t next_head = (head + 1) & mask_;
 
-    if (next_head == tail_.load(std::memory_order_acquire)) {
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    if (next_head == tail) {
+      telemetry_.on_full();
       return false; // Queue full
     }
 
     buffer_[head] = std::move(item);
     head_.store(next_head, std::memory_order_release);
+    telemetry_.on_push((next_head - tail) & mask_, capacity_);
     return true;
   }
 
@@ -138,6 +149,19 @@ public:
 
   size_t capacity() const { return capacity_; }
 
+  /**
+   * Producer-side telemetry (record_stall() from blocking enqueue loops)
+   */
+  Telemetry &telemetry() { return telemetry_; }
+  const Telemetry &telemetry() const { return telemetry_; }
+
+  /**
+   * Telemetry copy for reporting (QueueTelemetry only; any thread)
+   */
+  QueueTelemetrySnapshot telemetry_snapshot() const {
+    return telemetry_.snapshot(capacity_);
+  }
+
 private:
   static size_t round_up_to_power_of_2(size_t n) {
     if (n == 0) return 1;
@@ -159,4 +183,6 @@ private:
   alignas(64) std::atomic<size_t> head_;  // Producer writes, consumers read
 
   alignas(64) std::atomic<size_t> tail_;  // Consumers write (compete via CAS), producer reads
+
+  Telemetry telemetry_; // Producer-owned; own cache lines when enabled
 };
@@ -5,11 +5,17 @@
 #include <memory>
 #include <optional>
 
+#include "queue_telemetry.hpp"
+
 /**
  * Lock-Free Single-Producer Single-Consumer (SPSC) Ring Buffer
+ *
+ * Telemetry: pass QueueTelemetry as the second template argument to track
+ * high-water mark, full-queue pushes and sampled occupancy (see
+ * queue_telemetry.hpp). The default NullQueueTelemetry costs nothing.
  */
 
-template <typename T> class SPSCQueue {
+template <typename T, typename Telemetry = NullQueueTelemetry> class SPSCQueue {
 public:
   explicit SPSCQueue(size_t capacity)
       : capacity_(round_up_to_power_of_2(capacity)), mask_(capacity_ - 1),
@@ -31,7 +37,9 @@ public:
 
     // Check if queue is full (head would catch up to tail)
     // Use acquire to synchronize with consumer's release in pop()
-    if (next_head == tail_.load(std::memory_order_acquire)) {
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    if (next_head == tail) {
+      telemetry_.on_full();
       return false; // Queue full
     }
 
@@ -39,6 +47,7 @@ public:
 
     // Release: make the write to buffer visible to consumer
     head_.store(next_head, std::memory_order_release);
+    telemetry_.on_push((next_head - tail) & mask_, capacity_);
     return true;
   }
 
@@ -49,12 +58,15 @@ public:
     const size_t head = head_.load(std::memory_order_relaxed);
     const size_t next_head = (head + 1) & mask_;
 
-    if (next_head == tail_.load(std::memory_order_acquire)) {
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    if (next_head == tail) {
+      telemetry_.on_full();
       return false; // Queue full
     }
 
     buffer_[head] = std::move(item);
     head_.store(next_head, std::memory_order_release);
+    telemetry_.on_push((next_head - tail) & mask_, capacity_);
     return true;
   }
 
@@ -97,6 +109,19 @@ public:
 
   size_t capacity() const { return capacity_; }
 
+  /**
+   * Producer-side telemetry (record_stall() from blocking enqueue loops)
+   */
+  Telemetry &telemetry() { return telemetry_; }
+  const Telemetry &telemetry() const { return telemetry_; }
+
+  /**
+   * Telemetry copy for reporting (QueueTelemetry only; any thread)
+   */
+  QueueTelemetrySnapshot telemetry_snapshot() const {
+    return telemetry_.snapshot(capacity_);
+  }
+
 private:
   static size_t round_up_to_power_of_2(size_t n) {
     if (n == 0)
@@ -121,4 +146,6 @@ private:
   alignas(64) std::atomic<size_t> head_; // Producer writes, consumer reads
 
   alignas(64) std::atomic<size_t> tail_; // Consumer writes, producer reads
+
+  Telemetry telemetry_; // Producer-owned; own cache lines when enabled
 };
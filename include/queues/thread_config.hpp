@@ -0,0 +1,128 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Thread Placement and Naming
+ *
+ * Names show up in top -H, perf and gdb, which makes per-thread CPU use
+ * attributable. Pinning keeps a hot thread on one core so its caches
+ * stay warm and the scheduler never migrates it. Both are best-effort:
+ * failures are reported but never fatal, so the same configuration runs
+ * on research boxes without isolated cores.
+ */
+
+struct ThreadConfig {
+  std::string name; ///< Thread name (truncated to 15 characters on Linux)
+  int cpu = -1;     ///< CPU to pin to, -1 = let the scheduler decide
+};
+
+/**
+ * Names the calling thread
+ * @return true on success
+ */
+inline bool set_current_thread_name(const std::string &name) {
+#if defined(__linux__)
+  if (name.empty()) {
+    return false;
+  }
+  return pthread_setname_np(pthread_self(), name.substr(0, 15).c_str()) == 0;
+#else
+  (void)name;
+  return false;
+#endif
+}
+
+/**
+ * Gets the calling thread's name
+ */
+inline std::string get_current_thread_name() {
+#if defined(__linux__)
+  char buf[16] = {};
+  if (pthread_getname_np(pthread_self(), buf, sizeof(buf)) == 0) {
+    return buf;
+  }
+#endif
+  return "";
+}
+
+/**
+ * Pins the calling thread to one CPU
+ * @return true on success
+ */
+inline bool pin_current_thread(int cpu) {
+#if defined(__linux__)
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+/**
+ * Applies a ThreadConfig to the calling thread
+ * @return false if a requested pin failed
+ */
+inline bool apply_thread_config(const ThreadConfig &config) {
+  set_current_thread_name(config.name);
+  if (config.cpu < 0) {
+    return true;
+  }
+  return pin_current_thread(config.cpu);
+}
+
+/**
+ * Where one CPU sits: SMT siblings share a core, cores share a socket
+ */
+struct CpuLocation {
+  int cpu = -1;
+  int core = -1;   ///< core_id (unique only within its socket)
+  int socket = -1; ///< physical_package_id
+};
+
+/**
+ * Lists the CPUs this process may run on, with their core and socket
+ * @return Empty if the topology cannot be read (non-Linux, no sysfs)
+ */
+inline std::vector<CpuLocation> read_cpu_topology() {
+  std::vector<CpuLocation> cpus;
+#if defined(__linux__)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return cpus;
+  }
+  auto read_int = [](const std::string &path) {
+    std::ifstream file(path);
+    int value = -1;
+    file >> value;
+    return file ? value : -1;
+  };
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (!CPU_ISSET(cpu, &allowed)) {
+      continue;
+    }
+    std::string base =
+        "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+    CpuLocation location;
+    location.cpu = cpu;
+    location.core = read_int(base + "core_id");
+    location.socket = read_int(base + "physical_package_id");
+    cpus.push_back(location);
+  }
+#endif
+  return cpus;
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Wait Strategies for Queue Consumers
+ *
+ * What a consumer thread does when its queue is empty:
+ * - BUSY_SPIN:  pause instruction only. Lowest wakeup latency; burns a
+ *               full core. For colocated boxes with isolated cores.
+ * - SPIN_YIELD: spin for a bounded number of rounds, then yield the CPU
+ *               between polls. Previous default behaviour.
+ * - SPIN_PARK:  spin, then sleep on a futex until the producer signals
+ *               new work. Idle threads cost nothing; the producer pays
+ *               one fence per push while a consumer may be parked.
+ *
+ * One QueueWaiter is shared by the producer (notify) and the single
+ * consumer (idle / on_work) of a queue.
+ */
+
+enum class WaitStrategy {
+  BUSY_SPIN,  ///< Spin with pause; never gives up the core
+  SPIN_YIELD, ///< Spin, then std::this_thread::yield()
+  SPIN_PARK   ///< Spin, then park on a futex until notified
+};
+
+/**
+ * CPU hint for spin loops (reduces power and pipeline flushes)
+ */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+inline const char *wait_strategy_name(WaitStrategy strategy) {
+  switch (strategy) {
+  case WaitStrategy::BUSY_SPIN:
+    return "busy-spin";
+  case WaitStrategy::SPIN_YIELD:
+    return "spin-yield";
+  case WaitStrategy::SPIN_PARK:
+    return "spin-park";
+  }
+  return "unknown";
+}
+
+class QueueWaiter {
+public:
+  static constexpr uint32_t DEFAULT_SPIN_LIMIT = 1024;
+
+  /// Upper bound on a single park, so stop flags are always re-checked
+  static constexpr std::chrono::microseconds MAX_PARK{1000};
+
+  explicit QueueWaiter(WaitStrategy strategy = WaitStrategy::SPIN_YIELD,
+                       uint32_t spin_limit = DEFAULT_SPIN_LIMIT)
+      : strategy_(strategy), spin_limit_(spin_limit) {}
+
+  // Non-copyable, non-movable (contains atomics)
+  QueueWaiter(const QueueWaiter &) = delete;
+  QueueWaiter &operator=(const QueueWaiter &) = delete;
+
+  /**
+   * Sets the strategy (only while the consumer is not running)
+   */
+  void set_strategy(WaitStrategy strategy) { strategy_ = strategy; }
+  WaitStrategy strategy() const { return strategy_; }
+
+  /**
+   * Consumer-side: Called when a poll found no work
+   * @param ready Returns true if work (or a stop request) is pending.
+   *              Re-checked after announcing a park so a concurrent
+   *              notify() cannot be missed.
+   */
+  template <typename Ready> void idle(Ready &&ready) {
+    if (strategy_ == WaitStrategy::BUSY_SPIN || spins_ < spin_limit_) {
+      ++spins_;
+      cpu_relax();
+      return;
+    }
+
+    if (strategy_ == WaitStrategy::SPIN_YIELD) {
+      std::this_thread::yield();
+      return;
+    }
+
+    // SPIN_PARK: announce, re-check, then sleep until notified
+    const uint32_t epoch = epoch_.load(std::memory_order_acquire);
+    parked_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!ready()) {
+      park(epoch);
+      parks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    parked_.store(false, std::memory_order_relaxed);
+  }
+
+  /**
+   * Consumer-side: Called when a poll found work; restarts spinning
+   */
+  void on_work() { spins_ = 0; }
+
+  /**
+   * Producer-side: Called after publishing work
+   * Free for spinning strategies; for SPIN_PARK costs one fence, plus a
+   * wake syscall only if the consumer is actually parked.
+   */
+  void notify() {
+    if (strategy_ != WaitStrategy::SPIN_PARK) {
+      return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed)) {
+      wake();
+    }
+  }
+
+  /**
+   * Wakes a parked consumer unconditionally (e.g. on shutdown)
+   */
+  void wake() {
+    epoch_.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch_),
+            FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+  }
+
+  /**
+   * Number of times the consumer parked
+   */
+  uint64_t park_count() const { return parks_.load(std::memory_order_relaxed); }
+
+private:
+  void park(uint32_t epoch) {
+#if defined(__linux__)
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                  "futex word must be a plain 32-bit integer");
+    struct timespec timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(MAX_PARK).count();
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch_),
+            FUTEX_WAIT_PRIVATE, epoch, &timeout, nullptr, 0);
+#else
+    (void)epoch;
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif
+  }
+
+  WaitStrategy strategy_;
+  uint32_t spin_limit_;
+  uint32_t spins_ = 0; // Consumer only
+
+  alignas(64) std::atomic<uint32_t> epoch_{0};
+  std::atomic<bool> parked_{false};
+  std::atomic<uint64_t> parks_{0};
+};
@@ -1,12 +1,14 @@
 // src/fill_router.cpp
 #include "fill_router.hpp"
-#include <algorithm>
+#include "trace_recorder.hpp"
 #include <iomanip>
 #include <iostream>
 
 bool FillRouter::route_fill(const Fill &fill, const Order &aggressive_order,
                             const Order &passive_order,
                             const std::string &symbol) {
+  TRACE_SPAN("fill_router.route", current_trace_event());
+
   // 1. Check for self-trades
   if (prevent_self_trades_ && is_self_trade(aggressive_order, passive_order)) {
     self_trades_prevented_++;
@@ -40,11 +42,16 @@ bool FillRouter::route_fill(const Fill &fill, const Order &aggressive_order,
     calculate_fees(enhanced_fill, aggressive_is_buyer);
   }
 
-  // 6. Store fill
+  // 6. Store fill (routing_time marks hand-off to the callbacks)
+  enhanced_fill.routing_time = Clock::now();
   routed_fills_.push_back(enhanced_fill);
+  index_fill(static_cast<uint32_t>(routed_fills_.size() - 1));
   total_fills_routed_++;
 
-  // 7. Notify callbacks
+  // 7. Update positions (before callbacks, so they see post-fill P&L)
+  update_positions(enhanced_fill);
+
+  // 8. Notify callbacks
   notify_callbacks(enhanced_fill);
 
   return true;
@@ -71,6 +78,27 @@ void FillRouter::calculate_fees(EnhancedFill &fill, bool aggressive_is_buyer) {
   }
 }
 
+void FillRouter::index_fill(uint32_t offset) {
+  const EnhancedFill &fill = routed_fills_[offset];
+  fill_id_index_.insert(fill.fill_id, offset);
+  fills_by_account_[fill.buy_account_id].push_back(offset);
+  if (fill.sell_account_id != fill.buy_account_id) {
+    fills_by_account_[fill.sell_account_id].push_back(offset);
+  }
+  fills_by_symbol_[fill.symbol].push_back(offset);
+}
+
+void FillRouter::update_positions(const EnhancedFill &fill) {
+  const SymbolId symbol = ledger_.intern_symbol(fill.symbol);
+  const int64_t qty = fill.base_fill.quantity;
+  const double price = fill.base_fill.price;
+  // The aggressor takes liquidity; the resting side makes it
+  ledger_.record(fill.buy_account_id, symbol, qty, price, fill.buyer_fee,
+                 !fill.is_aggressive_buy, fill.fill_id);
+  ledger_.record(fill.sell_account_id, symbol, -qty, price, fill.seller_fee,
+                 fill.is_aggressive_buy, fill.fill_id);
+}
+
 void FillRouter::notify_callbacks(const EnhancedFill &fill) {
   for (const auto &callback : fill_callbacks_) {
     callback(fill);
@@ -84,35 +112,29 @@ void FillRouter::notify_self_trade(int account_id, const Order &order1,
   }
 }
 
-std::vector<EnhancedFill>
-FillRouter::get_fills_for_account(int account_id) const {
-  std::vector<EnhancedFill> result;
-  for (const auto &fill : routed_fills_) {
-    if (fill.buy_account_id == account_id ||
-        fill.sell_account_id == account_id) {
-      result.push_back(fill);
-    }
-  }
-  return result;
+EnhancedFillView FillRouter::get_fills_for_account(int account_id) const {
+  auto it = fills_by_account_.find(account_id);
+  return it != fills_by_account_.end()
+             ? EnhancedFillView(&routed_fills_, &it->second)
+             : EnhancedFillView();
 }
 
-std::vector<EnhancedFill>
+EnhancedFillView
 FillRouter::get_fills_for_symbol(const std::string &symbol) const {
-  std::vector<EnhancedFill> result;
-  for (const auto &fill : routed_fills_) {
-    if (fill.symbol == symbol) {
-      result.push_back(fill);
-    }
-  }
-  return result;
+  auto it = fills_by_symbol_.find(symbol);
+  return it != fills_by_symbol_.end()
+             ? EnhancedFillView(&routed_fills_, &it->second)
+             : EnhancedFillView();
 }
 
 EnhancedFill *FillRouter::get_fill_by_id(uint64_t fill_id) {
-  auto it = std::find_if(
-      routed_fills_.begin(), routed_fills_.end(),
-      [fill_id](const EnhancedFill &f) { return f.fill_id == fill_id; });
+  const uint32_t offset = fill_id_index_.find(fill_id);
+  return offset != FillIdIndex::NONE ? &routed_fills_[offset] : nullptr;
+}
 
-  return (it != routed_fills_.end()) ? &(*it) : nullptr;
+const EnhancedFill *FillRouter::get_fill_by_id(uint64_t fill_id) const {
+  const uint32_t offset = fill_id_index_.find(fill_id);
+  return offset != FillIdIndex::NONE ? &routed_fills_[offset] : nullptr;
 }
 
 void FillRouter::print_statistics() const {
@@ -1,5 +1,6 @@
 #include "order_book.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
@@ -18,14 +19,125 @@ OrderBook::OrderBook(const std::string &symbol)
 //  HELPERS (for stop triggers & post-match finalization)
 // ============================================================================
 
+// Visible size at a level: icebergs show only their display quantity
+int64_t OrderBook::visible_quantity(const Order &order) {
+  return order.is_iceberg() ? std::min(order.display_qty, order.remaining_qty)
+                            : order.remaining_qty;
+}
+
+void OrderBook::apply_depth_change(Side side, double price, int64_t delta) {
+  if (delta == 0) {
+    return;
+  }
+  int64_t quantity;
+  if (side == Side::BUY) {
+    auto it = bid_depth_.emplace(price, 0).first;
+    quantity = (it->second += delta);
+    if (quantity <= 0) {
+      bid_depth_.erase(it);
+      quantity = 0;
+    }
+  } else {
+    auto it = ask_depth_.emplace(price, 0).first;
+    quantity = (it->second += delta);
+    if (quantity <= 0) {
+      ask_depth_.erase(it);
+      quantity = 0;
+    }
+  }
+
+  notify_depth(side, price, quantity);
+}
+
+void OrderBook::notify_depth(Side side, double price, int64_t quantity) {
+  const BookLevelUpdate update{++depth_sequence_, side, price, quantity};
+  for (const auto &listener : depth_listeners_) {
+    listener(update);
+  }
+}
+
+// Emits one level event per level that differs between two depth maps
+template <typename Map>
+void OrderBook::notify_depth_diff(Side side, const Map &before,
+                                  const Map &after) {
+  for (const auto &level : before) {
+    if (after.find(level.first) == after.end()) {
+      notify_depth(side, level.first, 0);
+    }
+  }
+  for (const auto &level : after) {
+    auto it = before.find(level.first);
+    if (it == before.end() || it->second != level.second) {
+      notify_depth(side, level.first, level.second);
+    }
+  }
+}
+
+// Recomputes depth from resting orders; with notify, listeners receive
+// the changed levels so subscribers converge on the new book
+void OrderBook::rebuild_depth(bool notify) {
+  auto old_bids = std::move(bid_depth_);
+  auto old_asks = std::move(ask_depth_);
+  bid_depth_.clear();
+  ask_depth_.clear();
+  for (const auto &entry : active_orders_) {
+    const Order &order = entry.second;
+    if (!order.is_active() || order.is_stop || order.remaining_qty <= 0) {
+      continue;
+    }
+    if (order.side == Side::BUY) {
+      bid_depth_[order.price] += visible_quantity(order);
+    } else {
+      ask_depth_[order.price] += visible_quantity(order);
+    }
+  }
+
+  if (notify) {
+    notify_depth_diff(Side::BUY, old_bids, bid_depth_);
+    notify_depth_diff(Side::SELL, old_asks, ask_depth_);
+  }
+}
+
+// Collar reference: last trade, else BBO mid (0 if neither is known)
+double OrderBook::risk_reference_price() const {
+  if (last_trade_price_ > 0.0) {
+    return last_trade_price_;
+  }
+  if (!bids_.empty() && !asks_.empty()) {
+    return 0.5 * (bids_.top().price + asks_.top().price);
+  }
+  return 0.0;
+}
+
+// Frees the order's open-order slot if it is no longer working
+void OrderBook::release_risk_if_done(int order_id, int account_id) {
+  if (!risk_gate_) {
+    return;
+  }
+  auto it = active_orders_.find(order_id);
+  if (it == active_orders_.end() || it->second.state == OrderState::FILLED ||
+      it->second.state == OrderState::CANCELLED ||
+      it->second.remaining_qty == 0) {
+    risk_gate_->on_order_closed(account_id);
+  }
+}
+
 // ============================================================================
 //  CORE ORDER OPERATIONS
 // ============================================================================
 
-void OrderBook::add_order(Order o) {
+bool OrderBook::add_order(Order o) {
   Timer timer;
   timer.start();
 
+  // Pre-trade risk: rejected orders never touch the book
+  if (risk_gate_) {
+    last_risk_reject_ = risk_gate_->check(o, risk_reference_price());
+    if (last_risk_reject_ != RiskReject::NONE) {
+      return false;
+    }
+  }
+
   Order order = o;
 
   // Handle stop orders (now with trigger-on-placement)
@@ -42,7 +154,7 @@ void OrderBook::add_order(Order o) {
 
       timer.stop();
       insertion_latencies_ns_.push_back(timer.elapsed_nanoseconds());
-      return;
+      return true;
     }
 
     // Otherwise, enqueue as pending stop (original behavior)
@@ -63,7 +175,7 @@ void OrderBook::add_order(Order o) {
 
     timer.stop();
     insertion_latencies_ns_.push_back(timer.elapsed_nanoseconds());
-    return; // Don't match yet
+    return true; // Don't match yet
   }
 
   // Regular orders (or triggered stops) proceed normally
@@ -96,9 +208,11 @@ void OrderBook::add_order(Order o) {
   // IMPORTANT: finalize states (prevents overwriting IOC remainder =>
   // CANCELLED)
   finalize_after_matching(order);
+  release_risk_if_done(order.id, order.account_id);
 
   timer.stop();
   insertion_latencies_ns_.push_back(timer.elapsed_nanoseconds());
+  return true;
 }
 
 // ============================================================================
@@ -130,6 +244,17 @@ bool OrderBook::cancel_order(int order_id) {
     return false;
   }
 
+  // Resting quantity leaves the level
+  if (depth_tracking_ && order.is_active() && !order.is_stop &&
+      order.remaining_qty > 0) {
+    apply_depth_change(order.side, order.price, -visible_quantity(order));
+  }
+
+  // Release the open-order slot unless it already closed (IOC remainder)
+  if (risk_gate_ && order.state != OrderState::CANCELLED) {
+    risk_gate_->on_order_closed(order.account_id);
+  }
+
   // Mark as canceled
   order.state = OrderState::CANCELLED;
 
@@ -176,20 +301,28 @@ bool OrderBook::amend_order(int order_id, std::optional<double> new_price,
     return false;
   }
 
-  // Extract order details
-  Side side = order.side;
-  double price = new_price.value_or(order.price);
-  int quantity = new_quantity.value_or(order.remaining_qty);
+  // Create new order with same ID (before cancel_order erases `order`)
+  Order amended_order(order_id, order.account_id, order.side,
+                      new_price.value_or(order.price),
+                      new_quantity.value_or(order.remaining_qty), order.tif);
+
+  // Pre-trade risk: a rejected replacement leaves the original resting
+  if (risk_gate_) {
+    last_risk_reject_ = risk_gate_->evaluate(
+        amended_order, risk_reference_price(), /*replacing=*/true);
+    if (last_risk_reject_ != RiskReject::NONE) {
+      risk_gate_->record_reject(amended_order.account_id, last_risk_reject_);
+      return false;
+    }
+  }
 
   // Cancel old order
   cancel_order(order_id);
 
-  // Create new order with same ID
-  Order amended_order(order_id, order.account_id, side, price, quantity,
-                      order.tif);
-
   // CRITICAL: Use add_order() to trigger matching logic
-  add_order(amended_order);
+  if (!add_order(amended_order)) {
+    return false;
+  }
 
   timer.stop();
 
@@ -259,17 +392,11 @@ const std::vector<AccountFill> &OrderBook::get_account_fills() const {
 }
 
 // Get fills for a specific account
-std::vector<AccountFill>
-OrderBook::get_fills_for_account(int account_id) const {
-  std::vector<AccountFill> result;
-
-  for (const auto &af : account_fills_) {
-    if (af.buy_account_id == account_id || af.sell_account_id == account_id) {
-      result.push_back(af);
-    }
-  }
-
-  return result;
+FillView<AccountFill> OrderBook::get_fills_for_account(int account_id) const {
+  auto it = account_fill_index_.find(account_id);
+  return it != account_fill_index_.end()
+             ? FillView<AccountFill>(&account_fills_, &it->second)
+             : FillView<AccountFill>();
 }
 
 // Get order's account
@@ -287,6 +414,36 @@ std::optional<int> OrderBook::get_order_account(int order_id) const {
   return std::nullopt;
 }
 
+void OrderBook::enable_depth_tracking() {
+  if (!depth_tracking_) {
+    depth_tracking_ = true;
+    rebuild_depth();
+  }
+}
+
+void OrderBook::disable_depth_tracking() {
+  depth_tracking_ = false;
+  bid_depth_.clear();
+  ask_depth_.clear();
+}
+
+std::vector<DepthLevel> OrderBook::get_depth(Side side,
+                                             size_t max_levels) const {
+  std::vector<DepthLevel> levels;
+  if (side == Side::BUY) {
+    for (auto it = bid_depth_.begin();
+         it != bid_depth_.end() && levels.size() < max_levels; ++it) {
+      levels.push_back({it->first, it->second});
+    }
+  } else {
+    for (auto it = ask_depth_.begin();
+         it != ask_depth_.end() && levels.size() < max_levels; ++it) {
+      levels.push_back({it->first, it->second});
+    }
+  }
+  return levels;
+}
+
 std::optional<Order> OrderBook::get_best_bid() const {
   if (bids_.empty()) {
     return std::nullopt;
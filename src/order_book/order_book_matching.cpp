@@ -1,6 +1,7 @@
 #include "order_book.hpp"
 
 #include <algorithm>
+#include <iomanip>
 #include <iostream>
 
 void OrderBook::finalize_after_matching(Order &o) {
@@ -152,6 +153,11 @@ bool OrderBook::execute_trade(Order &aggressive_order, Order &passive_order) {
   // Keep the old account_fills_ vector for backward compatibility
   account_fills_.emplace_back(fills_.back(), buy_account, sell_account,
                               current_symbol_);
+  const uint32_t fill_offset = static_cast<uint32_t>(account_fills_.size() - 1);
+  account_fill_index_[buy_account].push_back(fill_offset);
+  if (sell_account != buy_account) {
+    account_fill_index_[sell_account].push_back(fill_offset);
+  }
 
   // ========================================================================
   //  LOG FILL EVENT
@@ -166,6 +172,11 @@ bool OrderBook::execute_trade(Order &aggressive_order, Order &passive_order) {
   //  UPDATE ORDER QUANTITIES
   // ========================================================================
 
+  // The passive level loses the traded quantity
+  if (depth_tracking_) {
+    apply_depth_change(passive_order.side, passive_order.price, -trade_qty);
+  }
+
   // Update remaining quantities for both orders
   aggressive_order.remaining_qty -= trade_qty;
   passive_order.remaining_qty -= trade_qty;
@@ -175,6 +186,14 @@ bool OrderBook::execute_trade(Order &aggressive_order, Order &passive_order) {
     passive_order.display_qty -= trade_qty;
   }
 
+  // Pre-trade risk: positions and the resting order's open slot
+  if (risk_gate_) {
+    risk_gate_->on_fill(buy_account, sell_account, trade_qty);
+    if (passive_order.remaining_qty == 0) {
+      risk_gate_->on_order_closed(passive_order.account_id);
+    }
+  }
+
   // ========================================================================
   //  TRIGGER STOP ORDERS
   // ========================================================================
@@ -186,7 +205,7 @@ bool OrderBook::execute_trade(Order &aggressive_order, Order &passive_order) {
   //  VERBOSE LOGGING (OPTIONAL - FOR DEBUGGING)
   // ========================================================================
 
-#ifdef DEBUG
+#ifdef HFT_DEBUG
   std::cout << "✓ FILL: Order " << buy_id << " (Acct " << buy_account << ") "
             << "bought " << trade_qty << " @ $" << std::fixed
             << std::setprecision(2) << trade_price << " from Order " << sell_id
@@ -244,6 +263,9 @@ void OrderBook::handle_unfilled_order(
     } else if (order.side == Side::SELL && ask_book) {
       ask_book->push(order);
     }
+    if (depth_tracking_) {
+      apply_depth_change(order.side, order.price, visible_quantity(order));
+    }
     return;
   }
 
@@ -350,6 +372,10 @@ void OrderBook::match_buy_order(Order &buy_order) {
       stored_order.display_qty = best_ask.display_qty;
       stored_order.hidden_qty = best_ask.hidden_qty;
       stored_order.timestamp = best_ask.timestamp;
+      if (depth_tracking_) {
+        apply_depth_change(best_ask.side, best_ask.price,
+                           visible_quantity(best_ask));
+      }
 
       // Push refreshed order back to book
       asks_.push(best_ask);
@@ -417,6 +443,10 @@ void OrderBook::match_sell_order(Order &sell_order) {
       stored_order.display_qty = best_bid.display_qty;
       stored_order.hidden_qty = best_bid.hidden_qty;
       stored_order.timestamp = best_bid.timestamp;
+      if (depth_tracking_) {
+        apply_depth_change(best_bid.side, best_bid.price,
+                           visible_quantity(best_bid));
+      }
 
       // Push refreshed order back to book
       bids_.push(best_bid);
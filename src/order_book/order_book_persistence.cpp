@@ -100,6 +100,11 @@ void OrderBook::restore_from_snapshot(const Snapshot &snapshot) {
     }
   }
 
+  // Publish the restored depth as level changes so subscribers converge
+  if (depth_tracking_) {
+    rebuild_depth(/*notify=*/true);
+  }
+
   std::cout << "Order book restored successfully" << std::endl;
   std::cout << "   Active orders: " << active_orders_.size() << std::endl;
   std::cout << "   Pending stops: " << (stop_buys_.size() + stop_sells_.size())
@@ -85,6 +85,7 @@ void OrderBook::trigger_stop_order_immediately(Order &stop_order,
   } else {
     match_sell_order(stop_order);
   }
+  release_risk_if_done(stop_order.id, stop_order.account_id);
 }
 
 void OrderBook::check_stop_triggers(double trade_price) {
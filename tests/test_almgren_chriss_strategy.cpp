@@ -1,3 +1,4 @@
+#include "almgren_chriss_frontier.hpp"
 #include "almgren_chriss_strategy.hpp"
 #include "execution_algorithm.hpp"
 #include "execution_simulator.hpp"
@@ -483,6 +484,149 @@ void test_front_loading() {
     std::cout << "PASSED\n";
 }
 
+/**
+ * @brief Tests that the batch frontier matches per-strategy solves
+ */
+void test_efficient_frontier() {
+    std::cout << "Testing efficient frontier solver... ";
+
+    FrontierConfig config;
+    config.target_quantity = 100000;
+    config.adv = 1000000.0;
+    config.permanent_impact = 0.1;
+    config.num_slices = 20;
+    config.store_trajectories = true;
+
+    auto lambdas = AlmgrenChrissFrontier::log_space(1e-4, 1e2, 13);
+    auto grid = AlmgrenChrissFrontier::make_grid(
+        lambdas, {0.01, 0.02, 0.04}, {0.005, 0.01}, {10.0, 60.0});
+    assert(grid.size() == 13 * 3 * 2 * 2);
+
+    AlmgrenChrissFrontier frontier(config);
+    FrontierTable table = frontier.solve(grid);
+    assert(table.size() == grid.size());
+
+    double max_cost_err = 0.0;
+    double max_traj_err = 0.0;
+    for (size_t i = 0; i < grid.size(); ++i) {
+        const auto& p = grid[i];
+        AlmgrenChrissStrategy ac(config.target_quantity,
+                                 static_cast<int>(p.horizon_minutes),
+                                 config.num_slices, true);
+        ac.set_risk_aversion(p.risk_aversion);
+        ac.set_volatility(p.volatility);
+        ac.set_market_impact(config.permanent_impact, p.temporary_impact, config.adv);
+        ac.compute_trajectory();
+
+        double expected = ac.estimate_expected_cost();
+        max_cost_err = std::max(max_cost_err,
+                                std::abs(table.expected_cost_bps[i] - expected));
+
+        const auto& trajectory = ac.get_trajectory();
+        const float* stored = table.trajectory(i);
+        for (size_t k = 0; k < trajectory.size(); ++k) {
+            max_traj_err = std::max(max_traj_err, std::abs(stored[k] - trajectory[k]));
+        }
+    }
+    assert(max_cost_err < 1e-6);
+    assert(max_traj_err < 1e-5);
+
+    // Along a lambda sweep, risk falls as expected cost rises
+    for (size_t i = 1; i < lambdas.size(); ++i) {
+        assert(table.cost_stdev_bps[i] <= table.cost_stdev_bps[i - 1] + 1e-9);
+        assert(table.expected_cost_bps[i] >= table.expected_cost_bps[i - 1] - 1e-6);
+    }
+
+    // Non-positive eta is clamped like lambda and sigma, not divided by
+    std::vector<FrontierParams> degenerate = {{1e-2, 0.02, 0.0, 60.0},
+                                             {1e-2, 0.02, -0.01, 60.0}};
+    FrontierTable clamped = frontier.solve(degenerate);
+    for (size_t i = 0; i < degenerate.size(); ++i) {
+        AlmgrenChrissStrategy ac(config.target_quantity, 60, config.num_slices, true);
+        ac.set_risk_aversion(degenerate[i].risk_aversion);
+        ac.set_volatility(degenerate[i].volatility);
+        ac.set_market_impact(config.permanent_impact, degenerate[i].temporary_impact,
+                             config.adv);
+        ac.compute_trajectory();
+        assert(clamped.temporary_impact[i] > 0.0);
+        assert(std::isfinite(clamped.expected_cost_bps[i]));
+        assert(std::abs(clamped.expected_cost_bps[i] - ac.estimate_expected_cost()) < 1e-6);
+    }
+
+    std::cout << "max cost error: " << std::scientific << std::setprecision(1)
+              << max_cost_err << std::fixed << "... ";
+    std::cout << "PASSED\n";
+
+    table.print(lambdas.size());
+}
+
+/**
+ * @brief Times the frontier solver on a large parameter grid
+ */
+void test_efficient_frontier_performance() {
+    std::cout << "Testing efficient frontier throughput... ";
+
+    FrontierConfig config;
+    config.num_slices = 20;
+
+    auto grid = AlmgrenChrissFrontier::make_grid(
+        AlmgrenChrissFrontier::log_space(1e-6, 1e2, 100),
+        AlmgrenChrissFrontier::log_space(0.005, 0.05, 20),
+        {0.0025, 0.005, 0.01, 0.02, 0.04},
+        {5.0, 15.0, 30.0, 60.0, 120.0, 390.0});
+
+    // Single-threaded batch solve
+    config.num_threads = 1;
+    auto start = std::chrono::high_resolution_clock::now();
+    FrontierTable single = AlmgrenChrissFrontier(config).solve(grid);
+    auto single_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start).count();
+
+    // Multi-threaded batch solve
+    config.num_threads = 0;
+    start = std::chrono::high_resolution_clock::now();
+    FrontierTable multi = AlmgrenChrissFrontier(config).solve(grid);
+    auto multi_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start).count();
+
+    // Scalar baseline: one strategy per point on a sample of the grid
+    size_t sample = 2000;
+    double checksum = 0.0;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < sample; ++i) {
+        const auto& p = grid[i * (grid.size() / sample)];
+        AlmgrenChrissStrategy ac(config.target_quantity,
+                                 static_cast<int>(p.horizon_minutes),
+                                 config.num_slices, true);
+        ac.set_risk_aversion(p.risk_aversion);
+        ac.set_volatility(p.volatility);
+        ac.set_market_impact(config.permanent_impact, p.temporary_impact, config.adv);
+        ac.compute_trajectory();
+        checksum += ac.estimate_expected_cost();
+    }
+    auto scalar_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start).count();
+
+    assert(single.size() == grid.size());
+    assert(multi.size() == grid.size());
+    for (size_t i = 0; i < grid.size(); ++i) {
+        assert(single.expected_cost_bps[i] == multi.expected_cost_bps[i]);
+        assert(single.cost_stdev_bps[i] == multi.cost_stdev_bps[i]);
+    }
+    (void)checksum;
+
+    double n = static_cast<double>(grid.size());
+    std::cout << "\n  " << grid.size() << " points, " << config.num_slices << " slices\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Batch (1 thread):   " << single_us / 1000.0 << " ms ("
+              << single_us * 1000.0 / n << " ns/point)\n";
+    std::cout << "  Batch (threaded):   " << multi_us / 1000.0 << " ms ("
+              << multi_us * 1000.0 / n << " ns/point)\n";
+    std::cout << "  Per-strategy solve: "
+              << scalar_us * 1000.0 / static_cast<double>(sample) << " ns/point\n";
+    std::cout << "PASSED\n";
+}
+
 /**
  * @brief Main test runner
  */
@@ -514,6 +658,12 @@ int main() {
         // Comparison tests
         test_risk_aversion_comparison();
 
+        std::cout << "\n";
+
+        // Efficient frontier tests
+        test_efficient_frontier();
+        test_efficient_frontier_performance();
+
         std::cout << "\n=== All Tests Completed Successfully ===\n";
         return 0;
 
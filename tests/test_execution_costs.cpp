@@ -17,7 +17,9 @@
 #include "execution_simulator.hpp"
 #include "market_impact_calibration.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
@@ -463,6 +465,90 @@ void test_cost_model_validation() {
     }
 }
 
+/**
+ * @brief Tests streaming results, opt-in recording and collectors
+ */
+void test_streaming_result() {
+    std::cout << "Testing streaming simulation results... ";
+
+    SimulationConfig config;
+    config.volatility = 0.3;
+    config.tick_size = 0.0001;
+
+    // Default: aggregates only, no per-event storage
+    ExecutionSimulator sim(config);
+    TWAPStrategy twap(100000, std::chrono::milliseconds(60000), 20, true);
+    auto result = sim.run_simulation(twap, std::chrono::milliseconds(60000));
+
+    assert(result.price_path.empty() && result.price_path.capacity() == 0);
+    assert(result.fills.empty() && result.fills.capacity() == 0);
+    assert(result.stats.num_ticks > 0);
+    assert(result.stats.num_fills == result.report.num_fills);
+    assert(result.stats.filled_quantity == result.report.total_quantity);
+    assert(std::abs(result.stats.vwap() - result.report.avg_execution_price) < 1e-9);
+    assert(result.stats.slippage.total == result.stats.filled_quantity);
+    assert(result.stats.mean_slippage_bps() > 0.0);  // Market orders cross the spread
+
+    // Opt-in recording and a collector see the same events
+    config.record_price_path = true;
+    config.record_fills = true;
+    sim.set_config(config);
+    PathRecorder recorder;
+    auto recorded = sim.run_simulation(twap, std::chrono::milliseconds(60000), &recorder);
+
+    assert(recorded.price_path.size() == recorded.stats.num_ticks);
+    assert(recorded.fills.size() == recorded.stats.num_fills);
+    assert(recorder.price_path().size() == recorded.price_path.size());
+    assert(recorder.fills().size() == recorded.fills.size());
+    assert(recorded.stats.num_ticks == result.stats.num_ticks);
+    assert(recorded.report.implementation_shortfall_bps ==
+           result.report.implementation_shortfall_bps);
+
+    // Aggregates match an offline pass over the recorded history
+    double notional = 0.0;
+    uint64_t quantity = 0;
+    for (const auto& fill : recorded.fills) {
+        notional += fill.price * fill.quantity;
+        quantity += fill.quantity;
+    }
+    assert(quantity == recorded.stats.filled_quantity);
+    assert(std::abs(notional / quantity - recorded.stats.vwap()) < 1e-9);
+
+    double max_price = 0.0;
+    for (const auto& md : recorded.price_path) {
+        max_price = std::max(max_price, md.price);
+    }
+    assert(max_price == recorded.stats.max_price);
+
+    // Replay does not copy the input unless asked to
+    config.record_price_path = false;
+    config.record_fills = false;
+    sim.set_config(config);
+    auto replay = sim.run_simulation(twap, recorded.price_path);
+    assert(replay.price_path.capacity() == 0);
+    assert(replay.stats.num_ticks > 0);
+
+    (void)notional;
+    (void)quantity;
+    (void)max_price;
+
+    std::cout << "PASSED\n";
+
+    // Long high-frequency run: result size is independent of run length
+    config.ticks_per_second = 1000;
+    sim.set_config(config);
+    TWAPStrategy slow(1000000, std::chrono::milliseconds(600000), 100, true);
+    auto start = std::chrono::steady_clock::now();
+    auto long_run = sim.run_simulation(slow, std::chrono::milliseconds(600000));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    assert(long_run.price_path.capacity() == 0);
+    std::cout << "  " << long_run.stats.num_ticks << " ticks streamed in "
+              << elapsed.count() << " ms (result holds no per-tick storage)\n";
+    long_run.stats.print();
+}
+
 /**
  * @brief Performance benchmark for execution simulation
  */
@@ -486,9 +572,9 @@ void test_performance_benchmark() {
     std::cout << "Benchmark Results:\n";
     std::cout << "  Target quantity: 1,000,000 shares\n";
     std::cout << "  Simulation duration: " << duration.count() << " ms\n";
-    std::cout << "  Price points processed: " << result.price_path.size() << "\n";
-    std::cout << "  Fills generated: " << result.fills.size() << "\n";
-    std::cout << "  Throughput: " << (result.price_path.size() * 1000.0 / duration.count())
+    std::cout << "  Price points processed: " << result.stats.num_ticks << "\n";
+    std::cout << "  Fills generated: " << result.stats.num_fills << "\n";
+    std::cout << "  Throughput: " << (result.stats.num_ticks * 1000.0 / duration.count())
               << " events/sec\n";
 
     assert(duration.count() < 10000);  // Should complete within 10 seconds
@@ -558,6 +644,7 @@ int main() {
         test_execution_with_impact_simulation();
         test_aggressive_twap();
         test_cost_model_validation();
+        test_streaming_result();
 
         // Performance
         test_performance_benchmark();
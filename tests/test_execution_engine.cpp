@@ -0,0 +1,435 @@
+#include "almgren_chriss_strategy.hpp"
+#include "execution_engine.hpp"
+#include "execution_simulator.hpp"
+#include "order_sink.hpp"
+#include "timer_wheel.hpp"
+#include "twap_strategy.hpp"
+#include "vwap_strategy.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Tests TimerWheel scheduling and expiry
+ */
+void test_timer_wheel() {
+    std::cout << "Testing TimerWheel... ";
+
+    TimerWheel wheel(1000);  // 1us ticks
+    wheel.schedule(1, 500);
+    wheel.schedule(2, 2500);
+    wheel.schedule(3, 200000);       // Level 1
+    wheel.schedule(4, 90000000);     // Level 4
+    assert(wheel.size() == 4);
+
+    std::vector<TimerWheel::TimerId> fired;
+    auto collect = [&](TimerWheel::TimerId id) { fired.push_back(id); };
+
+    wheel.advance(1000, collect);
+    assert(fired.size() == 1 && fired[0] == 1);
+
+    // Same tick, deadline not yet reached
+    wheel.advance(2400, collect);
+    assert(fired.size() == 1);
+    wheel.advance(2500, collect);
+    assert(fired.size() == 2 && fired[1] == 2);
+
+    wheel.advance(199999, collect);
+    assert(fired.size() == 2);
+    wheel.advance(200000, collect);
+    assert(fired.size() == 3 && fired[2] == 3);
+
+    // Long jump (e.g. replay gap) cascades without visiting every tick
+    wheel.advance(1000000000, collect);
+    assert(fired.size() == 4 && fired[3] == 4);
+    assert(wheel.empty());
+
+    // Past deadlines fire on the next advance
+    wheel.schedule(5, 100);
+    wheel.advance(1000000000, collect);
+    assert(fired.size() == 5 && fired[4] == 5);
+
+    std::cout << "PASSED\n";
+}
+
+/**
+ * @brief Tests that timers fire exactly when due across all levels
+ */
+void test_timer_wheel_ordering() {
+    std::cout << "Testing TimerWheel ordering... ";
+
+    TimerWheel wheel(1);
+    std::mt19937_64 rng(7);
+    std::vector<uint64_t> deadlines(5000);
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        // Spread over many orders of magnitude to exercise every level
+        deadlines[i] = rng() >> (16 + rng() % 40);
+        wheel.schedule(static_cast<TimerWheel::TimerId>(i), deadlines[i]);
+    }
+
+    std::vector<uint64_t> sorted = deadlines;
+    std::sort(sorted.begin(), sorted.end());
+
+    size_t fired = 0;
+    bool all_due = true;
+    uint64_t now = 0;
+    for (size_t k = 0; k < sorted.size(); k += 97) {
+        now = sorted[k];
+        wheel.advance(now, [&](TimerWheel::TimerId id) {
+            if (deadlines[id] > now) all_due = false;
+            fired++;
+        });
+        // Everything with deadline <= now must have fired
+        size_t expected = static_cast<size_t>(
+            std::upper_bound(sorted.begin(), sorted.end(), now) - sorted.begin());
+        assert(fired == expected);
+        (void)expected;
+    }
+    wheel.advance(~uint64_t(0), [&](TimerWheel::TimerId) { fired++; });
+    assert(all_due);
+    assert(fired == deadlines.size());
+    assert(wheel.empty());
+
+    std::cout << "PASSED\n";
+}
+
+/**
+ * @brief Tests that wheel-driven slice timing matches polling
+ */
+void test_slice_timer_matches_polling() {
+    std::cout << "Testing slice timer vs polling... ";
+
+    SimulationConfig config;
+    config.random_seed = 11;
+    auto market_data = generate_synthetic_market_data(2000, config);
+
+    auto run = [&](ExecutionAlgorithm& algo, bool use_timer) {
+        SimulationConfig c = config;
+        c.use_slice_timer = use_timer;
+        ExecutionSimulator sim(c);
+        return sim.run_simulation(algo, market_data);
+    };
+
+    TWAPStrategy twap(10000, std::chrono::milliseconds(5000), 10, true);
+    auto polled = run(twap, false);
+    auto timed = run(twap, true);
+    assert(polled.report.num_child_orders == timed.report.num_child_orders);
+    assert(polled.report.total_quantity == timed.report.total_quantity);
+    assert(twap.get_slice_timer() == nullptr);
+
+    VWAPStrategy vwap(10000, 1, 10, VWAPStrategy::VolumeProfile::U_SHAPED, true);
+    polled = run(vwap, false);
+    timed = run(vwap, true);
+    assert(polled.report.num_child_orders == timed.report.num_child_orders);
+
+    AlmgrenChrissStrategy ac(10000, 1, 10, true);
+    polled = run(ac, false);
+    timed = run(ac, true);
+    assert(polled.report.num_child_orders == timed.report.num_child_orders);
+    assert(polled.report.total_quantity == timed.report.total_quantity);
+
+    // Shared wheel: many strategies, only due ones are woken
+    TimerWheel shared;
+    std::vector<std::unique_ptr<TWAPStrategy>> strategies;
+    for (int i = 0; i < 1000; ++i) {
+        strategies.push_back(std::make_unique<TWAPStrategy>(1000, 10, true));
+        strategies.back()->attach_slice_timer(&shared);
+    }
+    auto data = MarketData::from_price(100.0);
+    TimePoint t0 = data.timestamp;
+    size_t orders = 0;
+    for (auto& s : strategies) orders += s->on_market_data(data).size();
+    assert(orders == 1000);
+    assert(shared.size() == 1000);
+
+    data.timestamp = t0 + 30s;
+    size_t woken = shared.advance_to(data.timestamp);
+    assert(woken == 0);
+
+    data.timestamp = t0 + 60s;
+    woken = shared.advance_to(data.timestamp);
+    assert(woken == 1000);
+    orders = 0;
+    for (auto& s : strategies) orders += s->on_market_data(data).size();
+    assert(orders == 1000);
+
+    // Destroying an armed strategy cancels its timer
+    strategies.resize(500);
+    assert(shared.size() == 500);
+    data.timestamp = t0 + 120s;
+    woken = shared.advance_to(data.timestamp);
+    assert(woken == 500);
+    (void)orders;
+    (void)woken;
+
+    std::cout << "PASSED\n";
+}
+
+/**
+ * @brief Tests that only parents with a due slice are dispatched
+ */
+void test_engine_dispatch() {
+    std::cout << "Testing ExecutionEngine dispatch... ";
+
+    ExecutionEngine engine;
+    const SymbolId aapl = 0;
+    const SymbolId msft = 1;
+
+    for (int i = 0; i < 100; ++i) {
+        engine.add_parent(std::make_unique<TWAPStrategy>(10000, 10, true), aapl);
+        engine.add_parent(std::make_unique<TWAPStrategy>(10000, 10, true), msft);
+    }
+    assert(engine.num_parents() == 200);
+    assert(engine.num_parents_for_symbol(aapl) == 100);
+    assert(engine.num_active() == 200);
+
+    FixedOrderBuffer<256> orders;
+    auto data = MarketData::from_price(100.0);
+    data.symbol_id = aapl;
+    TimePoint t0 = data.timestamp;
+
+    // First slice of every AAPL parent is due immediately
+    size_t dispatched = engine.on_market_data(data, orders);
+    assert(dispatched == 100);
+    assert(orders.size() == 100);
+
+    // One second later nothing is due
+    orders.clear();
+    data.timestamp = t0 + 1s;
+    dispatched = engine.on_market_data(data, orders);
+    assert(dispatched == 0);
+    assert(orders.empty());
+
+    // Next slice after the one-minute interval
+    data.timestamp = t0 + 60s;
+    dispatched = engine.on_market_data(data, orders);
+    assert(dispatched == 100);
+    assert(orders.size() == 100);
+
+    // Other symbols are untouched by AAPL updates
+    orders.clear();
+    data.symbol_id = msft;
+    dispatched = engine.on_market_data(data, orders);
+    assert(dispatched == 100);
+
+    // Unknown symbol is ignored
+    data.symbol_id = 7;
+    dispatched = engine.on_market_data(data, orders);
+    assert(dispatched == 0);
+
+    (void)dispatched;
+    std::cout << "PASSED\n";
+}
+
+/**
+ * @brief Tests routing fills back to parents by child order id
+ */
+void test_engine_fill_routing() {
+    std::cout << "Testing ExecutionEngine fill routing... ";
+
+    ExecutionEngine engine;
+    auto buy_id = engine.add_parent(std::make_unique<TWAPStrategy>(1000, 1, true), 0);
+    auto sell_id = engine.add_parent(std::make_unique<TWAPStrategy>(1000, 1, false), 0);
+
+    FixedOrderBuffer<4> orders;
+    auto data = MarketData::from_price(100.0);
+    data.symbol_id = 0;
+    engine.on_market_data(data, orders);
+    assert(orders.size() == 2);
+
+    for (const auto& order : orders) {
+        assert(ExecutionEngine::parent_of_order(order.id) ==
+               (order.side == Side::BUY ? buy_id : sell_id));
+        Fill fill(order.id, order.id, 100.0, order.quantity);
+        bool routed = engine.on_fill(fill);
+        assert(routed);
+        (void)routed;
+    }
+
+    assert(engine.get_parent(buy_id)->is_complete());
+    assert(engine.get_parent(sell_id)->is_complete());
+    assert(engine.num_active() == 0);
+    (void)buy_id;
+    (void)sell_id;
+
+    // Ids outside any parent range are rejected
+    Fill stray(5, 5, 100.0, 10);
+    bool routed = engine.on_fill(stray);
+    assert(!routed);
+    (void)routed;
+
+    // A parent cannot spill child ids into the next parent's range
+    ExecutionAlgorithm* buyer = engine.get_parent(buy_id);
+    int last_id = 0;
+    bool exhausted = false;
+    try {
+        for (int i = 0; i <= ExecutionEngine::ORDER_ID_STRIDE; ++i) {
+            last_id = buyer->get_next_order_id();
+        }
+    } catch (const std::length_error&) {
+        exhausted = true;
+    }
+    assert(exhausted);
+    assert(ExecutionEngine::parent_of_order(last_id) == buy_id);
+    (void)exhausted;
+    (void)last_id;
+
+    std::cout << "PASSED\n";
+}
+
+/**
+ * @brief Tests that a parent out of child order ids fails alone
+ */
+void test_engine_order_id_exhaustion() {
+    std::cout << "Testing ExecutionEngine order id exhaustion... ";
+
+    ExecutionEngine engine;
+    auto spent = engine.add_parent(std::make_unique<TWAPStrategy>(1000, 10, true), 0);
+    auto healthy = engine.add_parent(std::make_unique<TWAPStrategy>(1000, 10, true), 0);
+    for (int i = 0; i < ExecutionEngine::ORDER_ID_STRIDE; ++i) {
+        engine.get_parent(spent)->get_next_order_id();
+    }
+
+    FixedOrderBuffer<4> orders;
+    auto data = MarketData::from_price(100.0);
+    data.symbol_id = 0;
+    size_t dispatched = engine.on_market_data(data, orders);
+    assert(dispatched == 2);
+    assert(orders.size() == 1);
+    assert(ExecutionEngine::parent_of_order(orders[0].id) == healthy);
+    assert(engine.is_failed(spent));
+    assert(!engine.is_failed(healthy));
+    assert(engine.num_failed() == 1);
+    assert(engine.num_active() == 1);
+    (void)dispatched;
+    (void)healthy;
+
+    std::cout << "PASSED\n";
+}
+
+/**
+ * @brief Tests symbol-sharded execution across worker threads
+ */
+void test_sharded_engine() {
+    std::cout << "Testing ShardedExecutionEngine... ";
+
+    const size_t num_shards = 4;
+    const SymbolId num_symbols = 8;
+    const int parents_per_symbol = 50;
+
+    ShardedExecutionEngine engine(num_shards);
+    for (SymbolId s = 0; s < num_symbols; ++s) {
+        for (int i = 0; i < parents_per_symbol; ++i) {
+            engine.add_parent(std::make_unique<TWAPStrategy>(10000, 10, true), s);
+        }
+    }
+
+    // One counting sink per shard, each touched only by its worker
+    std::vector<size_t> counts(num_shards, 0);
+    std::vector<std::unique_ptr<OrderSink>> sinks;
+    for (size_t i = 0; i < num_shards; ++i) {
+        size_t* counter = &counts[i];
+        sinks.push_back(std::make_unique<CallbackOrderSink<std::function<void(const Order&)>>>(
+            [counter](const Order&) { (*counter)++; }));
+        engine.set_shard_sink(i, sinks.back().get());
+    }
+
+    engine.start();
+
+    auto data = MarketData::from_price(100.0);
+    TimePoint t0 = data.timestamp;
+    for (int tick = 0; tick < 3; ++tick) {
+        data.timestamp = t0 + std::chrono::seconds(tick * 60);
+        for (SymbolId s = 0; s < num_symbols; ++s) {
+            data.symbol_id = s;
+            while (!engine.publish(data)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    engine.stop();
+
+    size_t total = 0;
+    for (size_t c : counts) total += c;
+    assert(total == 3 * num_symbols * parents_per_symbol);
+    assert(counts[0] == 3 * 2 * parents_per_symbol);  // Symbols 0 and 4
+    assert(engine.get_events_processed(1) == 3 * 2);
+    (void)total;
+
+    std::cout << "PASSED\n";
+}
+
+/**
+ * @brief Tests that per-tick cost tracks due slices, not total parents
+ */
+void test_engine_scaling() {
+    std::cout << "Testing ExecutionEngine scaling... ";
+
+    ExecutionEngine engine;
+    const int num_parents = 10000;
+    for (int i = 0; i < num_parents; ++i) {
+        engine.add_parent(std::make_unique<TWAPStrategy>(100000, 60, true), 0);
+    }
+
+    size_t emitted = 0;
+    auto orders = make_order_sink([&](const Order&) { emitted++; });
+    auto data = MarketData::from_price(100.0);
+    data.symbol_id = 0;
+    TimePoint t0 = data.timestamp;
+    engine.on_market_data(data, orders);
+    assert(emitted == static_cast<size_t>(num_parents));
+
+    // Ticks between slices dispatch nothing
+    const int idle_ticks = 10000;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 1; i <= idle_ticks; ++i) {
+        data.timestamp = t0 + std::chrono::milliseconds(i);
+        engine.on_market_data(data, orders);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double ns_per_tick = std::chrono::duration<double, std::nano>(end - start).count() / idle_ticks;
+    assert(engine.get_dispatch_count() == static_cast<uint64_t>(num_parents));
+
+    std::cout << "PASSED\n";
+    std::cout << "  " << num_parents << " parents, idle tick cost: "
+              << ns_per_tick << " ns\n";
+}
+
+/**
+ * @brief Main test runner
+ */
+int main() {
+    std::cout << "\n=== Execution Engine Test Suite ===\n\n";
+
+    try {
+        test_timer_wheel();
+        test_timer_wheel_ordering();
+        test_slice_timer_matches_polling();
+        test_engine_dispatch();
+        test_engine_fill_routing();
+        test_engine_order_id_exhaustion();
+        test_sharded_engine();
+
+        std::cout << "\n";
+
+        test_engine_scaling();
+
+        std::cout << "\n=== All Tests Completed Successfully ===\n";
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest FAILED with exception: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -1,9 +1,15 @@
 #include "microstructure_order_book.hpp"
+#include "conflating_subscriber.hpp"
+#include "market_data_publisher.hpp"
+#include "order_flow_workload.hpp"
 #include <cassert>
 #include <chrono>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <random>
+#include <sstream>
+#include <unordered_set>
 
 /**
  * @brief Test fixture for MicrostructureOrderBook tests
@@ -44,7 +50,7 @@ void test_spread_tracking() {
     fixture.book.add_order(fixture.create_sell_order(100.10, 100));
 
     // Check spread is calculated
-    auto spread = fixture.book.get_current_spread();
+    [[maybe_unused]] auto spread = fixture.book.get_current_spread();
     assert(spread.has_value());
     assert(std::abs(*spread - 0.10) < 0.0001);
 
@@ -101,7 +107,7 @@ void test_volume_tracking() {
     assert(fixture.book.get_total_sell_volume() == 400);
     assert(fixture.book.get_order_count() == 3);
 
-    double ratio = fixture.book.get_volume_ratio();
+    [[maybe_unused]] double ratio = fixture.book.get_volume_ratio();
     assert(std::abs(ratio - 2.0) < 0.0001);  // 800/400 = 2.0
 
     std::cout << "PASSED\n";
@@ -287,6 +293,626 @@ void test_fill_tracking() {
     }
 }
 
+/**
+ * @brief Tests indexed fill queries (by id, account and symbol)
+ */
+void test_fill_index() {
+    std::cout << "Testing fill index... ";
+
+    OrderBookTestFixture fixture;
+    const int third_account = 3;
+
+    // Account 1 buys from accounts 2 and 3 alternately
+    for (int i = 0; i < 20; ++i) {
+        fixture.book.add_order(fixture.create_buy_order(100.00, 100));
+        int seller = (i % 2 == 0) ? fixture.sell_account_id : third_account;
+        fixture.book.add_order(Order(fixture.next_order_id++, seller, Side::SELL, 100.00, 100));
+    }
+
+    const FillRouter& router = fixture.book.get_fill_router();
+    const auto& all = router.get_all_fills();
+    assert(all.size() == 20);
+
+    // Views select without copying and preserve fill order
+    EnhancedFillView buyer = router.get_fills_for_account(fixture.buy_account_id);
+    [[maybe_unused]] EnhancedFillView seller = router.get_fills_for_account(fixture.sell_account_id);
+    EnhancedFillView third = router.get_fills_for_account(third_account);
+    assert(buyer.size() == 20);
+    assert(seller.size() == 10);
+    assert(third.size() == 10);
+    assert(&buyer[0] == &all[0]);
+    [[maybe_unused]] uint64_t last_id = 0;
+    for (const auto& fill : third) {
+        assert(fill.sell_account_id == third_account);
+        assert(fill.fill_id > last_id);
+        last_id = fill.fill_id;
+    }
+    assert(router.get_fills_for_account(99).empty());
+
+    assert(router.get_fills_for_symbol("TEST").size() == 20);
+    assert(router.get_fills_for_symbol("OTHER").empty());
+    assert(router.get_fills_for_symbol("TEST").to_vector().size() == 20);
+
+    // Dense id lookup
+    for ([[maybe_unused]] const auto& fill : all) {
+        assert(router.get_fill_by_id(fill.fill_id) == &fill);
+    }
+    assert(router.get_fill_by_id(0) == nullptr);
+    assert(router.get_fill_by_id(all.back().fill_id + 1) == nullptr);
+
+    // The base book's account index agrees with the router
+    auto account_fills = fixture.book.get_fills_for_account(third_account);
+    assert(account_fills.size() == 10);
+    for ([[maybe_unused]] const auto& af : account_fills) {
+        assert(af.sell_account_id == third_account);
+    }
+
+    // Posting lists span chunks without relocating earlier entries
+    FillPostingList postings;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        postings.push_back(i);
+    }
+    [[maybe_unused]] const uint32_t* first = &postings[0];
+    postings.push_back(1000);
+    assert(&postings[0] == first);
+    assert(postings.size() == 1001 && postings[640] == 640);
+
+    std::cout << "PASSED (" << buyer.size() << " fills indexed)\n";
+}
+
+/**
+ * @brief Tests the incremental position and P&L ledger fed by the router
+ */
+void test_position_ledger() {
+    std::cout << "Testing position ledger... ";
+
+    // Average cost, realized P&L and flips on a single position
+    Position p;
+    p.apply(100, 10.0);
+    p.apply(100, 12.0);
+    assert(p.net_quantity == 200 && std::abs(p.average_cost - 11.0) < 1e-9);
+    p.apply(-50, 13.0);
+    assert(std::abs(p.realized_pnl - 100.0) < 1e-9);
+    assert(std::abs(p.average_cost - 11.0) < 1e-9);
+    p.apply(-200, 10.0);  // Close 150 at a loss, open 50 short
+    assert(p.net_quantity == -50);
+    assert(std::abs(p.realized_pnl - (100.0 - 150.0)) < 1e-9);
+    assert(std::abs(p.average_cost - 10.0) < 1e-9);
+    p.mark(9.0);
+    assert(std::abs(p.unrealized_pnl - 50.0) < 1e-9);
+    p.apply(50, 9.5);
+    assert(p.net_quantity == 0 && p.average_cost == 0.0);
+    assert(p.bought_quantity == 250 && p.sold_quantity == 250);
+
+    // Routed fills update both counterparties with maker/taker fees
+    OrderBookTestFixture fixture;
+    fixture.book.set_fee_schedule(-0.0002, 0.0003);
+    fixture.book.add_order(fixture.create_sell_order(100.00, 100));
+    fixture.book.add_order(fixture.create_buy_order(100.00, 100)); // Buyer takes
+    fixture.book.add_order(fixture.create_buy_order(101.00, 40));
+    fixture.book.add_order(fixture.create_sell_order(101.00, 40)); // Seller takes
+
+    const FillRouter& router = fixture.book.get_fill_router();
+    [[maybe_unused]] Position buyer = router.get_position(fixture.buy_account_id, "TEST");
+    [[maybe_unused]] Position seller = router.get_position(fixture.sell_account_id, "TEST");
+    assert(buyer.net_quantity == 140 && seller.net_quantity == -140);
+    assert(buyer.fill_count == 2 && seller.fill_count == 2);
+    assert(std::abs(buyer.average_cost - (100.0 * 100 + 101.0 * 40) / 140) < 1e-9);
+    assert(std::abs(buyer.taker_fees - 100.0 * 100 * 0.0003) < 1e-9);
+    assert(std::abs(buyer.maker_fees - 101.0 * 40 * -0.0002) < 1e-9);
+    assert(std::abs(seller.taker_fees - 101.0 * 40 * 0.0003) < 1e-9);
+
+    // Unrealized P&L marks to the last trade; both sides net to zero
+    assert(router.get_ledger().last_price("TEST") == 101.00);
+    assert(std::abs(buyer.unrealized_pnl - 100.0) < 1e-9);
+    assert(std::abs(buyer.unrealized_pnl + seller.unrealized_pnl) < 1e-9);
+    assert(router.get_fills_for_account(fixture.buy_account_id).back().fill_id ==
+           buyer.last_fill_id);
+
+    // Stable handle sees later fills; unknown pairs read as flat
+    PositionHandle handle = router.get_ledger().handle(fixture.sell_account_id, "TEST");
+    assert(handle.valid());
+    fixture.book.add_order(Order(fixture.next_order_id++, 3, Side::SELL, 99.00, 140));
+    fixture.book.add_order(Order(fixture.next_order_id++, fixture.sell_account_id,
+                                 Side::BUY, 99.00, 140)); // Covers the short
+    [[maybe_unused]] Position closed = handle.read();
+    assert(closed.net_quantity == 0);
+    assert(std::abs(closed.realized_pnl - (100.0 * 1 + 40.0 * 2)) < 1e-9);
+    assert(fixture.book.get_position(fixture.buy_account_id).net_quantity == 140);
+    assert(fixture.book.get_position(3).net_quantity == -140);
+    assert(router.get_position(99, "TEST").fill_count == 0);
+    assert(!router.get_ledger().handle(fixture.buy_account_id, "OTHER").valid());
+
+    [[maybe_unused]] Position totals = router.get_ledger().get_account_totals(fixture.sell_account_id);
+    assert(totals.fill_count == 3 && totals.bought_quantity == 140);
+    assert(std::abs(totals.net_pnl() - (closed.realized_pnl - closed.total_fees())) < 1e-9);
+    assert(router.get_ledger().total_records() == 6);
+
+    std::cout << "PASSED (" << router.get_ledger().account_count() << " accounts)\n";
+}
+
+/**
+ * @brief Tests the pre-trade risk gate in front of add_order
+ */
+void test_pre_trade_risk() {
+    std::cout << "Testing pre-trade risk gate... ";
+
+    OrderBookTestFixture fixture;
+    RiskLimits limits;
+    limits.max_order_quantity = 500;
+    limits.max_order_notional = 40000.0;
+    limits.price_collar = 0.05;
+    limits.max_open_orders = 3;
+    limits.max_position = 300;
+    fixture.book.enable_risk_checks(limits, 16);
+    const PreTradeRiskGate& gate = *fixture.book.get_risk_gate();
+
+    // Size, notional and unknown-account checks
+    assert(!fixture.book.add_order(fixture.create_buy_order(100.00, 600)));
+    assert(gate.rejects(RiskReject::MAX_QUANTITY) == 1);
+    assert(!fixture.book.add_order(fixture.create_buy_order(100.00, 450)));
+    assert(gate.rejects(RiskReject::MAX_NOTIONAL) == 1);
+    assert(!fixture.book.add_order(Order(fixture.next_order_id++, 99, Side::BUY, 100.00, 10)));
+    assert(gate.rejects(RiskReject::UNKNOWN_ACCOUNT) == 1);
+
+    // No trade or BBO yet: a market order cannot be priced against the notional limit
+    assert(!fixture.book.add_order(Order(fixture.next_order_id++, fixture.buy_account_id,
+                                         Side::BUY, OrderType::MARKET, 10)));
+    assert(gate.rejects(RiskReject::NO_REFERENCE_PRICE) == 1);
+    assert(!fixture.book.get_best_bid().has_value());
+
+    // Open-order limit; cancels and fills free slots
+    assert(fixture.book.add_order(fixture.create_buy_order(100.00, 100)));
+    int cancel_id = fixture.next_order_id;
+    assert(fixture.book.add_order(fixture.create_buy_order(99.90, 100)));
+    [[maybe_unused]] int amend_id = fixture.next_order_id;
+    assert(fixture.book.add_order(fixture.create_buy_order(99.80, 100)));
+    assert(gate.open_orders(fixture.buy_account_id) == 3);
+    assert(!fixture.book.add_order(fixture.create_buy_order(99.70, 100)));
+    assert(fixture.book.last_risk_reject() == RiskReject::MAX_OPEN_ORDERS);
+    fixture.book.cancel_order(cancel_id);
+    assert(gate.open_orders(fixture.buy_account_id) == 2);
+
+    // A fill closes both sides and moves positions
+    assert(fixture.book.add_order(fixture.create_sell_order(100.00, 100)));
+    assert(gate.open_orders(fixture.buy_account_id) == 1);
+    assert(gate.open_orders(fixture.sell_account_id) == 0);
+    assert(gate.position(fixture.buy_account_id) == 100);
+    assert(gate.position(fixture.sell_account_id) == -100);
+
+    // Price collar around the last trade (100.00 +/- 5%)
+    assert(!fixture.book.add_order(fixture.create_sell_order(94.00, 10)));
+    assert(gate.rejects(RiskReject::PRICE_COLLAR) == 1);
+    assert(fixture.book.add_order(fixture.create_sell_order(104.00, 10)));
+
+    // Position limit: adding is capped, reducing is always allowed
+    assert(!fixture.book.add_order(fixture.create_buy_order(99.00, 250)));
+    assert(gate.rejects(RiskReject::POSITION_LIMIT) == 1);
+    RiskLimits tight = limits;
+    tight.max_position = 50;
+    fixture.book.get_risk_gate()->set_limits(fixture.buy_account_id, tight);
+    assert(fixture.book.add_order(
+        Order(fixture.next_order_id++, fixture.buy_account_id, Side::SELL, 101.00, 10)));
+
+    // Token bucket: burst of 2, then throttled until time passes
+    RiskLimits throttled;
+    throttled.max_orders_per_second = 10.0;
+    throttled.burst = 2.0;
+    fixture.book.get_risk_gate()->set_limits(5, throttled);
+    Order first(fixture.next_order_id++, 5, Side::BUY, 98.00, 1);
+    Order second(fixture.next_order_id++, 5, Side::BUY, 98.00, 1);
+    Order third(fixture.next_order_id++, 5, Side::BUY, 98.00, 1);
+    second.timestamp = first.timestamp;
+    third.timestamp = first.timestamp;
+    assert(fixture.book.add_order(first));
+    assert(fixture.book.add_order(second));
+    assert(!fixture.book.add_order(third));
+    assert(gate.rejects(RiskReject::RATE_LIMIT) == 1);
+    third.timestamp = first.timestamp + std::chrono::milliseconds(100);
+    assert(fixture.book.add_order(third));
+
+    // A rejected amend leaves the original resting; an accepted one reuses its slot
+    fixture.book.get_risk_gate()->set_limits(fixture.buy_account_id, limits);
+    [[maybe_unused]] uint32_t open_before_amend = gate.open_orders(fixture.buy_account_id);
+    assert(!fixture.book.amend_order(amend_id, std::nullopt, 600));
+    assert(fixture.book.last_risk_reject() == RiskReject::MAX_QUANTITY);
+    assert(fixture.book.get_order(amend_id)->state == OrderState::ACTIVE);
+    assert(fixture.book.get_order(amend_id)->remaining_qty == 100);
+    assert(fixture.book.amend_order(amend_id, 99.85, 100));
+    assert(fixture.book.get_order(amend_id)->price == 99.85);
+    assert(gate.open_orders(fixture.buy_account_id) == open_before_amend);
+
+    assert(gate.total_rejects() == 9);
+    assert(gate.accepted() + gate.total_rejects() == gate.checks());
+    assert(gate.account_rejects(fixture.buy_account_id) == 6);
+
+    // Rejected orders never reached the book
+    assert(fixture.book.get_fills().size() == 1);
+
+    std::cout << "PASSED (" << gate.checks() << " checked, "
+              << gate.total_rejects() << " rejected)\n";
+}
+
+/**
+ * @brief Tests the order-flow workload generator and its CSV roundtrip
+ */
+void test_order_flow_workload() {
+    std::cout << "Testing order-flow workload... ";
+
+    WorkloadConfig config;
+    config.seed = 7;
+    OrderFlowWorkload a(config);
+    OrderFlowWorkload b(config);
+    auto ops = a.generate(20000);
+    auto same = b.generate(20000);
+
+    // Same seed, same stream
+    assert(ops.size() == same.size());
+    for (size_t i = 0; i < ops.size(); ++i) {
+        assert(ops[i].type == same[i].type);
+        assert(ops[i].order_id == same[i].order_id);
+        assert(ops[i].price == same[i].price);
+        assert(ops[i].quantity == same[i].quantity);
+    }
+
+    // Roughly nine in ten messages are cancels or replaces
+    [[maybe_unused]] WorkloadMix mix = OrderFlowWorkload::mix(ops);
+    assert(mix.total() == ops.size());
+    assert(std::abs(mix.share(WorkloadOpType::CANCEL) +
+                    mix.share(WorkloadOpType::AMEND) - 0.90) < 0.04);
+    assert(std::abs(mix.share(WorkloadOpType::ADD) - 0.08) < 0.03);
+    assert(mix.share(WorkloadOpType::CANCEL) > 0.05);
+    assert(mix.share(WorkloadOpType::MARKET) > 0.0);
+    assert(mix.share(WorkloadOpType::STOP) > 0.0);
+
+    // Every cancel/amend targets an order added earlier
+    std::unordered_set<int> added;
+    for (const auto& op : ops) {
+        if (op.type == WorkloadOpType::CANCEL || op.type == WorkloadOpType::AMEND) {
+            assert(added.count(op.order_id) == 1);
+        } else {
+            added.insert(op.order_id);
+        }
+    }
+
+    // Roundtrip through the OrderEvent CSV format
+    std::system("mkdir -p tests/data");
+    const std::string file = "tests/data/order_flow_workload.csv";
+    OrderFlowWorkload::save(file, ops);
+    auto loaded = OrderFlowWorkload::load(file);
+    assert(loaded.size() == ops.size());
+    for (size_t i = 0; i < ops.size(); ++i) {
+        assert(loaded[i].type == ops[i].type);
+        assert(loaded[i].order_id == ops[i].order_id);
+        assert(loaded[i].side == ops[i].side || ops[i].type == WorkloadOpType::CANCEL ||
+               ops[i].type == WorkloadOpType::AMEND);
+        assert(std::abs(loaded[i].price - ops[i].price) < 1e-6);
+        assert(loaded[i].quantity == ops[i].quantity);
+    }
+
+    // Replaying into a book keeps resting depth on both sides
+    MicrostructureOrderBook book("TEST");
+    book.enable_self_trade_prevention(false);
+    std::ostringstream sink;
+    auto* old_buf = std::cout.rdbuf(sink.rdbuf());
+    for (const auto& op : loaded) {
+        OrderFlowWorkload::apply(book, op);
+    }
+    std::cout.rdbuf(old_buf);
+    assert(book.get_best_bid().has_value());
+    assert(book.get_best_ask().has_value());
+    (void)added;
+
+    std::cout << "PASSED (" << ops.size() << " msgs, " << a.live_orders() << " live)\n";
+}
+
+/**
+ * @brief Tests incremental depth against a rebuild, and L2 publish/subscribe
+ */
+void test_incremental_depth() {
+    std::cout << "Testing incremental depth and L2 publishing... ";
+
+    MicrostructureOrderBook book("TEST");
+    book.enable_self_trade_prevention(false);
+    MarketDataPublisher publisher("TEST", 1 << 16, 512);
+    publisher.attach(book);
+    MarketDataSubscriber subscriber(publisher);
+    MarketDataSubscriber late_joiner(publisher);
+
+    // Small ring: a reader that polls rarely gets lapped and resyncs
+    MicrostructureOrderBook lapped_book("TEST");
+    lapped_book.enable_self_trade_prevention(false);
+    MarketDataPublisher lapped_publisher("TEST", 64, 16);
+    lapped_publisher.attach(lapped_book);
+    MarketDataSubscriber slow(lapped_publisher);
+
+    WorkloadConfig config;
+    config.seed = 11;
+    OrderFlowWorkload workload(config);
+    auto ops = workload.generate(20000);
+
+    std::ostringstream sink;
+    auto* old_buf = std::cout.rdbuf(sink.rdbuf());
+    for (size_t i = 0; i < ops.size(); ++i) {
+        OrderFlowWorkload::apply(book, ops[i]);
+        OrderFlowWorkload::apply(lapped_book, ops[i]);
+        if (i % 7 == 0) {
+            subscriber.poll();
+        }
+        if (i % 5000 == 0) {
+            slow.poll();
+        }
+    }
+    std::cout.rdbuf(old_buf);
+
+    // Incremental levels match a rebuild from the resting orders
+    auto bids = book.get_depth(Side::BUY, SIZE_MAX);
+    auto asks = book.get_depth(Side::SELL, SIZE_MAX);
+    assert(!bids.empty() && !asks.empty());
+    book.disable_depth_tracking();
+    book.enable_depth_tracking();
+    auto rebuilt_bids = book.get_depth(Side::BUY, SIZE_MAX);
+    auto rebuilt_asks = book.get_depth(Side::SELL, SIZE_MAX);
+    assert(bids.size() == rebuilt_bids.size() && asks.size() == rebuilt_asks.size());
+    for (size_t i = 0; i < bids.size(); ++i) {
+        assert(bids[i].price == rebuilt_bids[i].price);
+        assert(bids[i].quantity == rebuilt_bids[i].quantity);
+    }
+    for (size_t i = 0; i < asks.size(); ++i) {
+        assert(asks[i].price == rebuilt_asks[i].price);
+        assert(asks[i].quantity == rebuilt_asks[i].quantity);
+    }
+    assert(publisher.sequence() == book.depth_sequence());
+
+    // Subscribers (continuous, late, lapped) converge on the book's depth
+    auto same_depth = [](const std::vector<OrderBookLevel>& wire,
+                         const std::vector<DepthLevel>& levels) {
+        if (wire.size() != levels.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < wire.size(); ++i) {
+            if (wire[i].price != static_cast<float>(levels[i].price) ||
+                wire[i].quantity != static_cast<uint64_t>(levels[i].quantity)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    subscriber.poll();
+    late_joiner.poll();
+    slow.poll();
+    for (const MarketDataSubscriber* reader : {&subscriber, &late_joiner}) {
+        assert(reader->sequence() == publisher.sequence());
+        assert(same_depth(reader->bids(), bids));
+        assert(same_depth(reader->asks(), asks));
+        (void)reader;
+    }
+    assert(subscriber.snapshots_applied() == 1 && subscriber.laps() == 0);
+    assert(late_joiner.snapshots_applied() == 1 &&
+           late_joiner.updates_applied() < subscriber.updates_applied());
+    assert(slow.laps() > 0 && slow.sequence() == lapped_publisher.sequence());
+    assert(same_depth(slow.bids(), lapped_book.get_depth(Side::BUY, SIZE_MAX)));
+    assert(same_depth(slow.asks(), lapped_book.get_depth(Side::SELL, SIZE_MAX)));
+
+    // Restoring a snapshot publishes the level differences
+    MicrostructureOrderBook small("TEST");
+    small.add_order(Order(900001, 1, Side::BUY, 99.50, 300));
+    small.add_order(Order(900002, 2, Side::SELL, 100.50, 200));
+    old_buf = std::cout.rdbuf(sink.rdbuf());
+    book.get_underlying_book().restore_from_snapshot(
+        small.get_underlying_book().create_snapshot());
+    std::cout.rdbuf(old_buf);
+    subscriber.poll();
+    assert(subscriber.snapshots_applied() == 1);
+    assert(subscriber.sequence() == book.depth_sequence());
+    assert(same_depth(subscriber.bids(), book.get_depth(Side::BUY, SIZE_MAX)));
+    assert(same_depth(subscriber.asks(), book.get_depth(Side::SELL, SIZE_MAX)));
+    assert(subscriber.bids().size() == 1 && subscriber.asks().size() == 1);
+    (void)same_depth;
+
+    std::cout << "PASSED (" << publisher.sequence() << " updates, "
+              << publisher.snapshots_published() << " snapshots, " << bids.size()
+              << "/" << asks.size() << " levels)\n";
+}
+
+/**
+ * @brief Tests snapshots built by a reader-side snapshotter instead of the book thread
+ */
+void test_snapshotter() {
+    std::cout << "Testing off-book-thread snapshots... ";
+
+    MicrostructureOrderBook book("TEST");
+    book.enable_self_trade_prevention(false);
+    MarketDataPublisher publisher("TEST", 64, 16);
+    publisher.attach(book);
+    MarketDataSnapshotter snapshotter(publisher);
+    MarketDataSubscriber slow(publisher);
+    assert(publisher.snapshots_published() == 1); // attach()
+
+    WorkloadConfig config;
+    config.seed = 23;
+    OrderFlowWorkload workload(config);
+    auto ops = workload.generate(20000);
+
+    std::ostringstream sink;
+    auto* old_buf = std::cout.rdbuf(sink.rdbuf());
+    size_t installed = 0;
+    for (size_t i = 0; i < ops.size(); ++i) {
+        OrderFlowWorkload::apply(book, ops[i]);
+        if (i % 3 == 0) {
+            installed += snapshotter.poll();
+        }
+        if (i % 5000 == 0) {
+            slow.poll();
+        }
+    }
+    installed += snapshotter.poll();
+
+    // Every snapshot came from the snapshotter; lapped readers still resync
+    assert(installed > 0 && snapshotter.laps() == 0);
+    assert(publisher.snapshots_published() == 1 + installed);
+    assert(snapshotter.sequence() == publisher.sequence());
+    slow.poll();
+    assert(slow.laps() > 0 && slow.sequence() == publisher.sequence());
+    auto same_depth = [](const std::vector<OrderBookLevel>& wire,
+                         const std::vector<DepthLevel>& levels) {
+        if (wire.size() != levels.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < wire.size(); ++i) {
+            if (wire[i].price != static_cast<float>(levels[i].price) ||
+                wire[i].quantity != static_cast<uint64_t>(levels[i].quantity)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    assert(same_depth(slow.bids(), book.get_depth(Side::BUY, SIZE_MAX)));
+    assert(same_depth(slow.asks(), book.get_depth(Side::SELL, SIZE_MAX)));
+
+    // A lapped snapshotter asks the book thread for one snapshot and recovers
+    const uint64_t before = publisher.snapshots_published();
+    for (size_t i = 0; i < 2000; ++i) {
+        OrderFlowWorkload::apply(book, ops[i]);
+    }
+    installed = snapshotter.poll();
+    assert(installed == 0 && snapshotter.laps() == 1);
+    assert(publisher.snapshots_published() == before);
+    for (size_t i = 2000; i < 2010; ++i) {
+        OrderFlowWorkload::apply(book, ops[i]);
+    }
+    installed = snapshotter.poll();
+    std::cout.rdbuf(old_buf);
+    assert(snapshotter.sequence() == publisher.sequence());
+    assert(publisher.snapshots_published() == before + 1 + installed);
+    (void)same_depth;
+
+    std::cout << "PASSED (" << publisher.snapshots_published() << " snapshots, "
+              << snapshotter.laps() << " lap)\n";
+}
+
+/**
+ * @brief Tests last-value conflation for a consumer slower than the book
+ */
+void test_conflating_subscriber() {
+    std::cout << "Testing conflating subscriber... ";
+
+    MicrostructureOrderBook book("TEST");
+    book.enable_self_trade_prevention(false);
+    MarketDataPublisher publisher("TEST", 1 << 16, 512);
+    publisher.attach(book);
+
+    // Small ring and cache: laps and overflows still converge
+    MicrostructureOrderBook tight_book("TIGH");
+    tight_book.enable_self_trade_prevention(false);
+    MarketDataPublisher tight_publisher("TIGH", 256, 64);
+    tight_publisher.attach(tight_book);
+
+    ConflatingSubscriber conflator;
+    ConflatingSubscriber bounded(8);
+    [[maybe_unused]] uint32_t main_source = conflator.add_source(publisher);
+    [[maybe_unused]] uint32_t tight_source = conflator.add_source(tight_publisher);
+    bounded.add_source(publisher);
+    assert(conflator.symbol(tight_source) == "TIGH");
+
+    // Consumer-side books rebuilt only from delivered updates
+    using BidLevels = std::map<float, uint64_t, std::greater<float>>;
+    using AskLevels = std::map<float, uint64_t>;
+    struct ConsumerBook { BidLevels bids; AskLevels asks; uint64_t clears = 0; };
+    std::vector<ConsumerBook> consumer(2);
+    ConsumerBook bounded_consumer;
+    auto apply_to = [](ConsumerBook& view, const ConflatedUpdate& u) {
+        if (u.type == ConflatedUpdate::Type::CLEAR) {
+            view.bids.clear();
+            view.asks.clear();
+            view.clears++;
+            return;
+        }
+        if (u.side == 0) {
+            if (u.quantity > 0) view.bids[u.price] = u.quantity; else view.bids.erase(u.price);
+        } else {
+            if (u.quantity > 0) view.asks[u.price] = u.quantity; else view.asks.erase(u.price);
+        }
+    };
+
+    WorkloadConfig config;
+    config.seed = 23;
+    OrderFlowWorkload workload(config);
+    auto ops = workload.generate(20000);
+
+    size_t max_pending = 0;
+    std::ostringstream sink;
+    auto* old_buf = std::cout.rdbuf(sink.rdbuf());
+    for (size_t i = 0; i < ops.size(); ++i) {
+        OrderFlowWorkload::apply(book, ops[i]);
+        OrderFlowWorkload::apply(tight_book, ops[i]);
+        if (i % 10 == 0) {
+            bounded.poll();
+        }
+        if (i % 1000 == 0) {
+            conflator.poll();  // The tight ring laps between polls
+        }
+        max_pending = std::max(max_pending, bounded.stats().pending_levels);
+        if (i % 2000 == 0) {  // Slow consumer, partial batches
+            conflator.deliver([&](const ConflatedUpdate& u) { apply_to(consumer[u.source], u); },
+                              200);
+            bounded.deliver([&](const ConflatedUpdate& u) { apply_to(bounded_consumer, u); });
+        }
+    }
+    std::cout.rdbuf(old_buf);
+
+    conflator.poll();
+    bounded.poll();
+    while (conflator.deliver(
+               [&](const ConflatedUpdate& u) { apply_to(consumer[u.source], u); }) > 0) {
+    }
+    bounded.deliver([&](const ConflatedUpdate& u) { apply_to(bounded_consumer, u); });
+
+    // Every consumer ends on the book's current depth
+    auto matches = [](const ConsumerBook& view, const MicrostructureOrderBook& b) {
+        auto bids = b.get_depth(Side::BUY, SIZE_MAX);
+        auto asks = b.get_depth(Side::SELL, SIZE_MAX);
+        if (view.bids.size() != bids.size() || view.asks.size() != asks.size()) {
+            return false;
+        }
+        size_t i = 0;
+        for (const auto& level : view.bids) {
+            if (level.first != static_cast<float>(bids[i].price) ||
+                level.second != static_cast<uint64_t>(bids[i].quantity)) {
+                return false;
+            }
+            i++;
+        }
+        i = 0;
+        for (const auto& level : view.asks) {
+            if (level.first != static_cast<float>(asks[i].price) ||
+                level.second != static_cast<uint64_t>(asks[i].quantity)) {
+                return false;
+            }
+            i++;
+        }
+        return true;
+    };
+    assert(matches(consumer[main_source], book));
+    assert(matches(consumer[tight_source], tight_book));
+    assert(matches(bounded_consumer, book));
+
+    // Slow delivery merged many changes; the bounded cache refreshed instead
+    ConflationStats stats = conflator.stats();
+    assert(stats.laps > 0);
+    assert(stats.pending_levels == 0);
+    assert(stats.conflation_ratio() > 2.0);
+    ConflationStats bounded_stats = bounded.stats();
+    assert(bounded_stats.overflows > 0 && bounded_consumer.clears > 0);
+    assert(max_pending <= 8);
+    (void)matches;
+    (void)max_pending;
+
+    std::cout << "PASSED (ratio " << std::fixed << std::setprecision(1)
+              << stats.conflation_ratio() << ", " << stats.laps << " laps, "
+              << bounded_stats.overflows << " overflows)\n";
+}
+
 /**
  * @brief Main test runner
  */
@@ -299,6 +925,13 @@ int main() {
         test_imbalance_tracking();
         test_volume_tracking();
         test_fill_tracking();
+        test_fill_index();
+        test_position_ledger();
+        test_pre_trade_risk();
+        test_order_flow_workload();
+        test_incremental_depth();
+        test_snapshotter();
+        test_conflating_subscriber();
         std::cout << "\n";
         test_performance();
         std::cout << "\n";
@@ -7,13 +7,23 @@
  */
 
 #include "microstructure_platform.hpp"
+#include "mpsc_queue.hpp"
+#include "spmc_queue.hpp"
 
 #include <cassert>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <regex>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 // Test utilities
 static int tests_run = 0;
@@ -327,6 +337,13 @@ TEST(test_analytics_snapshot) {
     order_book.add_order(bid);
     order_book.add_order(ask);
 
+    // Readers only see published state
+    uint64_t version = platform.snapshot_version();
+    ASSERT_EQ(platform.get_snapshot().best_bid, 0.0);
+
+    platform.publish_snapshot();
+    ASSERT_EQ(platform.snapshot_version(), version + 1);
+
     // Get snapshot
     auto snapshot = platform.get_snapshot();
 
@@ -335,6 +352,103 @@ TEST(test_analytics_snapshot) {
     ASSERT_NEAR(snapshot.best_ask, 100.05, 0.001);
 }
 
+TEST(test_snapshot_concurrent_readers) {
+    // One writer publishes snapshots whose fields are all derived from a
+    // counter; readers must never observe a mix of two publishes
+    SeqLock<AnalyticsSnapshot> published;
+    std::atomic<bool> done{false};
+    const uint64_t num_publishes = 200000;
+
+    std::thread writer([&]() {
+        AnalyticsSnapshot s;
+        for (uint64_t i = 1; i <= num_publishes; ++i) {
+            s.events_processed = i;
+            s.best_bid = static_cast<double>(i);
+            s.best_ask = static_cast<double>(i) + 1.0;
+            s.flow.buy_volume = static_cast<int64_t>(i);
+            s.latency_p99_ns = i * 2;
+            published.write(s);
+        }
+        done = true;
+    });
+
+    std::vector<std::thread> readers;
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> reads{0};
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            uint64_t last = 0;
+            while (!done) {
+                AnalyticsSnapshot s = published.read();
+                uint64_t i = s.events_processed;
+                if (s.best_bid != static_cast<double>(i) ||
+                    s.best_ask != static_cast<double>(i) + 1.0 ||
+                    s.flow.buy_volume != static_cast<int64_t>(i) ||
+                    s.latency_p99_ns != i * 2 || i < last) {
+                    torn++;
+                }
+                last = i;
+                reads++;
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    ASSERT_EQ(torn.load(), 0u);
+    ASSERT_GT(reads.load(), 0u);
+    ASSERT_EQ(published.version(), num_publishes);
+    ASSERT_EQ(published.read().events_processed, num_publishes);
+}
+
+TEST(test_symbol_routing) {
+    PlatformConfig config;
+    config.verbose = false;
+    config.symbols = {"MSFT"};
+    config.pinned_symbols = {"AAPL"};
+    config.snapshot_publish_events = 1;
+
+    MicrostructureAnalyticsPlatform platform(config);
+    platform.initialize();
+
+    // Pre-sized from config
+    ASSERT_EQ(platform.symbol_count(), 2u);
+    ASSERT_TRUE(platform.is_pinned("AAPL"));
+    ASSERT_FALSE(platform.is_pinned("MSFT"));
+    ASSERT_TRUE(platform.find_order_book("GOOG") == nullptr);
+
+    const char* symbols[] = {"AAPL", "MSFT", "GOOG"};
+    const double base[] = {150.0, 300.0, 2800.0};
+    for (int i = 0; i < 300; ++i) {
+        int s = i % 3;
+        double price = base[s] + (i % 2 == 0 ? -0.05 : 0.05);
+        FeedTick tick(i, symbols[s], price, 100 + (i % 2));
+        platform.route_tick(AggregatedTick(tick, "test", 0));
+    }
+    platform.flush_workers();
+
+    // GOOG was created lazily on its first tick
+    ASSERT_EQ(platform.symbol_count(), 3u);
+    for (const char* symbol : symbols) {
+        ASSERT_EQ(platform.ticks_processed(symbol), 100u);
+        ASSERT_TRUE(platform.find_order_book(symbol) != nullptr);
+        ASSERT_EQ(platform.find_order_book(symbol)->get_symbol(), std::string(symbol));
+    }
+    ASSERT_EQ(platform.get_order_book().get_order_count(), 0u);
+
+    // Each book only saw its own prices
+    platform.stop();
+    auto aapl = platform.get_snapshot("AAPL");
+    auto goog = platform.get_snapshot("GOOG");
+    ASSERT_GT(aapl.best_bid, 0.0);
+    ASSERT_TRUE(aapl.best_ask < 151.0);
+    ASSERT_GT(goog.best_bid, 2799.0);
+    ASSERT_EQ(platform.get_snapshot("IBM").best_bid, 0.0);
+}
+
 // ============================================================
 // Multi-Feed Aggregator Tests
 // ============================================================
@@ -362,6 +476,703 @@ TEST(test_feed_aggregator_stats) {
     ASSERT_FALSE(stats.connected);  // Not started yet
 }
 
+TEST(test_aggregator_wait_strategies) {
+    for (WaitStrategy strategy : {WaitStrategy::BUSY_SPIN, WaitStrategy::SPIN_YIELD,
+                                  WaitStrategy::SPIN_PARK}) {
+        MultiFeedAggregator aggregator(1024);
+        aggregator.add_feed("TestFeed", "localhost", 9000);
+        aggregator.set_wait_strategy(strategy);
+        aggregator.set_processor_thread_config({"test-proc", -1});
+
+        std::atomic<uint64_t> received{0};
+        std::string thread_name;
+        aggregator.set_tick_callback([&](const AggregatedTick&) {
+            if (received.load(std::memory_order_relaxed) == 0) {
+                thread_name = get_current_thread_name();
+            }
+            received.fetch_add(1, std::memory_order_release);
+        });
+
+        ASSERT_TRUE(aggregator.start_all());
+
+        // Let the processor go idle long enough to park
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        const uint64_t num_ticks = 5000;
+        for (uint64_t i = 0; i < num_ticks; ++i) {
+            aggregator.inject_tick(FeedTick(i, "AAPL", 100.0, 100));
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (received.load(std::memory_order_acquire) < num_ticks &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        aggregator.stop();
+
+        ASSERT_EQ(received.load(), num_ticks);
+        ASSERT_EQ(thread_name, std::string("test-proc"));
+        if (strategy == WaitStrategy::SPIN_PARK) {
+            ASSERT_GT(aggregator.processor_park_count(), 0u);
+        } else {
+            ASSERT_EQ(aggregator.processor_park_count(), 0u);
+        }
+    }
+}
+
+TEST(test_thread_config) {
+    std::string name;
+    bool pinned = false;
+    std::thread t([&]() {
+        pinned = apply_thread_config({"a-very-long-thread-name", 0});
+        name = get_current_thread_name();
+    });
+    t.join();
+
+    // Linux limits names to 15 characters
+    ASSERT_EQ(name, std::string("a-very-long-thr"));
+    ASSERT_TRUE(pinned);
+    ASSERT_FALSE(pin_current_thread(-1));
+}
+
+TEST(test_mpsc_queue_multi_producer) {
+    MPSCQueue<uint64_t> queue(64);
+    ASSERT_EQ(queue.capacity(), 64u);
+    ASSERT_TRUE(queue.empty());
+
+    const uint64_t per_producer = 20000;
+    const int num_producers = 3;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&queue, p, per_producer]() {
+            for (uint64_t i = 0; i < per_producer; ++i) {
+                while (!queue.push(p * per_producer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's items must arrive in its own push order
+    std::vector<uint64_t> next(num_producers, 0);
+    uint64_t received = 0;
+    while (received < per_producer * num_producers) {
+        auto item = queue.pop();
+        if (!item) {
+            std::this_thread::yield();
+            continue;
+        }
+        uint64_t producer = *item / per_producer;
+        ASSERT_EQ(*item % per_producer, next[producer]);
+        next[producer]++;
+        received++;
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.pop().has_value());
+
+    // Full at capacity
+    for (uint64_t i = 0; i < 64; ++i) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    ASSERT_FALSE(queue.push(64));
+    ASSERT_EQ(*queue.pop(), 0u);
+    ASSERT_TRUE(queue.push(64));
+
+    // The process may run on at least one CPU
+    ASSERT_FALSE(read_cpu_topology().empty());
+}
+
+TEST(test_queue_telemetry) {
+    SPSCQueue<int, QueueTelemetry> queue(8);  // 7 usable slots
+
+    for (int i = 0; i < 7; ++i) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    ASSERT_FALSE(queue.push(7));
+    ASSERT_FALSE(queue.push(7));
+    queue.telemetry().record_stall(42, 1000);
+
+    auto t = queue.telemetry_snapshot();
+    ASSERT_EQ(t.capacity, 8u);
+    ASSERT_EQ(t.pushes, 7u);
+    ASSERT_EQ(t.high_water, 7u);
+    ASSERT_EQ(t.push_failures, 2u);
+    ASSERT_EQ(t.stalls, 1u);
+    ASSERT_EQ(t.stall_spins, 42u);
+    ASSERT_EQ(t.stall_ns, 1000u);
+
+    // Draining does not lower the high-water mark; occupancy is sampled
+    // once per SAMPLE_INTERVAL pushes while the queue holds one item
+    while (queue.pop()) {}
+    for (uint64_t i = 0; i < QueueTelemetry::SAMPLE_INTERVAL * 4; ++i) {
+        ASSERT_TRUE(queue.push(1));
+        ASSERT_TRUE(queue.pop().has_value());
+    }
+    t = queue.telemetry_snapshot();
+    ASSERT_EQ(t.high_water, 7u);
+    ASSERT_EQ(t.occupancy_samples, 4u);
+    ASSERT_EQ(t.occupancy[1], 4u);  // 1/8 full -> the 10-20% bucket
+    ASSERT_NEAR(t.mean_occupancy(), 1.0, 1e-9);
+
+    queue.telemetry().reset();
+    ASSERT_EQ(queue.telemetry_snapshot().pushes, 0u);
+
+    // Disabled telemetry keeps the default queue API unchanged
+    SPMCQueue<int> plain(4);
+    ASSERT_FALSE(std::decay_t<decltype(plain.telemetry())>::enabled);
+    ASSERT_TRUE(plain.push(1));
+
+    // A slow pinned worker shows up as stalls on its queue
+    PlatformConfig config;
+    config.verbose = false;
+    config.pinned_symbols = {"AAPL"};
+    config.worker_queue_capacity = 2;
+    MicrostructureAnalyticsPlatform platform(config);
+    platform.initialize();
+    for (int i = 0; i < 200; ++i) {
+        FeedTick tick(i, "AAPL", 150.0 + (i % 2) * 0.05, 100);
+        platform.route_tick(AggregatedTick(tick, "test", 0));
+    }
+    platform.flush_workers();
+    auto worker = platform.worker_queue_telemetry("AAPL");
+    ASSERT_EQ(worker.pushes, 200u);
+    ASSERT_EQ(worker.high_water, 1u);
+    ASSERT_EQ(platform.worker_queue_telemetry("MSFT").pushes, 0u);
+    platform.stop();
+}
+
+TEST(test_latency_checkpoints) {
+    LatencyCheckpoints checkpoints;
+    checkpoints.stamp(CP_RECEIVED, 1000);
+    checkpoints.stamp(CP_PARSED, 1200);
+    checkpoints.stamp(CP_DEQUEUED, 1700);
+    ASSERT_EQ(checkpoints.hop_ns(CP_PARSED), 200u);
+    ASSERT_EQ(checkpoints.hop_ns(CP_DEQUEUED), 500u);  // Skips unstamped enqueue
+    ASSERT_EQ(checkpoints.hop_ns(CP_ENQUEUED), 0u);
+    ASSERT_EQ(checkpoints.total_ns(), 700u);
+
+    // Decoded ticks carry the feed handler's receive time
+    auto text_tick = parse_text_tick("1000 AAPL 150.25 100");
+    ASSERT_TRUE(text_tick.has_value());
+    const uint64_t received = checkpoint_now_ns();
+    FeedTick decoded(*text_tick, received);
+    ASSERT_EQ(decoded.checkpoints.ns[CP_RECEIVED], received);
+    ASSERT_TRUE(decoded.checkpoints.ns[CP_PARSED] >= received);
+    ASSERT_TRUE(!FeedTick(*text_tick).checkpoints.has(CP_RECEIVED));
+
+    PlatformConfig config;
+    config.verbose = false;
+    config.symbols = {"AAPL"};
+    MicrostructureAnalyticsPlatform platform(config);
+    platform.initialize();
+    // Synthetic orders share one account
+    platform.find_order_book("AAPL")->enable_self_trade_prevention(false);
+
+    // Alternate crossing buys and sells so the book keeps trading
+    for (int i = 0; i < 100; ++i) {
+        FeedTick tick(i, "AAPL", i % 2 == 0 ? 100.02 : 99.98, 100 + (i % 2));
+        tick.checkpoints.stamp(CP_RECEIVED);
+        tick.checkpoints.stamp(CP_PARSED);
+        platform.route_tick(AggregatedTick(tick, "test", 0));
+    }
+
+    const ComponentLatencyTracker& tracker = platform.get_latency_tracker();
+    ASSERT_EQ(tracker.hop(CP_PARSED).events_processed(), 100u);
+    ASSERT_EQ(tracker.hop(CP_BOOK_DONE).events_processed(), 100u);
+    ASSERT_EQ(tracker.hop(CP_ANALYTICS_DONE).events_processed(), 100u);
+    ASSERT_GT(tracker.hop(CP_FILL_ROUTED).events_processed(), 0u);
+    ASSERT_EQ(tracker.hop(CP_RECEIVED).events_processed(), 0u);
+    ASSERT_EQ(tracker.end_to_end().events_processed(), 100u);
+}
+
+// Event ids of the exported complete spans, by span name
+static std::map<std::string, std::vector<uint64_t>> span_event_ids(const std::string& json) {
+    static const std::regex span_re(
+        "\"ph\":\"X\",[^}]*\"name\":\"([^\"]+)\"[^}]*\"event_id\":([0-9]+)");
+    std::map<std::string, std::vector<uint64_t>> ids;
+    for (std::sregex_iterator it(json.begin(), json.end(), span_re), end; it != end; ++it) {
+        ids[(*it)[1]].push_back(std::stoull((*it)[2]));
+    }
+    return ids;
+}
+
+TEST(test_trace_span_export) {
+    TraceRecorder& recorder = TraceRecorder::instance();
+
+    // Disabled tracing records nothing
+    size_t before = recorder.span_count();
+    { TRACE_SPAN("test.disabled", 1); }
+    ASSERT_EQ(recorder.span_count(), before);
+
+    PlatformConfig config;
+    config.verbose = false;
+    config.symbols = {"AAPL"};
+    MicrostructureAnalyticsPlatform platform(config);
+    platform.initialize();
+    platform.find_order_book("AAPL")->enable_self_trade_prevention(false);
+
+    recorder.enable();
+    MultiFeedAggregator aggregator(1024);
+    aggregator.add_feed("TestFeed", "localhost", 9000);
+    aggregator.set_processor_thread_config({"trace-proc", -1});
+    std::atomic<uint64_t> received{0};
+    aggregator.set_tick_callback([&](const AggregatedTick& tick) {
+        platform.route_tick(tick);
+        received.fetch_add(1, std::memory_order_release);
+    });
+    ASSERT_TRUE(aggregator.start_all());
+
+    // Crossing buys and sells so fills are routed; the timestamps repeat
+    // and overlap the order ids, so only the trace ids can link the chain
+    const uint64_t num_ticks = 100;
+    for (uint64_t i = 1; i <= num_ticks; ++i) {
+        aggregator.inject_tick(FeedTick(i % 10, "AAPL", i % 2 == 0 ? 100.02 : 99.98,
+                                        100 + static_cast<int64_t>(i % 2)));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received.load(std::memory_order_acquire) < num_ticks &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    aggregator.stop();
+    recorder.disable();
+
+    // Enqueue on this thread, dispatch on the processor thread
+    ASSERT_TRUE(recorder.thread_count() >= 2u);
+    ASSERT_TRUE(recorder.span_count() >= before + 2 * num_ticks);
+
+    std::string path = "/tmp/test_platform_trace.json";
+    recorder.export_chrome_json(path);
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string json = contents.str();
+
+    ASSERT_TRUE(json.find("\"traceEvents\"") != std::string::npos);
+    ASSERT_TRUE(json.find("\"aggregator.enqueue\"") != std::string::npos);
+    ASSERT_TRUE(json.find("\"aggregator.dispatch\"") != std::string::npos);
+    ASSERT_TRUE(json.find("\"trace-proc\"") != std::string::npos);
+    // Per-tick trace ids link the two threads with flow events
+    ASSERT_TRUE(json.find("\"ph\":\"s\"") != std::string::npos);
+    ASSERT_TRUE(json.find("\"ph\":\"f\"") != std::string::npos);
+    ASSERT_EQ(json.substr(json.size() - 3), std::string("]}\n"));
+
+    // One distinct id per tick, carried by every stage it passes through
+    auto ids = span_event_ids(json);
+    std::set<uint64_t> enqueued(ids["aggregator.enqueue"].begin(),
+                                ids["aggregator.enqueue"].end());
+    ASSERT_EQ(enqueued.size(), static_cast<size_t>(num_ticks));
+    ASSERT_EQ(enqueued.count(0), 0u);
+    for (const char* stage : {"aggregator.dispatch", "platform.route",
+                              "platform.book_update", "book.add_order"}) {
+        ASSERT_EQ(ids[stage].size(), static_cast<size_t>(num_ticks));
+    }
+    ASSERT_GT(ids["fill_router.route"].size(), 0u);
+    for (const char* stage : {"aggregator.dispatch", "platform.route",
+                              "platform.book_update", "book.add_order",
+                              "fill_router.route"}) {
+        for (uint64_t id : ids[stage]) {
+            ASSERT_EQ(enqueued.count(id), 1u);
+        }
+    }
+
+    recorder.clear();
+    ASSERT_EQ(recorder.span_count(), 0u);
+    std::remove(path.c_str());
+}
+
+TEST(test_trace_ring_recycling) {
+    TraceRecorder& recorder = TraceRecorder::instance();
+    const size_t max_rings = recorder.thread_count() + 2;
+    recorder.enable(1024, max_rings);
+
+    // Short-lived threads reuse the rings of exited ones past the bound
+    for (int i = 0; i < 16; ++i) {
+        std::thread([] { TRACE_SPAN("test.short_lived", 0); }).join();
+    }
+    ASSERT_TRUE(recorder.thread_count() <= max_rings);
+    ASSERT_TRUE(recorder.span_count() >= 1u);
+
+    recorder.enable();
+    recorder.disable();
+    recorder.clear();
+}
+
+static std::string http_get(int port, const std::string& path) {
+    auto conn = socket_connect("127.0.0.1", port);
+    if (!conn) {
+        throw std::runtime_error(conn.error());
+    }
+    int fd = conn.value();
+    std::string request = "GET " + path + " HTTP/1.0\r\n\r\n";
+    send(fd, request.data(), request.size(), 0);
+    std::string response;
+    char buf[4096];
+    ssize_t n;
+    while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+        response.append(buf, static_cast<size_t>(n));
+    }
+    close(fd);
+    return response;
+}
+
+TEST(test_prometheus_metrics_endpoint) {
+    PrometheusWriter writer;
+    writer.counter("t_total", "Test", 3, {{"feed", "a\"b"}});
+    writer.counter("t_total", "Test", 4, {{"feed", "c"}});
+    writer.summary("t_ns", "Latency", {{0.5, 10}, {0.99, 250.5}}, 1000, 7);
+    std::string text = writer.str();
+    ASSERT_EQ(writer.family_count(), 2u);
+    ASSERT_TRUE(text.find("# TYPE t_total counter\n"
+                          "t_total{feed=\"a\\\"b\"} 3\n"
+                          "t_total{feed=\"c\"} 4\n") != std::string::npos);
+    ASSERT_TRUE(text.find("t_ns{quantile=\"0.99\"} 250.5\n") != std::string::npos);
+    ASSERT_TRUE(text.find("t_ns_count 7\n") != std::string::npos);
+
+    PlatformConfig config;
+    config.verbose = false;
+    config.pinned_symbols = {"AAPL"};
+    config.feed_sources.emplace_back("TestFeed", "localhost", 9000);
+    MicrostructureAnalyticsPlatform platform(config);
+    platform.initialize();
+    ASSERT_TRUE(platform.start_metrics_server(0));
+    ASSERT_GT(platform.metrics_port(), 0);
+
+    for (int i = 0; i < 50; ++i) {
+        FeedTick tick(i, i % 2 ? "AAPL" : "MSFT", 150.0 + (i % 2) * 0.05, 100);
+        tick.checkpoints.stamp(CP_PARSED);
+        platform.route_tick(AggregatedTick(tick, "TestFeed", 0));
+    }
+    platform.flush_workers();
+
+    std::string response = http_get(platform.metrics_port(), "/metrics");
+    ASSERT_TRUE(response.rfind("HTTP/1.0 200 OK", 0) == 0);
+    ASSERT_TRUE(response.find("text/plain; version=0.0.4") != std::string::npos);
+    ASSERT_TRUE(response.find("hft_feed_messages_received_total{feed=\"TestFeed\"} 0")
+                != std::string::npos);
+    ASSERT_TRUE(response.find("hft_aggregator_queue_depth 0") != std::string::npos);
+    ASSERT_TRUE(response.find("hft_latency_ns{component=\"tick_processing\",quantile=\"0.99\"}")
+                != std::string::npos);
+    ASSERT_TRUE(response.find("hft_events_dropped_total{component=\"tick_processing\"}")
+                != std::string::npos);
+    ASSERT_TRUE(response.find("hft_symbol_ticks_total{symbol=\"AAPL\"} 25") != std::string::npos);
+    ASSERT_TRUE(response.find("hft_worker_queue_depth{symbol=\"AAPL\"} 0") != std::string::npos);
+    ASSERT_TRUE(response.find("hft_hop_latency_ns{hop=\"book_done\"") != std::string::npos);
+
+    std::string missing = http_get(platform.metrics_port(), "/");
+    ASSERT_TRUE(missing.rfind("HTTP/1.0 404", 0) == 0);
+
+    platform.stop();
+    ASSERT_EQ(platform.metrics_port(), 0);
+}
+
+TEST(test_pre_trade_risk_gate) {
+    PlatformConfig config;
+    config.verbose = false;
+    config.enable_risk_checks = true;
+    config.risk_limits.max_order_quantity = 150;
+    MicrostructureAnalyticsPlatform platform(config);
+    platform.initialize();
+
+    // Odd volumes sell, even volumes buy; the 200-lot orders breach the limit
+    for (int i = 0; i < 40; ++i) {
+        int64_t volume = (i % 4 == 0) ? 200 : 100 + (i % 2);
+        FeedTick tick(i, "MSFT", 300.0 + (i % 2) * 0.10, volume);
+        platform.route_tick(AggregatedTick(tick, "TestFeed", 0));
+    }
+
+    PrometheusWriter writer;
+    platform.write_prometheus(writer);
+    std::string text = writer.str();
+    ASSERT_TRUE(text.find("hft_risk_checks_total{symbol=\"MSFT\"} 40") != std::string::npos);
+    ASSERT_TRUE(text.find("hft_risk_rejects_total{symbol=\"MSFT\",reason=\"max_quantity\"} 10")
+                != std::string::npos);
+    ASSERT_TRUE(text.find("hft_risk_rejects_total{symbol=\"MSFT\",reason=\"rate_limit\"} 0")
+                != std::string::npos);
+    ASSERT_TRUE(text.find("hft_risk_checks_total{symbol=\"DEFAULT\"} 0") != std::string::npos);
+
+    // Disabled by default: no risk families at all
+    PlatformConfig plain;
+    plain.verbose = false;
+    MicrostructureAnalyticsPlatform unchecked(plain);
+    unchecked.initialize();
+    PrometheusWriter plain_writer;
+    unchecked.write_prometheus(plain_writer);
+    ASSERT_TRUE(plain_writer.str().find("hft_risk_") == std::string::npos);
+}
+
+TEST(test_market_data_publisher) {
+    PlatformConfig config;
+    config.verbose = false;
+    config.enable_market_data = true;
+    config.market_data_snapshot_interval = 8;
+    MicrostructureAnalyticsPlatform platform(config);
+    platform.initialize();
+
+    for (int i = 0; i < 60; ++i) {
+        FeedTick tick(i, "AAPL", 150.0 + (i % 5) * 0.01, 100 + i);
+        platform.route_tick(AggregatedTick(tick, "TestFeed", 0));
+    }
+
+    // A subscriber joining now rebuilds the book's depth from snapshot + updates
+    const MarketDataPublisher* publisher = platform.market_data_publisher("AAPL");
+    ASSERT_TRUE(publisher != nullptr);
+    ASSERT_TRUE(publisher->sequence() > 0);
+    MarketDataSubscriber subscriber(*publisher);
+    subscriber.poll();
+    ASSERT_TRUE(subscriber.synced());
+    ASSERT_EQ(subscriber.sequence(), publisher->sequence());
+    ASSERT_TRUE(platform.market_data_publisher("MSFT") == nullptr);
+    ASSERT_EQ(publisher->snapshots_published(), 1u); // attach() only: no snapshot thread
+
+    PrometheusWriter writer;
+    platform.write_prometheus(writer);
+    std::string text = writer.str();
+    ASSERT_TRUE(text.find("hft_md_updates_total{symbol=\"AAPL\"} " +
+                          std::to_string(publisher->sequence())) != std::string::npos);
+    ASSERT_TRUE(text.find("hft_md_snapshots_total{symbol=\"AAPL\"}") != std::string::npos);
+
+    // Disabled by default
+    PlatformConfig plain;
+    plain.verbose = false;
+    MicrostructureAnalyticsPlatform quiet(plain);
+    quiet.initialize();
+    FeedTick tick(1, "AAPL", 150.0, 100);
+    quiet.route_tick(AggregatedTick(tick, "TestFeed", 0));
+    ASSERT_TRUE(quiet.market_data_publisher("AAPL") == nullptr);
+}
+
+TEST(test_market_data_snapshot_thread) {
+    PlatformConfig config;
+    config.verbose = false;
+    config.enable_analytics_updates = false;
+    config.enable_market_data = true;
+    config.market_data_snapshot_interval = 8;
+    config.feed_sources.emplace_back("FeedA", "localhost", 9000);
+    MicrostructureAnalyticsPlatform platform(config);
+    ASSERT_TRUE(platform.start_real_time_mode());
+    for (uint64_t i = 1; i <= 200; ++i) {
+        platform.get_feed_aggregator().inject_tick(
+            FeedTick(i, "AAPL", 150.0 + (i % 5) * 0.01, 100 + i));
+    }
+
+    // The snapshot thread, not the book thread, keeps snapshots current
+    const MarketDataPublisher* publisher = nullptr;
+    uint64_t snapshot_sequence = 0;
+    for (int spin = 0; spin < 2000; ++spin) {
+        publisher = platform.market_data_publisher("AAPL");
+        if (publisher && publisher->sequence() >= 8) {
+            snapshot_sequence = publisher->latest_snapshot().sequence;
+            if (snapshot_sequence + 8 > publisher->sequence()) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(publisher != nullptr);
+    ASSERT_GT(publisher->snapshots_published(), 1u);
+    ASSERT_GT(snapshot_sequence, 0u);
+    ASSERT_EQ(snapshot_sequence % 8, 0u);
+    platform.stop();
+}
+
+TEST(test_symbol_creation_off_feed_thread) {
+    PlatformConfig config;
+    config.verbose = false;
+    config.enable_market_data = true;
+    MicrostructureAnalyticsPlatform platform(config);
+    platform.initialize();
+
+    // Another thread creates books while the feed thread routes new symbols
+    std::thread subscriber_thread([&] {
+        for (int i = 0; i < 50; ++i) {
+            platform.add_conflating_subscriber("sub", {"S" + std::to_string(i)});
+        }
+    });
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < 50; ++i) {
+            std::string symbol = (i % 2 ? "S" : "R") + std::to_string(i);
+            FeedTick tick(i, symbol.c_str(), 100.0, 100);
+            platform.route_tick(AggregatedTick(tick, "TestFeed", 0));
+        }
+    }
+    subscriber_thread.join();
+
+    ASSERT_EQ(platform.symbol_count(), 75u);
+    ASSERT_EQ(platform.ticks_processed("S1"), 4u);
+    ASSERT_EQ(platform.ticks_processed("R0"), 4u);
+    ASSERT_EQ(platform.ticks_processed("S0"), 0u);
+}
+
+TEST(test_conflating_subscriber_metrics) {
+    PlatformConfig config;
+    config.verbose = false;
+    config.enable_market_data = true;
+    MicrostructureAnalyticsPlatform platform(config);
+    platform.initialize();
+    ConflatingSubscriber* ui = platform.add_conflating_subscriber("ui", {"AAPL", "MSFT"});
+    ASSERT_TRUE(ui != nullptr);
+    ASSERT_EQ(ui->source_count(), 2u);
+
+    // The consumer polls once and delivers once for the whole session
+    for (int i = 0; i < 200; ++i) {
+        FeedTick tick(i, i % 2 ? "AAPL" : "MSFT", 150.0 + (i % 3) * 0.01, 100 + i);
+        platform.route_tick(AggregatedTick(tick, "TestFeed", 0));
+    }
+    ui->poll();
+    size_t delivered = ui->deliver([](const ConflatedUpdate&) {});
+    ConflationStats stats = ui->stats();
+    ASSERT_EQ(stats.updates_delivered, delivered);
+    ASSERT_GT(stats.updates_received, stats.updates_delivered);
+    ASSERT_EQ(stats.pending_levels, 0u);
+
+    PrometheusWriter writer;
+    platform.write_prometheus(writer);
+    std::string text = writer.str();
+    ASSERT_TRUE(text.find("hft_md_conflation_ratio{subscriber=\"ui\"}") != std::string::npos);
+    ASSERT_TRUE(text.find("hft_md_conflated_delivered_total{subscriber=\"ui\"} " +
+                          std::to_string(delivered)) != std::string::npos);
+
+    // Requires market data
+    PlatformConfig plain;
+    plain.verbose = false;
+    MicrostructureAnalyticsPlatform quiet(plain);
+    quiet.initialize();
+    ASSERT_TRUE(quiet.add_conflating_subscriber("ui", {"AAPL"}) == nullptr);
+}
+
+TEST(test_tick_capture_replay) {
+    const std::string path = "/tmp/test_platform_capture.bin";
+
+    // Record a session from a live aggregator
+    std::vector<AggregatedTick> dispatched;
+    {
+        MultiFeedAggregator aggregator(1024);
+        aggregator.add_feed("FeedA", "localhost", 9000);
+        aggregator.add_feed("FeedB", "localhost", 9001);
+        TickCaptureWriter writer(path, aggregator.feed_names());
+        writer.attach(aggregator);
+        aggregator.set_tick_callback([&](const AggregatedTick& t) { dispatched.push_back(t); });
+        ASSERT_TRUE(aggregator.start_all());
+        for (uint64_t i = 1; i <= 200; ++i) {
+            FeedTick tick(i, i % 3 ? "AAPL" : "MSFT", 150.0 + i * 0.01, 100 + i, i * 7);
+            aggregator.inject_tick(tick, i % 2);
+            if (i % 50 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+        aggregator.wait();
+        ASSERT_EQ(writer.records_written(), 200u);
+    }
+
+    // A full disk latches the writer instead of throwing into the feed path
+    {
+        MultiFeedAggregator aggregator(1024);
+        aggregator.add_feed("FeedA", "localhost", 9000);
+        TickCaptureWriter full_disk("/dev/full", aggregator.feed_names());
+        full_disk.attach(aggregator);
+        ASSERT_TRUE(aggregator.start_all());
+        for (uint64_t i = 1; i <= 3000; ++i) {
+            aggregator.inject_tick(FeedTick(i, "AAPL", 150.0, 100));
+        }
+        aggregator.wait();
+        aggregator.stop();
+        full_disk.close();
+        ASSERT_TRUE(full_disk.failed());
+        ASSERT_EQ(full_disk.write_errors(), 1u);
+        ASSERT_EQ(full_disk.records_dropped(), full_disk.records_written());
+    }
+
+    TickCaptureReader reader(path);
+    ASSERT_EQ(reader.sources().size(), 2u);
+    ASSERT_EQ(reader.sources()[1], std::string("FeedB"));
+    auto captured = reader.read_all();
+    ASSERT_EQ(captured.size(), 200u);
+    for (size_t i = 0; i < captured.size(); ++i) {
+        ASSERT_EQ(captured[i].aggregator_recv_ns, dispatched[i].aggregator_recv_ns);
+        ASSERT_EQ(captured[i].source_index, dispatched[i].source_index);
+        ASSERT_EQ(std::memcmp(&captured[i].tick.price, &dispatched[i].tick.price, 8), 0);
+    }
+
+    // Replay flat out into a fresh aggregator: identical ticks, same order
+    TickReplayer replayer(path);
+    std::vector<AggregatedTick> replayed;
+    MultiFeedAggregator target(1024);
+    replayer.add_missing_feeds(target);
+    ASSERT_EQ(target.feed_count(), 2u);
+    target.set_tick_callback([&](const AggregatedTick& t) { replayed.push_back(t); });
+    ASSERT_TRUE(target.start_all());
+    ReplayOptions flat_out;
+    flat_out.speed = 0.0;
+    auto stats = replayer.replay(target, flat_out);
+    target.wait();
+    ASSERT_EQ(stats.ticks_replayed, 200u);
+    ASSERT_EQ(replayed.size(), 200u);
+    for (size_t i = 0; i < replayed.size(); ++i) {
+        const FeedTick& a = dispatched[i].tick;
+        const FeedTick& b = replayed[i].tick;
+        ASSERT_EQ(a.timestamp, b.timestamp);
+        ASSERT_EQ(std::string(a.symbol), std::string(b.symbol));
+        ASSERT_EQ(std::memcmp(&a.price, &b.price, 8), 0);
+        ASSERT_EQ(a.volume, b.volume);
+        ASSERT_EQ(a.recv_timestamp_ns, b.recv_timestamp_ns);
+        ASSERT_EQ(replayed[i].source, dispatched[i].source);
+        ASSERT_TRUE(b.checkpoints.has(CP_RECEIVED));
+    }
+
+    // Paced replay takes at least the recorded span (scaled by speed)
+    MultiFeedAggregator paced_target(1024);
+    ReplayOptions double_speed;
+    double_speed.speed = 2.0;
+    replayer.add_missing_feeds(paced_target);
+    ASSERT_TRUE(paced_target.start_all());
+    auto paced = replayer.replay(paced_target, double_speed);
+    paced_target.wait();
+    ASSERT_EQ(paced.ticks_replayed, 200u);
+    ASSERT_TRUE(paced.capture_span_ns >= 6000000u);
+    ASSERT_TRUE(paced.replay_duration_ns >= paced.capture_span_ns / 2);
+
+    // The platform records its session and replays it into another instance
+    const std::string session = "/tmp/test_platform_session.bin";
+    {
+        PlatformConfig config;
+        config.verbose = false;
+        config.enable_analytics_updates = false;
+        config.capture_file = session;
+        config.feed_sources.emplace_back("FeedA", "localhost", 9000);
+        MicrostructureAnalyticsPlatform platform(config);
+        ASSERT_TRUE(platform.start_real_time_mode());
+        for (uint64_t i = 1; i <= 100; ++i) {
+            platform.get_feed_aggregator().inject_tick(
+                FeedTick(i, "AAPL", 150.0 + (i % 2) * 0.05, 100));
+        }
+        platform.wait();
+    }
+    PlatformConfig replay_config;
+    replay_config.verbose = false;
+    replay_config.enable_analytics_updates = false;
+    MicrostructureAnalyticsPlatform replay_platform(replay_config);
+    auto platform_stats = replay_platform.replay_capture(session, flat_out);
+    replay_platform.wait();
+    ASSERT_EQ(platform_stats.ticks_replayed, 100u);
+    ASSERT_EQ(replay_platform.get_feed_aggregator().feed_names()[0], std::string("FeedA"));
+    ASSERT_EQ(replay_platform.get_feed_aggregator().total_messages(), 100u);
+
+    bool threw = false;
+    try {
+        TickCaptureReader bad("/tmp/definitely_missing_capture.bin");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    std::remove(path.c_str());
+    std::remove(session.c_str());
+}
+
 // ============================================================
 // End-to-End Integration Tests
 // ============================================================
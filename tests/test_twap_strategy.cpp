@@ -1,5 +1,7 @@
 #include "execution_algorithm.hpp"
 #include "execution_simulator.hpp"
+#include "order_sink.hpp"
+#include "symbol_table.hpp"
 #include "twap_strategy.hpp"
 #include <cassert>
 #include <chrono>
@@ -48,10 +50,12 @@ void test_execution_algorithm_base() {
             strategy_name_ = "SimpleTest";
         }
 
-        std::vector<Order> compute_child_orders(const MarketData& data) override {
-            if (remaining_quantity() == 0) return {};
+        using ExecutionAlgorithm::compute_child_orders;
+
+        void compute_child_orders(const MarketData&, OrderSink& sink) override {
+            if (remaining_quantity() == 0) return;
             // Execute all at once
-            return {create_market_order(static_cast<int>(remaining_quantity()))};
+            sink.emit(create_market_order(static_cast<int>(remaining_quantity())));
         }
     };
 
@@ -434,8 +438,8 @@ void test_twap_performance() {
     std::cout << "\n";
     std::cout << "  Target quantity: 1,000,000\n";
     std::cout << "  Simulation duration: " << duration_ms << " ms\n";
-    std::cout << "  Price points: " << result.price_path.size() << "\n";
-    std::cout << "  Fill count: " << result.fills.size() << "\n";
+    std::cout << "  Price points: " << result.stats.num_ticks << "\n";
+    std::cout << "  Fill count: " << result.stats.num_fills << "\n";
     std::cout << "  Completed: " << (result.completed ? "Yes" : "No") << "\n";
 
     assert(duration_ms < 5000);  // Should complete within 5 seconds
@@ -474,6 +478,59 @@ void test_twap_reset() {
     std::cout << "PASSED\n";
 }
 
+/**
+ * @brief Tests OrderSink emission and symbol-id keyed MarketData
+ */
+void test_order_sink() {
+    std::cout << "Testing OrderSink... ";
+
+    static_assert(std::is_trivially_copyable<MarketData>::value,
+                  "MarketData must be trivially copyable");
+
+    SymbolTable symbols;
+    SymbolId aapl = symbols.intern("AAPL");
+    [[maybe_unused]] SymbolId msft = symbols.intern("MSFT");
+    assert(aapl == 0 && msft == 1);
+    assert(symbols.intern("AAPL") == aapl);
+    assert(symbols.find("GOOG") == INVALID_SYMBOL_ID);
+    assert(symbols.name(msft) == "MSFT");
+
+    auto data = MarketData::from_quotes(100.0, 100.10);
+    data.symbol_id = aapl;
+
+    // Fixed buffer: reused across ticks, rejects beyond capacity
+    TWAPStrategy twap(10000, 10, true);
+    FixedOrderBuffer<1> buffer;
+    twap.on_market_data(data, buffer);
+    assert(buffer.size() == 1);
+    assert(buffer[0].quantity == 1000);
+
+    Order extra = buffer[0];
+    [[maybe_unused]] bool accepted = buffer.emit(extra);
+    assert(!accepted);
+    assert(buffer.dropped() == 1);
+
+    buffer.clear();
+    assert(buffer.empty() && buffer.dropped() == 0);
+
+    // Callback sink: orders forwarded without buffering
+    AggressiveTWAP aggressive(10000, 10, true);
+    int emitted = 0;
+    auto sink = make_order_sink([&](const Order& order) {
+        if (order.quantity > 0) emitted++;
+    });
+    aggressive.on_market_data(data, sink);
+    assert(emitted == 1);
+
+    // Vector API still matches the sink API
+    TWAPStrategy twap2(10000, 10, true);
+    auto orders = twap2.on_market_data(data);
+    assert(orders.size() == 1);
+    assert(orders[0].quantity == 1000);
+
+    std::cout << "PASSED\n";
+}
+
 /**
  * @brief Main test runner
  */
@@ -490,6 +547,7 @@ int main() {
         test_twap_report();
         test_twap_reset();
         test_aggressive_twap();
+        test_order_sink();
 
         std::cout << "\n";
 
@@ -1,9 +1,13 @@
 #include "execution_algorithm.hpp"
 #include "execution_simulator.hpp"
+#include "volume_curve_service.hpp"
 #include "vwap_strategy.hpp"
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
@@ -157,6 +161,197 @@ void test_vwap_custom_weights() {
     std::cout << "PASSED\n";
 }
 
+/**
+ * @brief Builds a synthetic multi-day timeline
+ *
+ * AAPL trades 10x its usual size in the first five minutes of each
+ * session; MSFT trades evenly. Quotes and pre-market trades are mixed
+ * in and must be ignored.
+ */
+std::vector<MarketEvent> make_volume_history(int num_days) {
+    std::vector<MarketEvent> events;
+    for (int day = 0; day < num_days; ++day) {
+        struct tm tm = {};
+        tm.tm_year = 2024 - 1900;
+        tm.tm_mon = 0;
+        tm.tm_mday = 15 + day;
+        tm.tm_isdst = -1;
+        uint64_t midnight = static_cast<uint64_t>(mktime(&tm));
+
+        // Pre-market trade, outside the session
+        events.push_back({(midnight + 8 * 3600) * 1000000000ULL, "AAPL", 150.0, 5000,
+                          MarketEventType::TRADE});
+
+        for (uint64_t sod = 34200; sod < 57600; sod += 5) {
+            uint64_t ts = (midnight + sod) * 1000000000ULL;
+            uint64_t aapl = sod < 34200 + 300 ? 1000 : 100;
+            events.push_back({ts, "AAPL", 150.0, aapl, MarketEventType::TRADE});
+            events.push_back({ts + 1, "MSFT", 300.0, 100, MarketEventType::TRADE});
+            events.push_back({ts + 2, "AAPL", 150.0, 9999, MarketEventType::QUOTE});
+        }
+    }
+    return events;
+}
+
+/**
+ * @brief Interns timeline symbols the way the backtester does
+ */
+SymbolTable make_symbol_table(const std::vector<MarketEvent>& events) {
+    SymbolTable symbols;
+    for (const auto& e : events) {
+        symbols.intern(e.symbol);
+    }
+    return symbols;
+}
+
+/**
+ * @brief Tests volume curves learned from a multi-day timeline
+ */
+void test_volume_curve_build() {
+    std::cout << "Testing volume curve build... ";
+
+    auto events = make_volume_history(3);
+    SymbolTable symbols = make_symbol_table(events);
+
+    VolumeCurveConfig config;
+    config.num_threads = 1;
+    VolumeCurveService single(config);
+    single.build(events, symbols);
+
+    config.num_threads = 4;
+    VolumeCurveService threaded(config);
+    threaded.build(events, symbols);
+
+    const VolumeCurve* aapl = single.find("AAPL");
+    const VolumeCurve* msft = single.find(symbols.find("MSFT"));
+    assert(aapl && msft);
+    assert(single.find("IBM") == nullptr);
+    assert(aapl->num_days == 3);
+    assert(aapl->num_buckets == 78);
+    assert(aapl->cumulative.front() == 0.0f);
+    assert(aapl->cumulative.back() == 1.0f);
+
+    // 60 trades per bucket: first bucket 60000 of 60000 + 77 * 6000 shares
+    double expected_open = 60000.0 / (60000.0 + 77 * 6000.0);
+    assert(std::abs(aapl->bucket_fraction(0) - expected_open) < 1e-5);
+    assert(aapl->bucket_fraction(0) > 5 * aapl->bucket_fraction(1));
+    assert(std::abs(msft->bucket_fraction(40) - 1.0 / 78) < 1e-5);
+    assert(std::abs(msft->fraction_before(34200 + 39 * 300) - 0.5) < 1e-5);
+
+    // Thread count does not change the result
+    for (size_t s = 0; s < single.size(); ++s) {
+        const VolumeCurve* a = single.find(static_cast<SymbolId>(s));
+        const VolumeCurve* b = threaded.find(static_cast<SymbolId>(s));
+        assert(a && b);
+        assert(a->num_days == b->num_days);
+        assert(a->cumulative == b->cumulative);
+        (void)a;
+        (void)b;
+    }
+    (void)aapl;
+    (void)msft;
+    (void)expected_open;
+
+    single.print_summary();
+
+    std::cout << "PASSED\n";
+}
+
+/**
+ * @brief Tests the binary curve cache
+ */
+void test_volume_curve_cache() {
+    std::cout << "Testing volume curve cache... ";
+
+    std::system("mkdir -p tests/data");
+    const std::string cache_file = "tests/data/volume_curves.bin";
+
+    auto events = make_volume_history(2);
+    VolumeCurveService built;
+    built.build(events, make_symbol_table(events));
+    built.save(cache_file);
+
+    VolumeCurveService loaded;
+    loaded.load(cache_file);
+    assert(loaded.size() == built.size());
+    for (const char* symbol : {"AAPL", "MSFT"}) {
+        const VolumeCurve* a = built.find(symbol);
+        const VolumeCurve* b = loaded.find(symbol);
+        assert(a && b);
+        assert(a->session_start_seconds == b->session_start_seconds);
+        assert(a->bucket_seconds == b->bucket_seconds);
+        assert(a->num_days == b->num_days);
+        assert(a->cumulative == b->cumulative);
+        (void)a;
+        (void)b;
+    }
+
+    // 4 bytes per bucket boundary plus a small header
+    std::ifstream in(cache_file, std::ios::binary | std::ios::ate);
+    assert(in.tellg() < 1000);
+    in.close();
+
+    // Garbage is rejected
+    std::ofstream(cache_file, std::ios::binary) << "not a curve file";
+    bool threw = false;
+    try {
+        loaded.load(cache_file);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(loaded.find("AAPL") != nullptr);  // Failed load leaves curves intact
+    (void)threw;
+
+    std::cout << "PASSED\n";
+}
+
+/**
+ * @brief Tests VWAP slices follow a historical volume curve
+ */
+void test_vwap_historical_curve() {
+    std::cout << "Testing VWAP historical volume curve... ";
+
+    auto events = make_volume_history(3);
+    VolumeCurveService service;
+    service.build(events, make_symbol_table(events));
+    const VolumeCurve* curve = service.find("AAPL");
+    assert(curve);
+
+    // 30 minutes from the open in 5-minute slices: one bucket per slice
+    VWAPStrategy vwap(10000, 30, 6, VWAPStrategy::VolumeProfile::UNIFORM, true);
+    vwap.set_volume_curve(*curve, 34200);
+
+    assert(vwap.get_profile_type() == VWAPStrategy::VolumeProfile::HISTORICAL);
+
+    const auto& weights = vwap.get_volume_weights();
+    assert(weights.size() == 6);
+    double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    assert(std::abs(sum - 1.0) < 1e-9);
+    assert(std::abs(weights[0] - 10.0 / 15.0) < 1e-4);
+    for (size_t i = 1; i < weights.size(); ++i) {
+        assert(std::abs(weights[i] - 1.0 / 15.0) < 1e-4);
+    }
+
+    const auto& slices = vwap.get_slice_sizes();
+    uint64_t total = std::accumulate(slices.begin(), slices.end(), uint64_t{0});
+    assert(total == 10000);
+    assert(slices[0] > 6 * slices[1]);
+
+    // Midday window sees a flat curve; an empty curve changes nothing
+    VWAPStrategy midday(10000, 30, 6, VWAPStrategy::VolumeProfile::MORNING, true);
+    midday.set_volume_curve(*curve, 12 * 3600);
+    assert(std::abs(midday.get_volume_weights()[0] - 1.0 / 6) < 1e-4);
+
+    VWAPStrategy untouched(10000, 30, 6, VWAPStrategy::VolumeProfile::MORNING, true);
+    untouched.set_volume_curve(VolumeCurve(), 34200);
+    assert(untouched.get_profile_type() == VWAPStrategy::VolumeProfile::MORNING);
+    (void)sum;
+    (void)total;
+
+    std::cout << "PASSED\n";
+}
+
 /**
  * @brief Tests VWAP slice generation
  */
@@ -468,6 +663,13 @@ int main() {
         // Comparison tests
         test_vwap_profile_comparison();
 
+        std::cout << "\n";
+
+        // Historical volume curves
+        test_volume_curve_build();
+        test_volume_curve_cache();
+        test_vwap_historical_curve();
+
         std::cout << "\n=== All Tests Completed Successfully ===\n";
         return 0;
 